@@ -1,13 +1,17 @@
 #pragma once
 
 #include "CachePolicy.h"
+#include "GenerationReclaimer.h"
+#include "LockPolicy.h"
 #include <list>
+#include <memory>
 #include <unordered_map>
 #include <mutex>
 
 namespace Cache {
 
-template <typename Key, typename Value>
+// Lock: thread-safety policy (see LockPolicy.h)
+template <typename Key, typename Value, typename Lock = std::mutex>
 class ArcCache : public CachePolicy<Key, Value> {
 public:
     explicit ArcCache(size_t capacity);
@@ -20,13 +24,18 @@ public:
     Value get(const Key& key) override;
 
     // Utility methods
-    void clear();
+    void clear();                     // O(1): the old generation is torn down later, off the lock
     size_t size() const;
     size_t capacity() const { return capacity_; }
     size_t p() const { return p_; }
     bool contains(const Key& key) const;
+    uint64_t generation() const { return reclaimer_.generation(); }   // clear() calls so far
+    bool reclaimPending() const { return reclaimer_.pending(); }      // A cleared generation is still alive
+    void reclaimNow() { reclaimer_.drainAll(kReclaimBatch); }  // Tear cleared generations down here and now
 
 private:
+    static constexpr size_t kReclaimBatch = 128;  // Cleared entries torn down per get / put
+
     enum class ListTag { None, T1, T2 };
 
     struct Entry {
@@ -35,6 +44,13 @@ private:
         typename std::list<Key>::iterator it; // Iterator pointing to the node in T1/T2
     };
 
+    // Everything clear() swapped out: one retired generation
+    struct Retired {
+        std::list<Key> t1, t2, b1, b2;
+        std::unordered_map<Key, Entry> map;
+        std::unordered_map<Key, typename std::list<Key>::iterator> b1Map, b2Map;
+    };
+
     // Four lists: T1/T2 are real cache; B1/B2 are ghosts (keys only)
     std::list<Key> t1_, t2_, b1_, b2_;
 
@@ -48,9 +64,13 @@ private:
     size_t p_{0};        // Target size of T1 (0..capacity_)
 
     // Thread-safety
-    mutable std::mutex mtx_;
+    mutable Lock mtx_;
+    GenerationReclaimer reclaimer_;  // Cleared generations
 
 private:
+    bool getLocked(const Key& key, Value& out);      // get body, mtx_ held
+    void putLocked(const Key& key, const Value& value);  // put body, mtx_ held
+
     // —— Core algorithm —— //
     void replace(bool hit_in_b1);  // Evict from T1 or T2 into B1/B2
     void adjustPOnB1Hit();         // On B1 hit: increase p
@@ -1,18 +1,39 @@
 #pragma once
 
 #include "CachePolicy.h"
+#include "ComputeOps.h"
+#include "LockPolicy.h"
 #include <list>
 #include <unordered_map>
 #include <mutex>
 #include <algorithm>
+#include <memory>
+#include <vector>
+
+#include "FlatCombiner.h"
+#include "GenerationReclaimer.h"
+#include "Graveyard.h"
+#include "Lease.h"
+#include "MaintenanceExecutor.h"
+#include "Priority.h"
+#include "RemovalListener.h"
+#include "TagIndex.h"
 
 namespace Cache {
 
-template <typename Key, typename Value>
-class Arc_new : public CachePolicy<Key, Value> {
+// Lock: thread-safety policy (see LockPolicy.h)
+template <typename Key, typename Value, typename Lock = std::mutex>
+class Arc_new : public CachePolicy<Key, Value>,
+                public ComputeOps<Arc_new<Key, Value, Lock>, Key, Value> {
 public:
-    explicit Arc_new(size_t capacity)
-        : capacity_(capacity), p_(0) {}
+    using PinLease = Lease<Arc_new, Key, Value>;
+    using Weigher  = typename PinTable<Key, Value>::Weigher;
+    using Tag      = CacheTag;
+
+    // flatCombining: concurrent puts are batched by one combiner thread (see FlatCombiner.h)
+    explicit Arc_new(size_t capacity, bool flatCombining = false)
+        : capacity_(capacity), p_(0),
+          combiner_(flatCombining ? std::make_unique<FlatCombiner<PutRequest>>() : nullptr) {}
 
     ~Arc_new() override = default;
 
@@ -21,24 +42,101 @@ public:
     bool   get(const Key& key, Value& out) override;
     Value  get(const Key& key) override;
 
+    // put that also replaces the entry's tags (a plain put keeps them);
+    // invalidateTag removes every entry carrying tag in one lock hold
+    // (Explicit, no ghost) and returns how many there were
+    void   put(const Key& key, const Value& value, const std::vector<Tag>& tags);
+    size_t invalidateTag(const Tag& tag);
+    size_t tagSize(const Tag& tag) const;   // Entries currently carrying tag
+
+    // put into a priority tier (a plain put inserts at Normal and keeps an
+    // existing entry's tier). T1 and T2 each keep one sub-list per tier;
+    // replacement takes the lowest tier that has entries and applies the
+    // usual T1-vs-T2 choice inside it (see Priority.h)
+    void   put(const Key& key, const Value& value, Priority priority);
+    PriorityStats priorityStats() const;
+
+    // Read-modify-write in place under one lock hold (see ComputeOps.h).
+    // A kept entry moves to T2 like a hit; a removed one leaves no ghost;
+    // an insert goes through put's ghost / replacement logic
+    template<typename F>
+    bool   compute(const Key& key, F&& fn);
+
     // Utility methods
-    void   clear();
-    size_t size() const;              // T1 + T2
+    void   clear();                   // O(1): the old generation is torn down later, off the lock
+    size_t size() const;              // T1 + T2 + pinned
     size_t capacity() const { return capacity_; }
     size_t p() const { return p_; }
     bool   contains(const Key& key) const;
+    size_t combinedPasses() const;    // Combiner passes that batched >1 put
+    uint64_t generation() const { return reclaimer_.generation(); }   // clear() calls so far
+    bool   reclaimPending() const { return reclaimer_.pending(); }    // A cleared generation is still alive
+    void   reclaimNow() { reclaimer_.drainAll(kReclaimBatch); }  // Tear cleared generations down here and now
+
+    // Pinned entries leave T1/T2 (replace() never sees them) until their
+    // last lease is released; they still count towards capacity (see Lease.h)
+    PinLease pin(const Key& key);
+    void   setPinLimit(size_t maxPinnedBytes, Weigher weigher = nullptr);
+    size_t pinnedBytes() const;
+
+    // Background replacement: put only inserts while |T1|+|T2| < highWatermark;
+    // the executor evicts (T1→B1 / T2→B2) down to lowWatermark
+    void   enableMaintenance(std::shared_ptr<MaintenanceExecutor> executor,
+                             size_t lowWatermark, size_t highWatermark);
+
+    // T1→B1 / T2→B2 evictions (DemotedT1 / DemotedT2), overwrites (Replaced)
+    // and clear() (Explicit) are reported in batches after the unlock
+    void   setRemovalListener(RemovalListener<Key, Value> listener,
+                              std::shared_ptr<MaintenanceExecutor> executor = nullptr);
 
 private:
+    friend PinLease;
+    static constexpr size_t kMaintenanceBatch = 64;  // Evictions per lock hold in the task
+    static constexpr size_t kReclaimBatch = 128;     // Cleared entries torn down per get / put
+
+    // What one operation takes out of the cache; handled after the unlock
+    struct Removed {
+        Graveyard<Value>         values;
+        RemovalBatch<Key, Value> notes;              // Used instead of values while a listener is set
+        size_t size() const { return values.size() + notes.size(); }
+    };
+
+    // What a put sets besides the value; null: leave as is
+    struct PutOptions {
+        const std::vector<Tag>* tags = nullptr;
+        const Priority*         priority = nullptr;
+    };
+    // Points into the waiting caller's frame: the value is moved/swapped in, and
+    // the caller's Removed receives the victim
+    struct PutRequest { const Key* key; Value* value; Removed* removed; PutOptions opts; };
+
     enum class ListTag { None, T1, T2 };
 
     struct Entry {
         Value value{};
         ListTag tag{ListTag::None};
         typename std::list<Key>::iterator it;  // Iterator pointing to the key's position in T1/T2
+        uint64_t pinId{0};                     // Non-zero while leased: off T1/T2, it is stale
+        TagLinks tags;                         // Tags this entry carries (see TagIndex.h)
+        Priority priority{Priority::Normal};   // Sub-list of T1/T2 it lives on
     };
 
-    // Four lists: T1/T2 are real cache; B1/B2 are ghost lists (keys only)
-    std::list<Key> t1_, t2_, b1_, b2_;
+    using Slot = std::pair<const Key, Entry>;  // map_ node: stable while the entry is resident
+    struct SlotTags { TagLinks& operator()(Slot* s) const { return s->second.tags; } };
+
+    // Everything clear() swapped out: one retired generation
+    struct Retired {
+        PriorityLists<Key> t1, t2;
+        std::list<Key> b1, b2;
+        std::unordered_map<Key, Entry> map;
+        std::unordered_map<Key, typename std::list<Key>::iterator> b1Map, b2Map;
+        TagIndex<Slot*, SlotTags> tags;
+    };
+
+    // Four lists: T1/T2 are real cache (one sub-list per priority tier);
+    // B1/B2 are ghost lists (keys only)
+    PriorityLists<Key> t1_, t2_;
+    std::list<Key> b1_, b2_;
 
     // Real cache index (only T1/T2 hold values)
     std::unordered_map<Key, Entry> map_;
@@ -48,22 +146,48 @@ private:
 
     size_t capacity_{0}; // Real cache capacity (T1+T2)
     size_t p_{0};        // Target size of T1 (0..capacity_)
+    PinTable<Key, Value> pins_;  // Leased entries (off T1/T2) + pinned-bytes budget
+    PriorityStats prioStats_;    // Per-tier hits / inserts / evictions / entries
+    TagIndex<Slot*, SlotTags> tags_;  // tag → tagged entries
 
-    mutable std::mutex mtx_;
+    mutable Lock mtx_;
+    std::unique_ptr<FlatCombiner<PutRequest>> combiner_;  // null unless flatCombining
+    RemovalDispatcher<Key, Value> removal_;               // Outlives maintenance_, whose task reports through it
+    GenerationReclaimer reclaimer_;                       // Cleared generations; also used by the task
+    MaintenanceHandle maintenance_;                       // Last member: unregisters first
 
 private:
+    bool getLocked(const Key& key, Value& out,           // get body, mtx_ held
+                   Removed& removed);
+    void putLocked(const Key& key, Value& value,         // put body, mtx_ held
+                   Removed& removed, const PutOptions& opts = {});
+    void putWith(const Key& key, const Value& value,     // put with options, any mode
+                 const PutOptions& opts);
+    bool replaceInline() const;                          // false while maintenance absorbs the overshoot
+    void scheduleIfOverCapacity();                       // After an insert, mtx_ held
+    void runMaintenance();                               // Executor task
+    size_t reclaimSome(Retired& old, size_t max);        // Drain step for a cleared generation
+    void unpin(const Key& key, uint64_t pinId);          // Lease release: relink after the last one
+    size_t resident() const { return t1_.size() + t2_.size() + pins_.entries(); }
+
     // —— Core algorithm —— //
-    void replace(bool hit_in_b1);  // Evict from T1 or T2 to B1/B2
+    void replace(bool hit_in_b1, Removed* removed);  // Evict from T1 or T2 (lowest tier) to B1/B2
     void adjustPOnB1Hit();         // On B1 hit: increase p (favor recency)
     void adjustPOnB2Hit();         // On B2 hit: decrease p (favor frequency)
 
     // —— List/index operations —— //
     void moveToT2(const Key& key);
-    void addToT1MRU(const Key& key, const Value& val);
-    void addToT2MRU(const Key& key, const Value& val);
-
-    void evictFromT1ToB1();
-    void evictFromT2ToB2();
+    Slot* addToT1MRU(const Key& key, Value&& val, Priority priority);
+    Slot* addToT2MRU(const Key& key, Value&& val, Priority priority);
+    PriorityLists<Key>& listOf(ListTag tag) { return tag == ListTag::T1 ? t1_ : t2_; }
+    void setPriority(Slot& slot, Priority priority);    // Relink in the new tier (unless pinned)
+
+    // removed: receives the victim's value so it can be reported / destroyed off the lock;
+    // tier: the sub-list the victim is taken from
+    void evictFromT1ToB1(Removed* removed, Priority tier);
+    void evictFromT2ToB2(Removed* removed, Priority tier);
+    void forgetEntry(const Entry& entry);               // Entry leaves map_: per-tier count
+    void retire(const Key& key, Value&& value, RemovalCause cause, Removed& removed);
 
     // Keep ghost lists bounded: |B1|, |B2| ≤ capacity_
     void trimGhost(std::list<Key>& blist,
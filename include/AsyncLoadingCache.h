@@ -0,0 +1,118 @@
+#pragma once
+
+// =========================================================
+//  AsyncLoadingCache: C++20 coroutine get-or-load
+//  ---------------------------------------------------------
+//      std::optional<V> v = co_await async.co_getOrLoad(key, loader);
+//
+//  Wraps any cache with get(key, value&) / put(key, value):
+//  every CachePolicy (LruCache, LfuCache, Arc_new …) and
+//  HashLruCaches alike. The cache is only referenced and must
+//  outlive this object and every load still in flight.
+//
+//  - Hit: await_ready() returns true, the coroutine never
+//    suspends and nothing is allocated.
+//  - Miss: the coroutine suspends. The first awaiter of a key
+//    starts the async loader; later awaiters of that key join
+//    it (coalescing) and their loaders are not called.
+//  - The loader calls `done(value, error)` exactly once, from
+//    any thread, possibly before it returns. The value goes
+//    into the cache and every waiter is resumed on the
+//    completing thread. nullopt means "no such key" (not
+//    cached); an error is rethrown from each co_await.
+//  - A loader that completes inline does not suspend its
+//    caller at all.
+//
+//  Only compiled when the compiler supports coroutines
+//  (CACHE_HAS_COROUTINES); the rest of the library stays C++17.
+// =========================================================
+
+#if defined(__cpp_impl_coroutine) && __cpp_impl_coroutine >= 201902L && __has_include(<coroutine>)
+#define CACHE_HAS_COROUTINES 1
+#else
+#define CACHE_HAS_COROUTINES 0
+#endif
+
+#if CACHE_HAS_COROUTINES
+
+#include <atomic>
+#include <coroutine>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+namespace Cache {
+
+template<typename Key, typename Value, typename CacheT>
+class AsyncLoadingCache {
+public:
+    using Completion  = std::function<void(std::optional<Value> value, std::exception_ptr error)>;
+    using AsyncLoader = std::function<void(const Key& key, Completion done)>;
+
+private:
+    // One in-flight load, shared by every awaiter of the key
+    struct Pending {
+        bool                                 done{false};
+        std::optional<Value>                 value;
+        std::exception_ptr                   error;
+        std::vector<std::coroutine_handle<>> waiters;
+    };
+
+public:
+    // ---- Awaitable returned by co_getOrLoad ----
+    class GetOrLoad {
+    public:
+        bool await_ready();
+        bool await_suspend(std::coroutine_handle<> handle);
+        std::optional<Value> await_resume();
+
+    private:
+        friend class AsyncLoadingCache;
+        GetOrLoad(AsyncLoadingCache& owner, const Key& key, AsyncLoader loader)
+            : owner_(&owner), key_(key), loader_(std::move(loader)) {}
+
+        AsyncLoadingCache*       owner_;
+        Key                      key_;
+        AsyncLoader              loader_;
+        std::optional<Value>     hit_;
+        std::shared_ptr<Pending> pending_;                // Set on a miss
+    };
+
+    explicit AsyncLoadingCache(CacheT& cache) : cache_(cache) {}
+
+    AsyncLoadingCache(const AsyncLoadingCache&) = delete;
+    AsyncLoadingCache& operator=(const AsyncLoadingCache&) = delete;
+
+    GetOrLoad co_getOrLoad(const Key& key, AsyncLoader loader) { return GetOrLoad(*this, key, std::move(loader)); }
+
+    // ---- Statistics ----
+    size_t hits() const        { return hits_.load(std::memory_order_relaxed); }
+    size_t loads() const       { return loads_.load(std::memory_order_relaxed); }         // Loader calls
+    size_t joined() const      { return joined_.load(std::memory_order_relaxed); }        // Awaited another's load
+    size_t suspensions() const { return suspensions_.load(std::memory_order_relaxed); }
+
+private:
+    bool start(GetOrLoad& awaiter, std::coroutine_handle<> handle);   // await_suspend body
+    void complete(const Key& key, const std::shared_ptr<Pending>& pending,
+                  std::optional<Value> value, std::exception_ptr error);
+
+private:
+    CacheT&                                           cache_;
+    std::mutex                                        mutex_;
+    std::unordered_map<Key, std::shared_ptr<Pending>> pending_;
+
+    std::atomic<size_t> hits_{0};
+    std::atomic<size_t> loads_{0};
+    std::atomic<size_t> joined_{0};
+    std::atomic<size_t> suspensions_{0};
+};
+
+} // namespace Cache
+
+#include "../src/AsyncLoadingCache.tpp"
+
+#endif // CACHE_HAS_COROUTINES
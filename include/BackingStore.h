@@ -0,0 +1,81 @@
+#pragma once
+
+// =========================================================
+//  BackingStore: the slow tier behind a WriteBackCache
+//  ---------------------------------------------------------
+//  read() fetches one key; writeBatch() persists many in one
+//  round trip, which is where write-back saves its cost.
+//  Implementations must be thread-safe: reads come from any
+//  caller thread while the flusher writes.
+//
+//  MemoryBackingStore is the stand-in used by the tests and
+//  benchmarks: a map plus a simulated per-call latency and
+//  counters for calls and entries written.
+// =========================================================
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace Cache {
+
+template<typename Key, typename Value>
+class BackingStore {
+public:
+    using Entries = std::vector<std::pair<Key, Value>>;
+
+    virtual ~BackingStore() = default;
+
+    virtual bool read(const Key& key, Value& value) = 0;   // false if absent
+    virtual void writeBatch(const Entries& entries) = 0;   // May throw; nothing is assumed written then
+};
+
+template<typename Key, typename Value>
+class MemoryBackingStore : public BackingStore<Key, Value> {
+public:
+    using typename BackingStore<Key, Value>::Entries;
+
+    // callLatency is slept once per read / writeBatch, like a network round trip
+    explicit MemoryBackingStore(std::chrono::microseconds callLatency = std::chrono::microseconds(0))
+        : callLatency_(callLatency) {}
+
+    bool read(const Key& key, Value& value) override {
+        wait();
+        reads_.fetch_add(1, std::memory_order_relaxed);
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = data_.find(key);
+        if (it == data_.end()) return false;
+        value = it->second;
+        return true;
+    }
+
+    void writeBatch(const Entries& entries) override {
+        wait();
+        writeCalls_.fetch_add(1, std::memory_order_relaxed);
+        entriesWritten_.fetch_add(entries.size(), std::memory_order_relaxed);
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (const auto& kv : entries) data_[kv.first] = kv.second;
+    }
+
+    size_t reads() const          { return reads_.load(std::memory_order_relaxed); }
+    size_t writeCalls() const     { return writeCalls_.load(std::memory_order_relaxed); }
+    size_t entriesWritten() const { return entriesWritten_.load(std::memory_order_relaxed); }
+
+private:
+    void wait() const {
+        if (callLatency_.count() > 0) std::this_thread::sleep_for(callLatency_);
+    }
+
+    std::chrono::microseconds     callLatency_;
+    std::mutex                    mutex_;
+    std::unordered_map<Key, Value> data_;
+    std::atomic<size_t>           reads_{0};
+    std::atomic<size_t>           writeCalls_{0};
+    std::atomic<size_t>           entriesWritten_{0};
+};
+
+} // namespace Cache
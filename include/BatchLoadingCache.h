@@ -0,0 +1,110 @@
+#pragma once
+
+// =========================================================
+//  BatchLoadingCache: coalesce misses into bulk loads
+//  ---------------------------------------------------------
+//  A HashLruCaches whose misses are fetched by a bulk loader
+//  (DataLoader-style). Misses from concurrent callers are
+//  collected into one batch and fetched with a single
+//  loader call; the results go into the cache and back to
+//  every waiting caller.
+//
+//  - The first miss of a batch is its leader: it waits up to
+//    `window` for more misses, then runs the loader on its
+//    own thread. A miss that fills the batch to maxBatch runs
+//    it at once instead. No background thread is involved.
+//  - A key that is already pending or loading is not asked
+//    for twice: later callers wait on the same result
+//    (single flight).
+//  - Keys the loader leaves out of its result are misses
+//    (get returns false). With negativeTtl > 0 they go into a
+//    NegativeCache and lookup() answers KnownAbsent for them
+//    without a loader call until it expires or a put().
+//  - A put() while the key is loading wins: the loaded value
+//    is still returned to the waiting callers but not cached.
+//  - A loader exception is rethrown from every get() that
+//    was waiting on that batch.
+// =========================================================
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "LruCache.h"
+#include "NegativeCache.h"
+
+namespace Cache {
+
+struct BatchLoaderOptions {
+    std::chrono::microseconds window{500};   // How long a leader waits for more misses
+    size_t maxBatch{64};                     // Keys per loader call
+    std::chrono::milliseconds negativeTtl{0};   // > 0: cache "no such key" this long
+    size_t negativeCapacity{4096};              // Absent keys remembered (own budget)
+};
+
+template<typename Key, typename Value>
+class BatchLoadingCache {
+public:
+    using BulkLoader = std::function<std::unordered_map<Key, Value>(const std::vector<Key>& keys)>;
+
+    BatchLoadingCache(size_t capacity, BulkLoader loader,
+                      BatchLoaderOptions options = BatchLoaderOptions{}, int sliceNum = 0);
+
+    BatchLoadingCache(const BatchLoadingCache&) = delete;
+    BatchLoadingCache& operator=(const BatchLoadingCache&) = delete;
+
+    bool get(const Key& key, Value& value);        // Loads on a miss; false if the loader has no value
+    LookupResult lookup(const Key& key, Value& value);   // get() that tells a fresh miss from a known one
+    void put(const Key& key, const Value& value);
+    void remove(const Key& key);
+
+    // ---- Statistics ----
+    size_t loaderCalls() const { return loaderCalls_.load(std::memory_order_relaxed); }
+    size_t keysLoaded() const  { return keysLoaded_.load(std::memory_order_relaxed); }   // Keys requested
+    size_t sharedMisses() const { return sharedMisses_.load(std::memory_order_relaxed); } // Joined a pending key
+    size_t negativeHits() const { return negativeHits_.load(std::memory_order_relaxed); } // Answered KnownAbsent
+
+private:
+    // One key's result, shared by every caller waiting for it
+    struct Slot {
+        bool               done{false};
+        bool               found{false};
+        bool               superseded{false};      // put() arrived: keep its value, don't cache the load
+        Value              value{};
+        std::exception_ptr error;
+    };
+
+    struct Batch {
+        std::vector<Key>                   keys;
+        std::vector<std::shared_ptr<Slot>> slots;
+        bool                               dispatched{false};   // Taken by whoever runs the loader
+    };
+
+    void dispatch(Batch& batch);                   // Run the loader and publish; mutex_ not held
+
+private:
+    HashLruCaches<Key, Value> cache_;
+    BulkLoader                loader_;
+    BatchLoaderOptions        options_;
+
+    std::mutex              mutex_;                // pending_ / open_; cache_ writes happen under it
+    std::condition_variable cv_;                   // Batch dispatched / slots completed
+    std::shared_ptr<Batch>  open_;                 // Batch still collecting misses
+    std::unordered_map<Key, std::shared_ptr<Slot>> pending_;   // Keys in a collecting or loading batch
+    std::unique_ptr<NegativeCache<Key>> negatives_;            // Null unless negativeTtl > 0; written under mutex_
+
+    std::atomic<size_t> loaderCalls_{0};
+    std::atomic<size_t> keysLoaded_{0};
+    std::atomic<size_t> sharedMisses_{0};
+    std::atomic<size_t> negativeHits_{0};
+};
+
+} // namespace Cache
+
+#include "../src/BatchLoadingCache.tpp"
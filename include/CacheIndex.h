@@ -0,0 +1,57 @@
+#pragma once
+
+// =========================================================
+//  CacheIndex.h —— key → node indices for the cache policies
+//  ---------------------------------------------------------
+//  An Index<Key, Mapped> provides:
+//    bool   find(const Key&, Mapped& out) const;
+//    bool   insertOrAssign(const Key&, const Mapped&);   // true if newly inserted
+//    bool   erase(const Key&);
+//    size_t size() const;
+//
+//  Available indices (pass as the Index template argument of
+//  LruCache / HashLruCaches):
+//    StdHashIndex    —— std::unordered_map (default)
+//    ConcurrentIndex —— ConcurrentHashMap: lock-free reads, EBR
+//    CuckooIndex     —— CuckooHashMap: 4-way cuckoo, >90% load
+// =========================================================
+
+#include <unordered_map>
+
+#include "ConcurrentHashMap.h"
+#include "CuckooHashMap.h"
+
+namespace Cache {
+
+// Thin adapter so std::unordered_map speaks the Index interface
+template<typename Key, typename Mapped>
+class StdHashIndex {
+public:
+    explicit StdHashIndex(size_t initialCapacity = 0) { map_.reserve(initialCapacity); }
+
+    bool find(const Key& key, Mapped& out) const {
+        auto it = map_.find(key);
+        if (it == map_.end()) return false;
+        out = it->second;
+        return true;
+    }
+
+    bool insertOrAssign(const Key& key, const Mapped& mapped) {
+        return map_.insert_or_assign(key, mapped).second;
+    }
+
+    bool   erase(const Key& key) { return map_.erase(key) > 0; }
+    size_t size() const { return map_.size(); }
+
+private:
+    std::unordered_map<Key, Mapped> map_;
+};
+
+// Two-parameter aliases: usable as template template arguments on every compiler
+template<typename Key, typename Mapped>
+using ConcurrentIndex = ConcurrentHashMap<Key, Mapped>;
+
+template<typename Key, typename Mapped>
+using CuckooIndex = CuckooHashMap<Key, Mapped>;
+
+} // namespace Cache
@@ -0,0 +1,73 @@
+#pragma once
+
+// =========================================================
+//  ComputeOps.h —— atomic read-modify-write on one entry
+//  ---------------------------------------------------------
+//  get() followed by put() takes the cache lock twice, probes
+//  the index twice and loses updates when two threads race on
+//  the same key. A cache that provides the primitive
+//
+//      bool compute(key, fn)      fn: bool(Value& value, bool present)
+//
+//  runs fn on the stored value in place, under one lock hold
+//  and one index probe:
+//    - present: value is the cached value itself; returning
+//      false removes the entry (reported as Explicit)
+//    - absent:  value is a default-constructed Value; returning
+//      true inserts it (which may evict, reported as Size)
+//  compute returns whether the key is cached afterwards.
+//
+//  ComputeOps<Derived> (CRTP) builds the usual variants on top:
+//    computeIfAbsent(key, fn)      fn: Value(const Key&)  → cached / new value
+//    computeIfPresent(key, fn)     fn: bool(Value&)       → false: not cached (afterwards)
+//    merge(key, value, fn)         fn: void(Value& stored, const Value& value)
+//
+//  fn runs with the cache lock held: keep it short and never
+//  call back into the same cache. In-place updates are not
+//  reported as Replaced (there is no old value left to report).
+//  If fn throws, nothing is inserted or removed, but a present
+//  value keeps whatever fn already did to it.
+// =========================================================
+
+#include <utility>
+
+namespace Cache {
+
+template<typename Derived, typename Key, typename Value>
+class ComputeOps {
+public:
+    // Returns the cached value, computing and inserting it on a miss
+    template<typename F>
+    Value computeIfAbsent(const Key& key, F&& fn) {
+        Value result{};
+        self().compute(key, [&](Value& value, bool present) {
+            if (!present) value = fn(key);
+            result = value;
+            return true;
+        });
+        return result;
+    }
+
+    // fn only runs when the key is cached; returning false removes it
+    template<typename F>
+    bool computeIfPresent(const Key& key, F&& fn) {
+        return self().compute(key, [&](Value& value, bool present) {
+            return present && fn(value);
+        });
+    }
+
+    // Absent: insert value. Present: fn folds value into the stored one
+    template<typename F>
+    void merge(const Key& key, const Value& value, F&& fn) {
+        self().compute(key, [&](Value& stored, bool present) {
+            if (present) fn(stored, value);
+            else stored = value;
+            return true;
+        });
+    }
+
+private:
+    Derived& self() { return static_cast<Derived&>(*this); }
+};
+
+} // namespace Cache
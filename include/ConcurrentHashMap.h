@@ -0,0 +1,95 @@
+#pragma once
+
+// =========================================================
+//  ConcurrentHashMap: read-mostly index with lock-free reads
+//  ---------------------------------------------------------
+//  Open addressing (linear probing) over an array of atomic
+//  node pointers:
+//   - find() never takes a lock: it probes under an
+//     EpochReclaimer::Guard and copies the value out of an
+//     immutable node.
+//   - Writers serialize per key on striped mutexes. An update
+//     publishes a fresh node and retires the old one; erase
+//     leaves a tombstone. Both go through EBR, so a reader
+//     still holding the old node stays safe.
+//   - Growth / tombstone purge rebuilds the slot array under
+//     all stripes and swaps the table pointer atomically.
+//
+//  Each node also carries an "accessed" bit that find() sets,
+//  which CLOCK/SIEVE-style policies (see SieveCache.h) read
+//  and clear on their eviction path.
+// =========================================================
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+
+#include "EpochReclaimer.h"
+
+namespace Cache {
+
+template<typename Key, typename Value, typename Hash = std::hash<Key>>
+class ConcurrentHashMap {
+public:
+    explicit ConcurrentHashMap(size_t initialCapacity = 64);
+    ~ConcurrentHashMap();
+
+    ConcurrentHashMap(const ConcurrentHashMap&) = delete;
+    ConcurrentHashMap& operator=(const ConcurrentHashMap&) = delete;
+
+    // ---- Lock-free reads ----
+    bool find(const Key& key, Value& value) const;       // Copies the value; marks the entry accessed
+    bool contains(const Key& key) const;                 // Does not mark the entry accessed
+
+    // ---- Writes (striped locks) ----
+    bool insertOrAssign(const Key& key, const Value& value, bool accessed = false); // true if newly inserted
+    bool erase(const Key& key);
+
+    // Access bit for CLOCK/SIEVE eviction: returns the old bit and clears it
+    bool testAndClearAccessed(const Key& key);
+
+    size_t size() const { return size_.load(std::memory_order_relaxed); }
+    size_t slotCount() const;                            // Current slot array length
+
+private:
+    struct Node {
+        size_t hash;
+        Key    key;
+        Value  value;
+        mutable std::atomic<bool> accessed;
+
+        Node(size_t h, const Key& k, const Value& v, bool a)
+            : hash(h), key(k), value(v), accessed(a) {}
+    };
+
+    struct Table {
+        size_t mask;
+        std::unique_ptr<std::atomic<Node*>[]> slots;
+        std::atomic<size_t> used{0};                     // Non-empty slots, tombstones included
+
+        explicit Table(size_t capacity);
+    };
+
+    static Node* tombstone() { return reinterpret_cast<Node*>(static_cast<uintptr_t>(1)); }
+    static bool  isLive(Node* n) { return n != nullptr && n != tombstone(); }
+    static size_t roundUpPow2(size_t n);
+
+    Node*      findNode(const Table* t, size_t h, const Key& key) const;  // Caller holds a Guard
+    std::mutex& stripeFor(size_t h) const { return stripes_[h & (kStripes - 1)]; }
+    bool       needsRehash(const Table* t) const;
+    void       rehash();                                 // Takes every stripe
+
+private:
+    static constexpr size_t kStripes = 32;
+
+    Hash                               hasher_;
+    std::atomic<Table*>                table_;
+    std::atomic<size_t>                size_{0};
+    mutable std::unique_ptr<std::mutex[]> stripes_;
+};
+
+} // namespace Cache
+
+#include "../src/ConcurrentHashMap.tpp"
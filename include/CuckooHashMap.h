@@ -0,0 +1,124 @@
+#pragma once
+
+// =========================================================
+//  CuckooHashMap: bucketized cuckoo hashing index
+//  ---------------------------------------------------------
+//  - 4-way buckets; each key lives in one of two buckets
+//    (partial-key cuckoo: the alternate bucket is derived
+//    from the bucket index and an 8-bit tag, so entries can
+//    be displaced without rehashing the key).
+//  - Writers lock the stripes of the (at most two) buckets
+//    they touch; displacement moves entries backwards along
+//    a BFS-found cuckoo path, one locked pair at a time, so
+//    a key is never absent from both of its buckets.
+//  - Reads are optimistic when Key and Value are trivially
+//    copyable: snapshot the two stripe versions, copy, and
+//    retry if either version moved. Other types read under
+//    the stripe locks.
+//  - The table only grows when no cuckoo path exists, which
+//    lets it run above 90% occupancy.
+//
+//  Same interface as ConcurrentHashMap, so it can be used as
+//  the Index of LruCache / HashLruCaches (see CacheIndex.h).
+// =========================================================
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+#include "EpochReclaimer.h"
+#include "Seqlock.h"
+
+namespace Cache {
+
+template<typename Key, typename Value, typename Hash = std::hash<Key>>
+class CuckooHashMap {
+public:
+    static constexpr size_t kSlotsPerBucket = 4;
+
+    explicit CuckooHashMap(size_t initialCapacity = 64);
+    ~CuckooHashMap();
+
+    CuckooHashMap(const CuckooHashMap&) = delete;
+    CuckooHashMap& operator=(const CuckooHashMap&) = delete;
+
+    bool find(const Key& key, Value& value) const;
+    bool contains(const Key& key) const;
+    bool insertOrAssign(const Key& key, const Value& value);  // true if newly inserted
+    bool erase(const Key& key);
+
+    // ---- Occupancy / memory statistics ----
+    size_t size() const { return size_.load(std::memory_order_relaxed); }
+    size_t slotCount() const;
+    double loadFactor() const { return static_cast<double>(size()) / slotCount(); }
+    size_t memoryBytes() const;                              // Bucket array + stripe locks
+    size_t growCount() const { return growCount_.load(std::memory_order_relaxed); }
+
+private:
+    static constexpr bool kOptimisticReads =
+        std::is_trivially_copyable<Key>::value && std::is_trivially_copyable<Value>::value;
+    static constexpr size_t kStripes   = 256;
+    static constexpr size_t kMaxBfs    = 512;                // Buckets visited per path search
+
+    struct Bucket {
+        std::atomic<uint8_t> tags[kSlotsPerBucket];          // 0 = empty slot
+        Key   keys[kSlotsPerBucket];
+        Value values[kSlotsPerBucket];
+
+        Bucket() { for (auto& t : tags) t.store(0, std::memory_order_relaxed); }
+    };
+
+    struct Table {
+        size_t mask;
+        std::unique_ptr<Bucket[]> buckets;
+        explicit Table(size_t bucketCount) : mask(bucketCount - 1), buckets(new Bucket[bucketCount]) {}
+    };
+
+    struct alignas(64) PaddedLock { VersionLock lock; };
+
+    struct PathStep { size_t bucket; size_t slot; int parent; };   // BFS node; slot = entry moved from parent
+    struct Move     { size_t from; size_t slot; size_t to; };
+    enum class MoveResult { Done, Raced, NoPath };
+
+    // ---- Hashing ----
+    size_t  hashOf(const Key& key) const;
+    static uint8_t tagOf(size_t h);
+    static size_t  altBucket(size_t bucket, uint8_t tag, size_t mask);
+
+    // ---- Slot access (atomic word copies for optimistic types) ----
+    static void loadKey(Key& dst, const Key& src);
+    static void loadValue(Value& dst, const Value& src);
+    static void storeSlot(Bucket& b, size_t slot, const Key& key, const Value& value, uint8_t tag);
+    static void moveSlot(Bucket& from, size_t fs, Bucket& to, size_t ts);
+    static void clearSlot(Bucket& b, size_t slot);
+    static int  findInBucket(const Bucket& b, uint8_t tag, const Key& key);
+    static int  freeSlot(const Bucket& b);
+
+    // ---- Locking ----
+    VersionLock& stripe(size_t bucket) const { return stripes_[bucket & (kStripes - 1)].lock; }
+    void lockPair(size_t b1, size_t b2) const;
+    void unlockPair(size_t b1, size_t b2) const;
+
+    bool findLocked(const Key& key, Value& value) const;
+    bool findOptimistic(const Key& key, Value& value) const;
+
+    // ---- Displacement / growth ----
+    static bool searchPath(const Table* t, size_t b1, size_t b2, std::vector<Move>& moves);
+    MoveResult  makeRoom(Table* t, size_t b1, size_t b2);
+    static bool insertUnpublished(Table* t, size_t h, const Key& key, const Value& value);
+    void        grow(Table* expected);
+
+private:
+    Hash                          hasher_;
+    std::atomic<Table*>           table_;
+    std::atomic<size_t>           size_{0};
+    std::atomic<size_t>           growCount_{0};
+    std::unique_ptr<PaddedLock[]> stripes_;
+};
+
+} // namespace Cache
+
+#include "../src/CuckooHashMap.tpp"
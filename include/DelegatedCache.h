@@ -0,0 +1,118 @@
+#pragma once
+
+// =========================================================
+//  DelegatedCache: one owner thread runs the cache
+//  ---------------------------------------------------------
+//  Any CachePolicy is handed to a dedicated owner thread.
+//  Clients never touch the policy: they push requests into
+//  a lock-free MPSC ring (MpscQueue.h) and the owner drains
+//  it in batches, so every list manipulation happens on one
+//  core and the policy's own mutex is never contended.
+//
+//  - Results of a drained batch are delivered after the
+//    whole batch has been applied (sync waiters, callbacks
+//    and futures alike). Callbacks run on the owner thread
+//    and must not call back into this cache synchronously.
+//  - put() is fire-and-forget; requests from one client are
+//    applied in submission order, so a get() issued after a
+//    put() from the same thread sees it.
+//  - A full ring applies backpressure: the client yields
+//    until the owner frees space.
+//  - An exception from the policy reaches the client: get()
+//    rethrows it, futures hold it. A throwing getAsync
+//    callback, or a failed fire-and-forget put(), has nobody
+//    to tell and is counted in errors(); the owner thread
+//    keeps running either way.
+//  - The destructor drains whatever is queued, then joins.
+// =========================================================
+
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+#include "CachePolicy.h"
+#include "MpscQueue.h"
+
+namespace Cache {
+
+template<typename Key, typename Value>
+class DelegatedCache : public CachePolicy<Key, Value> {
+public:
+    using GetCallback = std::function<void(bool found, const Value& value)>;
+
+    explicit DelegatedCache(std::unique_ptr<CachePolicy<Key, Value>> cache,
+                            size_t queueCapacity = 4096, size_t maxBatch = 256);
+    ~DelegatedCache() override;
+
+    DelegatedCache(const DelegatedCache&) = delete;
+    DelegatedCache& operator=(const DelegatedCache&) = delete;
+
+    // ---- CachePolicy interface ----
+    void   put(const Key& key, const Value& value) override;   // Enqueue, don't wait
+    bool   get(const Key& key, Value& value) override;         // Wait for the owner's answer
+    Value  get(const Key& key) override;                       // Throws if missing
+
+    // ---- Asynchronous requests ----
+    void getAsync(const Key& key, GetCallback done);
+    std::future<std::optional<Value>> getFuture(const Key& key);
+    std::future<void> putFuture(const Key& key, const Value& value);  // Ready once applied
+
+    // ---- Statistics (approximate while running) ----
+    size_t batches() const   { return batches_.load(std::memory_order_relaxed); }
+    size_t processed() const { return processed_.load(std::memory_order_relaxed); }
+    size_t errors() const    { return errors_.load(std::memory_order_relaxed); }   // Thrown, nobody to receive it
+
+private:
+    enum class Op { Put, Get };
+
+    // A client spinning on a stack-allocated answer (cheaper than a future)
+    struct SyncWaiter {
+        std::atomic<bool> done{false};
+        bool   found{false};
+        Value* out{nullptr};
+        std::exception_ptr error;
+    };
+
+    struct Request {
+        Op          op{Op::Get};
+        Key         key{};
+        Value       value{};
+        SyncWaiter* waiter{nullptr};
+        GetCallback callback;                                  // Get result, or plain "applied" for Put
+        std::function<void(std::exception_ptr)> onError;       // Futures: the promise takes the error
+        std::exception_ptr error;                              // Set on the owner thread
+    };
+
+    void submit(Request&& request);
+    void ownerLoop();
+    size_t drainBatch(std::vector<Request>& batch);
+    void complete(std::vector<Request>& batch, const std::vector<bool>& found);
+
+private:
+    static constexpr int kIdleSpins = 256;                     // Empty polls before parking
+
+    std::unique_ptr<CachePolicy<Key, Value>> cache_;           // Touched by the owner thread only
+    MpscQueue<Request>       queue_;
+    size_t                   maxBatch_;
+
+    std::atomic<bool>        stop_{false};
+    std::atomic<bool>        sleeping_{false};
+    std::mutex               parkMutex_;
+    std::condition_variable  parkCv_;
+
+    std::atomic<size_t>      batches_{0};
+    std::atomic<size_t>      processed_{0};
+    std::atomic<size_t>      errors_{0};
+    std::thread              owner_;                           // Started last, after every member above
+};
+
+} // namespace Cache
+
+#include "../src/DelegatedCache.tpp"
@@ -0,0 +1,93 @@
+#pragma once
+
+// =========================================================
+//  EpochReclaimer: epoch-based memory reclamation (EBR)
+//  ---------------------------------------------------------
+//  Lock-free readers may still be looking at a node that a
+//  writer has just unlinked. Instead of deleting it right
+//  away, the writer retire()s it; the node is freed only once
+//  every reader that could have seen it has left its
+//  critical section.
+//
+//  - Readers wrap each lookup in an EpochReclaimer::Guard
+//    (pins the current global epoch for the calling thread).
+//  - The global epoch advances only when every pinned thread
+//    has observed it; garbage retired in epoch e is freed once
+//    the global epoch reaches e + 2.
+//
+//  One process-wide domain (instance()) is shared by every
+//  lock-free structure in the library.
+// =========================================================
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+namespace Cache {
+
+class EpochReclaimer {
+public:
+    static EpochReclaimer& instance();
+
+    // RAII read-side critical section; nesting is allowed
+    class Guard {
+    public:
+        Guard();
+        ~Guard();
+        Guard(const Guard&) = delete;
+        Guard& operator=(const Guard&) = delete;
+    };
+
+    // Hand an unlinked object over; deleter runs once no reader can see it
+    void retire(void* ptr, void (*deleter)(void*));
+
+    template<typename T>
+    void retire(T* ptr) {
+        retire(static_cast<void*>(ptr), [](void* p) { delete static_cast<T*>(p); });
+    }
+
+    // Try to advance the epoch and free whatever became safe
+    void tryReclaim();
+
+    size_t   pendingCount() const;                 // Retired but not yet freed
+    uint64_t epoch() const { return globalEpoch_.load(std::memory_order_acquire); }
+
+    ~EpochReclaimer();
+
+private:
+    EpochReclaimer() = default;
+
+    static constexpr uint64_t kIdle = 0;           // Thread is outside any Guard
+    static constexpr size_t   kReclaimEvery = 64;  // retire() calls between reclaim attempts
+
+    struct ThreadRecord {
+        std::atomic<uint64_t> epoch{kIdle};
+        std::atomic<bool>     inUse{false};
+        int                   nesting{0};
+        ThreadRecord*         next{nullptr};
+    };
+
+    struct Retired {
+        void*    ptr;
+        void   (*deleter)(void*);
+        uint64_t epoch;
+    };
+
+    ThreadRecord* acquireRecord();
+    void          releaseRecord(ThreadRecord* rec);
+    ThreadRecord* localRecord();
+    bool          tryAdvance();
+
+private:
+    std::atomic<uint64_t>      globalEpoch_{1};
+    std::atomic<ThreadRecord*> records_{nullptr};  // Push-only list; records are reused, never freed early
+
+    mutable std::mutex   garbageMtx_;
+    std::vector<Retired> garbage_;
+    size_t               retiresSinceReclaim_{0};
+
+    friend struct EpochThreadHolder;
+};
+
+} // namespace Cache
@@ -0,0 +1,127 @@
+#pragma once
+
+// =========================================================
+//  FlatCombiner: flat-combining helper for write paths
+//  ---------------------------------------------------------
+//  Instead of every writer acquiring the cache mutex in turn,
+//  a writer that finds the mutex busy publishes its request
+//  into a per-thread slot and keeps trying the mutex. Whoever
+//  gets it becomes the combiner: it applies every pending
+//  request under that single lock hold (the lists stay hot
+//  in its cache) and marks them done.
+//  The other writers just wait for their slot to flip to Done.
+//
+//  - Slots are per instance, indexed by a process-wide thread
+//    number; if two threads map to the same slot the loser
+//    simply takes the mutex directly.
+//  - Requests are applied in slot order, not arrival order;
+//    operations that are in flight at the same time have no
+//    defined order anyway.
+//  - Mutex only needs lock / try_lock / unlock. It is always
+//    released through RAII, so a throwing request (bad_alloc,
+//    a throwing Value move) can't leave it locked.
+// =========================================================
+
+#include <atomic>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace Cache {
+
+template<typename Request>
+class FlatCombiner {
+public:
+    static constexpr size_t kSlots = 64;
+
+    FlatCombiner() : slots_(new Slot[kSlots]) {}
+
+    FlatCombiner(const FlatCombiner&) = delete;
+    FlatCombiner& operator=(const FlatCombiner&) = delete;
+
+    // Run apply(request) under mtx, possibly on another thread's behalf.
+    // An exception from apply is rethrown here, on the requesting thread
+    template<typename Mutex, typename Apply>
+    void execute(Mutex& mtx, const Request& request, Apply apply) {
+        if (mtx.try_lock()) {                       // Uncontended: no publication needed
+            std::unique_lock<Mutex> lock(mtx, std::adopt_lock);
+            apply(request);
+            return;
+        }
+
+        Slot& slot = slots_[threadSlot()];
+        uint32_t expected = kFree;
+        if (!slot.state.compare_exchange_strong(expected, kOwned, std::memory_order_acquire,
+                                                std::memory_order_relaxed)) {
+            std::lock_guard<Mutex> lock(mtx);       // Slot taken by another thread
+            apply(request);
+            return;
+        }
+
+        slot.request = request;
+        slot.state.store(kPending, std::memory_order_release);
+
+        for (int spins = 0; slot.state.load(std::memory_order_acquire) != kDone; ++spins) {
+            if (mtx.try_lock()) {
+                std::unique_lock<Mutex> lock(mtx, std::adopt_lock);
+                combine(apply);                     // Serves our own slot too
+                break;
+            }
+            if (spins >= kSpinsBeforeYield) std::this_thread::yield();
+        }
+        std::exception_ptr error = std::move(slot.error);
+        slot.error = nullptr;
+        slot.state.store(kFree, std::memory_order_release);
+        if (error) std::rethrow_exception(error);
+    }
+
+    // Number of combining passes that applied more than one request
+    size_t batchedPasses() const { return batchedPasses_.load(std::memory_order_relaxed); }
+
+private:
+    enum : uint32_t { kFree, kOwned, kPending, kDone };
+    static constexpr int kSpinsBeforeYield = 64;
+    static constexpr int kMaxPasses        = 3;
+
+    struct alignas(64) Slot {
+        std::atomic<uint32_t> state{kFree};
+        Request               request{};
+        std::exception_ptr    error;                // Set by the combiner if apply threw
+    };
+
+    // Caller holds the mutex: drain pending slots until a pass finds none.
+    // A throwing request still completes; its owner rethrows the error
+    template<typename Apply>
+    void combine(Apply& apply) {
+        for (int pass = 0; pass < kMaxPasses; ++pass) {
+            size_t applied = 0;
+            for (size_t i = 0; i < kSlots; ++i) {
+                Slot& s = slots_[i];
+                if (s.state.load(std::memory_order_acquire) != kPending) continue;
+                try {
+                    apply(s.request);
+                } catch (...) {
+                    s.error = std::current_exception();
+                }
+                s.state.store(kDone, std::memory_order_release);
+                ++applied;
+            }
+            if (applied > 1) batchedPasses_.fetch_add(1, std::memory_order_relaxed);
+            if (applied == 0) break;
+        }
+    }
+
+    static size_t threadSlot() {
+        static std::atomic<size_t> nextThread{0};
+        thread_local size_t slot = nextThread.fetch_add(1, std::memory_order_relaxed) % kSlots;
+        return slot;
+    }
+
+private:
+    std::unique_ptr<Slot[]> slots_;
+    std::atomic<size_t>     batchedPasses_{0};
+};
+
+} // namespace Cache
@@ -0,0 +1,130 @@
+#pragma once
+
+// =========================================================
+//  GenerationReclaimer —— O(1) clear, incremental teardown
+//  ---------------------------------------------------------
+//  clear() / purge() swap the cache's containers out under
+//  the lock (O(1)) and, once unlocked, hand the old
+//  containers over as a retired generation:
+//
+//      uint64_t gen = reclaimer_.retire(drain);
+//
+//  A retired generation is unreachable from lookups, so every
+//  key in it is a miss at once. Its entries are destroyed
+//  (and reported to a removal listener) later, in batches of
+//  at most `max` items per step(), off the cache lock:
+//    - by the maintenance task, when one is attached
+//    - otherwise lazily by the cache's own get / put calls
+//  Only one step() runs at a time and the others return at
+//  once, so concurrent callers never queue up behind each
+//  other's teardown work. The drain itself runs with no lock
+//  held: retire() never waits for it.
+//
+//  drain(max) destroys up to max items of its generation and
+//  returns how many it destroyed; 0 means the generation is
+//  gone. drainSome() helps write it for standard containers.
+// =========================================================
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+namespace Cache {
+
+class GenerationReclaimer {
+public:
+    using Drain = std::function<size_t(size_t max)>;
+
+    // Called after the cache lock is released; O(1): mutex_ is only ever
+    // held to push or pop a drain, never while one runs. Returns the new
+    // generation
+    uint64_t retire(Drain drain) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            retired_.push_back(std::move(drain));
+            pending_.store(true, std::memory_order_release);
+        }
+        return generation_.fetch_add(1, std::memory_order_relaxed) + 1;
+    }
+
+    // Destroy up to max retired items; 0 if nothing was pending or
+    // another thread is already reclaiming. The drain runs unlocked, so
+    // its removal listeners may call clear() / purge() again
+    size_t step(size_t max) {
+        if (!pending()) return 0;
+        if (stepping_.exchange(true, std::memory_order_acquire)) return 0;
+        struct Release {
+            std::atomic<bool>& flag;
+            ~Release() { flag.store(false, std::memory_order_release); }
+        } release{stepping_};
+
+        size_t done = 0;
+        while (done < max) {
+            Drain drain;
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                if (retired_.empty()) {
+                    pending_.store(false, std::memory_order_release);
+                    break;
+                }
+                drain = std::move(retired_.front());
+                retired_.pop_front();
+            }
+            size_t n = 0;
+            try {
+                n = drain(max - done);
+            } catch (...) {
+                putBack(std::move(drain));
+                throw;
+            }
+            if (n != 0) putBack(std::move(drain));   // Not gone yet: keep its place at the front
+            done += n;
+        }
+        reclaimed_.fetch_add(done, std::memory_order_relaxed);
+        return done;
+    }
+
+    // Everything retired so far, in steps of max (waits for a concurrent step)
+    void drainAll(size_t max) {
+        while (pending()) {
+            if (step(max) == 0) std::this_thread::yield();
+        }
+    }
+
+    bool     pending() const    { return pending_.load(std::memory_order_acquire); }
+    uint64_t generation() const { return generation_.load(std::memory_order_relaxed); }
+    size_t   reclaimed() const  { return reclaimed_.load(std::memory_order_relaxed); }
+
+private:
+    void putBack(Drain drain) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        retired_.push_front(std::move(drain));
+    }
+
+private:
+    std::mutex          mutex_;               // Guards retired_; held only to push / pop
+    std::deque<Drain>   retired_;             // The running drain is popped off while it runs
+    std::atomic<bool>   stepping_{false};     // One step() at a time; others return 0
+    std::atomic<size_t> reclaimed_{0};
+    std::atomic<bool>   pending_{false};      // retired_ non-empty or a drain is running
+    std::atomic<uint64_t> generation_{0};
+};
+
+// Destroy up to budget elements from the front of a list or (unordered) map;
+// returns how many were destroyed
+template<typename Container>
+size_t drainSome(Container& c, size_t budget) {
+    size_t n = 0;
+    while (n < budget && !c.empty()) {
+        c.erase(c.begin());
+        ++n;
+    }
+    return n;
+}
+
+} // namespace Cache
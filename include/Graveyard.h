@@ -0,0 +1,60 @@
+#pragma once
+
+// =========================================================
+//  Graveyard<T>: destroy objects after a lock is released
+//  ---------------------------------------------------------
+//  Code running under a cache lock moves dying objects
+//  (evicted nodes, overwritten values) in with bury(); they
+//  are destroyed when the Graveyard goes out of scope.
+//  Declare it BEFORE the lock_guard so it outlives the guard:
+//
+//      Graveyard<NodePtr> garbage;
+//      {
+//          std::lock_guard<Lock> lock(mutex_);
+//          garbage.bury(evictLeastRecent());
+//      }                                   // unlock
+//  }                                       // ~NodePtr → ~Value here
+//
+//  A Graveyard lives on the caller's stack, so each thread
+//  frees its own garbage and no synchronisation is needed.
+//  The first kInline objects are stored in place: a put that
+//  evicts one entry never allocates for the list itself.
+// =========================================================
+
+#include <cstddef>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace Cache {
+
+template<typename T, size_t kInline = 2>
+class Graveyard {
+public:
+    Graveyard() = default;
+
+    Graveyard(const Graveyard&) = delete;
+    Graveyard& operator=(const Graveyard&) = delete;
+
+    void bury(T&& obj) {
+        if (inlineCount_ < kInline) inline_[inlineCount_++].emplace(std::move(obj));
+        else overflow_.push_back(std::move(obj));
+    }
+
+    size_t size()  const { return inlineCount_ + overflow_.size(); }
+    bool   empty() const { return inlineCount_ == 0; }
+
+    // Destroy everything now (reuse in a loop; the overflow keeps its capacity)
+    void clear() {
+        for (size_t i = 0; i < inlineCount_; ++i) inline_[i].reset();
+        inlineCount_ = 0;
+        overflow_.clear();
+    }
+
+private:
+    std::optional<T> inline_[kInline];
+    size_t           inlineCount_{0};
+    std::vector<T>   overflow_;
+};
+
+} // namespace Cache
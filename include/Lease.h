@@ -0,0 +1,143 @@
+#pragma once
+
+// =========================================================
+//  Lease.h —— pinned entries that eviction must not touch
+//  ---------------------------------------------------------
+//      auto lease = cache.pin(key);       // empty on a miss or
+//      if (lease) use(lease.value());     // over the pin budget
+//                                         // ~Lease() / release() unpins
+//
+//  While an entry has at least one lease it is taken out of
+//  its policy's eviction order (LRU list, LFU frequency list,
+//  ARC T1/T2), so eviction never sees it and never has to
+//  scan past it. It still counts towards capacity; when every
+//  resident entry is pinned, inserts overshoot instead of
+//  evicting. The last release puts it back as most recently
+//  used.
+//
+//  get / put / compute keep working on a pinned entry.
+//  remove() / clear() / purge() still remove it: the pins die
+//  with the entry and its outstanding leases release nothing
+//  (each pinned entry gets a fresh pin id).
+//
+//  PinTable is the bookkeeping every cache shares: pin id →
+//  {lease count, charged weight}, plus a cap on pinned bytes.
+//  An entry is weighed once, on its first pin (default:
+//  sizeof(Key) + sizeof(Value)). Not thread-safe: the owning
+//  cache calls it under its own lock.
+// =========================================================
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <unordered_map>
+#include <utility>
+
+namespace Cache {
+
+template<typename Key, typename Value>
+class PinTable {
+public:
+    using Weigher = std::function<size_t(const Key& key, const Value& value)>;
+
+    void setLimit(size_t maxBytes, Weigher weigher) {
+        limit_   = maxBytes;
+        weigher_ = std::move(weigher);
+    }
+
+    // First pin of an entry: charge its weight. Returns its pin id, 0 if over budget
+    uint64_t acquire(const Key& key, const Value& value) {
+        const size_t weight = weigher_ ? weigher_(key, value) : sizeof(Key) + sizeof(Value);
+        if (bytes_ > limit_ || weight > limit_ - bytes_) return 0;
+        bytes_ += weight;
+        pins_.emplace(nextId_, Pin{1, weight});
+        return nextId_++;
+    }
+
+    void addRef(uint64_t id) { ++pins_[id].count; }
+
+    // true when that was the entry's last lease (the caller relinks it)
+    bool release(uint64_t id) {
+        auto it = pins_.find(id);
+        if (it == pins_.end() || --it->second.count > 0) return false;
+        bytes_ -= it->second.weight;
+        pins_.erase(it);
+        return true;
+    }
+
+    // The entry left the cache while pinned: refund it, whatever its count
+    void drop(uint64_t id) {
+        auto it = pins_.find(id);
+        if (it == pins_.end()) return;
+        bytes_ -= it->second.weight;
+        pins_.erase(it);
+    }
+
+    void clear() {
+        pins_.clear();
+        bytes_ = 0;
+    }
+
+    size_t bytes() const   { return bytes_; }
+    size_t entries() const { return pins_.size(); }
+
+private:
+    struct Pin {
+        unsigned count{0};
+        size_t   weight{0};
+    };
+
+    size_t   limit_{std::numeric_limits<size_t>::max()};
+    size_t   bytes_{0};
+    uint64_t nextId_{1};                               // 0 means "not pinned"
+    Weigher  weigher_;
+    std::unordered_map<uint64_t, Pin> pins_;
+};
+
+// RAII pin on one entry. Holds a copy of the value taken when it was
+// pinned; move-only. Owner provides unpin(key, pinId).
+template<typename Owner, typename Key, typename Value>
+class Lease {
+public:
+    Lease() = default;
+    ~Lease() { release(); }
+
+    Lease(Lease&& other) noexcept
+        : owner_(std::exchange(other.owner_, nullptr)), key_(std::move(other.key_)),
+          value_(std::move(other.value_)), pinId_(other.pinId_) {}
+
+    Lease& operator=(Lease&& other) noexcept {
+        if (this != &other) {
+            release();
+            owner_ = std::exchange(other.owner_, nullptr);
+            key_   = std::move(other.key_);
+            value_ = std::move(other.value_);
+            pinId_ = other.pinId_;
+        }
+        return *this;
+    }
+
+    Lease(const Lease&) = delete;
+    Lease& operator=(const Lease&) = delete;
+
+    explicit operator bool() const { return owner_ != nullptr; }
+    const Key&   key() const   { return key_; }
+    const Value& value() const { return value_; }
+
+    void release() {
+        if (owner_) std::exchange(owner_, nullptr)->unpin(key_, pinId_);
+    }
+
+private:
+    friend Owner;
+    Lease(Owner* owner, const Key& key, Value value, uint64_t pinId)
+        : owner_(owner), key_(key), value_(std::move(value)), pinId_(pinId) {}
+
+    Owner*   owner_{nullptr};
+    Key      key_{};
+    Value    value_{};
+    uint64_t pinId_{0};
+};
+
+} // namespace Cache
@@ -7,6 +7,14 @@
 #include <list>
 #include <vector>
 #include "CachePolicy.h"
+#include "ComputeOps.h"
+#include "GenerationReclaimer.h"
+#include "Graveyard.h"
+#include "Lease.h"
+#include "LockPolicy.h"
+#include "MaintenanceExecutor.h"
+#include "RemovalListener.h"
+#include "TagIndex.h"
 
 namespace Cache {
 
@@ -22,6 +30,8 @@ public:
         int freq;
         Key key;
         Value value;
+        uint64_t pinId{0};  // Non-zero while leased: out of every FreqList, never evicted
+        TagLinks tags;      // Tags this entry carries (see TagIndex.h)
 
         std::weak_ptr<Node> prev_;
         std::shared_ptr<Node> next_;
@@ -94,13 +104,20 @@ private:
 /* LFU Cache class definition (with Aging)
  * Trigger condition: curAverageNum_ > maxAverageNum_
  * Aging policy: for all nodes, freq = max(1, freq / 2)
+ * Lock: thread-safety policy (see LockPolicy.h)
+ * Maintenance (optional): eviction down to a low watermark and
+ * aging run on a MaintenanceExecutor instead of inside put/get
  */
 // =========================================================
 
-template<typename Key, typename Value>
-class LfuCache : public CachePolicy<Key, Value> {
+template<typename Key, typename Value, typename Lock = std::mutex>
+class LfuCache : public CachePolicy<Key, Value>,
+                 public ComputeOps<LfuCache<Key, Value, Lock>, Key, Value> {
 public:
     using NodePtr = typename FreqList<Key, Value>::NodePtr;
+    using PinLease = Lease<LfuCache, Key, Value>;
+    using Weigher = typename PinTable<Key, Value>::Weigher;
+    using Tag = CacheTag;
 
     // capacity: cache size; maxAvg: average-frequency threshold that triggers Aging
     LfuCache(int capacity, int maxAvg = 1000000)
@@ -113,29 +130,123 @@ public:
     void put(const Key& key, const Value& value) override;
     bool get(const Key& key, Value& value) override;
 
+    // put that also replaces the entry's tags (a plain put keeps them);
+    // invalidateTag removes every entry carrying tag in one lock hold
+    // (Explicit) and returns how many there were
+    void put(const Key& key, const Value& value, const std::vector<Tag>& tags);
+    size_t invalidateTag(const Tag& tag);
+
+    size_t tagSize(const Tag& tag) const {
+        ReadGuard<Lock> lock(mutex_);
+        return tags_.members(tag);
+    }
+
     // Convenience version for users (returns Value() on miss)
     Value get(const Key& key) override {
         Value v{};
         return get(key, v) ? v : Value{};
     }
 
+    // Read-modify-write in place under one lock hold (see ComputeOps.h);
+    // a kept entry counts as one access, like get
+    template<typename F>
+    bool compute(const Key& key, F&& fn);
+
+    // Pinned entries are skipped by eviction and aging until their last
+    // lease is released (see Lease.h); their frequency keeps counting
+    PinLease pin(const Key& key);
+
+    void setPinLimit(size_t maxPinnedBytes, Weigher weigher = nullptr) {
+        std::lock_guard<Lock> lock(mutex_);
+        pins_.setLimit(maxPinnedBytes, std::move(weigher));
+    }
+
+    size_t pinnedBytes() const {
+        ReadGuard<Lock> lock(mutex_);
+        return pins_.bytes();
+    }
+
+    // O(1) whatever the size: the old contents are swapped out under the
+    // lock as a retired generation, which later get / put calls (or the
+    // maintenance task) tear down in batches off the lock; a listener
+    // hears about each entry (Explicit) as it goes
     void purge() {
-        std::lock_guard<std::mutex> lock(mutex_);
-        nodeMap_.clear();
-        freqMap_.clear();
-        minFreq_ = 1;
-        curAverageNum_ = 0;
-        curTotalNum_ = 0;
+        auto old = std::make_shared<Retired>();
+        {
+            std::lock_guard<Lock> lock(mutex_);
+            nodeMap_.swap(old->nodes);
+            freqMap_.swap(old->lists);
+            tags_.swap(old->tags);
+            pins_.clear();
+            minFreq_ = 1;
+            curAverageNum_ = 0;
+            curTotalNum_ = 0;
+        }
+        reclaimer_.retire([this, old](size_t max) { return reclaimSome(*old, max); });
+        if (maintenance_.enabled()) maintenance_.request();
+    }
+
+    uint64_t generation() const { return reclaimer_.generation(); }   // purge() calls so far
+    bool reclaimPending() const { return reclaimer_.pending(); }      // A purged generation is still alive
+    void reclaimNow() { reclaimer_.drainAll(kReclaimBatch); }  // Tear purged generations down here and now
+
+    // Background eviction + aging: put only inserts while size < highWatermark
+    void enableMaintenance(std::shared_ptr<MaintenanceExecutor> executor,
+                           size_t lowWatermark, size_t highWatermark) {
+        maintenance_.attach(std::move(executor), static_cast<size_t>(capacity_),
+                            lowWatermark, highWatermark, [this] { runMaintenance(); });
+    }
+
+    // Evictions (Size), overwrites (Replaced) and purge() (Explicit) are
+    // reported in batches after the unlock, or on executor if given
+    void setRemovalListener(RemovalListener<Key, Value> listener,
+                            std::shared_ptr<MaintenanceExecutor> executor = nullptr) {
+        removal_.set(std::move(listener), std::move(executor));
+    }
+
+    size_t size() const {
+        ReadGuard<Lock> lock(mutex_);
+        return nodeMap_.size();
     }
 
 private:
+    friend PinLease;
+    static constexpr size_t kMaintenanceBatch = 64;  // Nodes evicted / re-bucketed per lock hold
+    static constexpr size_t kReclaimBatch = 128;     // Purged nodes torn down per get / put
+
+    using Node = typename FreqList<Key, Value>::Node;
+    struct NodeTags { TagLinks& operator()(Node* n) const { return n->tags; } };
+
+    // Everything purge() swapped out: one retired generation
+    struct Retired {
+        std::unordered_map<Key, NodePtr> nodes;
+        std::unordered_map<int, std::unique_ptr<FreqList<Key, Value>>> lists;
+        TagIndex<Node*, NodeTags> tags;
+    };
+
+    // What one operation takes out of the cache; handled after the unlock
+    struct Removed {
+        Graveyard<NodePtr>       nodes;
+        RemovalBatch<Key, Value> notes;  // Empty unless a listener is set
+    };
+
+    void putLocked(const Key& key, Value& fresh, Removed& removed,  // put body, mutex_ held;
+                   const std::vector<Tag>* tags = nullptr);        // tags: replaces the entry's tags
     void increaseFrequency(NodePtr node);
-    void evict();
+    NodePtr evict();  // Returns the victim (nullptr if none)
+    void unlink(NodePtr node);  // Take any node out of its list and the index
+    void detachFromList(NodePtr node);  // Out of its FreqList and the frequency totals
+    void unpin(const Key& key, uint64_t pinId);  // Lease release: relink after the last one
+    void retire(NodePtr node, RemovalCause cause, Removed& removed);
     void updateMinFreq(); // Optional: not explicitly used in the current implementation, kept for extensibility
 
     // Aging-related
     void maybeAge();  // Determine whether to trigger aging
     void ageAll();    // Perform a full aging pass
+    void runMaintenance();                     // Executor task
+    size_t reclaimSome(Retired& old, size_t max);  // Drain step for a purged generation
+    void ageIncrementally();                   // ageAll in lock-sized pieces
+    bool ageBucketBatch(int freq, size_t max); // true once bucket freq is drained
 
 private:
     int capacity_;
@@ -144,9 +255,16 @@ private:
     int curAverageNum_;
     int curTotalNum_;
 
-    std::mutex mutex_;
+    bool agingDue_{false};  // Aging requested from the executor, not yet finished
+
+    mutable Lock mutex_;
     std::unordered_map<Key, NodePtr> nodeMap_;
     std::unordered_map<int, std::unique_ptr<FreqList<Key, Value>>> freqMap_;
+    PinTable<Key, Value> pins_;  // Leased entries + pinned-bytes budget
+    TagIndex<Node*, NodeTags> tags_;  // tag → tagged nodes
+    RemovalDispatcher<Key, Value> removal_;  // Outlives maintenance_, whose task reports through it
+    GenerationReclaimer reclaimer_;  // Purged generations; also used by the task
+    MaintenanceHandle maintenance_;  // Last member: unregisters first
 };
 
 } // namespace Cache
@@ -0,0 +1,176 @@
+#pragma once
+
+// =========================================================
+//  LockPolicy.h —— compile-time thread-safety policies
+//  ---------------------------------------------------------
+//  The policies (LruCache, LfuCache, ArcCache, Arc_new,
+//  HashLruCaches) take the lock type as a template argument:
+//    NullLock          —— no-op; single-threaded / per-thread
+//                         instances compile to lock-free code
+//    std::mutex        —— default (previous behaviour)
+//    SpinLock          —— test-and-test-and-set with backoff
+//    AdaptiveLock      —— bounded backoff spinning, then park
+//    std::shared_mutex —— const methods (size/contains) take
+//                         a shared lock via ReadGuard
+//
+//  Any type with lock/try_lock/unlock works. Mutating ops use
+//  std::lock_guard<Lock>; read-only ops use ReadGuard<Lock>,
+//  which calls lock_shared when the type has it.
+//
+//  CacheLinePadded<T> gives an object its own cache line(s),
+//  e.g. the slices of HashLruCaches.
+// =========================================================
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+namespace Cache {
+
+// Spin-wait hint for the CPU (no-op where unsupported)
+inline void cpuRelax() noexcept {
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__)
+    asm volatile("yield");
+#endif
+}
+
+// ---- NullLock: every operation is a no-op ----
+struct NullLock {
+    void lock() noexcept {}
+    bool try_lock() noexcept { return true; }
+    void unlock() noexcept {}
+};
+
+// ---- SpinLock: TTAS with exponential backoff, then yield ----
+class SpinLock {
+public:
+    void lock() noexcept {
+        int backoff = 1;
+        for (;;) {
+            if (!locked_.exchange(true, std::memory_order_acquire)) return;
+            while (locked_.load(std::memory_order_relaxed)) {
+                if (backoff <= kMaxBackoff) {
+                    for (int i = 0; i < backoff; ++i) cpuRelax();
+                    backoff <<= 1;
+                } else {
+                    std::this_thread::yield();          // Holder may be descheduled
+                }
+            }
+        }
+    }
+
+    bool try_lock() noexcept {
+        return !locked_.load(std::memory_order_relaxed) &&
+               !locked_.exchange(true, std::memory_order_acquire);
+    }
+
+    void unlock() noexcept { locked_.store(false, std::memory_order_release); }
+
+private:
+    static constexpr int kMaxBackoff = 64;
+
+    std::atomic<bool> locked_{false};
+};
+
+// ---- AdaptiveLock: spin briefly (sections are ~50 ns), then sleep ----
+// State: 0 free, 1 held, 2 held with (possible) sleepers. Only the
+// 2 → 0 unlock pays for a wake-up; the uncontended path is one CAS.
+// Padded to a cache line so neighbouring data never shares it.
+class alignas(64) AdaptiveLock {
+public:
+    void lock() {
+        uint32_t expected = 0;
+        if (state_.compare_exchange_strong(expected, 1, std::memory_order_acquire,
+                                           std::memory_order_relaxed))
+            return;
+        if (spinAcquire()) return;
+        park();
+    }
+
+    bool try_lock() noexcept {
+        uint32_t expected = 0;
+        return state_.compare_exchange_strong(expected, 1, std::memory_order_acquire,
+                                              std::memory_order_relaxed);
+    }
+
+    void unlock() {
+        if (state_.exchange(0, std::memory_order_release) == 2) {
+            std::lock_guard<std::mutex> lk(parkMutex_);  // Waiter is inside wait() or will re-check
+            parkCv_.notify_one();
+        }
+    }
+
+private:
+    static constexpr int kSpinRounds = 10;             // Backoff 1, 2, 4 ... 64 pauses per round
+
+    bool spinAcquire() noexcept {
+        int backoff = 1;
+        for (int round = 0; round < kSpinRounds; ++round) {
+            for (int i = 0; i < backoff; ++i) cpuRelax();
+            if (backoff < 64) backoff <<= 1;
+            uint32_t expected = 0;
+            if (state_.load(std::memory_order_relaxed) == 0 &&
+                state_.compare_exchange_weak(expected, 1, std::memory_order_acquire,
+                                             std::memory_order_relaxed))
+                return true;
+        }
+        return false;
+    }
+
+    // Acquire in state 2: we can't know whether other sleepers remain.
+    // The timed wait is only a safety net; unlock() always notifies.
+    void park() {
+        std::unique_lock<std::mutex> lk(parkMutex_);
+        while (state_.exchange(2, std::memory_order_acquire) != 0)
+            parkCv_.wait_for(lk, std::chrono::milliseconds(1));
+    }
+
+    std::atomic<uint32_t>   state_{0};
+    std::mutex              parkMutex_;
+    std::condition_variable parkCv_;
+};
+
+// ---- CacheLinePadded: T on its own cache line(s) ----
+template<typename T>
+struct alignas(64) CacheLinePadded {
+    T value;
+
+    template<typename... Args>
+    explicit CacheLinePadded(Args&&... args) : value(std::forward<Args>(args)...) {}
+};
+
+// ---- ReadGuard: shared lock when available, exclusive otherwise ----
+template<typename Lock, typename = void>
+struct HasSharedLock : std::false_type {};
+
+template<typename Lock>
+struct HasSharedLock<Lock, std::void_t<decltype(std::declval<Lock&>().lock_shared())>> : std::true_type {};
+
+template<typename Lock>
+class ReadGuard {
+public:
+    explicit ReadGuard(Lock& lock) : lock_(lock) {
+        if constexpr (HasSharedLock<Lock>::value) lock_.lock_shared();
+        else lock_.lock();
+    }
+    ~ReadGuard() {
+        if constexpr (HasSharedLock<Lock>::value) lock_.unlock_shared();
+        else lock_.unlock();
+    }
+
+    ReadGuard(const ReadGuard&) = delete;
+    ReadGuard& operator=(const ReadGuard&) = delete;
+
+private:
+    Lock& lock_;
+};
+
+} // namespace Cache
@@ -15,6 +15,16 @@
 #include <cmath>           // std::ceil used in hash sharding
 
 #include "CachePolicy.h"   // Common cache policy interface (defines put / get)
+#include "CacheIndex.h"    // key → node index (std::unordered_map / concurrent / cuckoo)
+#include "ComputeOps.h"    // compute / computeIfAbsent / computeIfPresent / merge
+#include "FlatCombiner.h"  // Optional flat-combining write path
+#include "Graveyard.h"     // Evicted / overwritten values die after the unlock
+#include "Lease.h"         // Pinned entries skipped by eviction
+#include "LockPolicy.h"    // NullLock / SpinLock / std::mutex / std::shared_mutex
+#include "Priority.h"      // Per-priority recency sub-lists
+#include "MaintenanceExecutor.h"  // Optional background eviction
+#include "RemovalListener.h"      // Optional eviction / removal notifications
+#include "TagIndex.h"             // tag → entries, for invalidateTag
 
 namespace Cache {
 
@@ -22,7 +32,7 @@ namespace Cache {
 // 1. Forward declaration: let LruNode and LruCache be friends
 // =========================================================
 
-template<typename Key, typename Value>
+template<typename Key, typename Value, template<typename, typename> class Index, typename Lock>
 class LruCache;
 
 // =========================================================
@@ -35,6 +45,9 @@ private:
     Key   key_;              // Cache key
     Value value_;            // Cache value
     size_t accessCount_{};   // Access counter, available for extensions
+    uint64_t pinId_{0};      // Non-zero while leased: unlinked from the list, never evicted
+    TagLinks tags_;          // Tags this entry carries (see TagIndex.h); empty when untagged
+    Priority priority_{Priority::Normal};   // Which sub-list it lives on
 
     // **Pointer notes**
     // next_ : shared_ptr  → owns the successor node
@@ -46,6 +59,8 @@ public:
     // ----- Constructors -----
     LruNode(const Key& key, const Value& value)
         : key_(key), value_(value), accessCount_(1) {}
+    LruNode(const Key& key, Value&& value)
+        : key_(key), value_(std::move(value)), accessCount_(1) {}
 
     // ----- Basic getters / setters -----
     const Key&   getKey()   const { return key_; }
@@ -55,22 +70,31 @@ public:
     size_t getAccessCount() const { return accessCount_; }
     void   incrementAccessCount() { ++accessCount_; }
 
-    // Allow LruCache to access private members
-    friend class LruCache<Key, Value>;
+    // Allow LruCache (with any index) to access private members
+    template<typename K, typename V, template<typename, typename> class I, typename L>
+    friend class LruCache;
 };
 
 // =========================================================
 // 3. LruCache: standard least-recently-used cache (declaration)
+//    Index: key → node lookup structure (see CacheIndex.h)
+//    Lock : thread-safety policy (see LockPolicy.h)
 // =========================================================
 
-template<typename Key, typename Value>
-class LruCache : public CachePolicy<Key, Value> {
+template<typename Key, typename Value, template<typename, typename> class Index = StdHashIndex,
+         typename Lock = std::mutex>
+class LruCache : public CachePolicy<Key, Value>,
+                 public ComputeOps<LruCache<Key, Value, Index, Lock>, Key, Value> {
 public:
     using Node      = LruNode<Key, Value>;
     using NodePtr   = std::shared_ptr<Node>;
-    using NodeMap   = std::unordered_map<Key, NodePtr>;
+    using NodeMap   = Index<Key, NodePtr>;
+    using PinLease  = Lease<LruCache, Key, Value>;
+    using Weigher   = typename PinTable<Key, Value>::Weigher;
+    using Tag       = CacheTag;
 
-    explicit LruCache(int capacity);
+    // flatCombining: concurrent puts are batched by one combiner thread (see FlatCombiner.h)
+    explicit LruCache(int capacity, bool flatCombining = false);
     ~LruCache() override = default;
 
     // ---- Interface functions (must be implemented, see .cpp) ----
@@ -79,22 +103,95 @@ public:
     Value  get(const Key& key) override;                       // Read (convenience version)
     void   remove(const Key& key);                             // Erase a key
 
+    // put that also replaces the entry's tags (a plain put keeps them);
+    // invalidateTag removes every entry carrying tag in one lock hold
+    // (Explicit) and returns how many there were
+    void   put(const Key& key, const Value& value, const std::vector<Tag>& tags);
+    size_t invalidateTag(const Tag& tag);
+    size_t tagSize(const Tag& tag) const;                      // Entries currently carrying tag
+
+    // put into a priority tier (a plain put inserts at Normal and keeps an
+    // existing entry's tier); eviction drains lower tiers first (see Priority.h)
+    void   put(const Key& key, const Value& value, Priority priority);
+    PriorityStats priorityStats() const;
+
+    // Read-modify-write in place under one lock hold (see ComputeOps.h);
+    // bypasses the combiner, whose batches take the same mutex_
+    template<typename F>
+    bool   compute(const Key& key, F&& fn);
+
+    // Pinned entries are skipped by eviction until their last lease is
+    // released (see Lease.h); empty lease on a miss or over the pin budget
+    PinLease pin(const Key& key);
+    void   setPinLimit(size_t maxPinnedBytes, Weigher weigher = nullptr);
+    size_t pinnedBytes() const;
+    size_t pinnedEntries() const;
+
+    size_t combinedPasses() const;                             // Combiner passes that batched >1 put
+
+    // Background eviction: put only inserts while size < highWatermark;
+    // the executor evicts down to lowWatermark off the request path
+    void   enableMaintenance(std::shared_ptr<MaintenanceExecutor> executor,
+                             size_t lowWatermark, size_t highWatermark);
+
+    // Evictions (Size), overwrites (Replaced) and remove() (Explicit) are
+    // reported in batches after the unlock, or on executor if given
+    void   setRemovalListener(RemovalListener<Key, Value> listener,
+                              std::shared_ptr<MaintenanceExecutor> executor = nullptr);
+
 private:
+    friend PinLease;
+    static constexpr size_t kMaintenanceBatch = 64;            // Evictions per lock hold in the task
+
+    // What one operation takes out of the cache: nodes are destroyed and
+    // notifications delivered after the unlock, when the caller's frame unwinds
+    struct Removed {
+        Graveyard<NodePtr>       nodes;
+        RemovalBatch<Key, Value> notes;                        // Empty unless a listener is set
+    };
+
+    // What a put sets besides the value; null: leave as is
+    struct PutOptions {
+        const std::vector<Tag>* tags = nullptr;
+        const Priority*         priority = nullptr;
+    };
+    // Points into the waiting caller's frame: the value is moved/swapped in, and
+    // the caller's Removed receives the victim
+    struct PutRequest { const Key* key; Value* value; Removed* removed; PutOptions opts; };
+
+    struct NodeTags { TagLinks& operator()(Node* n) const { return n->tags_; } };
+
     // ---- Internal helpers ----
+    void putLocked(const Key& key, Value& value,               // put body, mutex_ held
+                   Removed& removed, const PutOptions& opts = {});
+    void putWith(const Key& key, const Value& value,           // put with options, any mode
+                 const PutOptions& opts);
     void initializeList();                                     // Create dummyHead / dummyTail
-    void updateExistingNode(NodePtr node, const Value& value); // Update on hit
-    void addNewNode(const Key& key, const Value& value);       // Add when not present
+    void updateExistingNode(NodePtr node, Value& value,        // Update on hit: swaps, old value → value
+                            Removed& removed);
+    NodePtr addNewNode(const Key& key, Value&& value,          // Add when not present
+                       Removed& removed, Priority priority = Priority::Normal);
+    void retire(NodePtr node, RemovalCause cause,              // Unlinked node → removed (+ notification)
+                Removed& removed);
     void moveToMostRecent(NodePtr node);                       // Move to list tail
     void removeNode(NodePtr node);                             // Remove from list
-    void insertNode(NodePtr node);                             // Insert at list tail
-    void evictLeastRecent();                                   // Evict when over capacity
+    void insertNode(NodePtr node);                             // Insert at its tier's list tail
+    NodePtr evictLeastRecent();                                // LRU of the lowest tier; returns the victim
+    void runMaintenance();                                     // Executor task
+    void unpin(const Key& key, uint64_t pinId);                // Lease release: relink after the last one
 
 private:
     int       capacity_{};   // Cache capacity
     NodeMap   nodeMap_;      // key → NodePtr
-    std::mutex mutex_;       // Global lock (simple thread-safety approach)
-    NodePtr   dummyHead_;    // Sentinel head node
-    NodePtr   dummyTail_;    // Sentinel tail node
+    mutable Lock mutex_;     // Global lock (NullLock when the cache is not shared)
+    NodePtr   dummyHead_[kPriorities];   // Sentinel head node per priority tier
+    NodePtr   dummyTail_[kPriorities];   // Sentinel tail node per priority tier
+    PriorityStats prioStats_;            // Per-tier hits / inserts / evictions / entries
+    PinTable<Key, Value> pins_;                          // Leased entries + pinned-bytes budget
+    TagIndex<Node*, NodeTags> tags_;                     // tag → tagged nodes
+    std::unique_ptr<FlatCombiner<PutRequest>> combiner_;  // null unless flatCombining
+    RemovalDispatcher<Key, Value> removal_;              // Outlives maintenance_, whose task reports through it
+    MaintenanceHandle maintenance_;                      // Last member: unregisters first
 };
 
 // =========================================================
@@ -123,14 +220,47 @@ private:
 // 5. HashLruCaches: sharded LRU to improve concurrency (declaration)
 // =========================================================
 
-template<typename Key, typename Value>
-class HashLruCaches {
+template<typename Key, typename Value, template<typename, typename> class Index = StdHashIndex,
+         typename Lock = std::mutex>
+class HashLruCaches : public ComputeOps<HashLruCaches<Key, Value, Index, Lock>, Key, Value> {
 public:
-    HashLruCaches(size_t capacity, int sliceNum = 0);          // sliceNum=0 → default to CPU core count
+    HashLruCaches(size_t capacity, int sliceNum = 0,           // sliceNum=0 → default to CPU core count
+                  bool flatCombining = false);
 
     void  put(const Key& key, const Value& value);
     bool  get(const Key& key, Value& value);
     Value get(const Key& key);
+    void  remove(const Key& key);
+
+    // Tagged put goes to the key's slice; invalidateTag visits every
+    // slice, one lock hold each
+    using Tag = CacheTag;
+    void   put(const Key& key, const Value& value, const std::vector<Tag>& tags);
+    size_t invalidateTag(const Tag& tag);
+    size_t tagSize(const Tag& tag) const;
+
+    // Each slice evicts its own lower tiers first; stats are summed
+    void   put(const Key& key, const Value& value, Priority priority);
+    PriorityStats priorityStats() const;
+
+    // Runs on the key's slice (see ComputeOps.h)
+    template<typename F>
+    bool  compute(const Key& key, F&& fn);
+
+    // Pins on the key's slice; the byte budget is split evenly across slices
+    using PinLease = typename LruCache<Key, Value, Index, Lock>::PinLease;
+    PinLease pin(const Key& key);
+    void   setPinLimit(size_t maxPinnedBytes,
+                       typename PinTable<Key, Value>::Weigher weigher = nullptr);
+    size_t pinnedBytes() const;
+
+    // Watermarks are split evenly across the slices
+    void  enableMaintenance(std::shared_ptr<MaintenanceExecutor> executor,
+                            size_t lowWatermark, size_t highWatermark);
+
+    // Every slice reports to the same listener, possibly concurrently
+    void  setRemovalListener(RemovalListener<Key, Value> listener,
+                             std::shared_ptr<MaintenanceExecutor> executor = nullptr);
 
 private:
     size_t calcSliceIndex(const Key& key) const;                // Compute which shard a key belongs to
@@ -138,7 +268,8 @@ private:
 private:
     size_t capacity_;       // Total capacity
     int    sliceNum_;       // Number of shards
-    std::vector<std::unique_ptr<LruCache<Key, Value>>> lruSlices_; // Multiple sub-caches
+    using Slice = CacheLinePadded<LruCache<Key, Value, Index, Lock>>;  // No two slices share a cache line
+    std::vector<std::unique_ptr<Slice>> lruSlices_; // Multiple sub-caches
 };
 
 } // namespace Cache
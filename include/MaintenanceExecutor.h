@@ -0,0 +1,126 @@
+#pragma once
+
+// =========================================================
+//  MaintenanceExecutor: background thread for cache upkeep
+//  ---------------------------------------------------------
+//  Caches register a maintenance task (evict down to the low
+//  watermark, age frequencies, destroy evicted values...) and
+//  schedule() it from the request path when there is work.
+//
+//  - schedule() coalesces: a task that is already pending is
+//    not queued twice; one run does all outstanding work.
+//  - remove() blocks until the task is no longer running, so
+//    a cache can unregister in its destructor and be sure the
+//    task never touches it again.
+//  - One executor can serve many caches (share it through a
+//    std::shared_ptr); tasks run one at a time, in order.
+//
+//  MaintenanceHandle is the cache-side half: task id, low/high
+//  watermarks and an "already scheduled" flag so only the first
+//  put over capacity pays for schedule().
+// =========================================================
+
+#include <condition_variable>
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <unordered_map>
+
+namespace Cache {
+
+class MaintenanceExecutor {
+public:
+    using TaskId = uint64_t;
+    using Task   = std::function<void()>;
+
+    MaintenanceExecutor();
+    ~MaintenanceExecutor();
+
+    MaintenanceExecutor(const MaintenanceExecutor&) = delete;
+    MaintenanceExecutor& operator=(const MaintenanceExecutor&) = delete;
+
+    TaskId add(Task task);
+    void   remove(TaskId id);         // Waits out a running invocation
+    void   schedule(TaskId id);       // No-op if already pending or unknown
+    void   drain();                   // Wait until nothing is pending or running
+
+    size_t runs() const;              // Task invocations so far
+
+private:
+    struct Entry {
+        Task task;
+        bool pending{false};
+    };
+
+    void loop();
+
+private:
+    mutable std::mutex                 mutex_;
+    std::condition_variable            workCv_;   // Executor waits for work
+    std::condition_variable            idleCv_;   // remove()/drain() wait for the executor
+    std::unordered_map<TaskId, Entry>  tasks_;
+    std::deque<TaskId>                 queue_;
+    TaskId                             nextId_{1};
+    TaskId                             running_{0};
+    size_t                             runs_{0};
+    bool                               stop_{false};
+    std::thread                        thread_;   // Started last
+};
+
+// ---- MaintenanceHandle: one cache's registration ----
+// Declare it as the cache's LAST member: it is destroyed first, and
+// its destructor waits out a running task before the cache's other
+// members go away.
+class MaintenanceHandle {
+public:
+    MaintenanceHandle() = default;
+    ~MaintenanceHandle() { reset(); }
+
+    MaintenanceHandle(const MaintenanceHandle&) = delete;
+    MaintenanceHandle& operator=(const MaintenanceHandle&) = delete;
+
+    // low ≤ capacity ≤ high; call before the cache is shared
+    void attach(std::shared_ptr<MaintenanceExecutor> executor, size_t capacity,
+                size_t lowWatermark, size_t highWatermark, MaintenanceExecutor::Task task) {
+        if (!executor || lowWatermark > capacity || highWatermark < capacity)
+            throw std::invalid_argument("maintenance watermarks must satisfy low <= capacity <= high");
+        reset();
+        low_      = lowWatermark;
+        high_     = highWatermark;
+        executor_ = std::move(executor);
+        id_       = executor_->add(std::move(task));
+    }
+
+    void reset() {
+        if (!executor_) return;
+        executor_->remove(id_);
+        executor_.reset();
+    }
+
+    bool   enabled() const { return executor_ != nullptr; }
+    size_t low()     const { return low_; }
+    size_t high()    const { return high_; }
+
+    // Request path: schedule once until the task starts running
+    void request() {
+        if (!scheduled_.exchange(true, std::memory_order_acq_rel))
+            executor_->schedule(id_);
+    }
+
+    // Task side: called first, so work arriving during the run re-schedules
+    void beginRun() { scheduled_.store(false, std::memory_order_release); }
+
+private:
+    std::shared_ptr<MaintenanceExecutor> executor_;
+    MaintenanceExecutor::TaskId          id_{0};
+    size_t                               low_{0};
+    size_t                               high_{0};
+    std::atomic<bool>                    scheduled_{false};
+};
+
+} // namespace Cache
@@ -0,0 +1,94 @@
+#pragma once
+
+// =========================================================
+//  MpscQueue: bounded lock-free multi-producer / single-
+//  consumer ring buffer (Vyukov's sequence-numbered cells)
+//  ---------------------------------------------------------
+//  - Producers claim a cell with one CAS on the tail, write
+//    the item, then publish it by bumping the cell sequence.
+//  - The single consumer reads cells in order without any
+//    read-modify-write; a cell that is claimed but not yet
+//    published simply ends the current drain.
+//  - Items from one producer come out in the order it pushed
+//    them.
+// =========================================================
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+namespace Cache {
+
+template<typename T>
+class MpscQueue {
+public:
+    explicit MpscQueue(size_t capacity)
+        : mask_(roundUpPow2(capacity < 2 ? 2 : capacity) - 1), cells_(new Cell[mask_ + 1])
+    {
+        for (size_t i = 0; i <= mask_; ++i)
+            cells_[i].seq.store(i, std::memory_order_relaxed);
+    }
+
+    MpscQueue(const MpscQueue&) = delete;
+    MpscQueue& operator=(const MpscQueue&) = delete;
+
+    // Returns false when the ring is full
+    bool tryPush(T&& item) {
+        size_t pos = tail_.load(std::memory_order_relaxed);
+        for (;;) {
+            Cell& cell = cells_[pos & mask_];
+            size_t seq = cell.seq.load(std::memory_order_acquire);
+            intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+            if (diff == 0) {
+                if (tail_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    cell.item = std::move(item);
+                    cell.seq.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false;                                   // Consumer hasn't freed this cell yet
+            } else {
+                pos = tail_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    // Consumer only
+    bool tryPop(T& out) {
+        Cell& cell = cells_[head_ & mask_];
+        if (cell.seq.load(std::memory_order_acquire) != head_ + 1) return false;
+        out = std::move(cell.item);
+        cell.seq.store(head_ + mask_ + 1, std::memory_order_release);
+        ++head_;
+        return true;
+    }
+
+    // Consumer only: nothing published at the head (a push may be in flight)
+    bool empty() const {
+        return cells_[head_ & mask_].seq.load(std::memory_order_acquire) != head_ + 1;
+    }
+
+    size_t capacity() const { return mask_ + 1; }
+
+private:
+    struct alignas(64) Cell {
+        std::atomic<size_t> seq{0};
+        T                   item{};
+    };
+
+    static size_t roundUpPow2(size_t n) {
+        size_t p = 1;
+        while (p < n) p <<= 1;
+        return p;
+    }
+
+private:
+    const size_t            mask_;
+    std::unique_ptr<Cell[]> cells_;
+    alignas(64) std::atomic<size_t> tail_{0};                   // Producers
+    alignas(64) size_t              head_{0};                   // Consumer
+};
+
+} // namespace Cache
@@ -0,0 +1,152 @@
+#pragma once
+
+// =========================================================
+//  NamespacedCache: one shared LRU for many tenants
+//  ---------------------------------------------------------
+//  Instead of a fixed-size cache per tenant (idle tenants sit
+//  on memory that busy ones could use), every entry belongs
+//  to a namespace and all namespaces share one capacity:
+//
+//      auto ns = cache.open("tenant-17", /*min*/ 50, /*max*/ 5000);
+//      cache.put(ns, key, value);
+//      cache.get(ns, key, value);
+//      cache.flush(ns);                  // O(1)
+//
+//  Eviction is global LRU with quotas:
+//  - max: a namespace at its max evicts its own LRU entry
+//  - min: a namespace at or below its min is never chosen as
+//    a victim by anyone else's insert
+//  - otherwise the victim is the oldest entry among the
+//    namespaces above their min
+//  Each namespace keeps its own LRU list and key index; the
+//  namespaces above their min sit in an ordered set keyed by
+//  the stamp of their LRU entry, so the victim is the set's
+//  first element. The set is only touched when a namespace's
+//  LRU entry or its eligibility changes: a hit on anything but
+//  the LRU entry is a plain list splice. O(log #namespaces)
+//  at worst, O(1) on most hits.
+//
+//  The sum of the mins may not exceed the capacity, and the
+//  capacity is a hard bound: when every namespace is at or
+//  below its min, an insert replaces the inserting namespace's
+//  own LRU entry (or is dropped if it has none).
+//
+//  A NamespaceId not returned by open() on this cache throws
+//  std::out_of_range.
+//
+//  flush(ns) swaps the namespace's list and index out into a
+//  retired generation (see GenerationReclaimer.h) that later
+//  calls tear down in batches, off the lock.
+// =========================================================
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "GenerationReclaimer.h"
+#include "Graveyard.h"
+#include "LockPolicy.h"
+
+namespace Cache {
+
+using NamespaceId = uint32_t;
+
+// Snapshot of one namespace
+struct NamespaceStats {
+    size_t   size{0};
+    size_t   minEntries{0};
+    size_t   maxEntries{0};
+    uint64_t hits{0};
+    uint64_t misses{0};
+    uint64_t puts{0};
+    uint64_t evictions{0};      // By anyone's insert, including its own max
+    uint64_t flushes{0};
+
+    double hitRate() const { return hits + misses ? static_cast<double>(hits) / (hits + misses) : 0.0; }
+};
+
+template<typename Key, typename Value, typename Lock = std::mutex>
+class NamespacedCache {
+public:
+    static constexpr size_t kNoLimit = std::numeric_limits<size_t>::max();
+
+    explicit NamespacedCache(size_t capacity);
+
+    NamespacedCache(const NamespacedCache&) = delete;
+    NamespacedCache& operator=(const NamespacedCache&) = delete;
+
+    // The id of name, created on first use with the given quotas (an
+    // existing namespace keeps its own). Throws std::invalid_argument
+    // if min > max or the mins would add up past the capacity
+    NamespaceId open(const std::string& name, size_t minEntries = 0, size_t maxEntries = kNoLimit);
+    void   setQuota(NamespaceId ns, size_t minEntries, size_t maxEntries);   // Same checks; trims to max
+
+    void   put(NamespaceId ns, const Key& key, const Value& value);
+    bool   get(NamespaceId ns, const Key& key, Value& value);
+    bool   remove(NamespaceId ns, const Key& key);
+    size_t flush(NamespaceId ns);                 // O(1); returns how many entries were dropped
+
+    NamespaceStats stats(NamespaceId ns) const;
+    size_t namespaces() const;
+    size_t size() const;                          // All namespaces
+    size_t capacity() const { return capacity_; }
+
+    bool   reclaimPending() const { return reclaimer_.pending(); }   // A flushed namespace is still alive
+    void   reclaimNow() { reclaimer_.drainAll(kReclaimBatch); }
+
+private:
+    static constexpr size_t kReclaimBatch = 128;  // Flushed entries torn down per get / put
+
+    struct Entry {
+        Key      key;
+        Value    value;
+        uint64_t stamp;                           // Last access, on the cache-wide clock
+    };
+    using List  = std::list<Entry>;               // front = most recent
+    using Index = std::unordered_map<Key, typename List::iterator>;
+
+    struct Namespace {
+        std::string    name;
+        List           lru;
+        Index          index;
+        NamespaceStats stats;
+        uint64_t       victimStamp{0};            // Its key in victims_ while listed there
+        bool           listed{false};
+    };
+
+    // A flushed namespace's containers: one retired generation
+    struct Retired {
+        List  lru;
+        Index index;
+    };
+
+    Namespace&       space(NamespaceId id);        // Throws std::out_of_range for an unknown id
+    const Namespace& space(NamespaceId id) const;
+    void checkQuota(size_t minEntries, size_t maxEntries, size_t oldMin) const;   // mutex_ held
+    void sync(NamespaceId id);                    // Re-file in victims_ after its LRU end or size changed
+    void evictFrom(NamespaceId id, Graveyard<Value>& dead);   // Its LRU entry; mutex_ held
+    bool makeRoom(NamespaceId id, Graveyard<Value>& dead);    // Before inserting into id; false: don't
+
+private:
+    size_t capacity_;
+    size_t size_{0};
+    size_t reservedMin_{0};                       // Sum of the mins
+    uint64_t clock_{0};
+    std::vector<std::unique_ptr<Namespace>> spaces_;          // By NamespaceId
+    std::unordered_map<std::string, NamespaceId> names_;
+    std::set<std::pair<uint64_t, NamespaceId>> victims_;      // Above their min, by LRU stamp
+    mutable Lock mutex_;
+    GenerationReclaimer reclaimer_;               // Flushed namespaces
+};
+
+} // namespace Cache
+
+#include "../src/NamespacedCache.tpp"
@@ -0,0 +1,93 @@
+#pragma once
+
+// =========================================================
+//  NearCache: per-thread L0 cache in front of a sharded cache
+//  ---------------------------------------------------------
+//  Even with sharding, the hottest keys all land in one slice
+//  and serialize on its mutex. NearCache keeps a tiny
+//  direct-mapped table per thread in front of the backend
+//  (HashLruCaches by default), so repeated reads of a hot key
+//  never touch the shared lock.
+//
+//  Coherence:
+//   - Every key hashes onto a version stamp (striped array of
+//     atomics). put/remove update the backend first, then bump
+//     the stamp; an L0 slot is only valid while its recorded
+//     stamp still matches.
+//   - A global epoch invalidates every L0 table at once
+//     (invalidateAll), e.g. after writing the backend directly.
+//
+//  L0 hits do not refresh recency in the backend, and a key
+//  evicted from the backend may still be served from L0 until
+//  its slot is overwritten or invalidated.
+// =========================================================
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "LruCache.h"
+
+namespace Cache {
+
+template<typename Key, typename Value, typename Backend = HashLruCaches<Key, Value>>
+class NearCache {
+public:
+    // l0Slots: slots per thread (rounded up to a power of two)
+    // backendArgs: forwarded to the Backend constructor
+    template<typename... Args>
+    explicit NearCache(size_t l0Slots, Args&&... backendArgs);
+    ~NearCache();
+
+    NearCache(const NearCache&) = delete;
+    NearCache& operator=(const NearCache&) = delete;
+
+    void  put(const Key& key, const Value& value);
+    bool  get(const Key& key, Value& value);
+    Value get(const Key& key);
+    void  remove(const Key& key);
+
+    // Drop every thread's L0 contents (backend is untouched)
+    void  invalidateAll();
+
+    Backend& backend() { return backend_; }
+
+private:
+    struct Slot {
+        bool     valid{false};
+        Key      key{};
+        Value    value{};
+        uint64_t version{0};
+        uint64_t epoch{0};
+    };
+
+    struct Table {
+        uint64_t          ownerId{0};
+        std::shared_ptr<std::atomic<bool>> alive;   // Cleared when the owning NearCache dies
+        std::vector<Slot> slots;
+    };
+
+    Table&    localTable();
+    size_t    stampIndex(size_t hash) const { return hash & (stampCount_ - 1); }
+    static size_t roundUpPow2(size_t n);
+    static uint64_t nextInstanceId();
+
+private:
+    static constexpr size_t kStampCount = 4096;     // Version stripes shared by all threads
+
+    Backend  backend_;
+    uint64_t id_;                                   // Unique per instance; tags thread-local tables
+    size_t   slotMask_;
+    size_t   stampCount_;
+    std::unique_ptr<std::atomic<uint64_t>[]> stamps_;
+    std::atomic<uint64_t> epoch_{0};
+    std::shared_ptr<std::atomic<bool>> alive_;
+};
+
+} // namespace Cache
+
+#include "../src/NearCache.tpp"
@@ -0,0 +1,80 @@
+#pragma once
+
+// =========================================================
+//  NegativeCache: compact memory of "known absent" keys
+//  ---------------------------------------------------------
+//  Loading caches remember keys their loader reported as
+//  missing, so repeated lookups of nonexistent keys stop
+//  reaching the backend until a short ttl runs out.
+//
+//  - No Key or Value is stored: a slot is the key's 64-bit
+//    (mixed) hash plus an expiry, 16 bytes, in a fixed table
+//    allocated once. Two keys with the same std::hash share
+//    a slot; for integer keys the hash is exact.
+//  - 4-way set associative with its own capacity budget: a
+//    full set replaces the entry closest to expiry, so the
+//    budget never grows with the absent-key traffic.
+//  - Lock striping: sets map onto 64 mutexes.
+//  - erase() when the key gets a value (put), so a negative
+//    entry never hides a real one.
+// =========================================================
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <vector>
+
+namespace Cache {
+
+// What a loading cache's lookup() found
+enum class LookupResult {
+    Hit,          // Value returned
+    Miss,         // The loader has no value (just asked)
+    KnownAbsent   // Answered by the negative cache; the loader was not called
+};
+
+template<typename Key, typename Hash = std::hash<Key>>
+class NegativeCache {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    NegativeCache(size_t capacity, std::chrono::milliseconds ttl);
+
+    NegativeCache(const NegativeCache&) = delete;
+    NegativeCache& operator=(const NegativeCache&) = delete;
+
+    void insert(const Key& key, Clock::time_point now);     // Absent until now + ttl
+    bool contains(const Key& key, Clock::time_point now);   // Known absent and not expired
+    void erase(const Key& key);
+    void clear();
+
+    size_t capacity() const { return slots_.size(); }
+    size_t memoryBytes() const { return slots_.size() * sizeof(Slot); }
+
+private:
+    static constexpr size_t kWays    = 4;
+    static constexpr size_t kStripes = 64;
+
+    struct Slot {
+        uint64_t fingerprint{0};     // 0 = empty
+        int64_t  expires{0};         // Milliseconds on Clock
+    };
+
+    static uint64_t mix(uint64_t h);                         // splitmix64 finalizer (bijective)
+    static int64_t  millis(Clock::time_point t);
+    size_t          setOf(uint64_t fingerprint) const { return static_cast<size_t>(fingerprint >> 20) & setMask_; }
+    uint64_t        fingerprint(const Key& key) const;
+
+private:
+    std::vector<Slot>                 slots_;                // sets × kWays
+    size_t                            setMask_;
+    int64_t                           ttlMs_;
+    std::array<std::mutex, kStripes>  stripes_;
+};
+
+} // namespace Cache
+
+#include "../src/NegativeCache.tpp"
@@ -0,0 +1,136 @@
+#pragma once
+
+// =========================================================
+//  OffHeapArena: value memory outside the C++ heap
+//  ---------------------------------------------------------
+//  Millions of variable-size values on the heap make malloc
+//  fragment: memory freed by evicted values is scattered
+//  over pages that stay resident, and a large heap turns
+//  every trim and arena scan into a stall. The arena instead
+//  maps big regions with mmap, either anonymous or from a
+//  scratch file, and carves them into fixed-size slabs:
+//
+//      region (64 MiB mmap) → slabs (1 MiB) → chunks of one size class
+//
+//  - Size classes grow geometrically (x1.25 by default), from
+//    32 bytes to a quarter slab. A request gets the smallest
+//    class that fits, so internal waste is at most ~25%.
+//  - Each class hands out chunks from its free list, else
+//    from its current slab, carving lazily: pages of a fresh
+//    slab are only touched once a chunk on them is used.
+//    A class that runs out takes another slab.
+//  - Freed chunks go back to their class's free list, and a
+//    slab stays with its class once taken.
+//  - Larger requests get a mapping of their own, which is
+//    unmapped again when they are freed.
+//  - One mutex per class; slabs come from a region cursor
+//    under its own mutex, so allocations of different sizes
+//    don't contend.
+//
+//  With a backing file, regions are MAP_SHARED views of it
+//  and the kernel can write cold pages back to the file
+//  instead of needing RAM or swap. The file is scratch space:
+//  truncated when the arena opens, never read back.
+//
+//  deallocate() must get the same size as allocate(); the
+//  chunk has no header. The arena must outlive every chunk:
+//  unmapping happens in the destructor.
+// =========================================================
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace Cache {
+
+struct ArenaOptions {
+    std::string backingFile;                   // Empty → anonymous memory
+    size_t regionBytes{64u << 20};             // One mmap; a multiple of slabBytes
+    size_t slabBytes{1u << 20};                // Unit a size class grows by
+    double growthFactor{1.25};                 // Between neighbouring size classes
+    size_t minChunk{32};
+};
+
+// Snapshot; each class is read under its own lock, so it is only
+// consistent once allocations have stopped
+struct ArenaStats {
+    size_t mappedBytes{0};                     // Regions + large mappings
+    size_t slabBytes{0};                       // Slabs handed to a class
+    size_t largeBytes{0};                      // Large mappings
+    size_t chunkBytes{0};                      // Chunks in use, at their class size
+    size_t requestedBytes{0};                  // What callers asked for
+    size_t allocations{0};                     // Live, including large ones
+    size_t slabs{0};
+
+    // Share of the memory given to values that holds no requested byte:
+    // rounding up to a class, plus free chunks in slabs
+    double fragmentation() const {
+        const size_t held = slabBytes + largeBytes;
+        return held ? 1.0 - static_cast<double>(requestedBytes) / held : 0.0;
+    }
+};
+
+class OffHeapArena {
+public:
+    explicit OffHeapArena(ArenaOptions options = ArenaOptions{});
+    ~OffHeapArena();
+
+    OffHeapArena(const OffHeapArena&) = delete;
+    OffHeapArena& operator=(const OffHeapArena&) = delete;
+
+    // 16-byte aligned; throws std::bad_alloc when the kernel refuses a mapping
+    void*  allocate(size_t bytes);
+    void   deallocate(void* p, size_t bytes);
+
+    size_t classCount() const { return classes_.size(); }
+    size_t classSize(size_t cls) const { return classes_[cls]->chunk; }
+    size_t maxChunk() const { return classes_.back()->chunk; }   // Larger → own mapping
+    const ArenaOptions& options() const { return options_; }
+
+    ArenaStats stats() const;
+
+private:
+    struct FreeChunk { FreeChunk* next; };
+
+    struct SizeClass {
+        explicit SizeClass(size_t size) : chunk(size) {}
+        mutable std::mutex mutex;
+        const size_t chunk;
+        FreeChunk* freeList{nullptr};
+        char*  cursor{nullptr};                // Next never-used chunk of the current slab
+        char*  slabEnd{nullptr};
+        size_t slabs{0};
+        size_t used{0};                        // Chunks handed out
+        size_t requested{0};                   // Bytes asked for by those chunks
+    };
+
+    struct Mapping {
+        void*    base;
+        size_t   bytes;
+        uint64_t fileOffset;
+    };
+
+    size_t classFor(size_t bytes) const;       // classes_.size() when too large
+    char*  takeSlab();                         // regionMutex_ taken inside
+    Mapping map(size_t bytes);                 // Anonymous or appended to the file; regionMutex_ held
+    void   unmap(const Mapping& m);
+
+private:
+    ArenaOptions options_;
+    std::vector<std::unique_ptr<SizeClass>> classes_;   // Ascending chunk size
+    int    fd_{-1};                            // Backing file, -1 when anonymous
+
+    mutable std::mutex regionMutex_;           // Everything below
+    std::vector<Mapping> regions_;
+    char*  regionCursor_{nullptr};             // Next slab of the newest region
+    char*  regionEnd_{nullptr};
+    uint64_t fileSize_{0};
+    std::unordered_map<void*, Mapping> large_; // Live large allocations
+    size_t largeRequested_{0};
+};
+
+} // namespace Cache
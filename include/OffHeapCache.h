@@ -0,0 +1,105 @@
+#pragma once
+
+// =========================================================
+//  OffHeapCache: policies hold a 16-byte handle, the bytes
+//  live in an OffHeapArena
+//  ---------------------------------------------------------
+//  OffHeap<V> is a value handle: it serializes a V into an
+//  arena chunk through ValueTraits<V> and is what the policy
+//  stores in place of V. Any policy works unchanged:
+//
+//      auto arena = std::make_shared<OffHeapArena>();
+//      OffHeapCache<int, std::string> cache(
+//          std::make_unique<LruCache<int, OffHeap<std::string>>>(1000000), arena);
+//      cache.put(17, page);                // serialized into the arena
+//      cache.get(17, out);                 // copied back out
+//
+//  The chunk starts with a reference count and the length.
+//  Copying a handle bumps the count, so a get copies the
+//  handle under the policy's lock and reads the bytes after
+//  the unlock, while eviction may already have dropped the
+//  policy's copy. The last handle frees the chunk; with the
+//  policies' deferred destruction (Graveyard.h) that happens
+//  after their lock is released, too.
+//
+//  put() serializes before the policy is called, so an
+//  overwritten or evicted chunk is freed while the new one
+//  already exists: a key briefly costs two chunks.
+//
+//  The arena must outlive every handle: an OffHeapCache
+//  declares it before the policy, so the policy's entries
+//  go first.
+// =========================================================
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+#include "CachePolicy.h"
+#include "OffHeapArena.h"
+#include "ValueTraits.h"
+
+namespace Cache {
+
+template<typename Value, typename Traits = ValueTraits<Value>>
+class OffHeap {
+public:
+    OffHeap() = default;                       // Empty: what a policy default-constructs
+    OffHeap(OffHeapArena& arena, const Value& value);
+    ~OffHeap() { release(); }
+
+    OffHeap(const OffHeap& other) noexcept;
+    OffHeap(OffHeap&& other) noexcept;
+    OffHeap& operator=(const OffHeap& other) noexcept;
+    OffHeap& operator=(OffHeap&& other) noexcept;
+
+    explicit operator bool() const { return block_ != nullptr; }
+    bool   read(Value& out) const;             // false on an empty handle
+    Value  get() const;                        // Value{} on an empty handle
+    size_t bytes() const { return block_ ? block_->length : 0; }   // Serialized size
+
+private:
+    struct Block {
+        std::atomic<uint32_t> refs;
+        uint32_t              length;
+        char* data() { return reinterpret_cast<char*>(this + 1); }
+    };
+
+    void release() noexcept;
+
+    OffHeapArena* arena_{nullptr};
+    Block*        block_{nullptr};
+};
+
+template<typename Key, typename Value, typename Traits = ValueTraits<Value>>
+class OffHeapCache : public CachePolicy<Key, Value> {
+public:
+    using Handle = OffHeap<Value, Traits>;
+    using Policy = CachePolicy<Key, Handle>;
+
+    // nullptr arena → a private anonymous one with default options; a null
+    // policy throws std::invalid_argument
+    explicit OffHeapCache(std::unique_ptr<Policy> policy, std::shared_ptr<OffHeapArena> arena = nullptr);
+
+    OffHeapCache(const OffHeapCache&) = delete;
+    OffHeapCache& operator=(const OffHeapCache&) = delete;
+
+    // ---- CachePolicy interface ----
+    void   put(const Key& key, const Value& value) override;   // Serialized before the policy's lock
+    bool   get(const Key& key, Value& value) override;         // Deserialized after it
+    Value  get(const Key& key) override;                       // Value{} on a miss
+
+    Policy&       policy() { return *policy_; }                // Policy-specific calls (remove, tags, …)
+    OffHeapArena& arena()  { return *arena_; }
+    ArenaStats    arenaStats() const { return arena_->stats(); }
+
+private:
+    std::shared_ptr<OffHeapArena> arena_;                      // Declared first: outlives the handles
+    std::unique_ptr<Policy>       policy_;
+};
+
+} // namespace Cache
+
+#include "../src/OffHeapCache.tpp"
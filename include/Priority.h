@@ -0,0 +1,93 @@
+#pragma once
+
+// =========================================================
+//  Priority.h —— priority classes for cache entries
+//  ---------------------------------------------------------
+//      cache.put(key, cheap,     Priority::Low);
+//      cache.put(key, expensive, Priority::High);
+//
+//  Each priority has its own recency sub-list. Eviction takes
+//  the LRU entry of the lowest non-empty tier, so cheap
+//  entries churn among themselves while expensive ones stay;
+//  a higher tier only loses entries once every lower tier is
+//  empty. Finding the victim checks kPriorities lists: O(1).
+//  A plain put inserts at Normal and leaves an existing
+//  entry's priority alone; a put with a priority moves the
+//  entry to that tier.
+//
+//  PriorityLists is the tiered list Arc_new keeps for T1 and
+//  for T2. PriorityStats are per-tier counters; the cache
+//  updates them under its own lock.
+// =========================================================
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <utility>
+
+namespace Cache {
+
+enum class Priority : uint8_t { Low = 0, Normal = 1, High = 2 };
+
+constexpr size_t kPriorities = 3;
+
+inline size_t tierOf(Priority p) { return static_cast<size_t>(p); }
+
+// Per-tier counters. A get-or-load workload inserts after every miss,
+// so hits / (hits + inserts) is the tier's hit rate
+struct PriorityStats {
+    std::array<uint64_t, kPriorities> hits{};
+    std::array<uint64_t, kPriorities> inserts{};     // New keys
+    std::array<uint64_t, kPriorities> evictions{};
+    std::array<size_t,   kPriorities> entries{};     // Resident now
+
+    double hitRate(Priority p) const {
+        const uint64_t h = hits[tierOf(p)], n = h + inserts[tierOf(p)];
+        return n ? static_cast<double>(h) / n : 0.0;
+    }
+};
+
+// One std::list per priority; front = most recent. Iterators stay
+// valid until their element is erased, as with a plain std::list
+template<typename T>
+class PriorityLists {
+public:
+    using iterator = typename std::list<T>::iterator;
+
+    iterator pushFront(Priority p, const T& value) {
+        auto& list = lists_[tierOf(p)];
+        list.push_front(value);
+        ++size_;
+        return list.begin();
+    }
+
+    void erase(Priority p, iterator it) {
+        lists_[tierOf(p)].erase(it);
+        --size_;
+    }
+
+    // Lowest tier holding anything; only valid when !empty()
+    Priority lowest() const {
+        size_t t = 0;
+        while (lists_[t].empty()) ++t;
+        return static_cast<Priority>(t);
+    }
+
+    std::list<T>&       tier(Priority p)       { return lists_[tierOf(p)]; }
+    const std::list<T>& tier(Priority p) const { return lists_[tierOf(p)]; }
+
+    size_t size() const  { return size_; }
+    bool   empty() const { return size_ == 0; }
+
+    void swap(PriorityLists& other) {
+        lists_.swap(other.lists_);
+        std::swap(size_, other.size_);
+    }
+
+private:
+    std::array<std::list<T>, kPriorities> lists_;
+    size_t size_{0};
+};
+
+} // namespace Cache
@@ -0,0 +1,166 @@
+#pragma once
+
+// =========================================================
+//  RefreshAheadCache: TTL loading cache with refresh-ahead
+//  ---------------------------------------------------------
+//  A loading cache over any CachePolicy (LRU / LFU / ARC …)
+//  whose entries expire `ttl` after they were loaded. Hot
+//  keys are reloaded in the background before they expire,
+//  so readers keep hitting instead of all missing at once.
+//
+//  Age of the entry at get():
+//    < refreshAfter             fresh: plain hit
+//    < ttl                      hit; an asynchronous reload
+//                               is queued (refresh-ahead)
+//    < ttl + staleWindow        stale hit; reload queued
+//                               (stale-while-revalidate)
+//    otherwise / not cached     the loader runs on the
+//                               caller's thread (miss)
+//
+//  - Misses are single flight: one caller loads a key, the
+//    others missing it at the same time wait for its result.
+//  - xfetchBeta > 0 adds probabilistic early recomputation
+//    (XFetch): a fresh hit reloads on the caller's thread
+//    when  age + delta * beta * -ln(rand) >= ttl,  delta being
+//    how long the key's last load took. Readers of one key
+//    draw independently, so a hot key is recomputed a little
+//    before it expires by one reader instead of missing for
+//    all of them at once. Slow keys start earlier. Values
+//    from put() have no delta and just expire.
+//  - A put() while a load or reload of that key is in flight
+//    wins; the load's result is not cached.
+//  - Reloads run on a MaintenanceExecutor (shared or owned),
+//    one per key at a time: a key already queued or loading
+//    is not queued again.
+//  - Reloads call the loader on the executor thread. An
+//    executor shared with cache maintenance (eviction, aging,
+//    clear teardown) runs those tasks only between reloads,
+//    so a slow loader stalls maintenance for every cache on
+//    it; they fill to the high watermark and evict inline.
+//    Give refreshes their own executor (or pass nullptr).
+//  - A reload that throws, or finds no value, leaves the old
+//    entry in place until it expires; the next read past the
+//    threshold tries again.
+//  - refreshAfter >= ttl turns refresh-ahead off (plain TTL).
+//  - negativeTtl > 0 remembers keys the loader had no value
+//    for in a NegativeCache of negativeCapacity entries;
+//    lookup() reports them as KnownAbsent without calling
+//    the loader until negativeTtl has passed or a put().
+// =========================================================
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+#include "CachePolicy.h"
+#include "MaintenanceExecutor.h"
+#include "NegativeCache.h"
+
+namespace Cache {
+
+// What the wrapped policy stores: the value and when it was loaded
+template<typename Value>
+struct TimedValue {
+    Value                                 value{};
+    std::chrono::steady_clock::time_point loadedAt{};
+    std::chrono::steady_clock::duration   loadTime{};   // How long the load took (XFetch delta)
+};
+
+struct RefreshOptions {
+    std::chrono::milliseconds ttl{1000};              // Entries are misses after this
+    std::chrono::milliseconds refreshAfter{800};      // Reads after this queue a reload
+    std::chrono::milliseconds staleWindow{0};         // Past ttl, still served while reloading
+    double xfetchBeta{0.0};                           // > 0: early recomputation; 1 is the usual choice
+    std::chrono::milliseconds negativeTtl{0};         // > 0: cache "no such key" this long
+    size_t negativeCapacity{4096};                    // Absent keys remembered (own budget)
+    std::function<std::chrono::steady_clock::time_point()> clock;   // Empty → steady_clock::now
+};
+
+template<typename Key, typename Value>
+class RefreshAheadCache {
+public:
+    using Entry  = TimedValue<Value>;
+    using Policy = CachePolicy<Key, Entry>;
+    using Loader = std::function<bool(const Key& key, Value& value)>;   // false → no such key
+
+    RefreshAheadCache(std::unique_ptr<Policy> policy, Loader loader,
+                      RefreshOptions options = RefreshOptions{},
+                      std::shared_ptr<MaintenanceExecutor> executor = nullptr);   // nullptr → own executor; see above before sharing
+    ~RefreshAheadCache();
+
+    RefreshAheadCache(const RefreshAheadCache&) = delete;
+    RefreshAheadCache& operator=(const RefreshAheadCache&) = delete;
+
+    bool get(const Key& key, Value& value);          // Loads on a miss; false if the loader has no value
+    LookupResult lookup(const Key& key, Value& value);   // get() that tells a fresh miss from a known one
+    void put(const Key& key, const Value& value);    // Fresh entry, supersedes an in-flight reload
+
+    void awaitRefreshes();                           // Wait until queued reloads have run
+
+    // ---- Statistics ----
+    size_t loads() const         { return loads_.load(std::memory_order_relaxed); }          // On the caller's thread
+    size_t refreshes() const     { return refreshes_.load(std::memory_order_relaxed); }      // In the background
+    size_t refreshErrors() const { return refreshErrors_.load(std::memory_order_relaxed); }
+    size_t staleServed() const   { return staleServed_.load(std::memory_order_relaxed); }    // Served past ttl
+    size_t expiredMisses() const { return expiredMisses_.load(std::memory_order_relaxed); }
+    size_t sharedLoads() const   { return sharedLoads_.load(std::memory_order_relaxed); }    // Waited on another caller's load
+    size_t earlyLoads() const    { return earlyLoads_.load(std::memory_order_relaxed); }     // XFetch recomputations
+    size_t negativeHits() const  { return negativeHits_.load(std::memory_order_relaxed); }   // Answered KnownAbsent
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    // One caller's load of a key, shared by callers missing it meanwhile
+    struct Flight {
+        bool               done{false};
+        bool               found{false};
+        bool               superseded{false};   // A put() arrived: don't publish
+        Value              value{};
+        std::exception_ptr error;
+    };
+
+    enum class Load { Found, Absent, InFlight };
+
+    Clock::time_point now() const { return options_.clock ? options_.clock() : Clock::now(); }
+    bool drawsEarly(const Entry& entry, Clock::duration age) const;
+    Load load(const Key& key, Value& value, bool joinInFlight);   // On the caller's thread
+    void requestRefresh(const Key& key);
+    void runRefreshes();                             // Executor task
+
+private:
+    std::unique_ptr<Policy> policy_;
+    Loader                  loader_;
+    RefreshOptions          options_;
+
+    std::mutex                     refreshMutex_;
+    std::unordered_map<Key, bool>  refreshing_;      // Queued or loading → superseded by a put
+    std::deque<Key>                queue_;           // Waiting for the executor
+
+    std::mutex                     flightMutex_;
+    std::condition_variable        flightCv_;        // A flight completed
+    std::unordered_map<Key, std::shared_ptr<Flight>> flights_;
+
+    std::unique_ptr<NegativeCache<Key>> negatives_;  // Null unless negativeTtl > 0
+
+    std::atomic<size_t> loads_{0};
+    std::atomic<size_t> refreshes_{0};
+    std::atomic<size_t> refreshErrors_{0};
+    std::atomic<size_t> staleServed_{0};
+    std::atomic<size_t> expiredMisses_{0};
+    std::atomic<size_t> sharedLoads_{0};
+    std::atomic<size_t> earlyLoads_{0};
+    std::atomic<size_t> negativeHits_{0};
+
+    std::shared_ptr<MaintenanceExecutor> executor_;
+    MaintenanceExecutor::TaskId          taskId_{0};   // Registered last, removed first
+};
+
+} // namespace Cache
+
+#include "../src/RefreshAheadCache.tpp"
@@ -0,0 +1,138 @@
+#pragma once
+
+// =========================================================
+//  RemovalListener.h —— who left the cache, and why
+//  ---------------------------------------------------------
+//  LruCache / LfuCache / Arc_new (and HashLruCaches) accept a
+//  listener through setRemovalListener(). Every entry that
+//  leaves the cache is reported once, with its key, its value
+//  (moved out of the cache) and a RemovalCause:
+//
+//    Size      —— evicted for capacity (LRU / LFU)
+//    DemotedT1 —— ARC: T1 → B1, value dropped, key kept as ghost
+//    DemotedT2 —— ARC: T2 → B2
+//    Expired   —— TTL ran out (policies with expiration)
+//    Explicit  —— remove() / purge() / clear()
+//    Replaced  —— put() overwrote the value; the OLD value is reported
+//
+//  Notifications are collected under the cache lock and
+//  delivered as one batch per operation after the lock is
+//  released, so a listener may call back into the cache.
+//  With an executor they are appended to one pending batch
+//  and delivered on its thread instead: put pays only for the
+//  append, and the listener sees everything queued since its
+//  last run in a single call.
+//  The listener must be set before the cache is shared.
+// =========================================================
+
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include "MaintenanceExecutor.h"
+
+namespace Cache {
+
+enum class RemovalCause { Size, DemotedT1, DemotedT2, Expired, Explicit, Replaced };
+
+inline const char* toString(RemovalCause cause) {
+    switch (cause) {
+        case RemovalCause::Size:      return "Size";
+        case RemovalCause::DemotedT1: return "DemotedT1";
+        case RemovalCause::DemotedT2: return "DemotedT2";
+        case RemovalCause::Expired:   return "Expired";
+        case RemovalCause::Explicit:  return "Explicit";
+        case RemovalCause::Replaced:  return "Replaced";
+    }
+    return "?";
+}
+
+template<typename Key, typename Value>
+struct RemovalNotification {
+    Key          key;
+    Value        value;
+    RemovalCause cause;
+};
+
+// One operation's notifications; stays empty (no allocation) without a listener
+template<typename Key, typename Value>
+using RemovalBatch = std::vector<RemovalNotification<Key, Value>>;
+
+// The listener may move values out of the batch (e.g. to write them back)
+template<typename Key, typename Value>
+using RemovalListener = std::function<void(RemovalBatch<Key, Value>&)>;
+
+// ---- RemovalDispatcher: the cache-side half ----
+template<typename Key, typename Value>
+class RemovalDispatcher {
+public:
+    using Batch    = RemovalBatch<Key, Value>;
+    using Listener = RemovalListener<Key, Value>;
+
+    RemovalDispatcher() = default;
+    ~RemovalDispatcher() { reset(); }
+
+    RemovalDispatcher(const RemovalDispatcher&) = delete;
+    RemovalDispatcher& operator=(const RemovalDispatcher&) = delete;
+
+    // executor == nullptr → deliver on the calling thread after the unlock
+    void set(Listener listener, std::shared_ptr<MaintenanceExecutor> executor = nullptr) {
+        reset();
+        listener_ = std::move(listener);
+        executor_ = std::move(executor);
+        if (executor_ && listener_) taskId_ = executor_->add([this] { drainQueue(); });
+    }
+
+    bool enabled() const { return static_cast<bool>(listener_); }
+
+    // Call WITHOUT the cache lock held
+    void deliver(Batch& batch) {
+        if (batch.empty()) return;
+        if (!executor_) {
+            listener_(batch);
+            return;
+        }
+        bool wasEmpty;
+        {
+            std::lock_guard<std::mutex> lock(queueMutex_);
+            wasEmpty = pending_.empty();
+            if (wasEmpty) pending_.swap(batch);
+            else pending_.insert(pending_.end(), std::make_move_iterator(batch.begin()),
+                                 std::make_move_iterator(batch.end()));
+        }
+        batch.clear();
+        if (wasEmpty) executor_->schedule(taskId_);   // Otherwise a run is already due
+    }
+
+private:
+    void drainQueue() {
+        Batch ready;
+        {
+            std::lock_guard<std::mutex> lock(queueMutex_);
+            ready.swap(pending_);
+        }
+        if (!ready.empty()) listener_(ready);
+    }
+
+    // Unregister, then hand anything still queued to the listener
+    void reset() {
+        if (executor_) {
+            executor_->remove(taskId_);
+            drainQueue();
+            executor_.reset();
+        }
+        listener_ = nullptr;
+    }
+
+private:
+    Listener                             listener_;
+    std::shared_ptr<MaintenanceExecutor> executor_;
+    MaintenanceExecutor::TaskId          taskId_{0};
+    std::mutex                           queueMutex_;
+    Batch                                pending_;
+};
+
+} // namespace Cache
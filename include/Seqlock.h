@@ -0,0 +1,108 @@
+#pragma once
+
+// =========================================================
+//  Seqlock helpers
+//  ---------------------------------------------------------
+//  VersionLock: a spin lock whose counter doubles as a
+//  sequence number. Writers make it odd while they hold it;
+//  optimistic readers snapshot the (even) version, copy the
+//  data, and retry if the version moved in the meantime.
+//
+//  seqlockLoad/seqlockStore copy trivially copyable objects
+//  word by word with relaxed atomic builtins, so the racy
+//  optimistic copy is well defined (and visible to TSan);
+//  a torn result is simply discarded by the version check.
+// =========================================================
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <thread>
+#include <type_traits>
+
+namespace Cache {
+
+class VersionLock {
+public:
+    void lock() {
+        for (int spins = 0;; ++spins) {
+            uint64_t v = version_.load(std::memory_order_relaxed);
+            if ((v & 1) == 0 &&
+                version_.compare_exchange_weak(v, v + 1, std::memory_order_acquire,
+                                               std::memory_order_relaxed)) {
+                // Keep data stores after the odd version for optimistic readers
+                std::atomic_thread_fence(std::memory_order_release);
+                return;
+            }
+            if (spins >= kSpinsBeforeYield) std::this_thread::yield();
+        }
+    }
+
+    bool try_lock() {
+        uint64_t v = version_.load(std::memory_order_relaxed);
+        if ((v & 1) != 0 ||
+            !version_.compare_exchange_strong(v, v + 1, std::memory_order_acquire,
+                                              std::memory_order_relaxed))
+            return false;
+        std::atomic_thread_fence(std::memory_order_release);
+        return true;
+    }
+
+    void unlock() { version_.fetch_add(1, std::memory_order_release); }
+
+    // ---- Optimistic read side ----
+    // readBegin waits out an in-progress writer and returns an even version
+    uint64_t readBegin() const {
+        for (int spins = 0;; ++spins) {
+            uint64_t v = version_.load(std::memory_order_acquire);
+            if ((v & 1) == 0) return v;
+            if (spins >= kSpinsBeforeYield) std::this_thread::yield();
+        }
+    }
+
+    bool readRetry(uint64_t begin) const {
+        std::atomic_thread_fence(std::memory_order_acquire);
+        return version_.load(std::memory_order_relaxed) != begin;
+    }
+
+private:
+    static constexpr int kSpinsBeforeYield = 64;
+    std::atomic<uint64_t> version_{0};
+};
+
+// Copy src → dst with per-word relaxed atomic loads (reader side)
+template<typename T>
+inline void seqlockLoad(T& dst, const T& src) {
+    static_assert(std::is_trivially_copyable<T>::value, "seqlock copies need trivially copyable types");
+    unsigned char buf[sizeof(T)];
+    const unsigned char* s = reinterpret_cast<const unsigned char*>(&src);
+    size_t i = 0;
+    if (alignof(T) >= alignof(uint64_t)) {
+        for (; i + sizeof(uint64_t) <= sizeof(T); i += sizeof(uint64_t)) {
+            uint64_t w = __atomic_load_n(reinterpret_cast<const uint64_t*>(s + i), __ATOMIC_RELAXED);
+            std::memcpy(buf + i, &w, sizeof(w));
+        }
+    }
+    for (; i < sizeof(T); ++i) buf[i] = __atomic_load_n(s + i, __ATOMIC_RELAXED);
+    std::memcpy(&dst, buf, sizeof(T));
+}
+
+// Copy src → dst with per-word relaxed atomic stores (writer side, lock held)
+template<typename T>
+inline void seqlockStore(T& dst, const T& src) {
+    static_assert(std::is_trivially_copyable<T>::value, "seqlock copies need trivially copyable types");
+    unsigned char buf[sizeof(T)];
+    std::memcpy(buf, &src, sizeof(T));
+    unsigned char* d = reinterpret_cast<unsigned char*>(&dst);
+    size_t i = 0;
+    if (alignof(T) >= alignof(uint64_t)) {
+        for (; i + sizeof(uint64_t) <= sizeof(T); i += sizeof(uint64_t)) {
+            uint64_t w;
+            std::memcpy(&w, buf + i, sizeof(w));
+            __atomic_store_n(reinterpret_cast<uint64_t*>(d + i), w, __ATOMIC_RELAXED);
+        }
+    }
+    for (; i < sizeof(T); ++i) __atomic_store_n(d + i, buf[i], __ATOMIC_RELAXED);
+}
+
+} // namespace Cache
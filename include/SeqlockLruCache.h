@@ -0,0 +1,111 @@
+#pragma once
+
+// =========================================================
+//  SeqlockLruCache: LRU with lock-free get for trivially
+//  copyable keys/values
+//  ---------------------------------------------------------
+//  - Entries live in a fixed array (capacity slots, never
+//    freed), each guarded by its own VersionLock (Seqlock.h).
+//    get() finds the slot through a CuckooHashMap index and
+//    copies key + value optimistically; a concurrent write
+//    bumps the version and the reader retries.
+//  - Recency is deferred: a hit only sets the entry's
+//    referenced bit. The list is fixed up at eviction time:
+//    a referenced entry at the LRU end is moved to the MRU
+//    end (bit cleared) instead of being evicted — a second
+//    chance, so hot entries survive without readers ever
+//    touching the list.
+//  - put / remove serialize on one mutex per cache.
+//
+//  HashSeqlockLruCaches shards it like HashLruCaches.
+// =========================================================
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+#include <vector>
+
+#include "CachePolicy.h"
+#include "CuckooHashMap.h"
+#include "Seqlock.h"
+
+namespace Cache {
+
+template<typename Key, typename Value>
+class SeqlockLruCache : public CachePolicy<Key, Value> {
+    static_assert(std::is_trivially_copyable<Key>::value && std::is_trivially_copyable<Value>::value,
+                  "SeqlockLruCache copies keys/values optimistically: both must be trivially copyable");
+
+public:
+    explicit SeqlockLruCache(int capacity);
+    ~SeqlockLruCache() override = default;
+
+    void   put(const Key& key, const Value& value) override;
+    bool   get(const Key& key, Value& value) override;         // Lock-free
+    Value  get(const Key& key) override;
+    void   remove(const Key& key);
+
+    size_t size() const { return index_.size(); }
+
+    // get() calls that gave up on optimistic reads and took the mutex
+    size_t lockedReads() const { return lockedReads_.load(std::memory_order_relaxed); }
+
+private:
+    static constexpr uint32_t kNone       = UINT32_MAX;
+    static constexpr int      kMaxRetries = 8;
+
+    struct alignas(64) Entry {
+        VersionLock       lock;                                // Writers hold it while changing key/value/live
+        Key               key{};
+        Value             value{};
+        bool              live{false};
+        std::atomic<bool> referenced{false};                   // Set by get(), consumed at eviction
+    };
+
+    bool     readOptimistic(const Key& key, Value& value, bool& done);
+    bool     readLocked(const Key& key, Value& value);
+    void     writeEntry(uint32_t idx, const Key& key, const Value& value, bool live);
+    uint32_t takeSlot();                                       // Free slot or evicted victim
+    uint32_t selectVictim();
+    void     linkMostRecent(uint32_t idx);
+    void     unlink(uint32_t idx);
+
+private:
+    int                             capacity_;
+    std::unique_ptr<Entry[]>        entries_;
+    CuckooHashMap<Key, uint32_t>    index_;                    // key → entry slot
+
+    // ---- Writer-only state (under mutex_) ----
+    std::mutex                      mutex_;
+    std::vector<uint32_t>           prev_, next_;              // List links; index capacity_ is the sentinel
+    uint32_t                        used_{0};                  // Slots handed out so far
+    std::vector<uint32_t>           freeSlots_;                // Slots released by remove()
+
+    std::atomic<size_t>             lockedReads_{0};
+};
+
+// Sharded variant: same layout as HashLruCaches
+template<typename Key, typename Value>
+class HashSeqlockLruCaches {
+public:
+    HashSeqlockLruCaches(size_t capacity, int sliceNum = 0);   // sliceNum=0 → default to CPU core count
+
+    void  put(const Key& key, const Value& value);
+    bool  get(const Key& key, Value& value);
+    Value get(const Key& key);
+    void  remove(const Key& key);
+
+private:
+    size_t calcSliceIndex(const Key& key) const;
+
+private:
+    size_t capacity_;
+    int    sliceNum_;
+    std::vector<std::unique_ptr<SeqlockLruCache<Key, Value>>> slices_;
+};
+
+} // namespace Cache
+
+#include "../src/SeqlockLruCache.tpp"
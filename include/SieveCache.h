@@ -0,0 +1,54 @@
+#pragma once
+
+// =========================================================
+//  SieveCache: SIEVE eviction over a lock-free read index
+//  ---------------------------------------------------------
+//  LRU has to relink a node on every hit, so get() needs the
+//  mutex. SIEVE only sets a "visited" bit on a hit, which the
+//  ConcurrentHashMap does atomically inside find(): get()
+//  never takes a lock.
+//
+//  put() still serializes on mutex_ to maintain the FIFO
+//  queue and the eviction hand:
+//   - new keys enter at the head (front) of the queue
+//   - the hand walks from tail to head; visited entries get
+//     their bit cleared and survive, the first unvisited
+//     entry is evicted
+// =========================================================
+
+#include <list>
+#include <mutex>
+
+#include "CachePolicy.h"
+#include "ConcurrentHashMap.h"
+
+namespace Cache {
+
+template<typename Key, typename Value>
+class SieveCache : public CachePolicy<Key, Value> {
+public:
+    explicit SieveCache(size_t capacity);
+    ~SieveCache() override = default;
+
+    // CachePolicy interface
+    void  put(const Key& key, const Value& value) override;   // Locks mutex_
+    bool  get(const Key& key, Value& value) override;         // Lock-free
+    Value get(const Key& key) override;
+
+    size_t size() const { return index_.size(); }
+    size_t capacity() const { return capacity_; }
+
+private:
+    void evict();                                             // Caller holds mutex_
+
+private:
+    size_t                          capacity_;
+    ConcurrentHashMap<Key, Value>   index_;
+    std::list<Key>                  queue_;                   // front = newest, back = oldest
+    typename std::list<Key>::iterator hand_;                  // queue_.end() → restart at the tail
+    std::mutex                      mutex_;
+};
+
+} // namespace Cache
+
+#include "../src/SieveCache.tpp"
@@ -0,0 +1,112 @@
+#pragma once
+
+// =========================================================
+//  SlabAllocator: fixed memory split into pages, each page
+//  carved into the chunks of one size class
+//  ---------------------------------------------------------
+//  memcached's layout. The memory limit is reserved as one
+//  mapping and split into pages (1 MiB by default); a page is
+//  touched only when a class first takes it:
+//
+//      memory limit → pages → chunks of one size class
+//
+//  - Classes grow geometrically (x1.25 by default), from
+//    minChunk up to a whole page. A chunk is at most ~25%
+//    bigger than what it holds.
+//  - allocate(cls) takes a chunk from the class's free list,
+//    else carves a free page for it; nullptr once every page
+//    belongs to some class and this one has nothing free.
+//    What to evict then is the owner's call (SlabCache evicts
+//    the class's LRU item).
+//  - Pages never go back on their own. When the size mix
+//    shifts, the owner moves a page: detachPage() takes its
+//    free chunks off the free list (free lists are doubly
+//    linked for this), the owner empties the used chunks,
+//    then assignPage() re-carves it for another class.
+//    Chunks freed while their page is detached stay off the
+//    free list.
+//
+//  The first 4 bytes of a chunk tell free from used: free()
+//  writes 0 there, and the owner must keep them non-zero
+//  while the chunk holds something (see chunkInUse).
+//
+//  Not thread-safe: the owner calls it under its own lock.
+// =========================================================
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace Cache {
+
+struct SlabOptions {
+    size_t memoryLimit{64u << 20};             // Every page; reserved up front, touched on use
+    size_t pageBytes{1u << 20};                // Unit moved between classes; largest chunk
+    double growthFactor{1.25};                 // Between neighbouring size classes
+    size_t minChunk{64};
+    size_t rebalanceWindow{1000};              // SlabCache: evictions between automove decisions
+};
+
+class SlabAllocator {
+public:
+    static constexpr uint32_t kNoClass = UINT32_MAX;
+    static constexpr size_t   kNoPage  = SIZE_MAX;
+
+    explicit SlabAllocator(const SlabOptions& options);
+    ~SlabAllocator();
+
+    SlabAllocator(const SlabAllocator&) = delete;
+    SlabAllocator& operator=(const SlabAllocator&) = delete;
+
+    uint32_t classFor(size_t bytes) const;     // kNoClass when larger than a page
+    uint32_t classCount() const { return static_cast<uint32_t>(classes_.size()); }
+    size_t   chunkSize(uint32_t cls) const { return classes_[cls].chunk; }
+    size_t   pages(uint32_t cls) const     { return classes_[cls].pages; }
+    size_t   usedChunks(uint32_t cls) const { return classes_[cls].used; }
+
+    void*    allocate(uint32_t cls);           // nullptr: no free chunk and no free page
+    void     free(void* chunk);
+
+    static bool chunkInUse(const void* chunk) { return *static_cast<const uint32_t*>(chunk) != 0; }
+
+    // ---- Pages ----
+    size_t   pageCount() const    { return pageClass_.size(); }
+    size_t   freePages() const    { return freePages_.size(); }
+    size_t   pageBytes() const    { return pageBytes_; }
+    size_t   pageOf(const void* p) const { return static_cast<size_t>(static_cast<const char*>(p) - base_) / pageBytes_; }
+    char*    pageBase(size_t page) const { return base_ + page * pageBytes_; }
+    uint32_t pageClass(size_t page) const { return pageClass_[page]; }
+    uint32_t classOf(const void* p) const { return pageClass_[pageOf(p)]; }
+
+    void     detachPage(size_t page);          // Its free chunks leave the free list; frees into it are dropped
+    void     assignPage(size_t page, uint32_t cls);   // Every chunk free: re-carve for cls
+
+private:
+    struct FreeChunk {
+        uint32_t   state;                      // 0: free
+        FreeChunk* prev;
+        FreeChunk* next;
+    };
+
+    struct SizeClass {
+        size_t     chunk;
+        FreeChunk* head{nullptr};
+        size_t     pages{0};
+        size_t     used{0};
+    };
+
+    void carve(size_t page, uint32_t cls);
+    void pushFree(SizeClass& c, void* chunk);
+    void unlinkFree(SizeClass& c, FreeChunk* f);
+
+private:
+    size_t pageBytes_;
+    size_t mappedBytes_;
+    char*  base_{nullptr};
+    std::vector<SizeClass> classes_;           // Ascending chunk size
+    std::vector<uint32_t>  pageClass_;         // kNoClass: free page
+    std::vector<bool>      detached_;          // Being emptied for a move
+    std::vector<size_t>    freePages_;
+};
+
+} // namespace Cache
@@ -0,0 +1,170 @@
+#pragma once
+
+// =========================================================
+//  SlabCache: memcached-style cache in a fixed byte budget
+//  ---------------------------------------------------------
+//  Every item (LRU links, hash chain, key and value bytes)
+//  lives in one SlabAllocator chunk; the only heap memory is
+//  the hash bucket array. Capacity is bytes, not entries:
+//
+//      SlabOptions opts;
+//      opts.memoryLimit = 512u << 20;
+//      SlabCache<std::string, std::string> cache(opts);
+//      cache.enableRebalancing(executor);      // optional automove
+//
+//  - Keys and values are flattened through ValueTraits (see
+//    ValueTraits.h); get() copies the value out under the lock.
+//  - Each size class has its own LRU list. An insert that
+//    finds no free chunk and no free page evicts the LRU item
+//    of its own class; other classes are never touched.
+//    Item size decides the class, so a cache full of small
+//    items cannot make room for a big one that way: that is
+//    the rebalancer's job.
+//  - Rebalancer (memcached's slab automove): every
+//    rebalanceWindow evictions it picks a destination, the
+//    class that failed to store most in the window (it has no
+//    page), else the one that evicted most, and a source, the
+//    other class with the oldest LRU tail. If the source's
+//    tail is older than the destination's, one
+//    page moves: its items are evicted in batches of
+//    kMoveBatch per lock hold, then the page is re-carved for
+//    the destination. The moves run on a MaintenanceExecutor;
+//    rebalance() runs one on the caller's thread.
+//  - An item larger than a page is not stored (tooLarge) and
+//    the key's old item is dropped.
+//  - The hash table doubles once it holds 1.5 items per
+//    bucket, rehashing under the lock.
+// =========================================================
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "CachePolicy.h"
+#include "MaintenanceExecutor.h"
+#include "SlabAllocator.h"
+#include "ValueTraits.h"
+
+namespace Cache {
+
+struct SlabClassStats {
+    size_t   chunkBytes{0};
+    size_t   pages{0};
+    size_t   items{0};
+    size_t   requestedBytes{0};                // Item headers + keys + values
+    uint64_t evictions{0};                     // Including items evicted by page moves
+    uint64_t outOfMemory{0};                   // Stores dropped: nothing of this class to evict
+};
+
+struct SlabStats {
+    size_t   memoryLimit{0};
+    size_t   pageBytes{0};
+    size_t   pagesAssigned{0};
+    size_t   pagesFree{0};
+    size_t   items{0};
+    size_t   requestedBytes{0};
+    uint64_t hits{0};
+    uint64_t misses{0};
+    uint64_t evictions{0};
+    uint64_t pagesMoved{0};
+    uint64_t moveEvictions{0};                 // Items a page move displaced
+    uint64_t tooLarge{0};
+    std::vector<SlabClassStats> classes;       // Only classes that ever held a page
+
+    // Assigned page bytes that hold no requested byte: rounding up to a
+    // class, page tails, free chunks
+    double fragmentation() const {
+        return pagesAssigned ? 1.0 - static_cast<double>(requestedBytes) / (pagesAssigned * pageBytes) : 0.0;
+    }
+};
+
+template<typename Key, typename Value, typename Lock = std::mutex>
+class SlabCache : public CachePolicy<Key, Value> {
+public:
+    explicit SlabCache(SlabOptions options = SlabOptions{});
+    ~SlabCache() override;
+
+    SlabCache(const SlabCache&) = delete;
+    SlabCache& operator=(const SlabCache&) = delete;
+
+    // ---- CachePolicy interface ----
+    void   put(const Key& key, const Value& value) override;
+    bool   get(const Key& key, Value& value) override;
+    Value  get(const Key& key) override;                       // Value{} on a miss
+    bool   remove(const Key& key);
+
+    // Automatic page moves on executor; call before the cache is shared
+    void   enableRebalancing(std::shared_ptr<MaintenanceExecutor> executor);
+    bool   rebalance();                        // One decision, one move at most; true if a page moved
+
+    SlabStats stats() const;
+    size_t size() const;
+
+private:
+    static constexpr uint32_t kLinked    = 0x51AB17E5;   // Item::state while in the cache
+    static constexpr size_t   kMoveBatch = 64;            // Items evicted per lock hold during a move
+
+    // 48-byte header, then the key bytes, then the value bytes
+    struct Item {
+        uint32_t state;                        // kLinked; SlabAllocator's free marker otherwise
+        uint32_t hash;
+        uint32_t keyLen;
+        uint32_t valueLen;
+        Item*    prev;                         // Class LRU, front = most recent
+        Item*    next;
+        Item*    hnext;                        // Hash chain
+        uint64_t stamp;                        // Last access, cache-wide clock
+        char*  key()         { return reinterpret_cast<char*>(this + 1); }
+        char*  value()       { return key() + keyLen; }
+        size_t bytes() const { return sizeof(Item) + keyLen + valueLen; }
+    };
+
+    struct ClassLru {
+        Item*    head{nullptr};
+        Item*    tail{nullptr};
+        size_t   items{0};
+        size_t   requested{0};
+        uint64_t evictions{0};
+        uint64_t outOfMemory{0};
+        uint64_t windowPressure{0};            // Evictions + failed stores since the last decision
+        uint64_t windowFailed{0};              // Failed stores alone
+    };
+
+    static uint32_t hashOf(const Key& key);
+    Item** findSlot(const std::string& keyBytes, uint32_t hash);  // The link pointing at the item, or the chain's end
+    void   linkFront(uint32_t cls, Item* it);
+    void   unlinkLru(uint32_t cls, Item* it);
+    void   unlink(Item* it);                   // Out of hash + LRU, chunk freed
+    void   evictTail(uint32_t cls);
+    Item*  allocateItem(uint32_t cls);         // Evicts within cls when needed; nullptr if it can't
+    void   grow();
+    void   notePressure(uint32_t cls);
+    bool   pickMove(uint32_t& from, uint32_t& to, size_t& page);   // mutex_ held
+
+private:
+    SlabOptions          options_;
+    SlabAllocator        slabs_;
+    std::vector<ClassLru> lru_;
+    std::vector<Item*>   buckets_;             // Power of two
+    size_t               items_{0};
+    uint64_t             clock_{0};
+    uint64_t             hits_{0};
+    uint64_t             misses_{0};
+    uint64_t             windowEvictions_{0};
+    uint64_t             pagesMoved_{0};
+    uint64_t             moveEvictions_{0};
+    uint64_t             tooLarge_{0};
+    std::mutex           moveMutex_;           // One page move at a time
+    mutable Lock         mutex_;
+
+    std::shared_ptr<MaintenanceExecutor> executor_;
+    MaintenanceExecutor::TaskId          taskId_{0};           // Registered last, removed first
+};
+
+} // namespace Cache
+
+#include "../src/SlabCache.tpp"
@@ -0,0 +1,147 @@
+#pragma once
+
+// =========================================================
+//  TagIndex.h —— tag → entries, for group invalidation
+//  ---------------------------------------------------------
+//      cache.put(key, value, {"user:42", "tenant:7"});
+//      cache.invalidateTag("user:42");    // every member, one
+//                                         // lock hold per shard
+//
+//  Each tag is interned to a small id and owns a dense vector
+//  of its members (pointers to the cache's own nodes). Each
+//  node carries its TagLinks: {tag id, position in that tag's
+//  vector} per tag. So:
+//    - tagging an entry appends to the vectors (O(#tags))
+//    - an entry leaving the cache for any reason (eviction,
+//      remove, compute, invalidation) swap-removes itself from
+//      each of its tags, fixing the moved member's position
+//      (O(#tags), no search, no stale members left behind)
+//    - invalidating a tag walks its vector from the back, so
+//      each member's own unlink is a pop_back
+//  An untagged entry costs an empty vector and nothing else.
+//  A tag whose last member leaves gives its id back.
+//
+//  Member: a node pointer that stays valid while the entry is
+//  in the cache. LinksOf: stateless functor, Member → its
+//  TagLinks&. Not thread-safe: the owning cache calls it under
+//  its own lock.
+// =========================================================
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace Cache {
+
+using CacheTag = std::string;   // Tag type the caches accept
+
+struct TagLink {
+    uint32_t tag;   // Interned tag id
+    uint32_t pos;   // Index in that tag's member vector
+};
+using TagLinks = std::vector<TagLink>;
+
+template<typename Member, typename LinksOf, typename Tag = CacheTag>
+class TagIndex {
+public:
+    // Replace m's tags with tags (duplicates are ignored)
+    void assign(Member m, const std::vector<Tag>& tags) {
+        detach(m);
+        TagLinks& links = LinksOf{}(m);
+        for (const Tag& tag : tags) {
+            const uint32_t id = intern(tag);
+            bool dup = false;
+            for (const TagLink& l : links) dup |= l.tag == id;
+            if (dup) continue;
+            links.push_back({id, static_cast<uint32_t>(slots_[id].members.size())});
+            slots_[id].members.push_back(m);
+        }
+    }
+
+    // m leaves the cache: take it out of every tag it carries
+    void detach(Member m) {
+        TagLinks& links = LinksOf{}(m);
+        for (const TagLink& l : links) {
+            Slot& slot = slots_[l.tag];
+            Member last = slot.members.back();
+            if (last != m) {
+                slot.members[l.pos] = last;
+                for (TagLink& other : LinksOf{}(last)) {
+                    if (other.tag == l.tag) { other.pos = l.pos; break; }
+                }
+            }
+            slot.members.pop_back();
+            if (slot.members.empty()) release(l.tag);
+        }
+        links.clear();
+    }
+
+    // Calls remove(member) for every member of tag, last first; remove
+    // must take the member out of the cache, which detaches it here.
+    // Returns how many members were removed
+    template<typename Remove>
+    size_t removeAll(const Tag& tag, Remove&& remove) {
+        auto it = ids_.find(tag);
+        if (it == ids_.end()) return 0;
+        Slot& slot = slots_[it->second];            // detach never grows slots_
+        size_t n = 0;
+        while (!slot.members.empty()) {
+            remove(slot.members.back());
+            ++n;
+        }
+        return n;
+    }
+
+    size_t members(const Tag& tag) const {
+        auto it = ids_.find(tag);
+        return it == ids_.end() ? 0 : slots_[it->second].members.size();
+    }
+
+    size_t tags() const { return ids_.size(); }
+
+    void swap(TagIndex& other) {
+        ids_.swap(other.ids_);
+        slots_.swap(other.slots_);
+        free_.swap(other.free_);
+    }
+
+private:
+    struct Slot {
+        Tag                 tag;
+        std::vector<Member> members;
+    };
+
+    uint32_t intern(const Tag& tag) {
+        auto it = ids_.find(tag);
+        if (it != ids_.end()) return it->second;
+        uint32_t id;
+        if (!free_.empty()) {
+            id = free_.back();
+            free_.pop_back();
+            slots_[id].tag = tag;
+        } else {
+            id = static_cast<uint32_t>(slots_.size());
+            slots_.push_back(Slot{tag, {}});
+        }
+        ids_.emplace(tag, id);
+        return id;
+    }
+
+    // Last member gone: forget the tag and reuse its id
+    void release(uint32_t id) {
+        Slot& slot = slots_[id];
+        ids_.erase(slot.tag);
+        std::vector<Member>().swap(slot.members);
+        slot.tag = Tag{};
+        free_.push_back(id);
+    }
+
+    std::unordered_map<Tag, uint32_t> ids_;
+    std::vector<Slot>                 slots_;   // Indexed by tag id
+    std::vector<uint32_t>             free_;    // Released ids
+};
+
+} // namespace Cache
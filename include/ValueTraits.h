@@ -0,0 +1,57 @@
+#pragma once
+
+// =========================================================
+//  ValueTraits.h —— how a value is flattened into raw bytes
+//  ---------------------------------------------------------
+//  Storage that keeps values outside the C++ heap (see
+//  OffHeapArena.h) only sees bytes. ValueTraits<V> says how
+//  many bytes a value needs and how to copy it in and out:
+//
+//      static size_t size(const V& v);
+//      static void   write(const V& v, char* dst);         // size(v) bytes
+//      static void   read(const char* src, size_t n, V& out);
+//
+//  Provided: trivially copyable types (memcpy), std::string,
+//  and std::vector of a trivially copyable type. read()
+//  assigns into out, so a string or vector reused across
+//  reads keeps its capacity. Specialize for anything else.
+// =========================================================
+
+#include <cstddef>
+#include <cstring>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace Cache {
+
+template<typename V, typename = void>
+struct ValueTraits;   // No default: a type must be flat or have a specialization
+
+template<typename V>
+struct ValueTraits<V, std::enable_if_t<std::is_trivially_copyable<V>::value>> {
+    static size_t size(const V&) { return sizeof(V); }
+    static void write(const V& v, char* dst) { std::memcpy(dst, &v, sizeof(V)); }
+    static void read(const char* src, size_t, V& out) { std::memcpy(&out, src, sizeof(V)); }
+};
+
+template<>
+struct ValueTraits<std::string> {
+    static size_t size(const std::string& v) { return v.size(); }
+    static void write(const std::string& v, char* dst) { std::memcpy(dst, v.data(), v.size()); }
+    static void read(const char* src, size_t n, std::string& out) { out.assign(src, n); }
+};
+
+template<typename T>
+struct ValueTraits<std::vector<T>, std::enable_if_t<std::is_trivially_copyable<T>::value>> {
+    static size_t size(const std::vector<T>& v) { return v.size() * sizeof(T); }
+    static void write(const std::vector<T>& v, char* dst) {
+        if (!v.empty()) std::memcpy(dst, v.data(), v.size() * sizeof(T));
+    }
+    static void read(const char* src, size_t n, std::vector<T>& out) {
+        out.resize(n / sizeof(T));
+        if (n) std::memcpy(out.data(), src, n);
+    }
+};
+
+} // namespace Cache
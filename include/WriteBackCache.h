@@ -0,0 +1,105 @@
+#pragma once
+
+// =========================================================
+//  WriteBackCache: an LruCache that buffers writes
+//  ---------------------------------------------------------
+//  put() updates the cache and marks the key dirty; a
+//  background flusher writes dirty entries to the
+//  BackingStore in batches. Repeated puts to a key between
+//  flushes reach the store once (write coalescing).
+//
+//  - The flusher runs when the oldest dirty entry reaches
+//    maxDirtyAge or when flushBatch entries are dirty. Each
+//    run takes every dirty entry and writes it in
+//    flushBatch-sized writeBatch calls.
+//  - Past maxDirtyEntries, put flushes inline (backpressure).
+//    put() never throws a store error: a failed inline flush
+//    is counted in flushErrors() and retried like any other.
+//  - Dirty values live in their own map until written, so an
+//    evicted dirty key is still served by get() and is written
+//    with the next batch; the LRU only decides what stays hot.
+//    A miss everywhere reads the store and fills the cache.
+//  - A writeBatch that throws puts the entries back (newer
+//    puts win) and the next run retries; flush() rethrows.
+//  - The destructor stops the flusher and flushes the rest.
+// =========================================================
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+
+#include "BackingStore.h"
+#include "LruCache.h"
+
+namespace Cache {
+
+struct WriteBackOptions {
+    std::chrono::milliseconds maxDirtyAge{50};   // A dirty entry reaches the store within about this long
+    size_t flushBatch{256};                      // Entries per writeBatch; this many dirty wakes the flusher
+    size_t maxDirtyEntries{16384};               // put flushes inline beyond this
+};
+
+template<typename Key, typename Value>
+class WriteBackCache {
+public:
+    WriteBackCache(int capacity, std::shared_ptr<BackingStore<Key, Value>> store,
+                   WriteBackOptions options = WriteBackOptions{});
+    ~WriteBackCache();
+
+    WriteBackCache(const WriteBackCache&) = delete;
+    WriteBackCache& operator=(const WriteBackCache&) = delete;
+
+    void put(const Key& key, const Value& value);   // Cache + mark dirty; the store is written later
+    bool get(const Key& key, Value& value);         // Cache → dirty → store (read-through)
+    void flush();                                   // Write every dirty entry now
+
+    size_t dirtyCount() const;
+
+    // ---- Statistics ----
+    size_t puts() const           { return puts_.load(std::memory_order_relaxed); }
+    size_t flushedEntries() const { return flushedEntries_.load(std::memory_order_relaxed); }
+    size_t flushRuns() const      { return flushRuns_.load(std::memory_order_relaxed); }
+    size_t evictedDirty() const   { return evictedDirty_.load(std::memory_order_relaxed); }  // Left the LRU before their flush
+    size_t flushErrors() const    { return flushErrors_.load(std::memory_order_relaxed); }
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    void onRemoval(RemovalBatch<Key, Value>& batch);   // LRU listener; dirtyMutex_ is held
+    bool flushDue(Clock::time_point now) const;        // dirtyMutex_ held
+    void flusherLoop();
+
+private:
+    std::shared_ptr<BackingStore<Key, Value>> store_;
+    WriteBackOptions options_;
+
+    // Every cache_.put happens under dirtyMutex_, so evictions are
+    // reported to onRemoval on the putting thread with it held
+    mutable std::mutex dirtyMutex_;
+    std::unordered_map<Key, Value> dirty_;      // Written since the last flush began
+    std::unordered_map<Key, Value> inFlight_;   // Being written by the current flush
+    Clock::time_point dirtySince_{};            // When dirty_ last became non-empty
+    size_t writeEpoch_{0};                      // Bumped by every put: read-through fill check
+    bool   wakeRequested_{false};               // Flusher already signalled for this batch
+
+    std::mutex flushMutex_;                     // One flush at a time
+    std::condition_variable flusherCv_;
+    bool stop_{false};                          // Guarded by dirtyMutex_
+
+    std::atomic<size_t> puts_{0};
+    std::atomic<size_t> flushedEntries_{0};
+    std::atomic<size_t> flushRuns_{0};
+    std::atomic<size_t> evictedDirty_{0};
+    std::atomic<size_t> flushErrors_{0};
+
+    LruCache<Key, Value> cache_;                // Its listener points back here
+    std::thread flusher_;                       // Last: started once everything above exists
+};
+
+} // namespace Cache
+
+#include "../src/WriteBackCache.tpp"
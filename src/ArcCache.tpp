@@ -6,36 +6,72 @@
 namespace Cache {
 
 // ===== Construction / Basics =====
-template <typename Key, typename Value>
-ArcCache<Key, Value>::ArcCache(size_t capacity)
+template <typename Key, typename Value, typename Lock>
+ArcCache<Key, Value, Lock>::ArcCache(size_t capacity)
     : capacity_(capacity), p_(0) {
     // capacity_ can be 0 (all misses); p_ dynamically changes within [0, capacity_]
 }
 
-template <typename Key, typename Value>
-void ArcCache<Key, Value>::clear() {
-    std::lock_guard<std::mutex> lk(mtx_);
-    t1_.clear(); t2_.clear(); b1_.clear(); b2_.clear();
-    map_.clear(); b1_map_.clear(); b2_map_.clear();
-    p_ = 0;
+// O(1) under the lock whatever the size: the containers are swapped into
+// a retired generation that later get / put calls destroy in batches,
+// off the lock (see GenerationReclaimer.h)
+template <typename Key, typename Value, typename Lock>
+void ArcCache<Key, Value, Lock>::clear() {
+    auto old = std::make_shared<Retired>();
+    {
+        std::lock_guard<Lock> lk(mtx_);
+        t1_.swap(old->t1); t2_.swap(old->t2); b1_.swap(old->b1); b2_.swap(old->b2);
+        map_.swap(old->map); b1_map_.swap(old->b1Map); b2_map_.swap(old->b2Map);
+        p_ = 0;
+    }
+    reclaimer_.retire([old](size_t max) {
+        size_t n = drainSome(old->map, max);
+        n += drainSome(old->t1, max - n);
+        n += drainSome(old->t2, max - n);
+        n += drainSome(old->b1Map, max - n);
+        n += drainSome(old->b2Map, max - n);
+        n += drainSome(old->b1, max - n);
+        n += drainSome(old->b2, max - n);
+        return n;
+    });
 }
 
-template <typename Key, typename Value>
-size_t ArcCache<Key, Value>::size() const {
-    std::lock_guard<std::mutex> lk(mtx_);
+template <typename Key, typename Value, typename Lock>
+size_t ArcCache<Key, Value, Lock>::size() const {
+    ReadGuard<Lock> lk(mtx_);
     return t1_.size() + t2_.size();
 }
 
-template <typename Key, typename Value>
-bool ArcCache<Key, Value>::contains(const Key& key) const {
-    std::lock_guard<std::mutex> lk(mtx_);
+template <typename Key, typename Value, typename Lock>
+bool ArcCache<Key, Value, Lock>::contains(const Key& key) const {
+    ReadGuard<Lock> lk(mtx_);
     return map_.find(key) != map_.end();
 }
 
 // ===== CachePolicy interface: get / put =====
-template <typename Key, typename Value>
-bool ArcCache<Key, Value>::get(const Key& key, Value& out) {
-    std::lock_guard<std::mutex> lk(mtx_);
+// After the unlock, each call tears down a slice of a cleared generation
+template <typename Key, typename Value, typename Lock>
+bool ArcCache<Key, Value, Lock>::get(const Key& key, Value& out) {
+    bool hit;
+    {
+        std::lock_guard<Lock> lk(mtx_);
+        hit = getLocked(key, out);
+    }
+    reclaimer_.step(kReclaimBatch);
+    return hit;
+}
+
+template <typename Key, typename Value, typename Lock>
+void ArcCache<Key, Value, Lock>::put(const Key& key, const Value& value) {
+    {
+        std::lock_guard<Lock> lk(mtx_);
+        putLocked(key, value);
+    }
+    reclaimer_.step(kReclaimBatch);
+}
+
+template <typename Key, typename Value, typename Lock>
+bool ArcCache<Key, Value, Lock>::getLocked(const Key& key, Value& out) {
 
     // Hit in T1/T2: move to T2's MRU
     if (auto it = map_.find(key); it != map_.end()) {
@@ -71,16 +107,15 @@ bool ArcCache<Key, Value>::get(const Key& key, Value& out) {
     return false;
 }
 
-template <typename Key, typename Value>
-Value ArcCache<Key, Value>::get(const Key& key) {
+template <typename Key, typename Value, typename Lock>
+Value ArcCache<Key, Value, Lock>::get(const Key& key) {
     Value v{};
     get(key, v);
     return v;
 }
 
-template <typename Key, typename Value>
-void ArcCache<Key, Value>::put(const Key& key, const Value& value) {
-    std::lock_guard<std::mutex> lk(mtx_);
+template <typename Key, typename Value, typename Lock>
+void ArcCache<Key, Value, Lock>::putLocked(const Key& key, const Value& value) {
 
     // Already in T1/T2: update and move to T2
     if (auto it = map_.find(key); it != map_.end()) {
@@ -146,8 +181,8 @@ void ArcCache<Key, Value>::put(const Key& key, const Value& value) {
 }
 
 // ===== Core replacement =====
-template <typename Key, typename Value>
-void ArcCache<Key, Value>::replace(bool hit_in_b1) {
+template <typename Key, typename Value, typename Lock>
+void ArcCache<Key, Value, Lock>::replace(bool hit_in_b1) {
     // If T1 has extra (or B1 hit and T1 reaches quota) → evict T1.LRU to B1
     if (!t1_.empty() && (t1_.size() > p_ || (hit_in_b1 && t1_.size() == p_))) {
         evictFromT1ToB1();
@@ -157,8 +192,8 @@ void ArcCache<Key, Value>::replace(bool hit_in_b1) {
     }
 }
 
-template <typename Key, typename Value>
-void ArcCache<Key, Value>::evictFromT1ToB1() {
+template <typename Key, typename Value, typename Lock>
+void ArcCache<Key, Value, Lock>::evictFromT1ToB1() {
     const Key victim = t1_.back();
     t1_.pop_back();
 
@@ -175,8 +210,8 @@ void ArcCache<Key, Value>::evictFromT1ToB1() {
     trimGhost(b1_, b1_map_);
 }
 
-template <typename Key, typename Value>
-void ArcCache<Key, Value>::evictFromT2ToB2() {
+template <typename Key, typename Value, typename Lock>
+void ArcCache<Key, Value, Lock>::evictFromT2ToB2() {
     if (t2_.empty()) {
         // Corner case: T1 is empty, can only evict from T2; if T2 is also empty, nothing to do
         return;
@@ -198,8 +233,8 @@ void ArcCache<Key, Value>::evictFromT2ToB2() {
 }
 
 // ===== p's adaptive adjustment =====
-template <typename Key, typename Value>
-void ArcCache<Key, Value>::adjustPOnB1Hit() {
+template <typename Key, typename Value, typename Lock>
+void ArcCache<Key, Value, Lock>::adjustPOnB1Hit() {
     // Classic approximation: p += max(1, |B2|/|B1|)
     size_t b1s = b1_.size();
     size_t b2s = b2_.size();
@@ -207,8 +242,8 @@ void ArcCache<Key, Value>::adjustPOnB1Hit() {
     p_ = std::min(capacity_, p_ + delta);
 }
 
-template <typename Key, typename Value>
-void ArcCache<Key, Value>::adjustPOnB2Hit() {
+template <typename Key, typename Value, typename Lock>
+void ArcCache<Key, Value, Lock>::adjustPOnB2Hit() {
     // Classic approximation: p -= max(1, |B1|/|B2|)
     size_t b1s = b1_.size();
     size_t b2s = b2_.size();
@@ -217,8 +252,8 @@ void ArcCache<Key, Value>::adjustPOnB2Hit() {
 }
 
 // ===== List/index operations =====
-template <typename Key, typename Value>
-void ArcCache<Key, Value>::moveToT2(const Key& key) {
+template <typename Key, typename Value, typename Lock>
+void ArcCache<Key, Value, Lock>::moveToT2(const Key& key) {
     auto it = map_.find(key);
     if (it == map_.end()) return;
 
@@ -234,20 +269,20 @@ void ArcCache<Key, Value>::moveToT2(const Key& key) {
     it->second.tag = ListTag::T2;
 }
 
-template <typename Key, typename Value>
-void ArcCache<Key, Value>::addToT1MRU(const Key& key, const Value& val) {
+template <typename Key, typename Value, typename Lock>
+void ArcCache<Key, Value, Lock>::addToT1MRU(const Key& key, const Value& val) {
     auto iter = attachFront(t1_, key);
     map_[key] = Entry{val, ListTag::T1, iter};
 }
 
-template <typename Key, typename Value>
-void ArcCache<Key, Value>::addToT2MRU(const Key& key, const Value& val) {
+template <typename Key, typename Value, typename Lock>
+void ArcCache<Key, Value, Lock>::addToT2MRU(const Key& key, const Value& val) {
     auto iter = attachFront(t2_, key);
     map_[key] = Entry{val, ListTag::T2, iter};
 }
 
-template <typename Key, typename Value>
-void ArcCache<Key, Value>::trimGhost(
+template <typename Key, typename Value, typename Lock>
+void ArcCache<Key, Value, Lock>::trimGhost(
     std::list<Key>& blist,
     std::unordered_map<Key, typename std::list<Key>::iterator>& bmap) {
 
@@ -260,15 +295,15 @@ void ArcCache<Key, Value>::trimGhost(
 }
 
 // Utility: push_front / erase by iterator
-template <typename Key, typename Value>
+template <typename Key, typename Value, typename Lock>
 typename std::list<Key>::iterator
-ArcCache<Key, Value>::attachFront(std::list<Key>& lst, const Key& key) {
+ArcCache<Key, Value, Lock>::attachFront(std::list<Key>& lst, const Key& key) {
     lst.push_front(key);
     return lst.begin();
 }
 
-template <typename Key, typename Value>
-void ArcCache<Key, Value>::detach(std::list<Key>& lst, typename std::list<Key>::iterator it) {
+template <typename Key, typename Value, typename Lock>
+void ArcCache<Key, Value, Lock>::detach(std::list<Key>& lst, typename std::list<Key>::iterator it) {
     lst.erase(it);
 }
 
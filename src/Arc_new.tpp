@@ -4,34 +4,85 @@
 namespace Cache {
 
 // ===== Construction / Basics =====
-template <typename Key, typename Value>
-void Arc_new<Key, Value>::clear() {
-    std::lock_guard<std::mutex> lk(mtx_);
-    t1_.clear(); t2_.clear(); b1_.clear(); b2_.clear();
-    map_.clear(); b1_map_.clear(); b2_map_.clear();
-    p_ = 0;
+// O(1) under the lock whatever the size: the containers are swapped
+// into a retired generation, which is unreachable from then on. Its
+// entries are destroyed in batches off the lock, by the maintenance
+// task if there is one and by later get / put calls otherwise; a
+// listener hears about each of them (Explicit) as it goes
+template <typename Key, typename Value, typename Lock>
+void Arc_new<Key, Value, Lock>::clear() {
+    auto old = std::make_shared<Retired>();
+    {
+        std::lock_guard<Lock> lk(mtx_);
+        t1_.swap(old->t1); t2_.swap(old->t2); b1_.swap(old->b1); b2_.swap(old->b2);
+        map_.swap(old->map); b1_map_.swap(old->b1Map); b2_map_.swap(old->b2Map);
+        tags_.swap(old->tags);
+        p_ = 0;
+        pins_.clear();
+        prioStats_.entries = {};
+    }
+    reclaimer_.retire([this, old](size_t max) { return reclaimSome(*old, max); });
+    if (maintenance_.enabled()) maintenance_.request();
 }
 
-template <typename Key, typename Value>
-size_t Arc_new<Key, Value>::size() const {
-    std::lock_guard<std::mutex> lk(mtx_);
-    return t1_.size() + t2_.size();
+// Values first (they may go to the listener), then the key lists
+template <typename Key, typename Value, typename Lock>
+size_t Arc_new<Key, Value, Lock>::reclaimSome(Retired& old, size_t max) {
+    size_t n = 0;
+    if (removal_.enabled()) {
+        RemovalBatch<Key, Value> notes;
+        for (; n < max && !old.map.empty(); ++n) {
+            auto it = old.map.begin();
+            notes.push_back({it->first, std::move(it->second.value), RemovalCause::Explicit});
+            old.map.erase(it);
+        }
+        removal_.deliver(notes);
+    } else {
+        n += drainSome(old.map, max);
+    }
+    for (size_t t = 0; t < kPriorities; ++t) {
+        n += drainSome(old.t1.tier(static_cast<Priority>(t)), max - n);
+        n += drainSome(old.t2.tier(static_cast<Priority>(t)), max - n);
+    }
+    n += drainSome(old.b1Map, max - n);
+    n += drainSome(old.b2Map, max - n);
+    n += drainSome(old.b1, max - n);
+    n += drainSome(old.b2, max - n);
+    return n;
 }
 
-template <typename Key, typename Value>
-bool Arc_new<Key, Value>::contains(const Key& key) const {
-    std::lock_guard<std::mutex> lk(mtx_);
+template <typename Key, typename Value, typename Lock>
+size_t Arc_new<Key, Value, Lock>::size() const {
+    ReadGuard<Lock> lk(mtx_);
+    return resident();
+}
+
+template <typename Key, typename Value, typename Lock>
+bool Arc_new<Key, Value, Lock>::contains(const Key& key) const {
+    ReadGuard<Lock> lk(mtx_);
     return map_.find(key) != map_.end();
 }
 
 // ===== CachePolicy interface: get / put =====
-template <typename Key, typename Value>
-bool Arc_new<Key, Value>::get(const Key& key, Value& out) {
-    std::lock_guard<std::mutex> lk(mtx_);
+template <typename Key, typename Value, typename Lock>
+bool Arc_new<Key, Value, Lock>::get(const Key& key, Value& out) {
+    Removed removed;            // A ghost hit evicts; the victim dies after the unlock
+    bool hit;
+    {
+        std::lock_guard<Lock> lk(mtx_);
+        hit = getLocked(key, out, removed);
+    }
+    removal_.deliver(removed.notes);
+    if (!maintenance_.enabled()) reclaimer_.step(kReclaimBatch);
+    return hit;
+}
 
+template <typename Key, typename Value, typename Lock>
+bool Arc_new<Key, Value, Lock>::getLocked(const Key& key, Value& out, Removed& removed) {
     // Hit in T1/T2: move to T2's MRU
     if (auto it = map_.find(key); it != map_.end()) {
         out = it->second.value;
+        ++prioStats_.hits[tierOf(it->second.priority)];
         moveToT2(key);
         return true;
     }
@@ -44,7 +95,7 @@ bool Arc_new<Key, Value>::get(const Key& key, Value& out) {
         b1_map_.erase(b1it);
 
         adjustPOnB1Hit();
-        replace(true /*hit_in_b1*/);
+        replace(true /*hit_in_b1*/, &removed);
         return false; // Requires upper layer to load then put
     }
     if (auto b2it = b2_map_.find(key); b2it != b2_map_.end()) {
@@ -53,7 +104,7 @@ bool Arc_new<Key, Value>::get(const Key& key, Value& out) {
         b2_map_.erase(b2it);
 
         adjustPOnB2Hit();
-        replace(false /*hit_in_b1*/);
+        replace(false /*hit_in_b1*/, &removed);
         return false; // Same as above
     }
 
@@ -61,20 +112,209 @@ bool Arc_new<Key, Value>::get(const Key& key, Value& out) {
     return false;
 }
 
-template <typename Key, typename Value>
-Value Arc_new<Key, Value>::get(const Key& key) {
+template <typename Key, typename Value, typename Lock>
+Value Arc_new<Key, Value, Lock>::get(const Key& key) {
     Value v{};
     get(key, v);
     return v;
 }
 
-template <typename Key, typename Value>
-void Arc_new<Key, Value>::put(const Key& key, const Value& value) {
-    std::lock_guard<std::mutex> lk(mtx_);
+// The value is copied before locking and only moved/swapped under mtx_;
+// the victim (or the overwritten value, left in `fresh`) is destroyed
+// after the unlock, once removal notifications are delivered. Combining
+// mode: the request may be applied by whichever thread holds mtx_
+template <typename Key, typename Value, typename Lock>
+void Arc_new<Key, Value, Lock>::put(const Key& key, const Value& value) {
+    putWith(key, value, PutOptions{});
+}
+
+// Same as put; the tags replace whatever the entry carried before
+template <typename Key, typename Value, typename Lock>
+void Arc_new<Key, Value, Lock>::put(const Key& key, const Value& value, const std::vector<Tag>& tags) {
+    putWith(key, value, PutOptions{&tags, nullptr});
+}
+
+// Same as put; the entry moves to the given tier
+template <typename Key, typename Value, typename Lock>
+void Arc_new<Key, Value, Lock>::put(const Key& key, const Value& value, Priority priority) {
+    putWith(key, value, PutOptions{nullptr, &priority});
+}
+
+template <typename Key, typename Value, typename Lock>
+void Arc_new<Key, Value, Lock>::putWith(const Key& key, const Value& value, const PutOptions& opts) {
+    Value fresh(value);
+    Removed removed;
+    if (combiner_) {
+        combiner_->execute(mtx_, PutRequest{&key, &fresh, &removed, opts},
+                           [this](const PutRequest& r) { putLocked(*r.key, *r.value, *r.removed, r.opts); });
+    } else {
+        std::lock_guard<Lock> lk(mtx_);
+        putLocked(key, fresh, removed, opts);
+    }
+    removal_.deliver(removed.notes);
+    if (!maintenance_.enabled()) reclaimer_.step(kReclaimBatch);
+}
+
+template <typename Key, typename Value, typename Lock>
+PriorityStats Arc_new<Key, Value, Lock>::priorityStats() const {
+    ReadGuard<Lock> lk(mtx_);
+    return prioStats_;
+}
+
+// One lock hold for the whole group. Each member goes like a compute()
+// removal: out of T1/T2 (or out of the pin table), no ghost left behind
+template <typename Key, typename Value, typename Lock>
+size_t Arc_new<Key, Value, Lock>::invalidateTag(const Tag& tag) {
+    Removed removed;
+    size_t n;
+    {
+        std::lock_guard<Lock> lk(mtx_);
+        n = tags_.removeAll(tag, [&](Slot* slot) {
+            Entry& entry = slot->second;
+            if (entry.pinId) pins_.drop(entry.pinId);
+            else listOf(entry.tag).erase(entry.priority, entry.it);
+            tags_.detach(slot);
+            forgetEntry(entry);
+            retire(slot->first, std::move(entry.value), RemovalCause::Explicit, removed);
+            map_.erase(map_.find(slot->first));      // The key lives in the node being erased
+        });
+    }
+    removal_.deliver(removed.notes);
+    return n;
+}
+
+template <typename Key, typename Value, typename Lock>
+size_t Arc_new<Key, Value, Lock>::tagSize(const Tag& tag) const {
+    ReadGuard<Lock> lk(mtx_);
+    return tags_.members(tag);
+}
+
+// One lock hold and one probe on a hit: fn runs on the entry's value
+// itself. Bypasses the combiner, whose batches take the same mtx_
+template <typename Key, typename Value, typename Lock>
+template <typename F>
+bool Arc_new<Key, Value, Lock>::compute(const Key& key, F&& fn) {
+    Removed removed;
+    bool present;
+    {
+        std::lock_guard<Lock> lk(mtx_);
+        if (auto it = map_.find(key); it != map_.end()) {
+            Entry& entry = it->second;
+            ++prioStats_.hits[tierOf(entry.priority)];
+            present = fn(entry.value, true);
+            if (!entry.pinId) listOf(entry.tag).erase(entry.priority, entry.it);
+            if (present) {
+                if (!entry.pinId) entry.it = t2_.pushFront(entry.priority, key);   // moveToT2 without a second probe
+                entry.tag = ListTag::T2;
+            } else {
+                if (entry.pinId) pins_.drop(entry.pinId);
+                if (!entry.tags.empty()) tags_.detach(&*it);
+                forgetEntry(entry);
+                retire(key, std::move(entry.value), RemovalCause::Explicit, removed);
+                map_.erase(it);
+            }
+        } else {
+            Value value{};
+            present = fn(value, false) && capacity_ > 0;
+            if (present) putLocked(key, value, removed);
+        }
+    }
+    removal_.deliver(removed.notes);
+    return present;
+}
+
+// The first lease takes the entry out of T1/T2, so replace() and the
+// maintenance task never reach it. It keeps its tag and still counts
+// towards capacity (resident())
+template <typename Key, typename Value, typename Lock>
+typename Arc_new<Key, Value, Lock>::PinLease Arc_new<Key, Value, Lock>::pin(const Key& key) {
+    Value value;
+    uint64_t pinId;
+    {
+        std::lock_guard<Lock> lk(mtx_);
+        auto it = map_.find(key);
+        if (it == map_.end()) return PinLease();
+        Entry& entry = it->second;
+        if (entry.pinId) {
+            pinId = entry.pinId;
+            pins_.addRef(pinId);
+        } else {
+            pinId = pins_.acquire(key, entry.value);
+            if (!pinId) return PinLease();     // Over the pinned-bytes budget
+            listOf(entry.tag).erase(entry.priority, entry.it);
+            entry.pinId = pinId;
+        }
+        value = entry.value;
+    }
+    return PinLease(this, key, std::move(value), pinId);
+}
+
+// Back at the MRU end of the list it is tagged with; a stale pin id releases nothing
+template <typename Key, typename Value, typename Lock>
+void Arc_new<Key, Value, Lock>::unpin(const Key& key, uint64_t pinId) {
+    std::lock_guard<Lock> lk(mtx_);
+    auto it = map_.find(key);
+    if (it == map_.end() || it->second.pinId != pinId) return;
+    if (!pins_.release(pinId)) return;
+    Entry& entry = it->second;
+    entry.pinId = 0;
+    entry.it = listOf(entry.tag).pushFront(entry.priority, key);
+}
+
+template <typename Key, typename Value, typename Lock>
+void Arc_new<Key, Value, Lock>::setPinLimit(size_t maxPinnedBytes, Weigher weigher) {
+    std::lock_guard<Lock> lk(mtx_);
+    pins_.setLimit(maxPinnedBytes, std::move(weigher));
+}
+
+template <typename Key, typename Value, typename Lock>
+size_t Arc_new<Key, Value, Lock>::pinnedBytes() const {
+    ReadGuard<Lock> lk(mtx_);
+    return pins_.bytes();
+}
+
+template <typename Key, typename Value, typename Lock>
+size_t Arc_new<Key, Value, Lock>::combinedPasses() const {
+    return combiner_ ? combiner_->batchedPasses() : 0;
+}
+
+template <typename Key, typename Value, typename Lock>
+void Arc_new<Key, Value, Lock>::enableMaintenance(std::shared_ptr<MaintenanceExecutor> executor,
+                                                  size_t lowWatermark, size_t highWatermark) {
+    maintenance_.attach(std::move(executor), capacity_, lowWatermark, highWatermark,
+                        [this] { runMaintenance(); });
+}
+
+template <typename Key, typename Value, typename Lock>
+void Arc_new<Key, Value, Lock>::setRemovalListener(RemovalListener<Key, Value> listener,
+                                                   std::shared_ptr<MaintenanceExecutor> executor) {
+    removal_.set(std::move(listener), std::move(executor));
+}
+
+template <typename Key, typename Value, typename Lock>
+bool Arc_new<Key, Value, Lock>::replaceInline() const {
+    return !maintenance_.enabled() || resident() >= maintenance_.high();
+}
+
+template <typename Key, typename Value, typename Lock>
+void Arc_new<Key, Value, Lock>::scheduleIfOverCapacity() {
+    if (maintenance_.enabled() && resident() > capacity_)
+        maintenance_.request();
+}
+
+template <typename Key, typename Value, typename Lock>
+void Arc_new<Key, Value, Lock>::putLocked(const Key& key, Value& value, Removed& removed,
+                                          const PutOptions& opts) {
+    const std::vector<Tag>* tags = opts.tags;
+    const Priority priority = opts.priority ? *opts.priority : Priority::Normal;
 
     // Already in T1/T2: update and move to T2
     if (auto it = map_.find(key); it != map_.end()) {
-        it->second.value = value;
+        std::swap(it->second.value, value);
+        if (removal_.enabled())
+            removed.notes.push_back({key, std::move(value), RemovalCause::Replaced});
+        if (tags) tags_.assign(&*it, *tags);
+        if (opts.priority) setPriority(*it, priority);
         moveToT2(key);
         return;
     }
@@ -86,8 +326,10 @@ void Arc_new<Key, Value>::put(const Key& key, const Value& value) {
         b1_map_.erase(b1it);
 
         adjustPOnB1Hit();
-        replace(true);
-        addToT2MRU(key, value);
+        if (replaceInline()) replace(true, &removed);
+        Slot* slot = addToT2MRU(key, std::move(value), priority);
+        if (tags) tags_.assign(slot, *tags);
+        scheduleIfOverCapacity();
         return;
     }
     if (auto b2it = b2_map_.find(key); b2it != b2_map_.end()) {
@@ -96,8 +338,10 @@ void Arc_new<Key, Value>::put(const Key& key, const Value& value) {
         b2_map_.erase(b2it);
 
         adjustPOnB2Hit();
-        replace(false);
-        addToT2MRU(key, value);
+        if (replaceInline()) replace(false, &removed);
+        Slot* slot = addToT2MRU(key, std::move(value), priority);
+        if (tags) tags_.assign(slot, *tags);
+        scheduleIfOverCapacity();
         return;
     }
 
@@ -115,39 +359,56 @@ void Arc_new<Key, Value>::put(const Key& key, const Value& value) {
                 b1_.pop_back();
                 b1_map_.erase(tail);
             }
-        } else {
+            // Trimming B1 frees no real slot: still replace when T1+T2 is full
+            if (resident() >= capacity_ && replaceInline()) replace(false, &removed);
+        } else if (replaceInline()) {
             // |T1| == capacity_; handle via replace per ARC rules
-            replace(false);
+            replace(false, &removed);
         }
-    } else if (t1_.size() + t2_.size() >= capacity_) {
+    } else if (resident() >= capacity_ && replaceInline()) {
         // Real cache full: evict one from T1 or T2
-        replace(false);
+        replace(false, &removed);
     }
 
-    addToT1MRU(key, value);
+    Slot* slot = addToT1MRU(key, std::move(value), priority);
+    if (tags) tags_.assign(slot, *tags);
+    scheduleIfOverCapacity();
 }
 
 // ===== Core replacement =====
-template <typename Key, typename Value>
-void Arc_new<Key, Value>::replace(bool hit_in_b1) {
+// Only the lowest tier with resident entries is a candidate; inside it
+// the usual ARC choice, falling back to the other list when the chosen
+// one has nothing in that tier
+template <typename Key, typename Value, typename Lock>
+void Arc_new<Key, Value, Lock>::replace(bool hit_in_b1, Removed* removed) {
+    if (t1_.empty() && t2_.empty()) return;   // Only pinned entries left
+    const Priority tier = t1_.empty() ? t2_.lowest()
+                        : t2_.empty() ? t1_.lowest()
+                        : std::min(t1_.lowest(), t2_.lowest());
+    const bool inT1 = !t1_.tier(tier).empty(), inT2 = !t2_.tier(tier).empty();
+
     // If T1 has surplus (or B1 hit and T1 is at its quota) → evict T1.LRU to B1
-    if (!t1_.empty() && (t1_.size() > p_ || (hit_in_b1 && t1_.size() == p_))) {
-        evictFromT1ToB1();
+    if (inT1 && (!inT2 || t1_.size() > p_ || (hit_in_b1 && t1_.size() == p_))) {
+        evictFromT1ToB1(removed, tier);
     } else {
         // Otherwise evict T2.LRU to B2
-        evictFromT2ToB2();
+        evictFromT2ToB2(removed, tier);
     }
 }
 
-template <typename Key, typename Value>
-void Arc_new<Key, Value>::evictFromT1ToB1() {
-    if (t1_.empty()) return;
+template <typename Key, typename Value, typename Lock>
+void Arc_new<Key, Value, Lock>::evictFromT1ToB1(Removed* removed, Priority tier) {
+    if (t1_.tier(tier).empty()) return;
 
-    const Key victim = t1_.back();
-    t1_.pop_back();
+    const Key victim = t1_.tier(tier).back();
+    t1_.erase(tier, std::prev(t1_.tier(tier).end()));
+    ++prioStats_.evictions[tierOf(tier)];
 
     auto it = map_.find(victim);
     if (it != map_.end()) {
+        if (removed) retire(victim, std::move(it->second.value), RemovalCause::DemotedT1, *removed);
+        if (!it->second.tags.empty()) tags_.detach(&*it);
+        forgetEntry(it->second);
         map_.erase(it);
     }
 
@@ -159,15 +420,19 @@ void Arc_new<Key, Value>::evictFromT1ToB1() {
     trimGhost(b1_, b1_map_);
 }
 
-template <typename Key, typename Value>
-void Arc_new<Key, Value>::evictFromT2ToB2() {
-    if (t2_.empty()) return;
+template <typename Key, typename Value, typename Lock>
+void Arc_new<Key, Value, Lock>::evictFromT2ToB2(Removed* removed, Priority tier) {
+    if (t2_.tier(tier).empty()) return;
 
-    const Key victim = t2_.back();
-    t2_.pop_back();
+    const Key victim = t2_.tier(tier).back();
+    t2_.erase(tier, std::prev(t2_.tier(tier).end()));
+    ++prioStats_.evictions[tierOf(tier)];
 
     auto it = map_.find(victim);
     if (it != map_.end()) {
+        if (removed) retire(victim, std::move(it->second.value), RemovalCause::DemotedT2, *removed);
+        if (!it->second.tags.empty()) tags_.detach(&*it);
+        forgetEntry(it->second);
         map_.erase(it);
     }
 
@@ -179,9 +444,47 @@ void Arc_new<Key, Value>::evictFromT2ToB2() {
     trimGhost(b2_, b2_map_);
 }
 
+template <typename Key, typename Value, typename Lock>
+void Arc_new<Key, Value, Lock>::forgetEntry(const Entry& entry) {
+    --prioStats_.entries[tierOf(entry.priority)];
+}
+
+// With a listener the value travels in the notification, otherwise it is just buried
+template <typename Key, typename Value, typename Lock>
+void Arc_new<Key, Value, Lock>::retire(const Key& key, Value&& value, RemovalCause cause, Removed& removed) {
+    if (removal_.enabled()) removed.notes.push_back({key, std::move(value), cause});
+    else removed.values.bury(std::move(value));
+}
+
+// ===== Background maintenance =====
+// Cleared generations first, then eviction with replace(false)'s
+// choice (lowest tier first, falling back to whichever list has
+// entries there); stops early if only pinned entries are left.
+// Values are reported and destroyed off the lock.
+template <typename Key, typename Value, typename Lock>
+void Arc_new<Key, Value, Lock>::runMaintenance() {
+    maintenance_.beginRun();
+    while (reclaimer_.step(kMaintenanceBatch) > 0) {}   // Never under mtx_
+
+    Removed removed;
+    for (bool done = false; !done; ) {
+        {
+            std::lock_guard<Lock> lk(mtx_);
+            while (resident() > maintenance_.low() && !(t1_.empty() && t2_.empty()) &&
+                   removed.size() < kMaintenanceBatch) {
+                replace(false, &removed);
+            }
+            done = resident() <= maintenance_.low() || (t1_.empty() && t2_.empty());
+        }
+        removal_.deliver(removed.notes);
+        removed.notes.clear();
+        removed.values.clear();
+    }
+}
+
 // ===== Adaptive tuning of p =====
-template <typename Key, typename Value>
-void Arc_new<Key, Value>::adjustPOnB1Hit() {
+template <typename Key, typename Value, typename Lock>
+void Arc_new<Key, Value, Lock>::adjustPOnB1Hit() {
     // Common approximation: p += max(1, |B2|/|B1|)
     size_t b1s = b1_.size();
     size_t b2s = b2_.size();
@@ -189,8 +492,8 @@ void Arc_new<Key, Value>::adjustPOnB1Hit() {
     p_ = std::min(capacity_, p_ + delta);
 }
 
-template <typename Key, typename Value>
-void Arc_new<Key, Value>::adjustPOnB2Hit() {
+template <typename Key, typename Value, typename Lock>
+void Arc_new<Key, Value, Lock>::adjustPOnB2Hit() {
     // Common approximation: p -= max(1, |B1|/|B2|)
     size_t b1s = b1_.size();
     size_t b2s = b2_.size();
@@ -199,37 +502,58 @@ void Arc_new<Key, Value>::adjustPOnB2Hit() {
 }
 
 // ===== List / index operations =====
-template <typename Key, typename Value>
-void Arc_new<Key, Value>::moveToT2(const Key& key) {
+template <typename Key, typename Value, typename Lock>
+void Arc_new<Key, Value, Lock>::moveToT2(const Key& key) {
     auto it = map_.find(key);
     if (it == map_.end()) return;
+    if (it->second.pinId) {                  // Off the lists: unpin files it under T2
+        it->second.tag = ListTag::T2;
+        return;
+    }
 
     // Remove from the original list
-    if (it->second.tag == ListTag::T1) {
-        t1_.erase(it->second.it);
-    } else if (it->second.tag == ListTag::T2) {
-        t2_.erase(it->second.it);
-    }
+    Entry& entry = it->second;
+    if (entry.tag != ListTag::None) listOf(entry.tag).erase(entry.priority, entry.it);
+
+    // Insert at T2 MRU (of its tier)
+    entry.it = t2_.pushFront(entry.priority, key);
+    entry.tag = ListTag::T2;
+}
 
-    // Insert at T2 MRU
-    it->second.it = attachFront(t2_, key);
-    it->second.tag = ListTag::T2;
+// Pinned entries are off the lists: unpin relinks them in the new tier
+template <typename Key, typename Value, typename Lock>
+void Arc_new<Key, Value, Lock>::setPriority(Slot& slot, Priority priority) {
+    Entry& entry = slot.second;
+    if (entry.priority == priority) return;
+    --prioStats_.entries[tierOf(entry.priority)];
+    ++prioStats_.entries[tierOf(priority)];
+    if (!entry.pinId) {
+        listOf(entry.tag).erase(entry.priority, entry.it);
+        entry.it = listOf(entry.tag).pushFront(priority, slot.first);
+    }
+    entry.priority = priority;
 }
 
-template <typename Key, typename Value>
-void Arc_new<Key, Value>::addToT1MRU(const Key& key, const Value& val) {
-    auto iter = attachFront(t1_, key);
-    map_[key] = Entry{val, ListTag::T1, iter};
+template <typename Key, typename Value, typename Lock>
+typename Arc_new<Key, Value, Lock>::Slot* Arc_new<Key, Value, Lock>::addToT1MRU(const Key& key, Value&& val,
+                                                                               Priority priority) {
+    auto iter = t1_.pushFront(priority, key);
+    ++prioStats_.inserts[tierOf(priority)];
+    ++prioStats_.entries[tierOf(priority)];
+    return &*map_.insert_or_assign(key, Entry{std::move(val), ListTag::T1, iter, 0, {}, priority}).first;
 }
 
-template <typename Key, typename Value>
-void Arc_new<Key, Value>::addToT2MRU(const Key& key, const Value& val) {
-    auto iter = attachFront(t2_, key);
-    map_[key] = Entry{val, ListTag::T2, iter};
+template <typename Key, typename Value, typename Lock>
+typename Arc_new<Key, Value, Lock>::Slot* Arc_new<Key, Value, Lock>::addToT2MRU(const Key& key, Value&& val,
+                                                                               Priority priority) {
+    auto iter = t2_.pushFront(priority, key);
+    ++prioStats_.inserts[tierOf(priority)];
+    ++prioStats_.entries[tierOf(priority)];
+    return &*map_.insert_or_assign(key, Entry{std::move(val), ListTag::T2, iter, 0, {}, priority}).first;
 }
 
-template <typename Key, typename Value>
-void Arc_new<Key, Value>::trimGhost(
+template <typename Key, typename Value, typename Lock>
+void Arc_new<Key, Value, Lock>::trimGhost(
     std::list<Key>& blist,
     std::unordered_map<Key, typename std::list<Key>::iterator>& bmap) {
 
@@ -242,15 +566,15 @@ void Arc_new<Key, Value>::trimGhost(
 }
 
 // Helpers: push-front / erase
-template <typename Key, typename Value>
+template <typename Key, typename Value, typename Lock>
 typename std::list<Key>::iterator
-Arc_new<Key, Value>::attachFront(std::list<Key>& lst, const Key& key) {
+Arc_new<Key, Value, Lock>::attachFront(std::list<Key>& lst, const Key& key) {
     lst.push_front(key);
     return lst.begin();
 }
 
-template <typename Key, typename Value>
-void Arc_new<Key, Value>::detach(std::list<Key>& lst, typename std::list<Key>::iterator it) {
+template <typename Key, typename Value, typename Lock>
+void Arc_new<Key, Value, Lock>::detach(std::list<Key>& lst, typename std::list<Key>::iterator it) {
     lst.erase(it);
 }
 
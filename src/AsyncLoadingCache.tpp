@@ -0,0 +1,90 @@
+#pragma once
+#include "../include/AsyncLoadingCache.h"
+
+namespace Cache {
+
+// =============== AsyncLoadingCache implementation =============== //
+
+template<typename K, typename V, typename C>
+bool AsyncLoadingCache<K,V,C>::GetOrLoad::await_ready()
+{
+    V value;
+    if (!owner_->cache_.get(key_, value)) return false;
+    hit_.emplace(std::move(value));
+    owner_->hits_.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+template<typename K, typename V, typename C>
+bool AsyncLoadingCache<K,V,C>::GetOrLoad::await_suspend(std::coroutine_handle<> handle)
+{
+    return owner_->start(*this, handle);
+}
+
+template<typename K, typename V, typename C>
+std::optional<V> AsyncLoadingCache<K,V,C>::GetOrLoad::await_resume()
+{
+    if (!pending_) return std::move(hit_);
+    if (pending_->error) std::rethrow_exception(pending_->error);
+    return pending_->value;
+}
+
+// Returns false (don't suspend) when the load finished before this
+// coroutine could be queued. Once the handle is queued it may be resumed
+// on another thread at any moment, so the awaiter is not touched again
+template<typename K, typename V, typename C>
+bool AsyncLoadingCache<K,V,C>::start(GetOrLoad& awaiter, std::coroutine_handle<> handle)
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    auto it = pending_.find(awaiter.key_);
+    if (it != pending_.end()) {
+        awaiter.pending_ = it->second;
+        it->second->waiters.push_back(handle);
+        joined_.fetch_add(1, std::memory_order_relaxed);
+        suspensions_.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+    auto pending = std::make_shared<Pending>();
+    pending_.emplace(awaiter.key_, pending);
+    awaiter.pending_ = pending;
+    lock.unlock();
+
+    loads_.fetch_add(1, std::memory_order_relaxed);
+    K key = awaiter.key_;
+    try {
+        awaiter.loader_(key, [this, key, pending](std::optional<V> value, std::exception_ptr error) {
+            complete(key, pending, std::move(value), error);
+        });
+    } catch (...) {
+        complete(key, pending, std::nullopt, std::current_exception());
+    }
+
+    lock.lock();
+    if (pending->done) return false;
+    pending->waiters.push_back(handle);
+    suspensions_.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+// Cache first, then retire the pending entry: an awaiter arriving in
+// between hits instead of starting a second load
+template<typename K, typename V, typename C>
+void AsyncLoadingCache<K,V,C>::complete(const K& key, const std::shared_ptr<Pending>& pending,
+                                        std::optional<V> value, std::exception_ptr error)
+{
+    if (value && !error) cache_.put(key, *value);
+
+    std::vector<std::coroutine_handle<>> waiters;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        pending->value = std::move(value);
+        pending->error = error;
+        pending->done  = true;
+        waiters.swap(pending->waiters);
+        auto it = pending_.find(key);
+        if (it != pending_.end() && it->second == pending) pending_.erase(it);
+    }
+    for (auto handle : waiters) handle.resume();
+}
+
+} // namespace Cache
@@ -0,0 +1,156 @@
+#pragma once
+#include <stdexcept>
+#include "../include/BatchLoadingCache.h"
+
+namespace Cache {
+
+// =============== BatchLoadingCache implementation =============== //
+
+template<typename K, typename V>
+BatchLoadingCache<K,V>::BatchLoadingCache(size_t capacity, BulkLoader loader,
+                                          BatchLoaderOptions options, int sliceNum)
+    : cache_(capacity, sliceNum),
+      loader_(std::move(loader)),
+      options_(options)
+{
+    if (!loader_)
+        throw std::invalid_argument("BatchLoadingCache needs a loader");
+    if (options_.maxBatch == 0) options_.maxBatch = 1;
+    if (options_.negativeTtl.count() > 0)
+        negatives_ = std::make_unique<NegativeCache<K>>(options_.negativeCapacity, options_.negativeTtl);
+}
+
+template<typename K, typename V>
+bool BatchLoadingCache<K,V>::get(const K& key, V& value)
+{
+    return lookup(key, value) == LookupResult::Hit;
+}
+
+// Hit → done. Known absent → done. Miss → join the key's pending slot,
+// or add the key to the open batch (starting one makes this caller its
+// leader), then wait. Before adding the key the cache is checked again
+// under mutex_: a put() that landed after the first miss is a hit, not
+// a load that would overwrite it
+template<typename K, typename V>
+LookupResult BatchLoadingCache<K,V>::lookup(const K& key, V& value)
+{
+    if (cache_.get(key, value)) return LookupResult::Hit;
+    if (negatives_ && negatives_->contains(key, std::chrono::steady_clock::now())) {
+        negativeHits_.fetch_add(1, std::memory_order_relaxed);
+        return LookupResult::KnownAbsent;
+    }
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    std::shared_ptr<Slot>  slot;
+    std::shared_ptr<Batch> leading, full;
+
+    auto it = pending_.find(key);
+    if (it != pending_.end()) {
+        slot = it->second;
+        sharedMisses_.fetch_add(1, std::memory_order_relaxed);
+    } else {
+        if (cache_.get(key, value)) return LookupResult::Hit;
+        slot = std::make_shared<Slot>();
+        pending_.emplace(key, slot);
+        if (!open_) {
+            open_ = std::make_shared<Batch>();
+            leading = open_;
+        }
+        open_->keys.push_back(key);
+        open_->slots.push_back(slot);
+        if (open_->keys.size() >= options_.maxBatch) {
+            full = std::move(open_);               // Leaves open_ empty
+            full->dispatched = true;
+            cv_.notify_all();                      // The leader stops waiting
+        }
+    }
+
+    if (leading && !full) {
+        auto deadline = std::chrono::steady_clock::now() + options_.window;
+        while (!leading->dispatched) {
+            auto now = std::chrono::steady_clock::now();
+            if (now >= deadline) {
+                leading->dispatched = true;
+                if (open_ == leading) open_.reset();
+                full = leading;
+                break;
+            }
+            cv_.wait_for(lock, deadline - now);
+        }
+    }
+
+    if (full) {
+        lock.unlock();
+        dispatch(*full);
+        lock.lock();
+    }
+
+    while (!slot->done) cv_.wait_for(lock, std::chrono::milliseconds(10));
+    if (slot->error) std::rethrow_exception(slot->error);
+    if (!slot->found) return LookupResult::Miss;
+    value = slot->value;
+    return LookupResult::Hit;
+}
+
+// Under mutex_, so it is ordered against lookup()'s re-check and
+// dispatch(): a load in flight for the key is marked superseded and
+// won't overwrite this value, and a key not pending yet sees it
+template<typename K, typename V>
+void BatchLoadingCache<K,V>::put(const K& key, const V& value)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = pending_.find(key);
+    if (it != pending_.end()) it->second->superseded = true;
+    if (negatives_) negatives_->erase(key);
+    cache_.put(key, value);
+}
+
+// Forgets a negative entry too: the next get asks the loader again
+template<typename K, typename V>
+void BatchLoadingCache<K,V>::remove(const K& key)
+{
+    cache_.remove(key);
+    if (!negatives_) return;
+    std::lock_guard<std::mutex> lock(mutex_);
+    negatives_->erase(key);
+}
+
+// Loaded values (and absent keys) are cached before the keys leave
+// pending_, so a caller arriving afterwards hits instead of loading again.
+// Keys a put() superseded while the loader ran keep the put() value
+template<typename K, typename V>
+void BatchLoadingCache<K,V>::dispatch(Batch& batch)
+{
+    std::unordered_map<K, V> loaded;
+    std::exception_ptr error;
+    try {
+        loaded = loader_(batch.keys);
+    } catch (...) {
+        error = std::current_exception();
+    }
+    loaderCalls_.fetch_add(1, std::memory_order_relaxed);
+    keysLoaded_.fetch_add(batch.keys.size(), std::memory_order_relaxed);
+
+    auto now = std::chrono::steady_clock::now();
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (const auto& kv : loaded) {
+        auto it = pending_.find(kv.first);
+        if (it == pending_.end() || !it->second->superseded) cache_.put(kv.first, kv.second);
+    }
+    for (size_t i = 0; i < batch.keys.size(); ++i) {
+        Slot& slot = *batch.slots[i];
+        slot.error = error;
+        auto it = loaded.find(batch.keys[i]);
+        if (it != loaded.end()) {
+            slot.found = true;
+            slot.value = std::move(it->second);
+        } else if (!error && negatives_ && !slot.superseded) {
+            negatives_->insert(batch.keys[i], now);
+        }
+        slot.done = true;
+        pending_.erase(batch.keys[i]);
+    }
+    cv_.notify_all();
+}
+
+} // namespace Cache
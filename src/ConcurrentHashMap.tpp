@@ -0,0 +1,220 @@
+#pragma once
+#include <algorithm>
+#include "../include/ConcurrentHashMap.h"
+
+namespace Cache {
+
+// =============== ConcurrentHashMap implementation =============== //
+
+template<typename K, typename V, typename H>
+ConcurrentHashMap<K,V,H>::Table::Table(size_t capacity)
+    : mask(capacity - 1), slots(new std::atomic<Node*>[capacity])
+{
+    for (size_t i = 0; i < capacity; ++i)
+        slots[i].store(nullptr, std::memory_order_relaxed);
+}
+
+template<typename K, typename V, typename H>
+ConcurrentHashMap<K,V,H>::ConcurrentHashMap(size_t initialCapacity)
+    : table_(new Table(roundUpPow2(std::max<size_t>(16, initialCapacity * 2)))),
+      stripes_(new std::mutex[kStripes])
+{
+}
+
+template<typename K, typename V, typename H>
+ConcurrentHashMap<K,V,H>::~ConcurrentHashMap()
+{
+    // Replaced/erased nodes and old tables already belong to the reclaimer
+    Table* t = table_.load();
+    for (size_t i = 0; i <= t->mask; ++i) {
+        Node* n = t->slots[i].load(std::memory_order_relaxed);
+        if (isLive(n)) delete n;
+    }
+    delete t;
+}
+
+// -- public: find (lock-free) -------------------------------------
+template<typename K, typename V, typename H>
+bool ConcurrentHashMap<K,V,H>::find(const K& key, V& value) const
+{
+    size_t h = hasher_(key);
+    EpochReclaimer::Guard guard;
+    Node* n = findNode(table_.load(std::memory_order_acquire), h, key);
+    if (!n) return false;
+    value = n->value;
+    // Avoid dirtying the cache line when the bit is already set
+    if (!n->accessed.load(std::memory_order_relaxed))
+        n->accessed.store(true, std::memory_order_relaxed);
+    return true;
+}
+
+template<typename K, typename V, typename H>
+bool ConcurrentHashMap<K,V,H>::contains(const K& key) const
+{
+    size_t h = hasher_(key);
+    EpochReclaimer::Guard guard;
+    return findNode(table_.load(std::memory_order_acquire), h, key) != nullptr;
+}
+
+// -- public: insertOrAssign ---------------------------------------
+// Same key → same stripe, so duplicates cannot race in. Different
+// stripes may still compete for one empty slot: CAS decides, the
+// loser probes again.
+// ---------------------------------------------------------------
+template<typename K, typename V, typename H>
+bool ConcurrentHashMap<K,V,H>::insertOrAssign(const K& key, const V& value, bool accessed)
+{
+    size_t h = hasher_(key);
+    EpochReclaimer::Guard guard;   // We read other keys' nodes while probing
+
+    for (;;) {
+        if (needsRehash(table_.load(std::memory_order_acquire))) rehash();
+
+        std::unique_lock<std::mutex> lock(stripeFor(h));
+        Table* t = table_.load(std::memory_order_acquire);
+
+        std::atomic<Node*>* target = nullptr;
+        Node* expected = nullptr;
+        size_t i = h & t->mask;
+        for (size_t probe = 0; probe <= t->mask; ++probe, i = (i + 1) & t->mask) {
+            Node* n = t->slots[i].load(std::memory_order_acquire);
+            if (n == nullptr) {
+                if (!target) { target = &t->slots[i]; expected = nullptr; }
+                break;
+            }
+            if (n == tombstone()) {
+                if (!target) { target = &t->slots[i]; expected = tombstone(); }
+                continue;
+            }
+            if (n->hash == h && n->key == key) {
+                t->slots[i].store(new Node(h, key, value, accessed), std::memory_order_release);
+                EpochReclaimer::instance().retire(n);
+                return false;
+            }
+        }
+
+        if (!target) {             // Every slot holds a live entry
+            lock.unlock();
+            rehash();
+            continue;
+        }
+
+        Node* fresh = new Node(h, key, value, accessed);
+        if (target->compare_exchange_strong(expected, fresh, std::memory_order_acq_rel)) {
+            if (expected == nullptr) t->used.fetch_add(1, std::memory_order_relaxed);
+            size_.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+        delete fresh;              // Never published
+    }
+}
+
+// -- public: erase ------------------------------------------------
+template<typename K, typename V, typename H>
+bool ConcurrentHashMap<K,V,H>::erase(const K& key)
+{
+    size_t h = hasher_(key);
+    EpochReclaimer::Guard guard;
+    std::lock_guard<std::mutex> lock(stripeFor(h));
+    Table* t = table_.load(std::memory_order_acquire);
+
+    size_t i = h & t->mask;
+    for (size_t probe = 0; probe <= t->mask; ++probe, i = (i + 1) & t->mask) {
+        Node* n = t->slots[i].load(std::memory_order_acquire);
+        if (n == nullptr) return false;
+        if (n != tombstone() && n->hash == h && n->key == key) {
+            t->slots[i].store(tombstone(), std::memory_order_release);
+            size_.fetch_sub(1, std::memory_order_relaxed);
+            EpochReclaimer::instance().retire(n);
+            return true;
+        }
+    }
+    return false;
+}
+
+template<typename K, typename V, typename H>
+bool ConcurrentHashMap<K,V,H>::testAndClearAccessed(const K& key)
+{
+    size_t h = hasher_(key);
+    EpochReclaimer::Guard guard;
+    Node* n = findNode(table_.load(std::memory_order_acquire), h, key);
+    return n && n->accessed.exchange(false, std::memory_order_relaxed);
+}
+
+template<typename K, typename V, typename H>
+size_t ConcurrentHashMap<K,V,H>::slotCount() const
+{
+    EpochReclaimer::Guard guard;
+    return table_.load(std::memory_order_acquire)->mask + 1;
+}
+
+// -- private helpers ---------------------------------------------
+
+template<typename K, typename V, typename H>
+typename ConcurrentHashMap<K,V,H>::Node*
+ConcurrentHashMap<K,V,H>::findNode(const Table* t, size_t h, const K& key) const
+{
+    size_t i = h & t->mask;
+    for (size_t probe = 0; probe <= t->mask; ++probe, i = (i + 1) & t->mask) {
+        Node* n = t->slots[i].load(std::memory_order_acquire);
+        if (n == nullptr) return nullptr;            // End of the probe chain
+        if (n != tombstone() && n->hash == h && n->key == key) return n;
+    }
+    return nullptr;
+}
+
+/** Keep probe chains short: rebuild at 75% occupancy (tombstones count) */
+template<typename K, typename V, typename H>
+bool ConcurrentHashMap<K,V,H>::needsRehash(const Table* t) const
+{
+    return t->used.load(std::memory_order_relaxed) * 4 >= (t->mask + 1) * 3;
+}
+
+/**
+ * Rebuild into a fresh slot array. Live nodes are moved by pointer (no copies),
+ * tombstones are dropped; the old array is retired so in-flight readers can
+ * finish probing it.
+ */
+template<typename K, typename V, typename H>
+void ConcurrentHashMap<K,V,H>::rehash()
+{
+    for (size_t s = 0; s < kStripes; ++s) stripes_[s].lock();
+
+    Table* old = table_.load(std::memory_order_acquire);
+    Table* retired = nullptr;
+    if (needsRehash(old)) {
+        size_t capacity = old->mask + 1;
+        size_t live = 0;
+        for (size_t i = 0; i < capacity; ++i)
+            if (isLive(old->slots[i].load(std::memory_order_relaxed))) ++live;
+
+        // Mostly tombstones → same size is enough; otherwise double
+        size_t newCapacity = (live * 2 < capacity) ? capacity : capacity * 2;
+        Table* fresh = new Table(newCapacity);
+        for (size_t i = 0; i < capacity; ++i) {
+            Node* n = old->slots[i].load(std::memory_order_relaxed);
+            if (!isLive(n)) continue;
+            size_t j = n->hash & fresh->mask;
+            while (fresh->slots[j].load(std::memory_order_relaxed) != nullptr)
+                j = (j + 1) & fresh->mask;
+            fresh->slots[j].store(n, std::memory_order_relaxed);
+        }
+        fresh->used.store(live, std::memory_order_relaxed);
+
+        table_.store(fresh, std::memory_order_release);
+        retired = old;
+    }
+
+    for (size_t s = kStripes; s-- > 0;) stripes_[s].unlock();
+    if (retired) EpochReclaimer::instance().retire(retired);
+}
+
+template<typename K, typename V, typename H>
+size_t ConcurrentHashMap<K,V,H>::roundUpPow2(size_t n)
+{
+    size_t p = 1;
+    while (p < n) p <<= 1;
+    return p;
+}
+
+} // namespace Cache
@@ -0,0 +1,438 @@
+#pragma once
+#include <algorithm>
+#include "../include/CuckooHashMap.h"
+
+namespace Cache {
+
+// =============== CuckooHashMap implementation =============== //
+
+template<typename K, typename V, typename H>
+CuckooHashMap<K,V,H>::CuckooHashMap(size_t initialCapacity)
+    : stripes_(new PaddedLock[kStripes])
+{
+    size_t buckets = 1;
+    while (buckets * kSlotsPerBucket < initialCapacity) buckets <<= 1;
+    table_.store(new Table(std::max<size_t>(buckets, 2)), std::memory_order_relaxed);
+}
+
+template<typename K, typename V, typename H>
+CuckooHashMap<K,V,H>::~CuckooHashMap()
+{
+    delete table_.load();   // Tables replaced by grow() belong to the reclaimer
+}
+
+// -- public: find -------------------------------------------------
+template<typename K, typename V, typename H>
+bool CuckooHashMap<K,V,H>::find(const K& key, V& value) const
+{
+    return kOptimisticReads ? findOptimistic(key, value) : findLocked(key, value);
+}
+
+template<typename K, typename V, typename H>
+bool CuckooHashMap<K,V,H>::contains(const K& key) const
+{
+    V tmp{};
+    return find(key, tmp);
+}
+
+/**
+ * Lock-free read: snapshot both stripe versions, copy, validate.
+ * The table pointer is re-checked too, since grow() may have swapped
+ * it between our load and the version snapshot.
+ */
+template<typename K, typename V, typename H>
+bool CuckooHashMap<K,V,H>::findOptimistic(const K& key, V& value) const
+{
+    size_t h = hashOf(key);
+    uint8_t tag = tagOf(h);
+    EpochReclaimer::Guard guard;
+
+    for (;;) {
+        Table* t = table_.load(std::memory_order_acquire);
+        size_t b1 = h & t->mask;
+        size_t b2 = altBucket(b1, tag, t->mask);
+        uint64_t v1 = stripe(b1).readBegin();
+        uint64_t v2 = stripe(b2).readBegin();
+
+        V tmp{};
+        bool found = false;
+        for (size_t b : {b1, b2}) {
+            int slot = findInBucket(t->buckets[b], tag, key);
+            if (slot >= 0) {
+                loadValue(tmp, t->buckets[b].values[slot]);
+                found = true;
+                break;
+            }
+        }
+
+        if (stripe(b1).readRetry(v1) || stripe(b2).readRetry(v2)) continue;
+        if (t != table_.load(std::memory_order_acquire)) continue;
+        if (found) value = tmp;
+        return found;
+    }
+}
+
+template<typename K, typename V, typename H>
+bool CuckooHashMap<K,V,H>::findLocked(const K& key, V& value) const
+{
+    size_t h = hashOf(key);
+    uint8_t tag = tagOf(h);
+    EpochReclaimer::Guard guard;
+
+    for (;;) {
+        Table* t = table_.load(std::memory_order_acquire);
+        size_t b1 = h & t->mask;
+        size_t b2 = altBucket(b1, tag, t->mask);
+        lockPair(b1, b2);
+        if (t != table_.load(std::memory_order_acquire)) { unlockPair(b1, b2); continue; }
+
+        bool found = false;
+        for (size_t b : {b1, b2}) {
+            int slot = findInBucket(t->buckets[b], tag, key);
+            if (slot >= 0) {
+                value = t->buckets[b].values[slot];
+                found = true;
+                break;
+            }
+        }
+        unlockPair(b1, b2);
+        return found;
+    }
+}
+
+// -- public: insertOrAssign ---------------------------------------
+// Presence check and insertion happen in one critical section over
+// both buckets; displacement runs between attempts, unlocked.
+// ---------------------------------------------------------------
+template<typename K, typename V, typename H>
+bool CuckooHashMap<K,V,H>::insertOrAssign(const K& key, const V& value)
+{
+    size_t h = hashOf(key);
+    uint8_t tag = tagOf(h);
+    EpochReclaimer::Guard guard;
+
+    for (;;) {
+        Table* t = table_.load(std::memory_order_acquire);
+        size_t b1 = h & t->mask;
+        size_t b2 = altBucket(b1, tag, t->mask);
+        lockPair(b1, b2);
+        if (t != table_.load(std::memory_order_acquire)) { unlockPair(b1, b2); continue; }
+
+        for (size_t b : {b1, b2}) {
+            int slot = findInBucket(t->buckets[b], tag, key);
+            if (slot >= 0) {
+                if constexpr (kOptimisticReads) seqlockStore(t->buckets[b].values[slot], value);
+                else t->buckets[b].values[slot] = value;
+                unlockPair(b1, b2);
+                return false;
+            }
+        }
+        for (size_t b : {b1, b2}) {
+            int slot = freeSlot(t->buckets[b]);
+            if (slot >= 0) {
+                storeSlot(t->buckets[b], slot, key, value, tag);
+                size_.fetch_add(1, std::memory_order_relaxed);
+                unlockPair(b1, b2);
+                return true;
+            }
+        }
+        unlockPair(b1, b2);
+
+        if (makeRoom(t, b1, b2) == MoveResult::NoPath) grow(t);
+    }
+}
+
+// -- public: erase ------------------------------------------------
+template<typename K, typename V, typename H>
+bool CuckooHashMap<K,V,H>::erase(const K& key)
+{
+    size_t h = hashOf(key);
+    uint8_t tag = tagOf(h);
+    EpochReclaimer::Guard guard;
+
+    for (;;) {
+        Table* t = table_.load(std::memory_order_acquire);
+        size_t b1 = h & t->mask;
+        size_t b2 = altBucket(b1, tag, t->mask);
+        lockPair(b1, b2);
+        if (t != table_.load(std::memory_order_acquire)) { unlockPair(b1, b2); continue; }
+
+        bool erased = false;
+        for (size_t b : {b1, b2}) {
+            int slot = findInBucket(t->buckets[b], tag, key);
+            if (slot >= 0) {
+                clearSlot(t->buckets[b], slot);
+                size_.fetch_sub(1, std::memory_order_relaxed);
+                erased = true;
+                break;
+            }
+        }
+        unlockPair(b1, b2);
+        return erased;
+    }
+}
+
+template<typename K, typename V, typename H>
+size_t CuckooHashMap<K,V,H>::slotCount() const
+{
+    EpochReclaimer::Guard guard;
+    return (table_.load(std::memory_order_acquire)->mask + 1) * kSlotsPerBucket;
+}
+
+template<typename K, typename V, typename H>
+size_t CuckooHashMap<K,V,H>::memoryBytes() const
+{
+    return slotCount() / kSlotsPerBucket * sizeof(Bucket) + kStripes * sizeof(PaddedLock);
+}
+
+// -- private: hashing ---------------------------------------------
+
+/** std::hash is the identity for integers; finalize it so low and high bits both mix */
+template<typename K, typename V, typename H>
+size_t CuckooHashMap<K,V,H>::hashOf(const K& key) const
+{
+    uint64_t h = static_cast<uint64_t>(hasher_(key));
+    h ^= h >> 33; h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33; h *= 0xc4ceb9fe1a85ec53ULL;
+    h ^= h >> 33;
+    return static_cast<size_t>(h);
+}
+
+template<typename K, typename V, typename H>
+uint8_t CuckooHashMap<K,V,H>::tagOf(size_t h)
+{
+    uint8_t tag = static_cast<uint8_t>(static_cast<uint64_t>(h) >> 56);
+    return tag ? tag : 1;   // 0 marks an empty slot
+}
+
+/** Involution: altBucket(altBucket(b, tag), tag) == b */
+template<typename K, typename V, typename H>
+size_t CuckooHashMap<K,V,H>::altBucket(size_t bucket, uint8_t tag, size_t mask)
+{
+    return (bucket ^ (static_cast<size_t>(tag) * 0x5bd1e995)) & mask;
+}
+
+// -- private: slot access -----------------------------------------
+
+template<typename K, typename V, typename H>
+void CuckooHashMap<K,V,H>::loadKey(K& dst, const K& src)
+{
+    if constexpr (kOptimisticReads) seqlockLoad(dst, src);
+    else dst = src;
+}
+
+template<typename K, typename V, typename H>
+void CuckooHashMap<K,V,H>::loadValue(V& dst, const V& src)
+{
+    if constexpr (kOptimisticReads) seqlockLoad(dst, src);
+    else dst = src;
+}
+
+template<typename K, typename V, typename H>
+void CuckooHashMap<K,V,H>::storeSlot(Bucket& b, size_t slot, const K& key, const V& value, uint8_t tag)
+{
+    if constexpr (kOptimisticReads) {
+        seqlockStore(b.keys[slot], key);
+        seqlockStore(b.values[slot], value);
+    } else {
+        b.keys[slot] = key;
+        b.values[slot] = value;
+    }
+    b.tags[slot].store(tag, std::memory_order_relaxed);
+}
+
+/** Copy into the destination first, then clear the source: never absent from both */
+template<typename K, typename V, typename H>
+void CuckooHashMap<K,V,H>::moveSlot(Bucket& from, size_t fs, Bucket& to, size_t ts)
+{
+    uint8_t tag = from.tags[fs].load(std::memory_order_relaxed);
+    if constexpr (kOptimisticReads) {
+        seqlockStore(to.keys[ts], from.keys[fs]);
+        seqlockStore(to.values[ts], from.values[fs]);
+    } else {
+        to.keys[ts] = std::move(from.keys[fs]);
+        to.values[ts] = std::move(from.values[fs]);
+    }
+    to.tags[ts].store(tag, std::memory_order_relaxed);
+    clearSlot(from, fs);
+}
+
+template<typename K, typename V, typename H>
+void CuckooHashMap<K,V,H>::clearSlot(Bucket& b, size_t slot)
+{
+    b.tags[slot].store(0, std::memory_order_relaxed);
+    if constexpr (!kOptimisticReads) {
+        b.keys[slot] = K{};      // Release resources now, not when the table dies
+        b.values[slot] = V{};
+    }
+}
+
+template<typename K, typename V, typename H>
+int CuckooHashMap<K,V,H>::findInBucket(const Bucket& b, uint8_t tag, const K& key)
+{
+    for (size_t i = 0; i < kSlotsPerBucket; ++i) {
+        if (b.tags[i].load(std::memory_order_relaxed) != tag) continue;
+        K k{};
+        loadKey(k, b.keys[i]);
+        if (k == key) return static_cast<int>(i);
+    }
+    return -1;
+}
+
+template<typename K, typename V, typename H>
+int CuckooHashMap<K,V,H>::freeSlot(const Bucket& b)
+{
+    for (size_t i = 0; i < kSlotsPerBucket; ++i)
+        if (b.tags[i].load(std::memory_order_relaxed) == 0) return static_cast<int>(i);
+    return -1;
+}
+
+// -- private: locking ---------------------------------------------
+
+/** Stripes are always taken in index order, so pairs cannot deadlock */
+template<typename K, typename V, typename H>
+void CuckooHashMap<K,V,H>::lockPair(size_t b1, size_t b2) const
+{
+    size_t s1 = b1 & (kStripes - 1), s2 = b2 & (kStripes - 1);
+    if (s1 == s2) { stripes_[s1].lock.lock(); return; }
+    stripes_[std::min(s1, s2)].lock.lock();
+    stripes_[std::max(s1, s2)].lock.lock();
+}
+
+template<typename K, typename V, typename H>
+void CuckooHashMap<K,V,H>::unlockPair(size_t b1, size_t b2) const
+{
+    size_t s1 = b1 & (kStripes - 1), s2 = b2 & (kStripes - 1);
+    stripes_[s1].lock.unlock();
+    if (s1 != s2) stripes_[s2].lock.unlock();
+}
+
+// -- private: displacement / growth -------------------------------
+
+/**
+ * BFS from b1/b2 over "where could this entry go instead" edges until a
+ * bucket with a free slot shows up. Reads tags without locks; every move
+ * is re-validated under locks in makeRoom(). Moves are returned
+ * leaf-first, i.e. in the order they must be executed.
+ */
+template<typename K, typename V, typename H>
+bool CuckooHashMap<K,V,H>::searchPath(const Table* t, size_t b1, size_t b2, std::vector<Move>& moves)
+{
+    std::vector<PathStep> queue;
+    queue.reserve(kMaxBfs);
+    queue.push_back({b1, 0, -1});
+    if (b2 != b1) queue.push_back({b2, 0, -1});
+
+    for (size_t head = 0; head < queue.size(); ++head) {
+        const Bucket& bucket = t->buckets[queue[head].bucket];
+        if (freeSlot(bucket) >= 0) {
+            for (int n = static_cast<int>(head); queue[n].parent >= 0; n = queue[n].parent)
+                moves.push_back({queue[queue[n].parent].bucket, queue[n].slot, queue[n].bucket});
+            return true;
+        }
+        for (size_t i = 0; i < kSlotsPerBucket && queue.size() < kMaxBfs; ++i) {
+            uint8_t tag = bucket.tags[i].load(std::memory_order_relaxed);
+            if (tag == 0) continue;
+            size_t alt = altBucket(queue[head].bucket, tag, t->mask);
+            bool onPath = false;   // Don't route an entry back through its own path
+            for (int n = static_cast<int>(head); n >= 0 && !onPath; n = queue[n].parent)
+                onPath = queue[n].bucket == alt;
+            if (!onPath) queue.push_back({alt, i, static_cast<int>(head)});
+        }
+    }
+    return false;
+}
+
+template<typename K, typename V, typename H>
+typename CuckooHashMap<K,V,H>::MoveResult
+CuckooHashMap<K,V,H>::makeRoom(Table* t, size_t b1, size_t b2)
+{
+    std::vector<Move> moves;
+    if (!searchPath(t, b1, b2, moves)) return MoveResult::NoPath;
+
+    for (const Move& m : moves) {
+        lockPair(m.from, m.to);
+        if (t != table_.load(std::memory_order_acquire)) { unlockPair(m.from, m.to); return MoveResult::Raced; }
+
+        Bucket& from = t->buckets[m.from];
+        Bucket& to   = t->buckets[m.to];
+        uint8_t tag  = from.tags[m.slot].load(std::memory_order_relaxed);
+        int free     = freeSlot(to);
+        if (tag == 0 || altBucket(m.from, tag, t->mask) != m.to || free < 0) {
+            unlockPair(m.from, m.to);
+            return MoveResult::Raced;   // Someone else changed the path; caller retries
+        }
+        moveSlot(from, m.slot, to, static_cast<size_t>(free));
+        unlockPair(m.from, m.to);
+    }
+    return MoveResult::Done;
+}
+
+/** Insert into a table nobody else can see yet (used by grow) */
+template<typename K, typename V, typename H>
+bool CuckooHashMap<K,V,H>::insertUnpublished(Table* t, size_t h, const K& key, const V& value)
+{
+    uint8_t tag = tagOf(h);
+    size_t b1 = h & t->mask;
+    size_t b2 = altBucket(b1, tag, t->mask);
+
+    for (int attempt = 0; attempt < 2; ++attempt) {
+        for (size_t b : {b1, b2}) {
+            int slot = freeSlot(t->buckets[b]);
+            if (slot >= 0) {
+                storeSlot(t->buckets[b], slot, key, value, tag);
+                return true;
+            }
+        }
+        std::vector<Move> moves;
+        if (!searchPath(t, b1, b2, moves)) return false;
+        for (const Move& m : moves) {
+            Bucket& to = t->buckets[m.to];
+            moveSlot(t->buckets[m.from], m.slot, to, static_cast<size_t>(freeSlot(to)));
+        }
+    }
+    return false;
+}
+
+/**
+ * Double the bucket array under every stripe. Optimistic readers that
+ * overlap see the versions move and retry on the new table; the old
+ * array is retired through EBR.
+ */
+template<typename K, typename V, typename H>
+void CuckooHashMap<K,V,H>::grow(Table* expected)
+{
+    for (size_t s = 0; s < kStripes; ++s) stripes_[s].lock.lock();
+
+    Table* old = table_.load(std::memory_order_acquire);
+    Table* retired = nullptr;
+    if (old == expected) {
+        size_t bucketCount = (old->mask + 1) * 2;
+        std::unique_ptr<Table> fresh;
+        for (bool placed = false; !placed; bucketCount *= 2) {
+            fresh.reset(new Table(bucketCount));
+            placed = true;
+            for (size_t b = 0; b <= old->mask && placed; ++b) {
+                Bucket& bucket = old->buckets[b];
+                for (size_t i = 0; i < kSlotsPerBucket && placed; ++i) {
+                    if (bucket.tags[i].load(std::memory_order_relaxed) == 0) continue;
+                    placed = insertUnpublished(fresh.get(), hashOf(bucket.keys[i]),
+                                               bucket.keys[i], bucket.values[i]);
+                }
+            }
+        }
+        if constexpr (!kOptimisticReads) {
+            // Only locked readers exist for these types, and they re-check table_
+            for (size_t b = 0; b <= old->mask; ++b)
+                for (size_t i = 0; i < kSlotsPerBucket; ++i) clearSlot(old->buckets[b], i);
+        }
+        table_.store(fresh.release(), std::memory_order_release);
+        growCount_.fetch_add(1, std::memory_order_relaxed);
+        retired = old;
+    }
+
+    for (size_t s = kStripes; s-- > 0;) stripes_[s].lock.unlock();
+    if (retired) EpochReclaimer::instance().retire(retired);
+}
+
+} // namespace Cache
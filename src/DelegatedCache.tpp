@@ -0,0 +1,229 @@
+#pragma once
+#include <stdexcept>
+#include "../include/DelegatedCache.h"
+
+namespace Cache {
+
+// =============== DelegatedCache implementation =============== //
+
+template<typename K, typename V>
+DelegatedCache<K,V>::DelegatedCache(std::unique_ptr<CachePolicy<K,V>> cache,
+                                    size_t queueCapacity, size_t maxBatch)
+    : cache_(std::move(cache)),
+      queue_(queueCapacity),
+      maxBatch_(maxBatch == 0 ? 1 : maxBatch)
+{
+    if (!cache_)
+        throw std::invalid_argument("DelegatedCache needs a cache to own");
+    owner_ = std::thread([this] { ownerLoop(); });
+}
+
+template<typename K, typename V>
+DelegatedCache<K,V>::~DelegatedCache()
+{
+    stop_.store(true, std::memory_order_seq_cst);
+    {
+        std::lock_guard<std::mutex> lock(parkMutex_);
+        parkCv_.notify_one();
+    }
+    owner_.join();
+}
+
+// -- public: CachePolicy interface --------------------------------
+
+template<typename K, typename V>
+void DelegatedCache<K,V>::put(const K& key, const V& value)
+{
+    Request r;
+    r.op    = Op::Put;
+    r.key   = key;
+    r.value = value;
+    submit(std::move(r));
+}
+
+template<typename K, typename V>
+bool DelegatedCache<K,V>::get(const K& key, V& value)
+{
+    SyncWaiter waiter;
+    waiter.out = &value;
+    Request r;
+    r.op     = Op::Get;
+    r.key    = key;
+    r.waiter = &waiter;
+    submit(std::move(r));
+
+    for (int spins = 0; !waiter.done.load(std::memory_order_acquire); ++spins) {
+        if (spins >= kIdleSpins) std::this_thread::yield();
+    }
+    if (waiter.error) std::rethrow_exception(waiter.error);
+    return waiter.found;
+}
+
+template<typename K, typename V>
+V DelegatedCache<K,V>::get(const K& key)
+{
+    V tmp{};
+    if (!get(key, tmp))
+        throw std::runtime_error("Key not found in delegated cache");
+    return tmp;
+}
+
+// -- public: asynchronous requests --------------------------------
+
+template<typename K, typename V>
+void DelegatedCache<K,V>::getAsync(const K& key, GetCallback done)
+{
+    Request r;
+    r.op       = Op::Get;
+    r.key      = key;
+    r.callback = std::move(done);
+    submit(std::move(r));
+}
+
+template<typename K, typename V>
+std::future<std::optional<V>> DelegatedCache<K,V>::getFuture(const K& key)
+{
+    auto promise = std::make_shared<std::promise<std::optional<V>>>();
+    auto future  = promise->get_future();
+    Request r;
+    r.op       = Op::Get;
+    r.key      = key;
+    r.callback = [promise](bool found, const V& value) {
+        promise->set_value(found ? std::optional<V>(value) : std::nullopt);
+    };
+    r.onError  = [promise](std::exception_ptr e) { promise->set_exception(e); };
+    submit(std::move(r));
+    return future;
+}
+
+template<typename K, typename V>
+std::future<void> DelegatedCache<K,V>::putFuture(const K& key, const V& value)
+{
+    auto promise = std::make_shared<std::promise<void>>();
+    auto future  = promise->get_future();
+    Request r;
+    r.op       = Op::Put;
+    r.key      = key;
+    r.value    = value;
+    r.callback = [promise](bool, const V&) { promise->set_value(); };
+    r.onError  = [promise](std::exception_ptr e) { promise->set_exception(e); };
+    submit(std::move(r));
+    return future;
+}
+
+// -- private: client side -----------------------------------------
+
+/** Push with backpressure, then wake the owner if it is parked */
+template<typename K, typename V>
+void DelegatedCache<K,V>::submit(Request&& request)
+{
+    while (!queue_.tryPush(std::move(request))) std::this_thread::yield();
+
+    // Store-buffering pair with ownerLoop(): the push is published with a
+    // release store, which may otherwise be reordered after this load.
+    // With a seq_cst fence on both sides, either the owner's re-check sees
+    // the request or this load sees sleeping_ set
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (sleeping_.load(std::memory_order_relaxed)) {
+        std::lock_guard<std::mutex> lock(parkMutex_);
+        parkCv_.notify_one();
+    }
+}
+
+// -- private: owner side ------------------------------------------
+
+template<typename K, typename V>
+void DelegatedCache<K,V>::ownerLoop()
+{
+    std::vector<Request> batch;
+    std::vector<bool>    found;
+    batch.reserve(maxBatch_);
+
+    int idle = 0;
+    for (;;) {
+        size_t n = drainBatch(batch);
+        if (n > 0) {
+            found.assign(n, false);
+            for (size_t i = 0; i < n; ++i) {
+                Request& r = batch[i];
+                try {
+                    if (r.op == Op::Put) {
+                        cache_->put(r.key, r.value);
+                    } else {
+                        found[i] = cache_->get(r.key, r.value);    // Result parked in the request
+                    }
+                } catch (...) {
+                    r.error = std::current_exception();             // Delivered by complete()
+                }
+            }
+            complete(batch, found);
+            batches_.fetch_add(1, std::memory_order_relaxed);
+            processed_.fetch_add(n, std::memory_order_relaxed);
+            idle = 0;
+            continue;
+        }
+
+        if (stop_.load(std::memory_order_acquire)) {
+            if (queue_.empty()) break;                         // Everything submitted has been served
+            continue;
+        }
+        if (++idle < kIdleSpins) { std::this_thread::yield(); continue; }
+
+        // Park; producers notify when they see sleeping_ set. The fence
+        // pairs with the one in submit(), so no wakeup is lost and the wait
+        // needs no timeout
+        std::unique_lock<std::mutex> lock(parkMutex_);
+        sleeping_.store(true, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (queue_.empty() && !stop_.load(std::memory_order_relaxed))
+            parkCv_.wait(lock);
+        sleeping_.store(false, std::memory_order_relaxed);
+        idle = 0;
+    }
+}
+
+template<typename K, typename V>
+size_t DelegatedCache<K,V>::drainBatch(std::vector<Request>& batch)
+{
+    batch.clear();
+    Request r;
+    while (batch.size() < maxBatch_ && queue_.tryPop(r))
+        batch.push_back(std::move(r));
+    return batch.size();
+}
+
+/** Deliver results only after the whole batch has been applied. Nothing
+ *  thrown here may leave the owner thread: an error goes to the waiter or
+ *  the future's promise, and is only counted when nobody can receive it */
+template<typename K, typename V>
+void DelegatedCache<K,V>::complete(std::vector<Request>& batch, const std::vector<bool>& found)
+{
+    for (size_t i = 0; i < batch.size(); ++i) {
+        Request& r = batch[i];
+        if (r.waiter) {
+            if (!r.error && found[i]) {
+                try {
+                    *r.waiter->out = r.value;
+                } catch (...) {
+                    r.error = std::current_exception();
+                }
+            }
+            r.waiter->found = found[i];
+            r.waiter->error = r.error;
+            r.waiter->done.store(true, std::memory_order_release);   // Waiter may leave right after
+            continue;
+        }
+        if (!r.error && r.callback) {
+            try {
+                r.callback(found[i], r.value);
+            } catch (...) {
+                r.error = std::current_exception();
+            }
+        }
+        if (!r.error) continue;
+        if (r.onError) r.onError(r.error);
+        else errors_.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+} // namespace Cache
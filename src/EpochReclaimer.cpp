@@ -0,0 +1,147 @@
+// ================================================================
+//  EpochReclaimer.cpp  ——  process-wide epoch-based reclamation
+// ================================================================
+
+#include "../include/EpochReclaimer.h"
+
+namespace Cache {
+
+// Owns the calling thread's record; hands it back for reuse on thread exit
+struct EpochThreadHolder {
+    EpochReclaimer::ThreadRecord* rec{nullptr};
+    ~EpochThreadHolder() {
+        if (rec) EpochReclaimer::instance().releaseRecord(rec);
+    }
+};
+
+EpochReclaimer& EpochReclaimer::instance()
+{
+    static EpochReclaimer domain;
+    return domain;
+}
+
+EpochReclaimer::~EpochReclaimer()
+{
+    // Process teardown: no reader can be active any more
+    for (auto& r : garbage_) r.deleter(r.ptr);
+    garbage_.clear();
+    ThreadRecord* rec = records_.load();
+    while (rec) {
+        ThreadRecord* next = rec->next;
+        delete rec;
+        rec = next;
+    }
+}
+
+// -- Guard --------------------------------------------------------
+// Publish the epoch we entered; re-check so the global epoch cannot
+// move on between our load and our store without us noticing.
+// ---------------------------------------------------------------
+EpochReclaimer::Guard::Guard()
+{
+    EpochReclaimer& d = EpochReclaimer::instance();
+    ThreadRecord* rec = d.localRecord();
+    if (rec->nesting++ > 0) return;
+
+    uint64_t e = d.globalEpoch_.load(std::memory_order_seq_cst);
+    for (;;) {
+        rec->epoch.store(e, std::memory_order_seq_cst);
+        uint64_t again = d.globalEpoch_.load(std::memory_order_seq_cst);
+        if (again == e) break;
+        e = again;
+    }
+}
+
+EpochReclaimer::Guard::~Guard()
+{
+    ThreadRecord* rec = EpochReclaimer::instance().localRecord();
+    if (--rec->nesting == 0)
+        rec->epoch.store(kIdle, std::memory_order_release);
+}
+
+// -- retire / reclaim ---------------------------------------------
+void EpochReclaimer::retire(void* ptr, void (*deleter)(void*))
+{
+    bool reclaim = false;
+    {
+        std::lock_guard<std::mutex> lock(garbageMtx_);
+        garbage_.push_back({ptr, deleter, globalEpoch_.load(std::memory_order_seq_cst)});
+        if (++retiresSinceReclaim_ >= kReclaimEvery) {
+            retiresSinceReclaim_ = 0;
+            reclaim = true;
+        }
+    }
+    if (reclaim) tryReclaim();
+}
+
+void EpochReclaimer::tryReclaim()
+{
+    tryAdvance();
+    uint64_t now = globalEpoch_.load(std::memory_order_acquire);
+
+    // Move the safe part out, run deleters without holding the lock
+    std::vector<Retired> ready;
+    {
+        std::lock_guard<std::mutex> lock(garbageMtx_);
+        size_t keep = 0;
+        for (size_t i = 0; i < garbage_.size(); ++i) {
+            if (garbage_[i].epoch + 2 <= now) ready.push_back(garbage_[i]);
+            else garbage_[keep++] = garbage_[i];
+        }
+        garbage_.resize(keep);
+    }
+    for (auto& r : ready) r.deleter(r.ptr);
+}
+
+size_t EpochReclaimer::pendingCount() const
+{
+    std::lock_guard<std::mutex> lock(garbageMtx_);
+    return garbage_.size();
+}
+
+/** Advance the global epoch if every pinned thread has already seen it */
+bool EpochReclaimer::tryAdvance()
+{
+    uint64_t e = globalEpoch_.load(std::memory_order_seq_cst);
+    for (ThreadRecord* rec = records_.load(std::memory_order_acquire); rec; rec = rec->next) {
+        uint64_t seen = rec->epoch.load(std::memory_order_seq_cst);
+        if (seen != kIdle && seen != e) return false;
+    }
+    return globalEpoch_.compare_exchange_strong(e, e + 1, std::memory_order_seq_cst);
+}
+
+// -- thread records -----------------------------------------------
+EpochReclaimer::ThreadRecord* EpochReclaimer::acquireRecord()
+{
+    // Reuse a record left behind by an exited thread first
+    for (ThreadRecord* rec = records_.load(std::memory_order_acquire); rec; rec = rec->next) {
+        bool expected = false;
+        if (!rec->inUse.load(std::memory_order_relaxed) &&
+            rec->inUse.compare_exchange_strong(expected, true, std::memory_order_acq_rel))
+            return rec;
+    }
+    auto* rec = new ThreadRecord();
+    rec->inUse.store(true, std::memory_order_relaxed);
+    ThreadRecord* head = records_.load(std::memory_order_relaxed);
+    do {
+        rec->next = head;
+    } while (!records_.compare_exchange_weak(head, rec, std::memory_order_release,
+                                             std::memory_order_relaxed));
+    return rec;
+}
+
+void EpochReclaimer::releaseRecord(ThreadRecord* rec)
+{
+    rec->nesting = 0;
+    rec->epoch.store(kIdle, std::memory_order_release);
+    rec->inUse.store(false, std::memory_order_release);
+}
+
+EpochReclaimer::ThreadRecord* EpochReclaimer::localRecord()
+{
+    thread_local EpochThreadHolder holder;
+    if (!holder.rec) holder.rec = acquireRecord();
+    return holder.rec;
+}
+
+} // namespace Cache
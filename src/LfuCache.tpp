@@ -6,25 +6,78 @@ namespace Cache {
 
 // Insert or update key
 // If it exists, update value and frequency; otherwise insert a new node and possibly evict
-template<typename Key, typename Value>
-void LfuCache<Key, Value>::put(const Key& key, const Value& value) {
-    std::lock_guard<std::mutex> lock(mutex_);
+// The value is copied before locking and only moved/swapped under the lock;
+// the victim (or the overwritten value, left in `fresh`) is destroyed after it,
+// once the removal notifications have been delivered
+template<typename Key, typename Value, typename Lock>
+void LfuCache<Key, Value, Lock>::put(const Key& key, const Value& value) {
+    Value fresh(value);
+    Removed removed;
+    {
+        std::lock_guard<Lock> lock(mutex_);
+        putLocked(key, fresh, removed);
+    }
+    removal_.deliver(removed.notes);
+    if (!maintenance_.enabled()) reclaimer_.step(kReclaimBatch);
+}
+
+// Same as put; the tags replace whatever the entry carried before
+template<typename Key, typename Value, typename Lock>
+void LfuCache<Key, Value, Lock>::put(const Key& key, const Value& value, const std::vector<Tag>& tags) {
+    Value fresh(value);
+    Removed removed;
+    {
+        std::lock_guard<Lock> lock(mutex_);
+        putLocked(key, fresh, removed, &tags);
+    }
+    removal_.deliver(removed.notes);
+    if (!maintenance_.enabled()) reclaimer_.step(kReclaimBatch);
+}
+
+// One lock hold for the whole group: each member is unlinked like a
+// compute() removal (pinned ones too); nodes die after the unlock
+template<typename Key, typename Value, typename Lock>
+size_t LfuCache<Key, Value, Lock>::invalidateTag(const Tag& tag) {
+    Removed removed;
+    size_t n;
+    {
+        std::lock_guard<Lock> lock(mutex_);
+        n = tags_.removeAll(tag, [&](Node* member) {
+            NodePtr node = nodeMap_.find(member->key)->second;
+            unlink(node);
+            retire(std::move(node), RemovalCause::Explicit, removed);
+        });
+    }
+    removal_.deliver(removed.notes);
+    return n;
+}
+
+template<typename Key, typename Value, typename Lock>
+void LfuCache<Key, Value, Lock>::putLocked(const Key& key, Value& fresh, Removed& removed,
+                                           const std::vector<Tag>* tags) {
     if (capacity_ == 0) return;
 
     auto it = nodeMap_.find(key);
     if (it != nodeMap_.end()) {
-        it->second->value = value;
+        std::swap(it->second->value, fresh);
+        if (removal_.enabled())
+            removed.notes.push_back({key, std::move(fresh), RemovalCause::Replaced});
+        if (tags) tags_.assign(it->second.get(), *tags);
         increaseFrequency(it->second);
         maybeAge();
         return;
     }
 
-    if (nodeMap_.size() >= static_cast<size_t>(capacity_)) {
-        evict();
+    // With maintenance on, only the high watermark forces an inline eviction
+    const size_t limit = maintenance_.enabled() ? maintenance_.high() : static_cast<size_t>(capacity_);
+    if (nodeMap_.size() >= limit) {
+        if (NodePtr victim = evict())
+            retire(std::move(victim), RemovalCause::Size, removed);
     }
 
-    auto node = std::make_shared<typename FreqList<Key, Value>::Node>(key, value);
+    auto node = std::make_shared<typename FreqList<Key, Value>::Node>(key, std::move(fresh));
     nodeMap_[key] = node;
+    if (tags) tags_.assign(node.get(), *tags);
 
     if (!freqMap_[1]) freqMap_[1] = std::make_unique<FreqList<Key, Value>>(1);
     freqMap_[1]->addNode(node);
@@ -34,25 +87,66 @@ void LfuCache<Key, Value>::put(const Key& key, const Value& value) {
     curTotalNum_ += 1; // Initial freq=1
     curAverageNum_ = nodeMap_.empty() ? 0 : (curTotalNum_ / static_cast<int>(nodeMap_.size()));
 
+    if (maintenance_.enabled() && nodeMap_.size() > static_cast<size_t>(capacity_))
+        maintenance_.request();
     maybeAge();
 }
 
 // Get value corresponding to key, return true and increase frequency if it exists, otherwise false
-template<typename Key, typename Value>
-bool LfuCache<Key, Value>::get(const Key& key, Value& value) {
-    std::lock_guard<std::mutex> lock(mutex_);
-    auto it = nodeMap_.find(key);
-    if (it == nodeMap_.end()) return false;
+template<typename Key, typename Value, typename Lock>
+bool LfuCache<Key, Value, Lock>::get(const Key& key, Value& value) {
+    bool hit = false;
+    {
+        std::lock_guard<Lock> lock(mutex_);
+        auto it = nodeMap_.find(key);
+        if (it != nodeMap_.end()) {
+            value = it->second->value;
+            increaseFrequency(it->second);
+            maybeAge();
+            hit = true;
+        }
+    }
+    if (!maintenance_.enabled()) reclaimer_.step(kReclaimBatch);
+    return hit;
+}
 
-    value = it->second->value;
-    increaseFrequency(it->second);
-    maybeAge();
-    return true;
+// One lock hold and one probe: a hit runs fn on the node's value itself.
+// A miss runs fn on a local value and inserts it through putLocked
+template<typename Key, typename Value, typename Lock>
+template<typename F>
+bool LfuCache<Key, Value, Lock>::compute(const Key& key, F&& fn) {
+    Removed removed;
+    bool present;
+    {
+        std::lock_guard<Lock> lock(mutex_);
+        auto it = nodeMap_.find(key);
+        if (it != nodeMap_.end()) {
+            NodePtr node = it->second;
+            present = fn(node->value, true);
+            if (present) {
+                increaseFrequency(node);
+                maybeAge();
+            } else {
+                unlink(node);
+                retire(std::move(node), RemovalCause::Explicit, removed);
+            }
+        } else {
+            Value value{};
+            present = fn(value, false) && capacity_ > 0;
+            if (present) putLocked(key, value, removed);
+        }
+    }
+    removal_.deliver(removed.notes);
+    return present;
 }
 
 // Move node to freq+1 list
-template<typename Key, typename Value>
-void LfuCache<Key, Value>::increaseFrequency(NodePtr node) {
+template<typename Key, typename Value, typename Lock>
+void LfuCache<Key, Value, Lock>::increaseFrequency(NodePtr node) {
+    if (node->pinId) {            // Off the lists: just count, unpin files it
+        ++node->freq;
+        return;
+    }
     const int oldFreq = node->freq;
 
     auto itList = freqMap_.find(oldFreq);
@@ -80,17 +174,17 @@ void LfuCache<Key, Value>::increaseFrequency(NodePtr node) {
 }
 
 // Evict the oldest node in the list with the current minimum frequency (list head)
-template<typename Key, typename Value>
-void LfuCache<Key, Value>::evict() {
-    if (nodeMap_.empty()) return;
+template<typename Key, typename Value, typename Lock>
+typename LfuCache<Key, Value, Lock>::NodePtr LfuCache<Key, Value, Lock>::evict() {
+    if (nodeMap_.empty()) return nullptr;
     if (freqMap_.count(minFreq_) == 0 || !freqMap_[minFreq_]) {
         // For safety, find the current minimum frequency
         updateMinFreq();
-        if (freqMap_.count(minFreq_) == 0 || !freqMap_[minFreq_]) return;
+        if (freqMap_.count(minFreq_) == 0 || !freqMap_[minFreq_]) return nullptr;
     }
 
     auto node = freqMap_[minFreq_]->getFirstNode();
-    if (!node || node->next_ == nullptr) return; // Empty or only sentinel, for safety
+    if (!node || node->next_ == nullptr) return nullptr; // Empty or only sentinel, for safety
 
     const int removedFreq = node->freq;
 
@@ -106,10 +200,115 @@ void LfuCache<Key, Value>::evict() {
     curTotalNum_ -= removedFreq;
     curTotalNum_ = std::max(0, curTotalNum_);
     curAverageNum_ = nodeMap_.empty() ? 0 : (curTotalNum_ / static_cast<int>(nodeMap_.size()));
+    return node;
 }
 
-template<typename Key, typename Value>
-void LfuCache<Key, Value>::updateMinFreq() {
+template<typename Key, typename Value, typename Lock>
+void LfuCache<Key, Value, Lock>::unlink(NodePtr node) {
+    if (!node->pinId) detachFromList(node);  // A pinned node is already off the lists
+    nodeMap_.erase(node->key);
+    curAverageNum_ = nodeMap_.empty() ? 0 : (curTotalNum_ / static_cast<int>(nodeMap_.size()));
+}
+
+template<typename Key, typename Value, typename Lock>
+void LfuCache<Key, Value, Lock>::detachFromList(NodePtr node) {
+    auto itList = freqMap_.find(node->freq);
+    if (itList != freqMap_.end() && itList->second) {
+        itList->second->removeNode(node);
+        if (itList->second->isEmpty()) {
+            freqMap_.erase(itList);
+            if (minFreq_ == node->freq) updateMinFreq();
+        }
+    }
+    curTotalNum_ = std::max(0, curTotalNum_ - node->freq);
+    curAverageNum_ = nodeMap_.empty() ? 0 : (curTotalNum_ / static_cast<int>(nodeMap_.size()));
+}
+
+// The first lease takes the node out of its FreqList (and out of the
+// totals aging works from), so evict() and aging never reach it
+template<typename Key, typename Value, typename Lock>
+typename LfuCache<Key, Value, Lock>::PinLease LfuCache<Key, Value, Lock>::pin(const Key& key) {
+    Value value;
+    uint64_t pinId;
+    {
+        std::lock_guard<Lock> lock(mutex_);
+        auto it = nodeMap_.find(key);
+        if (it == nodeMap_.end()) return PinLease();
+        NodePtr node = it->second;
+        if (node->pinId) {
+            pinId = node->pinId;
+            pins_.addRef(pinId);
+        } else {
+            pinId = pins_.acquire(key, node->value);
+            if (!pinId) return PinLease();   // Over the pinned-bytes budget
+            detachFromList(node);
+            node->pinId = pinId;
+        }
+        value = node->value;
+    }
+    return PinLease(this, key, std::move(value), pinId);
+}
+
+// Relinks at the node's current frequency; a stale pin id releases nothing
+template<typename Key, typename Value, typename Lock>
+void LfuCache<Key, Value, Lock>::unpin(const Key& key, uint64_t pinId) {
+    std::lock_guard<Lock> lock(mutex_);
+    auto it = nodeMap_.find(key);
+    if (it == nodeMap_.end() || it->second->pinId != pinId) return;
+    if (!pins_.release(pinId)) return;
+
+    NodePtr node = it->second;
+    node->pinId = 0;
+    auto& list = freqMap_[node->freq];
+    if (!list) list = std::make_unique<FreqList<Key, Value>>(node->freq);
+    list->addNode(node);
+    minFreq_ = freqMap_.size() == 1 ? node->freq : std::min(minFreq_, node->freq);
+    curTotalNum_ += node->freq;
+    curAverageNum_ = curTotalNum_ / static_cast<int>(nodeMap_.size());
+    maybeAge();
+}
+
+// Unlink the purged nodes from their lists first (dropping a long list
+// in one go would free its chain of next_ pointers recursively), then
+// release them from the index, reporting their values
+template<typename Key, typename Value, typename Lock>
+size_t LfuCache<Key, Value, Lock>::reclaimSome(Retired& old, size_t max) {
+    size_t n = 0;
+    while (n < max && !old.lists.empty()) {
+        auto it = old.lists.begin();
+        if (!it->second || it->second->isEmpty()) {
+            old.lists.erase(it);
+            continue;
+        }
+        it->second->removeNode(it->second->getFirstNode());
+        ++n;
+    }
+    if (removal_.enabled()) {
+        RemovalBatch<Key, Value> notes;
+        for (; n < max && !old.nodes.empty(); ++n) {
+            auto it = old.nodes.begin();
+            notes.push_back({it->first, std::move(it->second->value), RemovalCause::Explicit});
+            old.nodes.erase(it);
+        }
+        removal_.deliver(notes);
+    } else {
+        n += drainSome(old.nodes, max - n);
+    }
+    return n;
+}
+
+// Hand an unlinked node to the caller; with a listener, its value goes into the notification
+template<typename Key, typename Value, typename Lock>
+void LfuCache<Key, Value, Lock>::retire(NodePtr node, RemovalCause cause, Removed& removed) {
+    if (node->pinId) pins_.drop(node->pinId);  // Removed while leased: its leases release nothing
+    if (!node->tags.empty()) tags_.detach(node.get());
+    if (removal_.enabled())
+        removed.notes.push_back({node->key, std::move(node->value), cause});
+    removed.nodes.bury(std::move(node));
+}
+
+template<typename Key, typename Value, typename Lock>
+void LfuCache<Key, Value, Lock>::updateMinFreq() {
     // Simply find the minimum frequency that exists; after Aging, it usually returns to 1
     if (freqMap_.empty()) {
         minFreq_ = 1;
@@ -131,15 +330,19 @@ void LfuCache<Key, Value>::updateMinFreq() {
 
 // ===================== Aging implementation =====================
 
-template<typename Key, typename Value>
-void LfuCache<Key, Value>::maybeAge() {
-    if (!nodeMap_.empty() && curAverageNum_ > maxAverageNum_) {
+template<typename Key, typename Value, typename Lock>
+void LfuCache<Key, Value, Lock>::maybeAge() {
+    if (nodeMap_.empty() || curAverageNum_ <= maxAverageNum_) return;
+    if (!maintenance_.enabled()) {
         ageAll();
+    } else if (!agingDue_) {
+        agingDue_ = true;           // Hand the O(n) pass to the executor
+        maintenance_.request();
     }
 }
 
-template<typename Key, typename Value>
-void LfuCache<Key, Value>::ageAll() {
+template<typename Key, typename Value, typename Lock>
+void LfuCache<Key, Value, Lock>::ageAll() {
     // Halve the frequency of all nodes, minimum is 1
     // 1) Extract all nodes
     std::vector<NodePtr> all;
@@ -173,4 +376,98 @@ void LfuCache<Key, Value>::ageAll() {
     curAverageNum_ = nodeMap_.empty() ? 0 : (curTotalNum_ / static_cast<int>(nodeMap_.size()));
 }
 
+// ===================== Background maintenance =====================
+
+// Executor task: purged generations, then aging (it can free up low-frequency victims),
+// then eviction down to the low watermark. Victims are reported and
+// destroyed after the lock is released.
+template<typename Key, typename Value, typename Lock>
+void LfuCache<Key, Value, Lock>::runMaintenance() {
+    maintenance_.beginRun();
+    while (reclaimer_.step(kMaintenanceBatch) > 0) {}   // Purged generations first, never under mutex_
+
+    bool age;
+    {
+        std::lock_guard<Lock> lock(mutex_);
+        age = agingDue_;
+    }
+    if (age) ageIncrementally();
+
+    Removed removed;
+    for (bool done = false; !done; ) {
+        {
+            std::lock_guard<Lock> lock(mutex_);
+            while (nodeMap_.size() > maintenance_.low() && removed.nodes.size() < kMaintenanceBatch) {
+                NodePtr victim = evict();
+                if (!victim) break;
+                retire(std::move(victim), RemovalCause::Size, removed);
+            }
+            done = nodeMap_.size() <= maintenance_.low() || removed.nodes.empty();
+        }
+        removal_.deliver(removed.notes);
+        removed.notes.clear();
+        removed.nodes.clear();
+    }
+}
+
+// Same result as ageAll, one bucket batch per lock hold. Buckets are
+// processed in ascending order, so a halved node lands in a bucket
+// that has already been visited and is never halved twice by this
+// pass. (A node promoted by get() mid-pass may be.)
+template<typename Key, typename Value, typename Lock>
+void LfuCache<Key, Value, Lock>::ageIncrementally() {
+    std::vector<int> freqs;
+    {
+        std::lock_guard<Lock> lock(mutex_);
+        for (const auto& kv : freqMap_)
+            if (kv.first > 1) freqs.push_back(kv.first);
+    }
+    std::sort(freqs.begin(), freqs.end());
+
+    for (int freq : freqs) {
+        for (bool drained = false; !drained; ) {
+            std::lock_guard<Lock> lock(mutex_);
+            drained = ageBucketBatch(freq, kMaintenanceBatch);
+        }
+    }
+
+    std::lock_guard<Lock> lock(mutex_);
+    updateMinFreq();
+    agingDue_ = false;
+}
+
+// Move up to max nodes from bucket freq to bucket freq/2
+template<typename Key, typename Value, typename Lock>
+bool LfuCache<Key, Value, Lock>::ageBucketBatch(int freq, size_t max) {
+    auto it = freqMap_.find(freq);
+    if (it == freqMap_.end()) return true;
+    if (!it->second || it->second->isEmpty()) {
+        freqMap_.erase(it);
+        return true;
+    }
+
+    const int newFreq = std::max(1, freq / 2);
+    auto& target = freqMap_[newFreq];                 // May rehash: look up the source afterwards
+    if (!target) target = std::make_unique<FreqList<Key, Value>>(newFreq);
+    FreqList<Key, Value>* dst = target.get();
+    FreqList<Key, Value>* src = freqMap_[freq].get();
+
+    size_t moved = 0;
+    while (moved < max && !src->isEmpty()) {
+        NodePtr node = src->getFirstNode();
+        src->removeNode(node);
+        node->freq = newFreq;
+        dst->addNode(node);
+        ++moved;
+    }
+
+    curTotalNum_ -= static_cast<int>(moved) * (freq - newFreq);
+    curAverageNum_ = nodeMap_.empty() ? 0 : (curTotalNum_ / static_cast<int>(nodeMap_.size()));
+    minFreq_ = std::min(minFreq_, newFreq);
+
+    if (!src->isEmpty()) return false;
+    freqMap_.erase(freq);
+    return true;
+}
+
 } // namespace Cache
@@ -13,48 +13,156 @@ namespace Cache {
 /**
  * ctor: only save capacity and create dummyHead / dummyTail
  */
-template<typename K, typename V>
-LruCache<K,V>::LruCache(int capacity) : capacity_(capacity)
+template<typename K, typename V, template<typename, typename> class I, typename L>
+LruCache<K,V,I,L>::LruCache(int capacity, bool flatCombining)
+    : capacity_(capacity), nodeMap_(capacity > 0 ? capacity : 0)
 {
     if (capacity_ <= 0)
         throw std::invalid_argument("capacity must be > 0");
     initializeList();
+    if (flatCombining)
+        combiner_ = std::make_unique<FlatCombiner<PutRequest>>();
 }
 
 // -- public: put --------------------------------------------------
 // Write / update: O(1)
+// The value is copied before the lock is taken; under the lock it is
+// only moved or swapped. The evicted node (or, on update, the old
+// value left in `fresh`) is destroyed after the unlock, when this
+// frame unwinds; removal notifications are delivered just before.
+// In combining mode the request may be applied by another thread
+// that holds mutex_; put returns once it is applied.
 // ---------------------------------------------------------------
-template<typename K, typename V>
-void LruCache<K,V>::put(const K& key, const V& value)
+template<typename K, typename V, template<typename, typename> class I, typename L>
+void LruCache<K,V,I,L>::put(const K& key, const V& value)
 {
-    std::lock_guard<std::mutex> lock(mutex_);
-    auto it = nodeMap_.find(key);
-    if (it != nodeMap_.end()) {
-        updateExistingNode(it->second, value);
-        return;
+    putWith(key, value, PutOptions{});
+}
+
+// Same as put; the tags replace whatever the entry carried before
+template<typename K, typename V, template<typename, typename> class I, typename L>
+void LruCache<K,V,I,L>::put(const K& key, const V& value, const std::vector<Tag>& tags)
+{
+    putWith(key, value, PutOptions{&tags, nullptr});
+}
+
+// Same as put; the entry moves to the given tier
+template<typename K, typename V, template<typename, typename> class I, typename L>
+void LruCache<K,V,I,L>::put(const K& key, const V& value, Priority priority)
+{
+    putWith(key, value, PutOptions{nullptr, &priority});
+}
+
+template<typename K, typename V, template<typename, typename> class I, typename L>
+void LruCache<K,V,I,L>::putWith(const K& key, const V& value, const PutOptions& opts)
+{
+    V fresh(value);
+    Removed removed;
+    if (combiner_) {
+        combiner_->execute(mutex_, PutRequest{&key, &fresh, &removed, opts},
+                           [this](const PutRequest& r) { putLocked(*r.key, *r.value, *r.removed, r.opts); });
+    } else {
+        std::lock_guard<L> lock(mutex_);
+        putLocked(key, fresh, removed, opts);
+    }
+    removal_.deliver(removed.notes);
+}
+
+template<typename K, typename V, template<typename, typename> class I, typename L>
+PriorityStats LruCache<K,V,I,L>::priorityStats() const
+{
+    std::lock_guard<L> lock(mutex_);
+    return prioStats_;
+}
+
+// -- public: invalidateTag ---------------------------------------
+// One lock hold for the whole group: each member is unlinked like
+// remove() (pinned ones too); nodes die after the unlock
+// ---------------------------------------------------------------
+template<typename K, typename V, template<typename, typename> class I, typename L>
+size_t LruCache<K,V,I,L>::invalidateTag(const Tag& tag)
+{
+    Removed removed;
+    size_t n;
+    {
+        std::lock_guard<L> lock(mutex_);
+        n = tags_.removeAll(tag, [&](Node* member) {
+            NodePtr node;
+            nodeMap_.find(member->key_, node);
+            removeNode(node);
+            nodeMap_.erase(member->key_);
+            retire(std::move(node), RemovalCause::Explicit, removed);
+        });
+    }
+    removal_.deliver(removed.notes);
+    return n;
+}
+
+template<typename K, typename V, template<typename, typename> class I, typename L>
+size_t LruCache<K,V,I,L>::tagSize(const Tag& tag) const
+{
+    std::lock_guard<L> lock(mutex_);
+    return tags_.members(tag);
+}
+
+template<typename K, typename V, template<typename, typename> class I, typename L>
+size_t LruCache<K,V,I,L>::combinedPasses() const
+{
+    return combiner_ ? combiner_->batchedPasses() : 0;
+}
+
+template<typename K, typename V, template<typename, typename> class I, typename L>
+void LruCache<K,V,I,L>::enableMaintenance(std::shared_ptr<MaintenanceExecutor> executor,
+                                          size_t lowWatermark, size_t highWatermark)
+{
+    maintenance_.attach(std::move(executor), capacity_, lowWatermark, highWatermark,
+                        [this] { runMaintenance(); });
+}
+
+template<typename K, typename V, template<typename, typename> class I, typename L>
+void LruCache<K,V,I,L>::setRemovalListener(RemovalListener<K, V> listener,
+                                           std::shared_ptr<MaintenanceExecutor> executor)
+{
+    removal_.set(std::move(listener), std::move(executor));
+}
+
+template<typename K, typename V, template<typename, typename> class I, typename L>
+void LruCache<K,V,I,L>::putLocked(const K& key, V& value, Removed& removed, const PutOptions& opts)
+{
+    NodePtr node;
+    if (nodeMap_.find(key, node)) {
+        if (opts.priority && *opts.priority != node->priority_) {
+            --prioStats_.entries[tierOf(node->priority_)];
+            ++prioStats_.entries[tierOf(*opts.priority)];
+            node->priority_ = *opts.priority;  // The move to most recent relinks it in the new tier
+        }
+        updateExistingNode(node, value, removed);
+    } else {
+        node = addNewNode(key, std::move(value), removed, opts.priority ? *opts.priority : Priority::Normal);
     }
-    addNewNode(key, value);
+    if (opts.tags) tags_.assign(node.get(), *opts.tags);
 }
 
 // -- public: get  ----------------------------------------
 // If hit, return true and return value by reference; otherwise false
 // ---------------------------------------------------------------
-template<typename K, typename V>
-bool LruCache<K,V>::get(const K& key, V& value)
+template<typename K, typename V, template<typename, typename> class I, typename L>
+bool LruCache<K,V,I,L>::get(const K& key, V& value)
 {
-    std::lock_guard<std::mutex> lock(mutex_);
-    auto it = nodeMap_.find(key);
-    if (it == nodeMap_.end()) return false;
-    moveToMostRecent(it->second);
-    value = it->second->value_;
+    std::lock_guard<L> lock(mutex_);
+    NodePtr node;
+    if (!nodeMap_.find(key, node)) return false;
+    moveToMostRecent(node);
+    ++prioStats_.hits[tierOf(node->priority_)];
+    value = node->value_;
     return true;
 }
 
 // -- public: get  ----------------------------------------
 // If not hit, throw an exception
 // ---------------------------------------------------------------
-template<typename K, typename V>
-V LruCache<K,V>::get(const K& key)
+template<typename K, typename V, template<typename, typename> class I, typename L>
+V LruCache<K,V,I,L>::get(const K& key)
 {
     V tmp{};
     if (!get(key, tmp))
@@ -63,57 +171,180 @@ V LruCache<K,V>::get(const K& key)
 }
 
 // -- public: remove ----------------------------------------------
-template<typename K, typename V>
-void LruCache<K,V>::remove(const K& key)
+template<typename K, typename V, template<typename, typename> class I, typename L>
+void LruCache<K,V,I,L>::remove(const K& key)
+{
+    Removed removed;                       // Declared first: the node dies after the unlock
+    {
+        std::lock_guard<L> lock(mutex_);
+        NodePtr node;
+        if (!nodeMap_.find(key, node)) return;
+        removeNode(node);
+        nodeMap_.erase(key);
+        retire(std::move(node), RemovalCause::Explicit, removed);
+    }
+    removal_.deliver(removed.notes);
+}
+
+// -- public: compute ---------------------------------------------
+// One lock hold and one probe: a hit runs fn on node->value_ itself.
+// A miss runs fn on a local value first, so an exception leaves the
+// cache untouched and eviction only happens once fn chose to insert
+// ---------------------------------------------------------------
+template<typename K, typename V, template<typename, typename> class I, typename L>
+template<typename F>
+bool LruCache<K,V,I,L>::compute(const K& key, F&& fn)
+{
+    Removed removed;                       // Declared first: victims die after the unlock
+    bool present;
+    {
+        std::lock_guard<L> lock(mutex_);
+        NodePtr node;
+        if (nodeMap_.find(key, node)) {
+            ++prioStats_.hits[tierOf(node->priority_)];
+            present = fn(node->value_, true);
+            if (present) {
+                moveToMostRecent(node);
+            } else {
+                removeNode(node);
+                nodeMap_.erase(key);
+                retire(std::move(node), RemovalCause::Explicit, removed);
+            }
+        } else {
+            V value{};
+            present = fn(value, false);
+            if (present) addNewNode(key, std::move(value), removed);
+        }
+    }
+    removal_.deliver(removed.notes);
+    return present;
+}
+
+// -- public: pin -------------------------------------------------
+// The first lease unlinks the node from the list, so evictLeastRecent
+// and the maintenance task never reach it; it stays in nodeMap_ and
+// keeps counting towards capacity. The value is copied under the lock
+// (like get) and the lease is built after the unlock
+// ---------------------------------------------------------------
+template<typename K, typename V, template<typename, typename> class I, typename L>
+typename LruCache<K,V,I,L>::PinLease LruCache<K,V,I,L>::pin(const K& key)
+{
+    V value;
+    uint64_t pinId;
+    {
+        std::lock_guard<L> lock(mutex_);
+        NodePtr node;
+        if (!nodeMap_.find(key, node)) return PinLease();
+        if (node->pinId_) {
+            pinId = node->pinId_;
+            pins_.addRef(pinId);
+        } else {
+            pinId = pins_.acquire(key, node->value_);
+            if (!pinId) return PinLease();         // Over the pinned-bytes budget
+            removeNode(node);
+            node->prev_.reset();                   // removeNode is a no-op while pinned
+            node->next_.reset();
+            node->pinId_ = pinId;
+        }
+        value = node->value_;
+    }
+    return PinLease(this, key, std::move(value), pinId);
+}
+
+// A stale pin id (the entry was removed, maybe re-inserted) releases nothing
+template<typename K, typename V, template<typename, typename> class I, typename L>
+void LruCache<K,V,I,L>::unpin(const K& key, uint64_t pinId)
+{
+    std::lock_guard<L> lock(mutex_);
+    NodePtr node;
+    if (!nodeMap_.find(key, node) || node->pinId_ != pinId) return;
+    if (!pins_.release(pinId)) return;
+    node->pinId_ = 0;
+    insertNode(node);                              // Back as most recently used
+}
+
+template<typename K, typename V, template<typename, typename> class I, typename L>
+void LruCache<K,V,I,L>::setPinLimit(size_t maxPinnedBytes, Weigher weigher)
+{
+    std::lock_guard<L> lock(mutex_);
+    pins_.setLimit(maxPinnedBytes, std::move(weigher));
+}
+
+template<typename K, typename V, template<typename, typename> class I, typename L>
+size_t LruCache<K,V,I,L>::pinnedBytes() const
 {
-    std::lock_guard<std::mutex> lock(mutex_);
-    auto it = nodeMap_.find(key);
-    if (it == nodeMap_.end()) return;
-    removeNode(it->second);
-    nodeMap_.erase(it);
+    std::lock_guard<L> lock(mutex_);
+    return pins_.bytes();
+}
+
+template<typename K, typename V, template<typename, typename> class I, typename L>
+size_t LruCache<K,V,I,L>::pinnedEntries() const
+{
+    std::lock_guard<L> lock(mutex_);
+    return pins_.entries();
 }
 
 // -- private helpers ---------------------------------------------
 
-/** Create dummyHead / dummyTail and link them */
-template<typename K, typename V>
-void LruCache<K,V>::initializeList()
+/** Create dummyHead / dummyTail for every priority tier and link them */
+template<typename K, typename V, template<typename, typename> class I, typename L>
+void LruCache<K,V,I,L>::initializeList()
 {
-    dummyHead_ = std::make_shared<Node>(K{}, V{});
-    dummyTail_ = std::make_shared<Node>(K{}, V{});
-    dummyHead_->next_ = dummyTail_;
-    dummyTail_->prev_ = dummyHead_;
+    for (size_t t = 0; t < kPriorities; ++t) {
+        dummyHead_[t] = std::make_shared<Node>(K{}, V{});
+        dummyTail_[t] = std::make_shared<Node>(K{}, V{});
+        dummyHead_[t]->next_ = dummyTail_[t];
+        dummyTail_[t]->prev_ = dummyHead_[t];
+    }
 }
 
-template<typename K, typename V>
-void LruCache<K,V>::updateExistingNode(NodePtr node, const V& value)
+template<typename K, typename V, template<typename, typename> class I, typename L>
+void LruCache<K,V,I,L>::updateExistingNode(NodePtr node, V& value, Removed& removed)
 {
-    node->setValue(value);
+    std::swap(node->value_, value);
     moveToMostRecent(node);
+    if (removal_.enabled())
+        removed.notes.push_back({node->key_, std::move(value), RemovalCause::Replaced});
 }
 
-template<typename K, typename V>
-void LruCache<K,V>::addNewNode(const K& key, const V& value)
+/**
+ * With maintenance on, the cache may overshoot capacity up to the
+ * high watermark; only there does put evict inline (backpressure).
+ */
+template<typename K, typename V, template<typename, typename> class I, typename L>
+typename LruCache<K,V,I,L>::NodePtr LruCache<K,V,I,L>::addNewNode(const K& key, V&& value, Removed& removed,
+                                                                  Priority priority)
 {
-    if (static_cast<int>(nodeMap_.size()) >= capacity_)
-        evictLeastRecent();
+    const size_t limit = maintenance_.enabled() ? maintenance_.high() : static_cast<size_t>(capacity_);
+    if (nodeMap_.size() >= limit) {
+        if (NodePtr victim = evictLeastRecent())
+            retire(std::move(victim), RemovalCause::Size, removed);
+    }
 
-    NodePtr n = std::make_shared<Node>(key, value);
+    NodePtr n = std::make_shared<Node>(key, std::move(value));
+    n->priority_ = priority;
     insertNode(n);
-    nodeMap_[key] = n;
+    nodeMap_.insertOrAssign(key, n);
+    ++prioStats_.inserts[tierOf(priority)];
+    ++prioStats_.entries[tierOf(priority)];
+
+    if (maintenance_.enabled() && nodeMap_.size() > static_cast<size_t>(capacity_))
+        maintenance_.request();
+    return n;
 }
 
-/** Move node to the list tail (before dummyTail_) */
-template<typename K, typename V>
-void LruCache<K,V>::moveToMostRecent(NodePtr node)
+/** Move node to the tail of its tier's list (before dummyTail_) */
+template<typename K, typename V, template<typename, typename> class I, typename L>
+void LruCache<K,V,I,L>::moveToMostRecent(NodePtr node)
 {
+    if (node->pinId_) return;              // Off the list until unpinned
     removeNode(node);
     insertNode(node);
 }
 
 /** Disconnect node from the list */
-template<typename K, typename V>
-void LruCache<K,V>::removeNode(NodePtr node)
+template<typename K, typename V, template<typename, typename> class I, typename L>
+void LruCache<K,V,I,L>::removeNode(NodePtr node)
 {
     auto prev = node->prev_.lock();
     auto next = node->next_;
@@ -123,24 +354,70 @@ void LruCache<K,V>::removeNode(NodePtr node)
     }
 }
 
-/** Insert node at the tail */
-template<typename K, typename V>
-void LruCache<K,V>::insertNode(NodePtr node)
+/** Insert node at the tail of its tier's list */
+template<typename K, typename V, template<typename, typename> class I, typename L>
+void LruCache<K,V,I,L>::insertNode(NodePtr node)
 {
-    node->next_ = dummyTail_;
-    node->prev_ = dummyTail_->prev_;
-    dummyTail_->prev_.lock()->next_ = node;
-    dummyTail_->prev_ = node;
+    const NodePtr& tail = dummyTail_[tierOf(node->priority_)];
+    node->next_ = tail;
+    node->prev_ = tail->prev_;
+    tail->prev_.lock()->next_ = node;
+    tail->prev_ = node;
 }
 
-/** Delete the real node at the head of the list (least recently used) */
-template<typename K, typename V>
-void LruCache<K,V>::evictLeastRecent()
+/** Delete the real node at the head of the lowest non-empty tier
+ *  (its least recently used); at most kPriorities sentinel checks */
+template<typename K, typename V, template<typename, typename> class I, typename L>
+typename LruCache<K,V,I,L>::NodePtr LruCache<K,V,I,L>::evictLeastRecent()
 {
-    NodePtr lru = dummyHead_->next_;
-    if (lru == dummyTail_) return; // Shouldn't happen
+    size_t t = 0;
+    while (t < kPriorities && dummyHead_[t]->next_ == dummyTail_[t]) ++t;
+    if (t == kPriorities) return nullptr;  // Empty, or everything pinned
+    NodePtr lru = dummyHead_[t]->next_;
+    ++prioStats_.evictions[t];
     removeNode(lru);
+    lru->next_.reset();                    // Victim no longer keeps its neighbour alive
     nodeMap_.erase(lru->key_);
+    return lru;
+}
+
+/** Hand an unlinked node to the caller; with a listener, its value goes into the notification.
+ *  Only explicit removals ever retire a pinned node */
+template<typename K, typename V, template<typename, typename> class I, typename L>
+void LruCache<K,V,I,L>::retire(NodePtr node, RemovalCause cause, Removed& removed)
+{
+    if (node->pinId_) pins_.drop(node->pinId_);   // Removed while leased: its leases release nothing
+    if (!node->tags_.empty()) tags_.detach(node.get());
+    --prioStats_.entries[tierOf(node->priority_)];
+    if (removal_.enabled())
+        removed.notes.push_back({node->key_, std::move(node->value_), cause});
+    removed.nodes.bury(std::move(node));
+}
+
+/**
+ * Executor task: evict down to the low watermark in batches, so puts
+ * wait at most one batch for the lock; victims (and their values) are
+ * destroyed after it is released.
+ */
+template<typename K, typename V, template<typename, typename> class I, typename L>
+void LruCache<K,V,I,L>::runMaintenance()
+{
+    maintenance_.beginRun();
+    Removed removed;
+    for (bool done = false; !done; ) {
+        {
+            std::lock_guard<L> lock(mutex_);
+            while (nodeMap_.size() > maintenance_.low() && removed.nodes.size() < kMaintenanceBatch) {
+                NodePtr victim = evictLeastRecent();
+                if (!victim) break;
+                retire(std::move(victim), RemovalCause::Size, removed);
+            }
+            done = nodeMap_.size() <= maintenance_.low() || removed.nodes.empty();
+        }
+        removal_.deliver(removed.notes);   // Victims are reported and destroyed off the lock
+        removed.notes.clear();
+        removed.nodes.clear();
+    }
 }
 
 // ========= LruKCache =============================
@@ -208,38 +485,123 @@ V LruKCache<K, V>::get(const K& key)
 // ========= HashLruCaches(分片) =================================
 
 // 构造函数
-template<typename K, typename V>
-HashLruCaches<K,V>::HashLruCaches(size_t cap, int slice)
+template<typename K, typename V, template<typename, typename> class I, typename L>
+HashLruCaches<K,V,I,L>::HashLruCaches(size_t cap, int slice, bool flatCombining)
     : capacity_(cap)
 {
     sliceNum_ = slice > 0 ? slice : std::thread::hardware_concurrency(); // Default by CPU cores
     size_t sliceCap = std::ceil(capacity_ / static_cast<double>(sliceNum_)); // Capacity of each slice
 
     for (int i = 0; i < sliceNum_; ++i) {
-        lruSlices_.emplace_back(std::make_unique<LruCache<K, V>>(sliceCap));
+        lruSlices_.emplace_back(std::make_unique<Slice>(sliceCap, flatCombining));
     }
 }
 
 // Hash slices
-template<typename K, typename V>
-size_t HashLruCaches<K,V>::calcSliceIndex(const K& key) const {
+template<typename K, typename V, template<typename, typename> class I, typename L>
+size_t HashLruCaches<K,V,I,L>::calcSliceIndex(const K& key) const {
     return std::hash<K>{}(key) % sliceNum_;
 }
 
 // put/get call the target slice
-template<typename K, typename V>
-void HashLruCaches<K,V>::put(const K& key, const V& value) {
-    lruSlices_[calcSliceIndex(key)]->put(key, value);
+template<typename K, typename V, template<typename, typename> class I, typename L>
+void HashLruCaches<K,V,I,L>::put(const K& key, const V& value) {
+    lruSlices_[calcSliceIndex(key)]->value.put(key, value);
 }
 
-template<typename K, typename V>
-bool HashLruCaches<K,V>::get(const K& key, V& value) {
-    return lruSlices_[calcSliceIndex(key)]->get(key, value);
+template<typename K, typename V, template<typename, typename> class I, typename L>
+bool HashLruCaches<K,V,I,L>::get(const K& key, V& value) {
+    return lruSlices_[calcSliceIndex(key)]->value.get(key, value);
 }
 
-template<typename K, typename V>
-V HashLruCaches<K,V>::get(const K& key) {
-    return lruSlices_[calcSliceIndex(key)]->get(key);
+template<typename K, typename V, template<typename, typename> class I, typename L>
+V HashLruCaches<K,V,I,L>::get(const K& key) {
+    return lruSlices_[calcSliceIndex(key)]->value.get(key);
+}
+
+template<typename K, typename V, template<typename, typename> class I, typename L>
+void HashLruCaches<K,V,I,L>::remove(const K& key) {
+    lruSlices_[calcSliceIndex(key)]->value.remove(key);
+}
+
+template<typename K, typename V, template<typename, typename> class I, typename L>
+void HashLruCaches<K,V,I,L>::put(const K& key, const V& value, const std::vector<Tag>& tags) {
+    lruSlices_[calcSliceIndex(key)]->value.put(key, value, tags);
+}
+
+template<typename K, typename V, template<typename, typename> class I, typename L>
+void HashLruCaches<K,V,I,L>::put(const K& key, const V& value, Priority priority) {
+    lruSlices_[calcSliceIndex(key)]->value.put(key, value, priority);
+}
+
+template<typename K, typename V, template<typename, typename> class I, typename L>
+PriorityStats HashLruCaches<K,V,I,L>::priorityStats() const {
+    PriorityStats total;
+    for (const auto& slice : lruSlices_) {
+        PriorityStats s = slice->value.priorityStats();
+        for (size_t t = 0; t < kPriorities; ++t) {
+            total.hits[t]      += s.hits[t];
+            total.inserts[t]   += s.inserts[t];
+            total.evictions[t] += s.evictions[t];
+            total.entries[t]   += s.entries[t];
+        }
+    }
+    return total;
+}
+
+// Members of a tag can live on any slice
+template<typename K, typename V, template<typename, typename> class I, typename L>
+size_t HashLruCaches<K,V,I,L>::invalidateTag(const Tag& tag) {
+    size_t n = 0;
+    for (auto& slice : lruSlices_) n += slice->value.invalidateTag(tag);
+    return n;
+}
+
+template<typename K, typename V, template<typename, typename> class I, typename L>
+size_t HashLruCaches<K,V,I,L>::tagSize(const Tag& tag) const {
+    size_t n = 0;
+    for (const auto& slice : lruSlices_) n += slice->value.tagSize(tag);
+    return n;
+}
+
+template<typename K, typename V, template<typename, typename> class I, typename L>
+template<typename F>
+bool HashLruCaches<K,V,I,L>::compute(const K& key, F&& fn) {
+    return lruSlices_[calcSliceIndex(key)]->value.compute(key, std::forward<F>(fn));
+}
+
+template<typename K, typename V, template<typename, typename> class I, typename L>
+typename HashLruCaches<K,V,I,L>::PinLease HashLruCaches<K,V,I,L>::pin(const K& key) {
+    return lruSlices_[calcSliceIndex(key)]->value.pin(key);
+}
+
+template<typename K, typename V, template<typename, typename> class I, typename L>
+void HashLruCaches<K,V,I,L>::setPinLimit(size_t maxPinnedBytes, typename PinTable<K, V>::Weigher weigher) {
+    for (auto& slice : lruSlices_)
+        slice->value.setPinLimit(maxPinnedBytes / sliceNum_, weigher);
+}
+
+template<typename K, typename V, template<typename, typename> class I, typename L>
+size_t HashLruCaches<K,V,I,L>::pinnedBytes() const {
+    size_t bytes = 0;
+    for (const auto& slice : lruSlices_) bytes += slice->value.pinnedBytes();
+    return bytes;
+}
+
+template<typename K, typename V, template<typename, typename> class I, typename L>
+void HashLruCaches<K,V,I,L>::enableMaintenance(std::shared_ptr<MaintenanceExecutor> executor,
+                                               size_t lowWatermark, size_t highWatermark) {
+    size_t sliceLow  = lowWatermark / sliceNum_;
+    size_t sliceHigh = (highWatermark + sliceNum_ - 1) / sliceNum_;
+    for (auto& slice : lruSlices_)
+        slice->value.enableMaintenance(executor, sliceLow, sliceHigh);
+}
+
+template<typename K, typename V, template<typename, typename> class I, typename L>
+void HashLruCaches<K,V,I,L>::setRemovalListener(RemovalListener<K, V> listener,
+                                                std::shared_ptr<MaintenanceExecutor> executor) {
+    for (auto& slice : lruSlices_)
+        slice->value.setRemovalListener(listener, executor);
 }
 
 
@@ -0,0 +1,98 @@
+// ================================================================
+//  MaintenanceExecutor.cpp  ——  background thread for cache upkeep
+// ================================================================
+
+#include "../include/MaintenanceExecutor.h"
+
+#include <chrono>
+
+namespace Cache {
+
+// Waits use a short timeout as a safety net; every state change notifies
+static constexpr std::chrono::milliseconds kWaitSlice{10};
+
+MaintenanceExecutor::MaintenanceExecutor()
+{
+    thread_ = std::thread([this] { loop(); });
+}
+
+MaintenanceExecutor::~MaintenanceExecutor()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    workCv_.notify_one();
+    thread_.join();
+}
+
+MaintenanceExecutor::TaskId MaintenanceExecutor::add(Task task)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    TaskId id = nextId_++;
+    tasks_[id].task = std::move(task);
+    return id;
+}
+
+void MaintenanceExecutor::remove(TaskId id)
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (running_ == id) idleCv_.wait_for(lock, kWaitSlice);
+    tasks_.erase(id);   // A stale queue_ entry is skipped by loop()
+}
+
+void MaintenanceExecutor::schedule(TaskId id)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = tasks_.find(id);
+        if (it == tasks_.end() || it->second.pending) return;
+        it->second.pending = true;
+        queue_.push_back(id);
+    }
+    workCv_.notify_one();
+}
+
+void MaintenanceExecutor::drain()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (!queue_.empty() || running_ != 0) idleCv_.wait_for(lock, kWaitSlice);
+}
+
+size_t MaintenanceExecutor::runs() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return runs_;
+}
+
+// -- executor thread ----------------------------------------------
+// The task runs without mutex_ held; `pending` is cleared first, so
+// work that arrives during the run schedules another one.
+// ---------------------------------------------------------------
+void MaintenanceExecutor::loop()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    for (;;) {
+        while (queue_.empty() && !stop_) workCv_.wait_for(lock, kWaitSlice);
+        if (stop_) break;
+
+        TaskId id = queue_.front();
+        queue_.pop_front();
+        auto it = tasks_.find(id);
+        if (it == tasks_.end()) continue;                  // Removed while queued
+        it->second.pending = false;
+        Task task = it->second.task;
+        running_ = id;
+
+        lock.unlock();
+        task();
+        lock.lock();
+
+        running_ = 0;
+        ++runs_;
+        idleCv_.notify_all();
+    }
+    idleCv_.notify_all();
+}
+
+} // namespace Cache
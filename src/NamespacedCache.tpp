@@ -0,0 +1,255 @@
+#pragma once
+#include <stdexcept>
+#include "../include/NamespacedCache.h"
+
+namespace Cache {
+
+template<typename K, typename V, typename L>
+NamespacedCache<K,V,L>::NamespacedCache(size_t capacity)
+    : capacity_(capacity)
+{
+    if (capacity_ == 0)
+        throw std::invalid_argument("capacity must be > 0");
+}
+
+template<typename K, typename V, typename L>
+NamespaceId NamespacedCache<K,V,L>::open(const std::string& name, size_t minEntries, size_t maxEntries)
+{
+    std::lock_guard<L> lock(mutex_);
+    auto it = names_.find(name);
+    if (it != names_.end()) return it->second;
+
+    checkQuota(minEntries, maxEntries, 0);
+    const NamespaceId id = static_cast<NamespaceId>(spaces_.size());
+    auto ns = std::make_unique<Namespace>();
+    ns->name = name;
+    ns->stats.minEntries = minEntries;
+    ns->stats.maxEntries = maxEntries;
+    spaces_.push_back(std::move(ns));
+    names_.emplace(name, id);
+    reservedMin_ += minEntries;
+    return id;
+}
+
+// Lowering the max evicts the namespace's own LRU entries down to it
+template<typename K, typename V, typename L>
+void NamespacedCache<K,V,L>::setQuota(NamespaceId id, size_t minEntries, size_t maxEntries)
+{
+    Graveyard<V> dead;
+    std::lock_guard<L> lock(mutex_);
+    Namespace& ns = space(id);
+    checkQuota(minEntries, maxEntries, ns.stats.minEntries);
+    reservedMin_ = reservedMin_ - ns.stats.minEntries + minEntries;
+    ns.stats.minEntries = minEntries;
+    ns.stats.maxEntries = maxEntries;
+    while (ns.lru.size() > maxEntries) evictFrom(id, dead);
+    sync(id);
+}
+
+// -- public: put --------------------------------------------------
+// The value is copied before the lock; an overwritten value (left in
+// fresh) and any victim are destroyed after the unlock
+// ---------------------------------------------------------------
+template<typename K, typename V, typename L>
+void NamespacedCache<K,V,L>::put(NamespaceId id, const K& key, const V& value)
+{
+    V fresh(value);
+    Graveyard<V> dead;
+    {
+        std::lock_guard<L> lock(mutex_);
+        Namespace& ns = space(id);
+        ++ns.stats.puts;
+        auto it = ns.index.find(key);
+        if (it != ns.index.end()) {
+            auto entry = it->second;
+            std::swap(entry->value, fresh);
+            entry->stamp = ++clock_;
+            ns.lru.splice(ns.lru.begin(), ns.lru, entry);
+        } else {
+            if (ns.stats.maxEntries == 0 || !makeRoom(id, dead)) return;
+            ns.lru.push_front(Entry{key, std::move(fresh), ++clock_});
+            ns.index.emplace(key, ns.lru.begin());
+            ++size_;
+        }
+        sync(id);
+    }
+    reclaimer_.step(kReclaimBatch);
+}
+
+template<typename K, typename V, typename L>
+bool NamespacedCache<K,V,L>::get(NamespaceId id, const K& key, V& value)
+{
+    bool hit = false;
+    {
+        std::lock_guard<L> lock(mutex_);
+        Namespace& ns = space(id);
+        auto it = ns.index.find(key);
+        if (it == ns.index.end()) {
+            ++ns.stats.misses;
+        } else {
+            ++ns.stats.hits;
+            auto entry = it->second;
+            value = entry->value;
+            entry->stamp = ++clock_;
+            ns.lru.splice(ns.lru.begin(), ns.lru, entry);
+            sync(id);                              // No-op unless entry was the LRU one
+            hit = true;
+        }
+    }
+    reclaimer_.step(kReclaimBatch);
+    return hit;
+}
+
+template<typename K, typename V, typename L>
+bool NamespacedCache<K,V,L>::remove(NamespaceId id, const K& key)
+{
+    Graveyard<V> dead;
+    std::lock_guard<L> lock(mutex_);
+    Namespace& ns = space(id);
+    auto it = ns.index.find(key);
+    if (it == ns.index.end()) return false;
+    auto entry = it->second;
+    dead.bury(std::move(entry->value));
+    ns.index.erase(it);
+    ns.lru.erase(entry);
+    --size_;
+    sync(id);
+    return true;
+}
+
+// -- public: flush ------------------------------------------------
+// O(1) under the lock: the namespace's list and index are swapped
+// into a retired generation, torn down in batches by later calls
+// ---------------------------------------------------------------
+template<typename K, typename V, typename L>
+size_t NamespacedCache<K,V,L>::flush(NamespaceId id)
+{
+    auto old = std::make_shared<Retired>();
+    size_t n;
+    {
+        std::lock_guard<L> lock(mutex_);
+        Namespace& ns = space(id);
+        n = ns.lru.size();
+        ns.lru.swap(old->lru);
+        ns.index.swap(old->index);
+        size_ -= n;
+        ++ns.stats.flushes;
+        sync(id);
+    }
+    if (n > 0) {
+        reclaimer_.retire([old](size_t max) {
+            size_t done = drainSome(old->index, max);
+            return done + drainSome(old->lru, max - done);
+        });
+    }
+    return n;
+}
+
+template<typename K, typename V, typename L>
+NamespaceStats NamespacedCache<K,V,L>::stats(NamespaceId id) const
+{
+    ReadGuard<L> lock(mutex_);
+    const Namespace& ns = space(id);
+    NamespaceStats s = ns.stats;
+    s.size = ns.lru.size();
+    return s;
+}
+
+template<typename K, typename V, typename L>
+size_t NamespacedCache<K,V,L>::namespaces() const
+{
+    ReadGuard<L> lock(mutex_);
+    return spaces_.size();
+}
+
+template<typename K, typename V, typename L>
+size_t NamespacedCache<K,V,L>::size() const
+{
+    ReadGuard<L> lock(mutex_);
+    return size_;
+}
+
+// -- private helpers ---------------------------------------------
+
+template<typename K, typename V, typename L>
+typename NamespacedCache<K,V,L>::Namespace& NamespacedCache<K,V,L>::space(NamespaceId id)
+{
+    if (id >= spaces_.size())
+        throw std::out_of_range("unknown namespace id");
+    return *spaces_[id];
+}
+
+template<typename K, typename V, typename L>
+const typename NamespacedCache<K,V,L>::Namespace& NamespacedCache<K,V,L>::space(NamespaceId id) const
+{
+    if (id >= spaces_.size())
+        throw std::out_of_range("unknown namespace id");
+    return *spaces_[id];
+}
+
+template<typename K, typename V, typename L>
+void NamespacedCache<K,V,L>::checkQuota(size_t minEntries, size_t maxEntries, size_t oldMin) const
+{
+    if (minEntries > maxEntries)
+        throw std::invalid_argument("min quota must not exceed max quota");
+    if (reservedMin_ - oldMin + minEntries > capacity_)
+        throw std::invalid_argument("min quotas must add up to at most the capacity");
+}
+
+/** A namespace is a victim candidate while it holds more than its min;
+ *  its key is the stamp of its LRU entry. Only touches victims_ when
+ *  that changed */
+template<typename K, typename V, typename L>
+void NamespacedCache<K,V,L>::sync(NamespaceId id)
+{
+    Namespace& ns = space(id);
+    const bool eligible = ns.lru.size() > ns.stats.minEntries;
+    const uint64_t stamp = eligible ? ns.lru.back().stamp : 0;
+    if (ns.listed && eligible && stamp == ns.victimStamp) return;
+    if (ns.listed) {
+        victims_.erase({ns.victimStamp, id});
+        ns.listed = false;
+    }
+    if (eligible) {
+        victims_.emplace(stamp, id);
+        ns.victimStamp = stamp;
+        ns.listed = true;
+    }
+}
+
+template<typename K, typename V, typename L>
+void NamespacedCache<K,V,L>::evictFrom(NamespaceId id, Graveyard<V>& dead)
+{
+    Namespace& ns = space(id);
+    Entry& victim = ns.lru.back();
+    dead.bury(std::move(victim.value));
+    ns.index.erase(victim.key);
+    ns.lru.pop_back();
+    --size_;
+    ++ns.stats.evictions;
+    sync(id);
+}
+
+/** At its max: the namespace pays for itself. Otherwise, when the cache
+ *  is full, the oldest entry of any namespace above its min goes; if
+ *  every namespace is at or below its min, the inserting namespace
+ *  replaces its own oldest entry. False: nothing may go, skip the insert */
+template<typename K, typename V, typename L>
+bool NamespacedCache<K,V,L>::makeRoom(NamespaceId id, Graveyard<V>& dead)
+{
+    Namespace& ns = space(id);
+    if (ns.lru.size() >= ns.stats.maxEntries) {
+        evictFrom(id, dead);
+        return true;
+    }
+    if (size_ < capacity_) return true;
+    if (!victims_.empty())
+        evictFrom(victims_.begin()->second, dead);
+    else if (!ns.lru.empty())
+        evictFrom(id, dead);
+    else
+        return false;                              // Empty, and every other namespace at its min
+    return true;
+}
+
+} // namespace Cache
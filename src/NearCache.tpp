@@ -0,0 +1,138 @@
+#pragma once
+#include <stdexcept>
+#include "../include/NearCache.h"
+
+namespace Cache {
+
+// =============== NearCache implementation =============== //
+
+template<typename K, typename V, typename B>
+template<typename... Args>
+NearCache<K,V,B>::NearCache(size_t l0Slots, Args&&... backendArgs)
+    : backend_(std::forward<Args>(backendArgs)...),
+      slotMask_(roundUpPow2(l0Slots == 0 ? 1 : l0Slots) - 1),
+      stampCount_(kStampCount),
+      stamps_(new std::atomic<uint64_t>[kStampCount]),
+      alive_(std::make_shared<std::atomic<bool>>(true))
+{
+    id_ = nextInstanceId();
+    for (size_t i = 0; i < stampCount_; ++i)
+        stamps_[i].store(0, std::memory_order_relaxed);
+}
+
+template<typename K, typename V, typename B>
+NearCache<K,V,B>::~NearCache()
+{
+    // Threads prune tables of dead instances the next time they create one
+    alive_->store(false, std::memory_order_release);
+}
+
+// -- public: put --------------------------------------------------
+// Backend first, then bump the stamp: a reader that still sees the
+// old stamp will at worst cache a value it must re-validate later.
+// ---------------------------------------------------------------
+template<typename K, typename V, typename B>
+void NearCache<K,V,B>::put(const K& key, const V& value)
+{
+    size_t h = std::hash<K>{}(key);
+    backend_.put(key, value);
+    stamps_[stampIndex(h)].fetch_add(1, std::memory_order_release);
+    localTable().slots[h & slotMask_].valid = false;
+}
+
+// -- public: get --------------------------------------------------
+// L0 hit: no shared lock at all. Miss: read stamp + epoch *before*
+// going to the backend, and remember them with the fetched value.
+// ---------------------------------------------------------------
+template<typename K, typename V, typename B>
+bool NearCache<K,V,B>::get(const K& key, V& value)
+{
+    size_t h = std::hash<K>{}(key);
+    Slot& slot = localTable().slots[h & slotMask_];
+    uint64_t version = stamps_[stampIndex(h)].load(std::memory_order_acquire);
+    uint64_t epoch   = epoch_.load(std::memory_order_acquire);
+
+    if (slot.valid && slot.version == version && slot.epoch == epoch && slot.key == key) {
+        value = slot.value;
+        return true;
+    }
+
+    if (!backend_.get(key, value)) return false;
+    slot.valid   = true;
+    slot.key     = key;
+    slot.value   = value;
+    slot.version = version;
+    slot.epoch   = epoch;
+    return true;
+}
+
+template<typename K, typename V, typename B>
+V NearCache<K,V,B>::get(const K& key)
+{
+    V tmp{};
+    if (!get(key, tmp))
+        throw std::runtime_error("Key not found in near cache");
+    return tmp;
+}
+
+template<typename K, typename V, typename B>
+void NearCache<K,V,B>::remove(const K& key)
+{
+    size_t h = std::hash<K>{}(key);
+    backend_.remove(key);
+    stamps_[stampIndex(h)].fetch_add(1, std::memory_order_release);
+    localTable().slots[h & slotMask_].valid = false;
+}
+
+template<typename K, typename V, typename B>
+void NearCache<K,V,B>::invalidateAll()
+{
+    epoch_.fetch_add(1, std::memory_order_release);
+}
+
+// -- private helpers ---------------------------------------------
+
+/** Find (or lazily create) the calling thread's L0 table for this instance */
+template<typename K, typename V, typename B>
+typename NearCache<K,V,B>::Table& NearCache<K,V,B>::localTable()
+{
+    thread_local std::vector<std::unique_ptr<Table>> tables;
+    thread_local Table* last = nullptr;
+
+    if (last && last->ownerId == id_) return *last;
+    for (auto& t : tables) {
+        if (t->ownerId == id_) { last = t.get(); return *last; }
+    }
+
+    // Slow path: drop tables whose instance is gone, then allocate ours
+    tables.erase(std::remove_if(tables.begin(), tables.end(),
+                     [](const std::unique_ptr<Table>& t) {
+                         return !t->alive->load(std::memory_order_acquire);
+                     }),
+                 tables.end());
+    auto table = std::make_unique<Table>();
+    table->ownerId = id_;
+    table->alive   = alive_;
+    table->slots.resize(slotMask_ + 1);
+    tables.push_back(std::move(table));
+    last = tables.back().get();
+    return *last;
+}
+
+/** One counter per NearCache type, matching the scope of the thread-local tables */
+template<typename K, typename V, typename B>
+uint64_t NearCache<K,V,B>::nextInstanceId()
+{
+    static std::atomic<uint64_t> nextId{1};
+    return nextId.fetch_add(1, std::memory_order_relaxed);
+}
+
+template<typename K, typename V, typename B>
+size_t NearCache<K,V,B>::roundUpPow2(size_t n)
+{
+    size_t p = 1;
+    while (p < n) p <<= 1;
+    return p;
+}
+
+} // namespace Cache
@@ -0,0 +1,104 @@
+#pragma once
+#include <stdexcept>
+#include "../include/NegativeCache.h"
+
+namespace Cache {
+
+// =============== NegativeCache implementation =============== //
+
+template<typename K, typename H>
+NegativeCache<K,H>::NegativeCache(size_t capacity, std::chrono::milliseconds ttl)
+    : ttlMs_(ttl.count())
+{
+    if (capacity == 0 || ttl.count() <= 0)
+        throw std::invalid_argument("NegativeCache needs a capacity and a positive ttl");
+    size_t sets = 1;
+    while (sets * kWays < capacity) sets <<= 1;
+    slots_.resize(sets * kWays);
+    setMask_ = sets - 1;
+}
+
+template<typename K, typename H>
+uint64_t NegativeCache<K,H>::mix(uint64_t h)
+{
+    h ^= h >> 30; h *= 0xbf58476d1ce4e5b9ULL;
+    h ^= h >> 27; h *= 0x94d049bb133111ebULL;
+    h ^= h >> 31;
+    return h;
+}
+
+template<typename K, typename H>
+int64_t NegativeCache<K,H>::millis(Clock::time_point t)
+{
+    return std::chrono::duration_cast<std::chrono::milliseconds>(t.time_since_epoch()).count();
+}
+
+template<typename K, typename H>
+uint64_t NegativeCache<K,H>::fingerprint(const K& key) const
+{
+    uint64_t f = mix(static_cast<uint64_t>(H{}(key)));
+    return f ? f : 1;                                        // 0 marks an empty slot
+}
+
+// Same key → refresh its expiry; otherwise an empty or expired way,
+// else the way that would expire first
+template<typename K, typename H>
+void NegativeCache<K,H>::insert(const K& key, Clock::time_point now)
+{
+    uint64_t f   = fingerprint(key);
+    size_t   set = setOf(f);
+    int64_t  t   = millis(now);
+    Slot*    base = &slots_[set * kWays];
+
+    std::lock_guard<std::mutex> lock(stripes_[set % kStripes]);
+    Slot* victim = base;
+    for (size_t w = 0; w < kWays; ++w) {
+        Slot& s = base[w];
+        if (s.fingerprint == f) { victim = &s; break; }
+        if (s.fingerprint == 0 || s.expires <= t) victim = &s;
+        else if (victim->fingerprint != 0 && victim->expires > t && s.expires < victim->expires) victim = &s;
+    }
+    victim->fingerprint = f;
+    victim->expires     = t + ttlMs_;
+}
+
+template<typename K, typename H>
+bool NegativeCache<K,H>::contains(const K& key, Clock::time_point now)
+{
+    uint64_t f   = fingerprint(key);
+    size_t   set = setOf(f);
+    Slot*    base = &slots_[set * kWays];
+
+    std::lock_guard<std::mutex> lock(stripes_[set % kStripes]);
+    for (size_t w = 0; w < kWays; ++w) {
+        Slot& s = base[w];
+        if (s.fingerprint != f) continue;
+        if (s.expires > millis(now)) return true;
+        s.fingerprint = 0;                                   // Expired: free the way
+        return false;
+    }
+    return false;
+}
+
+template<typename K, typename H>
+void NegativeCache<K,H>::erase(const K& key)
+{
+    uint64_t f   = fingerprint(key);
+    size_t   set = setOf(f);
+    Slot*    base = &slots_[set * kWays];
+
+    std::lock_guard<std::mutex> lock(stripes_[set % kStripes]);
+    for (size_t w = 0; w < kWays; ++w)
+        if (base[w].fingerprint == f) base[w].fingerprint = 0;
+}
+
+template<typename K, typename H>
+void NegativeCache<K,H>::clear()
+{
+    for (size_t set = 0; set <= setMask_; ++set) {
+        std::lock_guard<std::mutex> lock(stripes_[set % kStripes]);
+        for (size_t w = 0; w < kWays; ++w) slots_[set * kWays + w].fingerprint = 0;
+    }
+}
+
+} // namespace Cache
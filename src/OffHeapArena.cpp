@@ -0,0 +1,191 @@
+// ================================================================
+//  OffHeapArena.cpp  ——  mmap regions carved into size-class slabs
+// ================================================================
+
+#include "../include/OffHeapArena.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cmath>
+#include <new>
+#include <stdexcept>
+
+namespace Cache {
+
+static constexpr size_t kAlign = 16;
+
+static size_t roundUp(size_t n, size_t to) { return (n + to - 1) / to * to; }
+
+static size_t pageSize()
+{
+    static const size_t page = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    return page;
+}
+
+OffHeapArena::OffHeapArena(ArenaOptions options)
+    : options_(std::move(options))
+{
+    if (options_.slabBytes < pageSize() || options_.slabBytes % pageSize() != 0)
+        throw std::invalid_argument("slabBytes must be a multiple of the page size");
+    if (options_.regionBytes < options_.slabBytes || options_.regionBytes % options_.slabBytes != 0)
+        throw std::invalid_argument("regionBytes must be a multiple of slabBytes");
+    if (options_.growthFactor <= 1.0)
+        throw std::invalid_argument("growthFactor must be > 1");
+
+    const size_t largest = options_.slabBytes / 4;
+    size_t size = roundUp(std::max(options_.minChunk, kAlign), kAlign);
+    while (size < largest) {
+        classes_.push_back(std::make_unique<SizeClass>(size));
+        const size_t next = static_cast<size_t>(std::ceil(size * options_.growthFactor));
+        size = std::max(size + kAlign, roundUp(next, kAlign));
+    }
+    classes_.push_back(std::make_unique<SizeClass>(largest));
+
+    if (!options_.backingFile.empty()) {
+        fd_ = ::open(options_.backingFile.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0600);
+        if (fd_ < 0) throw std::runtime_error("cannot open arena file " + options_.backingFile);
+    }
+}
+
+OffHeapArena::~OffHeapArena()
+{
+    for (auto& entry : large_) unmap(entry.second);
+    for (auto& region : regions_) unmap(region);
+    if (fd_ >= 0) ::close(fd_);
+}
+
+size_t OffHeapArena::classFor(size_t bytes) const
+{
+    auto it = std::lower_bound(classes_.begin(), classes_.end(), bytes,
+                               [](const std::unique_ptr<SizeClass>& c, size_t n) { return c->chunk < n; });
+    return static_cast<size_t>(it - classes_.begin());
+}
+
+// -- public: allocate ---------------------------------------------
+// Free list first, then the class's current slab, then a new slab
+// ---------------------------------------------------------------
+void* OffHeapArena::allocate(size_t bytes)
+{
+    const size_t cls = classFor(bytes);
+    if (cls == classes_.size()) {
+        std::lock_guard<std::mutex> lock(regionMutex_);
+        Mapping m = map(roundUp(bytes, pageSize()));
+        large_.emplace(m.base, m);
+        largeRequested_ += bytes;
+        return m.base;
+    }
+
+    SizeClass& c = *classes_[cls];
+    std::lock_guard<std::mutex> lock(c.mutex);
+    void* p;
+    if (c.freeList) {
+        p = c.freeList;
+        c.freeList = c.freeList->next;
+    } else {
+        if (c.cursor == nullptr || c.slabEnd - c.cursor < static_cast<ptrdiff_t>(c.chunk)) {
+            c.cursor = takeSlab();
+            c.slabEnd = c.cursor + options_.slabBytes;
+            ++c.slabs;
+        }
+        p = c.cursor;
+        c.cursor += c.chunk;
+    }
+    ++c.used;
+    c.requested += bytes;
+    return p;
+}
+
+void OffHeapArena::deallocate(void* p, size_t bytes)
+{
+    if (p == nullptr) return;
+    const size_t cls = classFor(bytes);
+    if (cls == classes_.size()) {
+        Mapping m;
+        {
+            std::lock_guard<std::mutex> lock(regionMutex_);
+            auto it = large_.find(p);
+            m = it->second;
+            large_.erase(it);
+            largeRequested_ -= bytes;
+        }
+        unmap(m);
+        return;
+    }
+
+    SizeClass& c = *classes_[cls];
+    std::lock_guard<std::mutex> lock(c.mutex);
+    c.freeList = new (p) FreeChunk{c.freeList};
+    --c.used;
+    c.requested -= bytes;
+}
+
+ArenaStats OffHeapArena::stats() const
+{
+    ArenaStats s;
+    for (const auto& c : classes_) {
+        std::lock_guard<std::mutex> lock(c->mutex);
+        s.slabs += c->slabs;
+        s.chunkBytes += c->used * c->chunk;
+        s.requestedBytes += c->requested;
+        s.allocations += c->used;
+    }
+    s.slabBytes = s.slabs * options_.slabBytes;
+    std::lock_guard<std::mutex> lock(regionMutex_);
+    for (const auto& region : regions_) s.mappedBytes += region.bytes;
+    for (const auto& entry : large_) s.largeBytes += entry.second.bytes;
+    s.mappedBytes += s.largeBytes;
+    s.chunkBytes += s.largeBytes;
+    s.requestedBytes += largeRequested_;
+    s.allocations += large_.size();
+    return s;
+}
+
+// -- private helpers ---------------------------------------------
+
+char* OffHeapArena::takeSlab()
+{
+    std::lock_guard<std::mutex> lock(regionMutex_);
+    if (regionCursor_ == regionEnd_) {
+        Mapping m = map(options_.regionBytes);
+        regions_.push_back(m);
+        regionCursor_ = static_cast<char*>(m.base);
+        regionEnd_ = regionCursor_ + m.bytes;
+    }
+    char* slab = regionCursor_;
+    regionCursor_ += options_.slabBytes;
+    return slab;
+}
+
+/** Anonymous memory, or the next bytes of the backing file (grown with
+ *  ftruncate, so untouched pages take no disk space). regionMutex_ held */
+OffHeapArena::Mapping OffHeapArena::map(size_t bytes)
+{
+    if (fd_ < 0) {
+        void* p = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (p == MAP_FAILED) throw std::bad_alloc();
+        return {p, bytes, 0};
+    }
+    const uint64_t offset = fileSize_;
+    if (::ftruncate(fd_, static_cast<off_t>(offset + bytes)) != 0) throw std::bad_alloc();
+    fileSize_ += bytes;
+    void* p = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, static_cast<off_t>(offset));
+    if (p == MAP_FAILED) throw std::bad_alloc();
+    return {p, bytes, offset};
+}
+
+/** For a file-backed mapping the range is also punched out of the file,
+ *  so a freed large value gives its disk blocks back */
+void OffHeapArena::unmap(const Mapping& m)
+{
+    ::munmap(m.base, m.bytes);
+#ifdef FALLOC_FL_PUNCH_HOLE
+    if (fd_ >= 0)
+        ::fallocate(fd_, FALLOC_FL_PUNCH_HOLE | FALLOC_FL_KEEP_SIZE,
+                    static_cast<off_t>(m.fileOffset), static_cast<off_t>(m.bytes));
+#endif
+}
+
+} // namespace Cache
@@ -0,0 +1,120 @@
+#pragma once
+#include <limits>
+#include <new>
+#include <stdexcept>
+#include "../include/OffHeapCache.h"
+
+namespace Cache {
+
+// ===================== OffHeap handle =====================
+
+template<typename V, typename T>
+OffHeap<V,T>::OffHeap(OffHeapArena& arena, const V& value)
+    : arena_(&arena)
+{
+    const size_t n = T::size(value);
+    if (n > std::numeric_limits<uint32_t>::max() - sizeof(Block))
+        throw std::length_error("off-heap value too large");
+    block_ = new (arena.allocate(sizeof(Block) + n)) Block{{1}, static_cast<uint32_t>(n)};
+    T::write(value, block_->data());
+}
+
+template<typename V, typename T>
+OffHeap<V,T>::OffHeap(const OffHeap& other) noexcept
+    : arena_(other.arena_), block_(other.block_)
+{
+    if (block_) block_->refs.fetch_add(1, std::memory_order_relaxed);
+}
+
+template<typename V, typename T>
+OffHeap<V,T>::OffHeap(OffHeap&& other) noexcept
+    : arena_(other.arena_), block_(std::exchange(other.block_, nullptr))
+{
+}
+
+template<typename V, typename T>
+OffHeap<V,T>& OffHeap<V,T>::operator=(const OffHeap& other) noexcept
+{
+    if (block_ == other.block_) return *this;
+    if (other.block_) other.block_->refs.fetch_add(1, std::memory_order_relaxed);
+    release();
+    arena_ = other.arena_;
+    block_ = other.block_;
+    return *this;
+}
+
+template<typename V, typename T>
+OffHeap<V,T>& OffHeap<V,T>::operator=(OffHeap&& other) noexcept
+{
+    if (this == &other) return *this;
+    release();
+    arena_ = other.arena_;
+    block_ = std::exchange(other.block_, nullptr);
+    return *this;
+}
+
+// The last handle frees the chunk; acq_rel so every read through the
+// other handles happens before the chunk is reused
+template<typename V, typename T>
+void OffHeap<V,T>::release() noexcept
+{
+    if (block_ && block_->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        const size_t n = sizeof(Block) + block_->length;
+        block_->~Block();
+        arena_->deallocate(block_, n);
+    }
+    block_ = nullptr;
+}
+
+template<typename V, typename T>
+bool OffHeap<V,T>::read(V& out) const
+{
+    if (!block_) return false;
+    T::read(block_->data(), block_->length, out);
+    return true;
+}
+
+template<typename V, typename T>
+V OffHeap<V,T>::get() const
+{
+    V v{};
+    read(v);
+    return v;
+}
+
+// ===================== OffHeapCache =====================
+
+template<typename K, typename V, typename T>
+OffHeapCache<K,V,T>::OffHeapCache(std::unique_ptr<Policy> policy, std::shared_ptr<OffHeapArena> arena)
+    : arena_(arena ? std::move(arena) : std::make_shared<OffHeapArena>())
+    , policy_(std::move(policy))
+{
+    if (!policy_)
+        throw std::invalid_argument("OffHeapCache needs a policy");
+}
+
+template<typename K, typename V, typename T>
+void OffHeapCache<K,V,T>::put(const K& key, const V& value)
+{
+    policy_->put(key, Handle(*arena_, value));
+}
+
+// Only the handle is copied under the policy's lock; the bytes are read
+// through that copy, which keeps the chunk alive
+template<typename K, typename V, typename T>
+bool OffHeapCache<K,V,T>::get(const K& key, V& value)
+{
+    Handle handle;
+    if (!policy_->get(key, handle)) return false;
+    return handle.read(value);
+}
+
+template<typename K, typename V, typename T>
+V OffHeapCache<K,V,T>::get(const K& key)
+{
+    V v{};
+    get(key, v);
+    return v;
+}
+
+} // namespace Cache
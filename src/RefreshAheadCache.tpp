@@ -0,0 +1,220 @@
+#pragma once
+#include <cmath>
+#include <random>
+#include <stdexcept>
+#include "../include/RefreshAheadCache.h"
+
+namespace Cache {
+
+// =============== RefreshAheadCache implementation =============== //
+
+template<typename K, typename V>
+RefreshAheadCache<K,V>::RefreshAheadCache(std::unique_ptr<Policy> policy, Loader loader,
+                                          RefreshOptions options,
+                                          std::shared_ptr<MaintenanceExecutor> executor)
+    : policy_(std::move(policy)),
+      loader_(std::move(loader)),
+      options_(std::move(options)),
+      executor_(executor ? std::move(executor) : std::make_shared<MaintenanceExecutor>())
+{
+    if (!policy_ || !loader_)
+        throw std::invalid_argument("RefreshAheadCache needs a policy and a loader");
+    if (options_.ttl.count() <= 0)
+        throw std::invalid_argument("RefreshAheadCache ttl must be positive");
+    if (options_.negativeTtl.count() > 0)
+        negatives_ = std::make_unique<NegativeCache<K>>(options_.negativeCapacity, options_.negativeTtl);
+    taskId_ = executor_->add([this] { runRefreshes(); });
+}
+
+// Unregister before any member goes away; queued reloads are dropped
+template<typename K, typename V>
+RefreshAheadCache<K,V>::~RefreshAheadCache()
+{
+    executor_->remove(taskId_);
+}
+
+template<typename K, typename V>
+bool RefreshAheadCache<K,V>::get(const K& key, V& value)
+{
+    return lookup(key, value) == LookupResult::Hit;
+}
+
+template<typename K, typename V>
+LookupResult RefreshAheadCache<K,V>::lookup(const K& key, V& value)
+{
+    Entry entry;
+    if (policy_->get(key, entry)) {
+        auto age = now() - entry.loadedAt;
+        bool serve = true;
+        if (age >= options_.ttl) {
+            serve = age < options_.ttl + options_.staleWindow;
+            (serve ? staleServed_ : expiredMisses_).fetch_add(1, std::memory_order_relaxed);
+        }
+        if (serve) {
+            if (age >= options_.refreshAfter) {
+                requestRefresh(key);
+            } else if (drawsEarly(entry, age)) {
+                // Recompute now; if another caller already is, or it fails, serve what we have
+                try {
+                    Load result = load(key, value, false);
+                    if (result != Load::InFlight) earlyLoads_.fetch_add(1, std::memory_order_relaxed);
+                    if (result == Load::Found) return LookupResult::Hit;
+                } catch (...) {
+                    earlyLoads_.fetch_add(1, std::memory_order_relaxed);
+                    refreshErrors_.fetch_add(1, std::memory_order_relaxed);
+                }
+            }
+            value = std::move(entry.value);
+            return LookupResult::Hit;
+        }
+    }
+    if (negatives_ && negatives_->contains(key, now())) {
+        negativeHits_.fetch_add(1, std::memory_order_relaxed);
+        return LookupResult::KnownAbsent;
+    }
+    return load(key, value, true) == Load::Found ? LookupResult::Hit : LookupResult::Miss;
+}
+
+// Marks in-flight loads and reloads of the key superseded, then writes.
+// The negative entry goes under flightMutex_ too, so a load finishing
+// concurrently cannot put it back
+template<typename K, typename V>
+void RefreshAheadCache<K,V>::put(const K& key, const V& value)
+{
+    {
+        std::lock_guard<std::mutex> lock(flightMutex_);
+        auto it = flights_.find(key);
+        if (it != flights_.end()) it->second->superseded = true;
+        if (negatives_) negatives_->erase(key);
+    }
+    {
+        std::lock_guard<std::mutex> lock(refreshMutex_);
+        auto it = refreshing_.find(key);
+        if (it != refreshing_.end()) it->second = true;
+    }
+    policy_->put(key, Entry{value, now(), Clock::duration::zero()});
+}
+
+template<typename K, typename V>
+void RefreshAheadCache<K,V>::awaitRefreshes()
+{
+    executor_->drain();
+}
+
+// XFetch: early with probability exp(-(ttl - age) / (delta * beta)).
+// delta is wall-clock load time even when options_.clock is replaced
+template<typename K, typename V>
+bool RefreshAheadCache<K,V>::drawsEarly(const Entry& entry, Clock::duration age) const
+{
+    if (options_.xfetchBeta <= 0.0 || entry.loadTime <= Clock::duration::zero()) return false;
+    thread_local std::mt19937_64 gen(std::random_device{}());
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+    double gap = std::chrono::duration<double>(entry.loadTime).count() * options_.xfetchBeta *
+                 -std::log(1.0 - unit(gen));
+    return std::chrono::duration<double>(age).count() + gap >=
+           std::chrono::duration<double>(options_.ttl).count();
+}
+
+// Single flight: the first caller loads, later ones wait for its result
+// (joinInFlight) or are told one is running. The result is cached under
+// flightMutex_, so a put() either supersedes it or lands after it
+template<typename K, typename V>
+typename RefreshAheadCache<K,V>::Load
+RefreshAheadCache<K,V>::load(const K& key, V& value, bool joinInFlight)
+{
+    std::shared_ptr<Flight> flight;
+    {
+        std::unique_lock<std::mutex> lock(flightMutex_);
+        auto it = flights_.find(key);
+        if (it != flights_.end()) {
+            if (!joinInFlight) return Load::InFlight;
+            flight = it->second;
+            sharedLoads_.fetch_add(1, std::memory_order_relaxed);
+            while (!flight->done) flightCv_.wait_for(lock, std::chrono::milliseconds(10));
+            if (flight->error) std::rethrow_exception(flight->error);
+            if (!flight->found) return Load::Absent;
+            value = flight->value;
+            return Load::Found;
+        }
+        flight = std::make_shared<Flight>();
+        flights_.emplace(key, flight);
+    }
+
+    loads_.fetch_add(1, std::memory_order_relaxed);
+    V    loaded;
+    bool found = false;
+    std::exception_ptr error;
+    auto start = Clock::now();
+    try {
+        found = loader_(key, loaded);
+    } catch (...) {
+        error = std::current_exception();
+    }
+    auto loadTime = Clock::now() - start;
+
+    {
+        std::lock_guard<std::mutex> lock(flightMutex_);
+        if (!flight->superseded) {
+            if (found) policy_->put(key, Entry{loaded, now(), loadTime});
+            else if (!error && negatives_) negatives_->insert(key, now());
+        }
+        flight->done  = true;
+        flight->found = found;
+        flight->error = error;
+        if (found) flight->value = loaded;
+        flights_.erase(key);
+    }
+    flightCv_.notify_all();
+
+    if (error) std::rethrow_exception(error);
+    if (!found) return Load::Absent;
+    value = std::move(loaded);
+    return Load::Found;
+}
+
+// Only the first reader past the threshold queues the key; schedule()
+// is needed only when the queue was empty, otherwise a run is due
+template<typename K, typename V>
+void RefreshAheadCache<K,V>::requestRefresh(const K& key)
+{
+    bool wasEmpty;
+    {
+        std::lock_guard<std::mutex> lock(refreshMutex_);
+        if (!refreshing_.emplace(key, false).second) return;
+        wasEmpty = queue_.empty();
+        queue_.push_back(key);
+    }
+    if (wasEmpty) executor_->schedule(taskId_);
+}
+
+// The result is published under refreshMutex_, so a put() either marks
+// the key superseded first or lands after the reloaded value
+template<typename K, typename V>
+void RefreshAheadCache<K,V>::runRefreshes()
+{
+    std::deque<K> keys;
+    {
+        std::lock_guard<std::mutex> lock(refreshMutex_);
+        keys.swap(queue_);
+    }
+    for (const K& key : keys) {
+        V    loaded;
+        bool found = false;
+        auto start = Clock::now();
+        try {
+            found = loader_(key, loaded);
+        } catch (...) {
+            refreshErrors_.fetch_add(1, std::memory_order_relaxed);
+        }
+        auto loadTime = Clock::now() - start;
+        refreshes_.fetch_add(1, std::memory_order_relaxed);
+
+        std::lock_guard<std::mutex> lock(refreshMutex_);
+        auto it = refreshing_.find(key);
+        bool superseded = it->second;
+        refreshing_.erase(it);
+        if (found && !superseded) policy_->put(key, Entry{std::move(loaded), now(), loadTime});
+    }
+}
+
+} // namespace Cache
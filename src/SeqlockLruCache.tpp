@@ -0,0 +1,232 @@
+#pragma once
+#include <cmath>
+#include <stdexcept>
+#include <thread>
+#include "../include/SeqlockLruCache.h"
+
+namespace Cache {
+
+// =============== SeqlockLruCache implementation =============== //
+
+template<typename K, typename V>
+SeqlockLruCache<K,V>::SeqlockLruCache(int capacity)
+    : capacity_(capacity),
+      entries_(capacity > 0 ? new Entry[capacity] : nullptr),
+      index_(capacity > 0 ? static_cast<size_t>(capacity) : 1)
+{
+    if (capacity_ <= 0)
+        throw std::invalid_argument("capacity must be > 0");
+    prev_.assign(capacity_ + 1, kNone);
+    next_.assign(capacity_ + 1, kNone);
+    prev_[capacity_] = next_[capacity_] = capacity_;          // Empty circular list
+}
+
+// -- public: get --------------------------------------------------
+// Optimistic first; after kMaxRetries torn reads, fall back to the
+// mutex so a reader can't be starved by a hot writer.
+// ---------------------------------------------------------------
+template<typename K, typename V>
+bool SeqlockLruCache<K,V>::get(const K& key, V& value)
+{
+    for (int attempt = 0; attempt < kMaxRetries; ++attempt) {
+        bool done = false;
+        bool found = readOptimistic(key, value, done);
+        if (done) return found;
+    }
+    lockedReads_.fetch_add(1, std::memory_order_relaxed);
+    return readLocked(key, value);
+}
+
+template<typename K, typename V>
+V SeqlockLruCache<K,V>::get(const K& key)
+{
+    V tmp{};
+    if (!get(key, tmp))
+        throw std::runtime_error("Key not found in seqlock LRU cache");
+    return tmp;
+}
+
+// -- public: put --------------------------------------------------
+template<typename K, typename V>
+void SeqlockLruCache<K,V>::put(const K& key, const V& value)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    uint32_t idx;
+    if (index_.find(key, idx)) {
+        writeEntry(idx, key, value, true);
+        unlink(idx);
+        linkMostRecent(idx);
+        return;
+    }
+    idx = takeSlot();
+    writeEntry(idx, key, value, true);
+    entries_[idx].referenced.store(false, std::memory_order_relaxed);
+    linkMostRecent(idx);
+    index_.insertOrAssign(key, idx);                           // Publish only after the entry is complete
+}
+
+template<typename K, typename V>
+void SeqlockLruCache<K,V>::remove(const K& key)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    uint32_t idx;
+    if (!index_.find(key, idx)) return;
+    index_.erase(key);
+    unlink(idx);
+    writeEntry(idx, entries_[idx].key, entries_[idx].value, false);  // Readers holding idx now miss
+    freeSlots_.push_back(idx);
+}
+
+// -- private: read paths ------------------------------------------
+
+/**
+ * done=false → torn read, retry. A key mismatch means the slot was
+ * reused after our index lookup; the index no longer maps key to it
+ * (eviction erases the index entry first), so a retry is accurate.
+ */
+template<typename K, typename V>
+bool SeqlockLruCache<K,V>::readOptimistic(const K& key, V& value, bool& done)
+{
+    uint32_t idx;
+    if (!index_.find(key, idx)) { done = true; return false; }
+
+    Entry& e = entries_[idx];
+    uint64_t version = e.lock.readBegin();
+    K    k;
+    V    v;
+    bool live;
+    seqlockLoad(k, e.key);
+    seqlockLoad(v, e.value);
+    seqlockLoad(live, e.live);
+    if (e.lock.readRetry(version)) return false;
+    if (!live || !(k == key)) return false;
+
+    if (!e.referenced.load(std::memory_order_relaxed))        // Avoid dirtying the line on every hit
+        e.referenced.store(true, std::memory_order_relaxed);
+    value = v;
+    done = true;
+    return true;
+}
+
+template<typename K, typename V>
+bool SeqlockLruCache<K,V>::readLocked(const K& key, V& value)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    uint32_t idx;
+    if (!index_.find(key, idx)) return false;
+    entries_[idx].referenced.store(true, std::memory_order_relaxed);
+    value = entries_[idx].value;
+    return true;
+}
+
+// -- private: writer helpers (mutex_ held) -------------------------
+
+template<typename K, typename V>
+void SeqlockLruCache<K,V>::writeEntry(uint32_t idx, const K& key, const V& value, bool live)
+{
+    Entry& e = entries_[idx];
+    e.lock.lock();
+    seqlockStore(e.key, key);
+    seqlockStore(e.value, value);
+    seqlockStore(e.live, live);
+    e.lock.unlock();
+}
+
+template<typename K, typename V>
+uint32_t SeqlockLruCache<K,V>::takeSlot()
+{
+    if (!freeSlots_.empty()) {
+        uint32_t idx = freeSlots_.back();
+        freeSlots_.pop_back();
+        return idx;
+    }
+    if (used_ < static_cast<uint32_t>(capacity_)) return used_++;
+
+    uint32_t victim = selectVictim();
+    index_.erase(entries_[victim].key);                       // Unpublish before the slot is rewritten
+    unlink(victim);
+    return victim;
+}
+
+/**
+ * Walk from the LRU end: referenced entries get their deferred
+ * promotion now (to MRU, bit cleared); the first unreferenced one
+ * is the victim. After one full lap every bit is clear.
+ */
+template<typename K, typename V>
+uint32_t SeqlockLruCache<K,V>::selectVictim()
+{
+    const uint32_t sentinel = capacity_;
+    for (int steps = 0; steps <= capacity_; ++steps) {
+        uint32_t lru = next_[sentinel];
+        if (!entries_[lru].referenced.exchange(false, std::memory_order_relaxed))
+            return lru;
+        unlink(lru);
+        linkMostRecent(lru);
+    }
+    return next_[sentinel];
+}
+
+/** Insert before the sentinel (MRU end); next_[sentinel] is the LRU end */
+template<typename K, typename V>
+void SeqlockLruCache<K,V>::linkMostRecent(uint32_t idx)
+{
+    const uint32_t sentinel = capacity_;
+    uint32_t last = prev_[sentinel];
+    next_[last] = idx;
+    prev_[idx]  = last;
+    next_[idx]  = sentinel;
+    prev_[sentinel] = idx;
+}
+
+template<typename K, typename V>
+void SeqlockLruCache<K,V>::unlink(uint32_t idx)
+{
+    next_[prev_[idx]] = next_[idx];
+    prev_[next_[idx]] = prev_[idx];
+    prev_[idx] = next_[idx] = kNone;
+}
+
+// =============== HashSeqlockLruCaches implementation =============== //
+
+template<typename K, typename V>
+HashSeqlockLruCaches<K,V>::HashSeqlockLruCaches(size_t cap, int slice)
+    : capacity_(cap)
+{
+    sliceNum_ = slice > 0 ? slice : std::thread::hardware_concurrency();
+    size_t sliceCap = std::ceil(capacity_ / static_cast<double>(sliceNum_));
+    for (int i = 0; i < sliceNum_; ++i)
+        slices_.emplace_back(std::make_unique<SeqlockLruCache<K, V>>(sliceCap));
+}
+
+template<typename K, typename V>
+size_t HashSeqlockLruCaches<K,V>::calcSliceIndex(const K& key) const
+{
+    return std::hash<K>{}(key) % sliceNum_;
+}
+
+template<typename K, typename V>
+void HashSeqlockLruCaches<K,V>::put(const K& key, const V& value)
+{
+    slices_[calcSliceIndex(key)]->put(key, value);
+}
+
+template<typename K, typename V>
+bool HashSeqlockLruCaches<K,V>::get(const K& key, V& value)
+{
+    return slices_[calcSliceIndex(key)]->get(key, value);
+}
+
+template<typename K, typename V>
+V HashSeqlockLruCaches<K,V>::get(const K& key)
+{
+    return slices_[calcSliceIndex(key)]->get(key);
+}
+
+template<typename K, typename V>
+void HashSeqlockLruCaches<K,V>::remove(const K& key)
+{
+    slices_[calcSliceIndex(key)]->remove(key);
+}
+
+} // namespace Cache
@@ -0,0 +1,69 @@
+#pragma once
+#include <iterator>
+#include <stdexcept>
+#include "../include/SieveCache.h"
+
+namespace Cache {
+
+template<typename K, typename V>
+SieveCache<K,V>::SieveCache(size_t capacity)
+    : capacity_(capacity), index_(capacity), hand_(queue_.end())
+{
+    if (capacity_ == 0)
+        throw std::invalid_argument("capacity must be > 0");
+}
+
+// -- public: put --------------------------------------------------
+// Existing key: publish the new value and count it as a visit.
+// New key: evict at the hand if full, then enqueue at the head.
+// ---------------------------------------------------------------
+template<typename K, typename V>
+void SieveCache<K,V>::put(const K& key, const V& value)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (index_.contains(key)) {
+        index_.insertOrAssign(key, value, /*accessed*/true);
+        return;
+    }
+    if (queue_.size() >= capacity_) evict();
+    queue_.push_front(key);
+    index_.insertOrAssign(key, value);
+}
+
+template<typename K, typename V>
+bool SieveCache<K,V>::get(const K& key, V& value)
+{
+    return index_.find(key, value);
+}
+
+template<typename K, typename V>
+V SieveCache<K,V>::get(const K& key)
+{
+    V tmp{};
+    if (!get(key, tmp))
+        throw std::runtime_error("Key not found in SIEVE cache");
+    return tmp;
+}
+
+// -- private: evict ----------------------------------------------
+// Readers keep setting bits while we clear them, so cap the sweep
+// at two laps; after that the entry under the hand goes anyway.
+// ---------------------------------------------------------------
+template<typename K, typename V>
+void SieveCache<K,V>::evict()
+{
+    if (queue_.empty()) return;
+    if (hand_ == queue_.end()) hand_ = std::prev(queue_.end());
+
+    for (size_t steps = 0; steps < 2 * queue_.size(); ++steps) {
+        if (!index_.testAndClearAccessed(*hand_)) break;
+        hand_ = (hand_ == queue_.begin()) ? std::prev(queue_.end()) : std::prev(hand_);
+    }
+
+    auto victim = hand_;
+    hand_ = (victim == queue_.begin()) ? queue_.end() : std::prev(victim);
+    index_.erase(*victim);
+    queue_.erase(victim);
+}
+
+} // namespace Cache
@@ -0,0 +1,137 @@
+// ================================================================
+//  SlabAllocator.cpp  ——  pages of one size class, moved on demand
+// ================================================================
+
+#include "../include/SlabAllocator.h"
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cmath>
+#include <new>
+#include <stdexcept>
+
+namespace Cache {
+
+static constexpr size_t kAlign = 16;
+
+static size_t roundUp(size_t n, size_t to) { return (n + to - 1) / to * to; }
+
+SlabAllocator::SlabAllocator(const SlabOptions& options)
+    : pageBytes_(options.pageBytes)
+{
+    const size_t page = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    if (pageBytes_ < page || pageBytes_ % page != 0)
+        throw std::invalid_argument("pageBytes must be a multiple of the page size");
+    if (options.memoryLimit < pageBytes_)
+        throw std::invalid_argument("memoryLimit must hold at least one page");
+    if (options.growthFactor <= 1.0)
+        throw std::invalid_argument("growthFactor must be > 1");
+
+    size_t size = roundUp(std::max(options.minChunk, sizeof(FreeChunk)), kAlign);
+    while (size < pageBytes_) {
+        classes_.push_back(SizeClass{size});
+        const size_t next = static_cast<size_t>(std::ceil(size * options.growthFactor));
+        size = std::max(size + kAlign, roundUp(next, kAlign));
+    }
+    classes_.push_back(SizeClass{pageBytes_});
+
+    const size_t pages = options.memoryLimit / pageBytes_;
+    mappedBytes_ = pages * pageBytes_;
+    void* p = ::mmap(nullptr, mappedBytes_, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE,
+                     -1, 0);
+    if (p == MAP_FAILED) throw std::bad_alloc();
+    base_ = static_cast<char*>(p);
+    pageClass_.assign(pages, kNoClass);
+    detached_.assign(pages, false);
+    for (size_t i = pages; i-- > 0;) freePages_.push_back(i);   // Lowest page first
+}
+
+SlabAllocator::~SlabAllocator()
+{
+    ::munmap(base_, mappedBytes_);
+}
+
+uint32_t SlabAllocator::classFor(size_t bytes) const
+{
+    auto it = std::lower_bound(classes_.begin(), classes_.end(), bytes,
+                               [](const SizeClass& c, size_t n) { return c.chunk < n; });
+    return it == classes_.end() ? kNoClass : static_cast<uint32_t>(it - classes_.begin());
+}
+
+void* SlabAllocator::allocate(uint32_t cls)
+{
+    SizeClass& c = classes_[cls];
+    if (!c.head) {
+        if (freePages_.empty()) return nullptr;
+        const size_t page = freePages_.back();
+        freePages_.pop_back();
+        carve(page, cls);
+    }
+    FreeChunk* f = c.head;
+    unlinkFree(c, f);
+    ++c.used;
+    return f;
+}
+
+void SlabAllocator::free(void* chunk)
+{
+    const size_t page = pageOf(chunk);
+    SizeClass& c = classes_[pageClass_[page]];
+    --c.used;
+    if (detached_[page]) {
+        *static_cast<uint32_t*>(chunk) = 0;       // Marked free; re-carved by assignPage
+        return;
+    }
+    pushFree(c, chunk);
+}
+
+// -- Page moves --------------------------------------------------
+
+void SlabAllocator::detachPage(size_t page)
+{
+    SizeClass& c = classes_[pageClass_[page]];
+    char* p = pageBase(page);
+    for (size_t off = 0; off + c.chunk <= pageBytes_; off += c.chunk) {
+        auto* f = reinterpret_cast<FreeChunk*>(p + off);
+        if (f->state == 0) unlinkFree(c, f);
+    }
+    detached_[page] = true;
+}
+
+void SlabAllocator::assignPage(size_t page, uint32_t cls)
+{
+    --classes_[pageClass_[page]].pages;
+    detached_[page] = false;
+    carve(page, cls);
+}
+
+// -- private helpers ---------------------------------------------
+
+/** Every chunk of the page onto the class's free list, in address order */
+void SlabAllocator::carve(size_t page, uint32_t cls)
+{
+    SizeClass& c = classes_[cls];
+    pageClass_[page] = cls;
+    ++c.pages;
+    char* p = pageBase(page);
+    const size_t n = pageBytes_ / c.chunk;
+    for (size_t i = n; i-- > 0;) pushFree(c, p + i * c.chunk);
+}
+
+void SlabAllocator::pushFree(SizeClass& c, void* chunk)
+{
+    auto* f = new (chunk) FreeChunk{0, nullptr, c.head};
+    if (c.head) c.head->prev = f;
+    c.head = f;
+}
+
+void SlabAllocator::unlinkFree(SizeClass& c, FreeChunk* f)
+{
+    if (f->prev) f->prev->next = f->next;
+    else c.head = f->next;
+    if (f->next) f->next->prev = f->prev;
+}
+
+} // namespace Cache
@@ -0,0 +1,355 @@
+#pragma once
+#include <cstring>
+#include <stdexcept>
+#include "../include/SlabCache.h"
+
+namespace Cache {
+
+template<typename K, typename V, typename L>
+SlabCache<K,V,L>::SlabCache(SlabOptions options)
+    : options_(options)
+    , slabs_(options_)
+    , lru_(slabs_.classCount())
+    , buckets_(1024, nullptr)
+{
+    if (options_.rebalanceWindow == 0)
+        throw std::invalid_argument("rebalanceWindow must be > 0");
+}
+
+template<typename K, typename V, typename L>
+SlabCache<K,V,L>::~SlabCache()
+{
+    if (executor_) executor_->remove(taskId_);
+}
+
+template<typename K, typename V, typename L>
+uint32_t SlabCache<K,V,L>::hashOf(const K& key)
+{
+    const size_t h = std::hash<K>{}(key);
+    return static_cast<uint32_t>(h ^ (static_cast<uint64_t>(h) >> 32));
+}
+
+// -- public: put --------------------------------------------------
+// Key and sizes are worked out before the lock. Same class as the old
+// item: rewritten in place. Otherwise the old item goes and a chunk of
+// the new class is taken, evicting that class's LRU items if needed
+// ---------------------------------------------------------------
+template<typename K, typename V, typename L>
+void SlabCache<K,V,L>::put(const K& key, const V& value)
+{
+    std::string keyBytes(ValueTraits<K>::size(key), '\0');
+    ValueTraits<K>::write(key, &keyBytes[0]);
+    const uint32_t hash = hashOf(key);
+    const size_t valueLen = ValueTraits<V>::size(value);
+    const size_t bytes = sizeof(Item) + keyBytes.size() + valueLen;
+    const uint32_t cls = slabs_.classFor(bytes);
+    bool due = false;
+    {
+        std::lock_guard<L> lock(mutex_);
+        Item* old = *findSlot(keyBytes, hash);
+        if (cls == SlabAllocator::kNoClass) {
+            ++tooLarge_;
+            if (old) unlink(old);
+            return;
+        }
+        if (old && slabs_.classOf(old) == cls) {
+            lru_[cls].requested += bytes - old->bytes();
+            old->valueLen = static_cast<uint32_t>(valueLen);
+            ValueTraits<V>::write(value, old->value());
+            old->stamp = ++clock_;
+            unlinkLru(cls, old);
+            linkFront(cls, old);
+            return;
+        }
+        if (old) unlink(old);
+
+        Item* it = allocateItem(cls);
+        if (!it) {
+            ++lru_[cls].outOfMemory;
+            ++lru_[cls].windowFailed;
+            notePressure(cls);
+        } else {
+            it->state = kLinked;
+            it->hash = hash;
+            it->keyLen = static_cast<uint32_t>(keyBytes.size());
+            it->valueLen = static_cast<uint32_t>(valueLen);
+            it->stamp = ++clock_;
+            std::memcpy(it->key(), keyBytes.data(), keyBytes.size());
+            ValueTraits<V>::write(value, it->value());
+            Item*& head = buckets_[hash & (buckets_.size() - 1)];
+            it->hnext = head;
+            head = it;
+            linkFront(cls, it);
+            lru_[cls].requested += bytes;
+            if (++items_ > buckets_.size() + buckets_.size() / 2) grow();
+        }
+        due = executor_ && windowEvictions_ >= options_.rebalanceWindow;
+    }
+    if (due) executor_->schedule(taskId_);
+}
+
+template<typename K, typename V, typename L>
+bool SlabCache<K,V,L>::get(const K& key, V& value)
+{
+    std::string keyBytes(ValueTraits<K>::size(key), '\0');
+    ValueTraits<K>::write(key, &keyBytes[0]);
+    const uint32_t hash = hashOf(key);
+
+    std::lock_guard<L> lock(mutex_);
+    Item* it = *findSlot(keyBytes, hash);
+    if (!it) {
+        ++misses_;
+        return false;
+    }
+    ++hits_;
+    it->stamp = ++clock_;
+    const uint32_t cls = slabs_.classOf(it);
+    unlinkLru(cls, it);
+    linkFront(cls, it);
+    ValueTraits<V>::read(it->value(), it->valueLen, value);
+    return true;
+}
+
+template<typename K, typename V, typename L>
+V SlabCache<K,V,L>::get(const K& key)
+{
+    V v{};
+    get(key, v);
+    return v;
+}
+
+template<typename K, typename V, typename L>
+bool SlabCache<K,V,L>::remove(const K& key)
+{
+    std::string keyBytes(ValueTraits<K>::size(key), '\0');
+    ValueTraits<K>::write(key, &keyBytes[0]);
+    const uint32_t hash = hashOf(key);
+
+    std::lock_guard<L> lock(mutex_);
+    Item* it = *findSlot(keyBytes, hash);
+    if (!it) return false;
+    unlink(it);
+    return true;
+}
+
+// -- Rebalancing --------------------------------------------------
+
+template<typename K, typename V, typename L>
+void SlabCache<K,V,L>::enableRebalancing(std::shared_ptr<MaintenanceExecutor> executor)
+{
+    if (!executor) throw std::invalid_argument("rebalancing needs an executor");
+    if (executor_) executor_->remove(taskId_);
+    executor_ = std::move(executor);
+    taskId_ = executor_->add([this] { rebalance(); });
+}
+
+/** The decision and the detach happen in one lock hold; the page's items
+ *  are then evicted kMoveBatch at a time, so gets and puts of every
+ *  class keep running between batches */
+template<typename K, typename V, typename L>
+bool SlabCache<K,V,L>::rebalance()
+{
+    std::lock_guard<std::mutex> move(moveMutex_);
+    uint32_t from, to;
+    size_t page;
+    {
+        std::lock_guard<L> lock(mutex_);
+        if (!pickMove(from, to, page)) return false;
+        slabs_.detachPage(page);
+    }
+    const size_t chunk = slabs_.chunkSize(from);
+    char* base = slabs_.pageBase(page);
+    size_t off = 0;
+    for (;;) {
+        std::lock_guard<L> lock(mutex_);
+        for (size_t n = 0; off + chunk <= slabs_.pageBytes() && n < kMoveBatch; off += chunk) {
+            auto* it = reinterpret_cast<Item*>(base + off);
+            if (it->state != kLinked) continue;
+            unlink(it);
+            ++lru_[from].evictions;
+            ++moveEvictions_;
+            ++n;
+        }
+        if (off + chunk > slabs_.pageBytes()) {
+            slabs_.assignPage(page, to);
+            ++pagesMoved_;
+            return true;
+        }
+    }
+}
+
+/** memcached-style automove. Destination: the class whose stores failed
+ *  most since the last decision (it has no page to evict from), else the
+ *  one that evicted most. Source: the class with the oldest LRU tail
+ *  among those with at least two pages, older than the destination's
+ *  tail; unless the destination is starving, the source must also have
+ *  had at most half its pressure. The page is the one holding the
+ *  source's tail */
+template<typename K, typename V, typename L>
+bool SlabCache<K,V,L>::pickMove(uint32_t& from, uint32_t& to, size_t& page)
+{
+    const uint32_t n = slabs_.classCount();
+    auto heavier = [&](uint32_t a, uint32_t b) {
+        if (lru_[a].windowFailed != lru_[b].windowFailed) return lru_[a].windowFailed > lru_[b].windowFailed;
+        return lru_[a].windowPressure > lru_[b].windowPressure;
+    };
+    to = SlabAllocator::kNoClass;
+    for (uint32_t c = 0; c < n; ++c)
+        if (lru_[c].windowPressure > 0 && (to == SlabAllocator::kNoClass || heavier(c, to))) to = c;
+
+    from = SlabAllocator::kNoClass;
+    uint64_t oldest = 0;
+    if (to != SlabAllocator::kNoClass) {
+        const bool starving = lru_[to].windowFailed > 0;
+        const uint64_t toStamp = lru_[to].tail ? lru_[to].tail->stamp : UINT64_MAX;
+        for (uint32_t c = 0; c < n; ++c) {
+            if (c == to || slabs_.pages(c) < 2) continue;
+            if (!starving && lru_[c].windowPressure * 2 > lru_[to].windowPressure) continue;
+            const uint64_t stamp = lru_[c].tail ? lru_[c].tail->stamp : 0;   // No items: nothing to lose
+            if (stamp < toStamp && (from == SlabAllocator::kNoClass || stamp < oldest)) {
+                from = c;
+                oldest = stamp;
+            }
+        }
+    }
+
+    for (auto& c : lru_) c.windowPressure = c.windowFailed = 0;
+    windowEvictions_ = 0;
+    if (from == SlabAllocator::kNoClass) return false;
+
+    if (lru_[from].tail) {
+        page = slabs_.pageOf(lru_[from].tail);
+    } else {
+        page = 0;
+        while (slabs_.pageClass(page) != from) ++page;
+    }
+    return true;
+}
+
+template<typename K, typename V, typename L>
+SlabStats SlabCache<K,V,L>::stats() const
+{
+    std::lock_guard<L> lock(mutex_);
+    SlabStats s;
+    s.memoryLimit = slabs_.pageCount() * slabs_.pageBytes();
+    s.pageBytes = slabs_.pageBytes();
+    s.pagesFree = slabs_.freePages();
+    s.pagesAssigned = slabs_.pageCount() - s.pagesFree;
+    s.items = items_;
+    s.hits = hits_;
+    s.misses = misses_;
+    s.pagesMoved = pagesMoved_;
+    s.moveEvictions = moveEvictions_;
+    s.tooLarge = tooLarge_;
+    for (uint32_t c = 0; c < slabs_.classCount(); ++c) {
+        const ClassLru& l = lru_[c];
+        s.requestedBytes += l.requested;
+        s.evictions += l.evictions;
+        if (slabs_.pages(c) == 0 && l.evictions == 0 && l.outOfMemory == 0) continue;
+        s.classes.push_back({slabs_.chunkSize(c), slabs_.pages(c), l.items, l.requested, l.evictions, l.outOfMemory});
+    }
+    return s;
+}
+
+template<typename K, typename V, typename L>
+size_t SlabCache<K,V,L>::size() const
+{
+    std::lock_guard<L> lock(mutex_);
+    return items_;
+}
+
+// -- private helpers ---------------------------------------------
+
+template<typename K, typename V, typename L>
+typename SlabCache<K,V,L>::Item** SlabCache<K,V,L>::findSlot(const std::string& keyBytes, uint32_t hash)
+{
+    Item** slot = &buckets_[hash & (buckets_.size() - 1)];
+    while (*slot) {
+        Item* it = *slot;
+        if (it->hash == hash && it->keyLen == keyBytes.size() &&
+            std::memcmp(it->key(), keyBytes.data(), keyBytes.size()) == 0)
+            break;
+        slot = &it->hnext;
+    }
+    return slot;
+}
+
+template<typename K, typename V, typename L>
+void SlabCache<K,V,L>::linkFront(uint32_t cls, Item* it)
+{
+    ClassLru& l = lru_[cls];
+    it->prev = nullptr;
+    it->next = l.head;
+    if (l.head) l.head->prev = it;
+    else l.tail = it;
+    l.head = it;
+    ++l.items;
+}
+
+template<typename K, typename V, typename L>
+void SlabCache<K,V,L>::unlinkLru(uint32_t cls, Item* it)
+{
+    ClassLru& l = lru_[cls];
+    if (it->prev) it->prev->next = it->next;
+    else l.head = it->next;
+    if (it->next) it->next->prev = it->prev;
+    else l.tail = it->prev;
+    --l.items;
+}
+
+template<typename K, typename V, typename L>
+void SlabCache<K,V,L>::unlink(Item* it)
+{
+    Item** slot = &buckets_[it->hash & (buckets_.size() - 1)];
+    while (*slot != it) slot = &(*slot)->hnext;
+    *slot = it->hnext;
+    const uint32_t cls = slabs_.classOf(it);
+    unlinkLru(cls, it);
+    lru_[cls].requested -= it->bytes();
+    --items_;
+    slabs_.free(it);
+}
+
+template<typename K, typename V, typename L>
+void SlabCache<K,V,L>::evictTail(uint32_t cls)
+{
+    unlink(lru_[cls].tail);
+    ++lru_[cls].evictions;
+    notePressure(cls);
+}
+
+template<typename K, typename V, typename L>
+typename SlabCache<K,V,L>::Item* SlabCache<K,V,L>::allocateItem(uint32_t cls)
+{
+    void* p = slabs_.allocate(cls);
+    while (!p && lru_[cls].tail) {             // A tail on a page being moved frees nothing usable
+        evictTail(cls);
+        p = slabs_.allocate(cls);
+    }
+    return static_cast<Item*>(p);
+}
+
+template<typename K, typename V, typename L>
+void SlabCache<K,V,L>::grow()
+{
+    std::vector<Item*> bigger(buckets_.size() * 2, nullptr);
+    for (Item* head : buckets_) {
+        while (head) {
+            Item* next = head->hnext;
+            Item*& slot = bigger[head->hash & (bigger.size() - 1)];
+            head->hnext = slot;
+            slot = head;
+            head = next;
+        }
+    }
+    buckets_.swap(bigger);
+}
+
+template<typename K, typename V, typename L>
+void SlabCache<K,V,L>::notePressure(uint32_t cls)
+{
+    ++lru_[cls].windowPressure;
+    ++windowEvictions_;
+}
+
+} // namespace Cache
@@ -0,0 +1,195 @@
+#pragma once
+#include <algorithm>
+#include <stdexcept>
+#include "../include/WriteBackCache.h"
+
+namespace Cache {
+
+// =============== WriteBackCache implementation =============== //
+
+template<typename K, typename V>
+WriteBackCache<K,V>::WriteBackCache(int capacity, std::shared_ptr<BackingStore<K,V>> store,
+                                    WriteBackOptions options)
+    : store_(std::move(store)),
+      options_(options),
+      cache_(capacity)
+{
+    if (!store_)
+        throw std::invalid_argument("WriteBackCache needs a backing store");
+    if (options_.flushBatch == 0) options_.flushBatch = 1;
+    if (options_.maxDirtyEntries < options_.flushBatch) options_.maxDirtyEntries = options_.flushBatch;
+    cache_.setRemovalListener([this](RemovalBatch<K,V>& batch) { onRemoval(batch); });
+    flusher_ = std::thread([this] { flusherLoop(); });
+}
+
+template<typename K, typename V>
+WriteBackCache<K,V>::~WriteBackCache()
+{
+    {
+        std::lock_guard<std::mutex> lock(dirtyMutex_);
+        stop_ = true;
+    }
+    flusherCv_.notify_one();
+    flusher_.join();
+    try {
+        flush();
+    } catch (...) {
+        flushErrors_.fetch_add(1, std::memory_order_relaxed);   // Nowhere left to retry
+    }
+}
+
+// -- public -------------------------------------------------------
+
+// The write goes to the dirty map and the LRU under dirtyMutex_, so a
+// concurrent read-through fill can never overwrite it with an older value.
+// The write has happened once it is in dirty_: a failed inline flush
+// is counted like a background one and left to the next run to retry
+template<typename K, typename V>
+void WriteBackCache<K,V>::put(const K& key, const V& value)
+{
+    bool wake = false, inlineFlush = false;
+    {
+        std::lock_guard<std::mutex> lock(dirtyMutex_);
+        if (dirty_.empty()) dirtySince_ = Clock::now();
+        dirty_.insert_or_assign(key, value);
+        ++writeEpoch_;
+        cache_.put(key, value);                     // May evict: onRemoval runs here
+        inlineFlush = dirty_.size() >= options_.maxDirtyEntries;
+        if (!wakeRequested_ && dirty_.size() >= options_.flushBatch) {
+            wakeRequested_ = true;
+            wake = true;
+        }
+    }
+    puts_.fetch_add(1, std::memory_order_relaxed);
+    if (inlineFlush) {
+        try {
+            flush();
+        } catch (...) {
+            flushErrors_.fetch_add(1, std::memory_order_relaxed);   // Entries were put back
+        }
+    } else if (wake) {
+        flusherCv_.notify_one();
+    }
+}
+
+template<typename K, typename V>
+bool WriteBackCache<K,V>::get(const K& key, V& value)
+{
+    if (cache_.get(key, value)) return true;
+
+    size_t epoch;
+    {
+        std::lock_guard<std::mutex> lock(dirtyMutex_);
+        auto it = dirty_.find(key);
+        if (it != dirty_.end()) { value = it->second; return true; }
+        it = inFlight_.find(key);
+        if (it != inFlight_.end()) { value = it->second; return true; }
+        epoch = writeEpoch_;
+    }
+
+    V loaded{};
+    if (!store_->read(key, loaded)) return false;
+
+    std::lock_guard<std::mutex> lock(dirtyMutex_);
+    for (auto* pending : {&dirty_, &inFlight_}) {   // Written while we were reading
+        auto it = pending->find(key);
+        if (it != pending->end()) {
+            value = it->second;
+            return true;
+        }
+    }
+    value = std::move(loaded);
+    if (epoch == writeEpoch_) cache_.put(key, value);   // Otherwise the store may already be stale for us
+    return true;
+}
+
+// Take every dirty entry, write it in flushBatch-sized calls, then drop
+// the in-flight copies. On failure the entries go back to dirty_ unless
+// a newer put replaced them, and the exception propagates.
+template<typename K, typename V>
+void WriteBackCache<K,V>::flush()
+{
+    std::lock_guard<std::mutex> flushLock(flushMutex_);
+    {
+        std::lock_guard<std::mutex> lock(dirtyMutex_);
+        wakeRequested_ = false;
+        if (dirty_.empty()) return;
+        inFlight_.swap(dirty_);                     // inFlight_ is empty between flushes
+    }
+
+    // inFlight_ is only read until the final clear, so no lock is needed here
+    typename BackingStore<K,V>::Entries batch;
+    batch.reserve(std::min(options_.flushBatch, inFlight_.size()));
+    try {
+        for (const auto& kv : inFlight_) {
+            batch.emplace_back(kv.first, kv.second);
+            if (batch.size() == options_.flushBatch) {
+                store_->writeBatch(batch);
+                batch.clear();
+            }
+        }
+        if (!batch.empty()) store_->writeBatch(batch);
+    } catch (...) {
+        std::lock_guard<std::mutex> lock(dirtyMutex_);
+        if (dirty_.empty()) dirtySince_ = Clock::now();
+        for (auto& kv : inFlight_) dirty_.emplace(kv.first, std::move(kv.second));   // Newer puts win
+        inFlight_.clear();
+        throw;
+    }
+
+    flushedEntries_.fetch_add(inFlight_.size(), std::memory_order_relaxed);
+    flushRuns_.fetch_add(1, std::memory_order_relaxed);
+    std::lock_guard<std::mutex> lock(dirtyMutex_);
+    inFlight_.clear();
+}
+
+template<typename K, typename V>
+size_t WriteBackCache<K,V>::dirtyCount() const
+{
+    std::lock_guard<std::mutex> lock(dirtyMutex_);
+    return dirty_.size() + inFlight_.size();
+}
+
+// -- private ------------------------------------------------------
+
+// An evicted dirty value stays in dirty_ and goes out with the next
+// batch: writing it alone here would give up the coalescing
+template<typename K, typename V>
+void WriteBackCache<K,V>::onRemoval(RemovalBatch<K,V>& batch)
+{
+    for (const auto& n : batch)
+        if (n.cause == RemovalCause::Size && dirty_.count(n.key))
+            evictedDirty_.fetch_add(1, std::memory_order_relaxed);
+}
+
+template<typename K, typename V>
+bool WriteBackCache<K,V>::flushDue(Clock::time_point now) const
+{
+    if (dirty_.empty()) return false;
+    return dirty_.size() >= options_.flushBatch || now - dirtySince_ >= options_.maxDirtyAge;
+}
+
+template<typename K, typename V>
+void WriteBackCache<K,V>::flusherLoop()
+{
+    const auto tick = std::max<std::chrono::milliseconds>(options_.maxDirtyAge / 4, std::chrono::milliseconds(1));
+    for (;;) {
+        bool due;
+        {
+            std::unique_lock<std::mutex> lock(dirtyMutex_);
+            if (!stop_ && !flushDue(Clock::now()))
+                flusherCv_.wait_for(lock, tick);
+            if (stop_) return;
+            due = flushDue(Clock::now());
+        }
+        if (!due) continue;
+        try {
+            flush();
+        } catch (...) {
+            flushErrors_.fetch_add(1, std::memory_order_relaxed);   // Entries were put back; retry next tick
+            std::this_thread::sleep_for(tick);
+        }
+    }
+}
+
+} // namespace Cache
@@ -0,0 +1,107 @@
+#pragma once
+
+// =========================================================
+//  BenchUtil.h —— shared helpers for the multi-threaded
+//  throughput scenarios under test/
+//  - ZipfGenerator : skewed key generator (precomputed CDF)
+//  - runThroughput : start N threads together, return ops/sec
+//  - Latency       : per-op latency samples + percentiles
+//  - residentBytes : the process's RSS (Linux; 0 elsewhere)
+// =========================================================
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <random>
+#include <thread>
+#include <vector>
+#include <unistd.h>
+
+namespace CacheBench {
+
+// Zipf(s) distribution over keys [0, n): key 0 is the hottest.
+// The CDF is built once; sampling is a binary search, so it's cheap
+// enough to sit inside a benchmark loop.
+class ZipfGenerator {
+public:
+    ZipfGenerator(size_t n, double s) : cdf_(n) {
+        double sum = 0.0;
+        for (size_t i = 0; i < n; ++i) {
+            sum += 1.0 / std::pow(static_cast<double>(i + 1), s);
+            cdf_[i] = sum;
+        }
+        for (auto& c : cdf_) c /= sum;
+    }
+
+    template<typename Gen>
+    int operator()(Gen& gen) const {
+        double u = std::uniform_real_distribution<double>(0.0, 1.0)(gen);
+        auto it = std::lower_bound(cdf_.begin(), cdf_.end(), u);
+        if (it == cdf_.end()) --it;
+        return static_cast<int>(it - cdf_.begin());
+    }
+
+private:
+    std::vector<double> cdf_;
+};
+
+// Run fn(threadIndex) on `threads` threads released at the same time.
+// fn returns the number of operations it performed; the result is ops/sec.
+template<typename Fn>
+double runThroughput(int threads, Fn fn) {
+    std::atomic<bool> go{false};
+    std::atomic<long long> totalOps{0};
+    std::vector<std::thread> workers;
+    workers.reserve(threads);
+    for (int t = 0; t < threads; ++t) {
+        workers.emplace_back([&, t] {
+            while (!go.load(std::memory_order_acquire)) std::this_thread::yield();
+            totalOps.fetch_add(fn(t), std::memory_order_relaxed);
+        });
+    }
+    auto start = std::chrono::steady_clock::now();
+    go.store(true, std::memory_order_release);
+    for (auto& w : workers) w.join();
+    std::chrono::duration<double> secs = std::chrono::steady_clock::now() - start;
+    return static_cast<double>(totalOps.load()) / secs.count();
+}
+
+// Per-op latency samples in nanoseconds. Each thread records into its own
+// Latency and the results are merged afterwards (no sharing while timing).
+class Latency {
+public:
+    template<typename Fn>
+    void time(Fn fn) {
+        auto start = std::chrono::steady_clock::now();
+        fn();
+        samples_.push_back(std::chrono::duration<double, std::nano>(
+                               std::chrono::steady_clock::now() - start).count());
+    }
+
+    void merge(const Latency& other) {
+        samples_.insert(samples_.end(), other.samples_.begin(), other.samples_.end());
+    }
+
+    // p in [0, 100]
+    double percentile(double p) {
+        if (samples_.empty()) return 0.0;
+        std::sort(samples_.begin(), samples_.end());
+        size_t idx = static_cast<size_t>(p / 100.0 * (samples_.size() - 1));
+        return samples_[idx];
+    }
+
+private:
+    std::vector<double> samples_;
+};
+
+// Resident set size from /proc/self/statm (second field, in pages)
+inline size_t residentBytes() {
+    std::ifstream statm("/proc/self/statm");
+    size_t pages = 0, resident = 0;
+    if (!(statm >> pages >> resident)) return 0;
+    return resident * static_cast<size_t>(sysconf(_SC_PAGESIZE));
+}
+
+} // namespace CacheBench
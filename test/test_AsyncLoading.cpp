@@ -0,0 +1,343 @@
+// AsyncLoadingCache: co_await get-or-load on a single-threaded event loop.
+// Hits never suspend; misses of one key share a load; absent keys, loader
+// errors and inline loaders; LRU / LFU / ARC / sharded LRU; blocking
+// cache-aside threads vs coroutines on one thread
+#include <iostream>
+#include <string>
+#include <random>
+#include <iomanip>
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <functional>
+#include <map>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include "AsyncLoadingCache.h"
+#include "LruCache.h"
+#include "LfuCache.h"
+#include "Arc_new.h"
+#include "BenchUtil.h"
+
+#if CACHE_HAS_COROUTINES
+
+using namespace Cache;
+using Clock = std::chrono::steady_clock;
+using Result = std::optional<std::string>;
+
+// Single-threaded event loop: ready callbacks plus timers; run() returns
+// when there is nothing left to do
+class EventLoop {
+public:
+    void post(std::function<void()> fn) { ready_.push_back(std::move(fn)); }
+    void postAfter(std::chrono::microseconds delay, std::function<void()> fn) {
+        timers_.emplace(Clock::now() + delay, std::move(fn));
+    }
+
+    void run() {
+        while (!ready_.empty() || !timers_.empty()) {
+            while (!ready_.empty()) {
+                auto fn = std::move(ready_.front());
+                ready_.pop_front();
+                fn();
+            }
+            if (timers_.empty()) break;
+            auto due = timers_.begin()->first;
+            if (due > Clock::now()) std::this_thread::sleep_until(due);
+            auto now = Clock::now();
+            while (!timers_.empty() && timers_.begin()->first <= now) {
+                auto fn = std::move(timers_.begin()->second);
+                timers_.erase(timers_.begin());
+                fn();
+            }
+        }
+    }
+
+private:
+    std::deque<std::function<void()>>                    ready_;
+    std::multimap<Clock::time_point, std::function<void()>> timers_;
+};
+
+// Fire-and-forget coroutine: starts at once, frees itself when done
+struct Task {
+    struct promise_type {
+        Task get_return_object() { return {}; }
+        std::suspend_never initial_suspend() noexcept { return {}; }
+        std::suspend_never final_suspend() noexcept { return {}; }
+        void return_void() {}
+        void unhandled_exception() { std::terminate(); }
+    };
+};
+
+// Async backend on the loop: answers after `latency`; negative keys don't
+// exist, keys >= 1000000 fail
+struct Backend {
+    EventLoop& loop;
+    std::chrono::microseconds latency;
+    int calls = 0;
+
+    template<typename Done>
+    void fetch(int key, Done done) {
+        ++calls;
+        loop.postAfter(latency, [key, done] {
+            if (key >= 1000000) done(std::nullopt, std::make_exception_ptr(std::runtime_error("backend error")));
+            else if (key < 0) done(std::nullopt, nullptr);
+            else done("v" + std::to_string(key), nullptr);
+        });
+    }
+};
+
+template<typename Async>
+typename Async::AsyncLoader loaderFor(Backend& backend) {
+    return [&backend](const int& key, typename Async::Completion done) { backend.fetch(key, std::move(done)); };
+}
+
+// Coroutine bodies are free functions: their parameters are copied into
+// the frame, while a capturing lambda's captures die with the temporary
+// closure at the first suspension
+template<typename Async>
+Task fetch(Async& async, int key, typename Async::AsyncLoader loader,
+           std::function<void(const Result& value, bool threw)> then) {
+    Result value;
+    bool threw = false;
+    try {
+        value = co_await async.co_getOrLoad(key, std::move(loader));
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    then(value, threw);
+}
+
+template<typename Async>
+Task readMany(Async& async, CacheBench::ZipfGenerator& zipf, int seed, int count,
+              typename Async::AsyncLoader loader) {
+    std::mt19937 gen(seed);
+    for (int i = 0; i < count; ++i) co_await async.co_getOrLoad(zipf(gen), loader);
+}
+
+template<typename Async>
+Task readHits(Async& async, int count, typename Async::AsyncLoader loader, size_t& sink) {
+    for (int i = 0; i < count; ++i) {
+        Result value = co_await async.co_getOrLoad(i % 100, loader);
+        sink += value.has_value();
+    }
+}
+
+// A hit completes inside the call that starts the coroutine; a miss only
+// once the loop has run the backend's answer
+template<typename CacheT>
+bool runHitMissTest(const std::string& testName, CacheT& cache) {
+    std::cout << "=== " << testName << " ===\n";
+    using Async = AsyncLoadingCache<int, std::string, CacheT>;
+    EventLoop loop;
+    Backend backend{loop, std::chrono::microseconds(500)};
+    Async async(cache);
+    cache.put(1, "cached");
+
+    bool hitDone = false, missDone = false, refilled = false;
+    Result hitValue, missValue;
+    fetch(async, 1, loaderFor<Async>(backend), [&](const Result& v, bool) {
+        hitValue = v;
+        hitDone  = true;
+    });
+    fetch(async, 2, loaderFor<Async>(backend), [&](const Result& v, bool) {
+        missValue = v;
+        missDone  = true;
+    });
+    bool hitSync = hitDone, missSuspended = !missDone;
+    loop.run();
+    fetch(async, 2, loaderFor<Async>(backend), [&](const Result& v, bool) { refilled = v == "v2"; });
+
+    std::cout << "hit completed synchronously: " << (hitSync ? "yes" : "no") << ", miss suspended: "
+              << (missSuspended ? "yes" : "no") << ", miss value: " << missValue.value_or("-")
+              << ", then a synchronous hit: " << (refilled ? "yes" : "no") << ", suspensions "
+              << async.suspensions() << "\n";
+    bool ok = hitSync && hitValue == "cached" && missSuspended && missDone && missValue == "v2" && refilled &&
+              async.suspensions() == 1 && async.hits() == 2 && backend.calls == 1;
+    std::cout << "Result: " << (ok ? "PASS" : "FAIL") << "\n\n";
+    return ok;
+}
+
+// Many coroutines awaiting one missing key share one load; absent keys give
+// nullopt, errors reach every awaiter, an inline loader never suspends
+bool runCoalescingTest(const std::string& testName, int coroutines) {
+    std::cout << "=== " << testName << " ===\n";
+    using Cache_ = LruCache<int, std::string>;
+    using Async  = AsyncLoadingCache<int, std::string, Cache_>;
+    EventLoop loop;
+    Backend backend{loop, std::chrono::microseconds(1000)};
+    Cache_ cache(100);
+    Async async(cache);
+
+    int right = 0, absent = 0, errors = 0;
+    for (int i = 0; i < coroutines; ++i) {
+        fetch(async, 5, loaderFor<Async>(backend), [&](const Result& v, bool) { right += v == "v5"; });
+        fetch(async, -5, loaderFor<Async>(backend), [&](const Result& v, bool threw) {
+            absent += !v && !threw;
+        });
+        fetch(async, 1000000, loaderFor<Async>(backend), [&](const Result&, bool threw) {
+            errors += threw;
+        });
+    }
+    loop.run();
+    int callsAfter = backend.calls;
+
+    bool inlineDone = false;
+    size_t suspensionsBefore = async.suspensions();
+    Async::AsyncLoader inlineLoader = [](const int& key, Async::Completion done) {
+        done("inline" + std::to_string(key), nullptr);
+    };
+    fetch(async, 9, inlineLoader, [&](const Result& v, bool) { inlineDone = v == "inline9"; });
+
+    std::cout << coroutines << " coroutines per key: loader calls " << callsAfter << " (joined " << async.joined()
+              << "), correct " << right << ", absent " << absent << ", errors " << errors
+              << "; inline loader completed without suspending: "
+              << (inlineDone && async.suspensions() == suspensionsBefore ? "yes" : "no") << "\n";
+    bool ok = callsAfter == 3 && right == coroutines && absent == coroutines && errors == coroutines &&
+              async.joined() == static_cast<size_t>(3 * (coroutines - 1)) && inlineDone &&
+              async.suspensions() == suspensionsBefore;
+    std::cout << "Result: " << (ok ? "PASS" : "FAIL") << "\n\n";
+    return ok;
+}
+
+// The backend answers from another thread: waiters resume there
+bool runCrossThreadTest(const std::string& testName, int coroutines) {
+    std::cout << "=== " << testName << " ===\n";
+    using Cache_ = HashLruCaches<int, std::string>;
+    using Async  = AsyncLoadingCache<int, std::string, Cache_>;
+    Cache_ cache(1000, 4);
+    Async async(cache);
+    std::vector<std::thread> io;
+    std::atomic<int> done{0}, right{0};
+    std::mutex ioMutex;
+
+    Async::AsyncLoader onIoThread = [&](const int& k, Async::Completion complete) {
+        std::lock_guard<std::mutex> lock(ioMutex);
+        io.emplace_back([k, complete] {
+            std::this_thread::sleep_for(std::chrono::milliseconds(2));
+            complete("v" + std::to_string(k), nullptr);
+        });
+    };
+    for (int i = 0; i < coroutines; ++i) {
+        int key = i % 10;
+        fetch(async, key, onIoThread, [&, key](const Result& v, bool) {
+            right += v == "v" + std::to_string(key);
+            done.fetch_add(1);
+        });
+    }
+    while (done.load() < coroutines) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    for (auto& t : io) t.join();
+    std::cout << coroutines << " coroutines over 10 keys, completions on I/O threads: loads " << async.loads()
+              << ", correct " << right.load() << "\n";
+    bool ok = right.load() == coroutines && async.loads() == 10;
+    std::cout << "Result: " << (ok ? "PASS" : "FAIL") << "\n\n";
+    return ok;
+}
+
+// Zipf gets against a 1 ms backend: blocking cache-aside on 1 and 8
+// threads vs `inFlight` coroutines on one event-loop thread
+void runThroughputBench(const std::string& testName, int keySpace, int capacity, int gets, int inFlight) {
+    std::cout << "=== " << testName << " ===\n";
+    CacheBench::ZipfGenerator zipf(keySpace, 0.9);
+    const auto latency = std::chrono::microseconds(1000);
+
+    auto report = [&](const char* name, int threads, double seconds, size_t loads, int count) {
+        std::cout << std::left << std::setw(22) << name << std::right << " | " << std::setw(7) << threads << " | "
+                  << std::setw(7) << loads << " | " << std::setw(9) << std::setprecision(1) << count / seconds / 1e3
+                  << "\n";
+    };
+    std::cout << std::fixed << "Mode                   | threads |   loads |  Kgets/s\n";
+
+    for (int threads : {1, 8}) {
+        HashLruCaches<int, std::string> cache(capacity, 4);
+        std::atomic<size_t> loads{0};
+        int perThread = gets / 8;                                    // One thread does an eighth of the work
+        auto start = Clock::now();
+        std::vector<std::thread> workers;
+        for (int t = 0; t < threads; ++t) {
+            workers.emplace_back([&, t] {
+                std::mt19937 gen(t + 1);
+                std::string v;
+                for (int i = 0; i < perThread; ++i) {
+                    int key = zipf(gen);
+                    if (cache.get(key, v)) continue;
+                    loads.fetch_add(1);
+                    std::this_thread::sleep_for(latency);            // Synchronous loader
+                    cache.put(key, "v" + std::to_string(key));
+                }
+            });
+        }
+        for (auto& w : workers) w.join();
+        report("blocking cache-aside", threads,
+               std::chrono::duration<double>(Clock::now() - start).count(), loads.load(), perThread * threads);
+    }
+    {
+        using Cache_ = HashLruCaches<int, std::string>;
+        using Async  = AsyncLoadingCache<int, std::string, Cache_>;
+        Cache_ cache(capacity, 4);
+        Async async(cache);
+        EventLoop loop;
+        Backend backend{loop, latency};
+        auto loader = loaderFor<Async>(backend);
+        int perCoroutine = gets / inFlight;
+        auto start = Clock::now();
+        for (int c = 0; c < inFlight; ++c) readMany(async, zipf, c + 1, perCoroutine, loader);
+        loop.run();
+        report("coroutines", 1, std::chrono::duration<double>(Clock::now() - start).count(), async.loads(),
+               perCoroutine * inFlight);
+        std::cout << "(" << inFlight << " coroutines in flight; suspensions " << async.suspensions() << ", joined "
+                  << async.joined() << ")\n";
+    }
+
+    // Hit path: co_getOrLoad on a cached key vs a plain get
+    {
+        using Cache_ = HashLruCaches<int, std::string>;
+        using Async  = AsyncLoadingCache<int, std::string, Cache_>;
+        Cache_ cache(capacity, 4);
+        Async async(cache);
+        for (int k = 0; k < 100; ++k) cache.put(k, "v" + std::to_string(k));
+        Async::AsyncLoader never = [](const int&, Async::Completion) { std::terminate(); };
+        const int n = 1000000;
+        std::string v;
+        size_t sink = 0;
+        auto start = Clock::now();
+        for (int i = 0; i < n; ++i) sink += cache.get(i % 100, v);
+        double getNs = std::chrono::duration<double, std::nano>(Clock::now() - start).count() / n;
+        start = Clock::now();
+        readHits(async, n, never, sink);
+        double coNs = std::chrono::duration<double, std::nano>(Clock::now() - start).count() / n;
+        std::cout << std::setprecision(1) << "Hit path: get " << getNs << " ns, co_getOrLoad " << coNs
+                  << " ns (suspensions " << async.suspensions() << ", sink " << sink << ")\n";
+    }
+    std::cout << "\n";
+}
+
+int main() {
+    bool ok = true;
+    {
+        LruCache<int, std::string> lru(100);
+        ok &= runHitMissTest("AsyncLoading Test 1: Hits don't suspend, misses do (LRU)", lru);
+        LfuCache<int, std::string> lfu(100);
+        ok &= runHitMissTest("AsyncLoading Test 2: Hits don't suspend, misses do (LFU)", lfu);
+        Arc_new<int, std::string> arc(100);
+        ok &= runHitMissTest("AsyncLoading Test 3: Hits don't suspend, misses do (ARC)", arc);
+        HashLruCaches<int, std::string> sharded(100, 4);
+        ok &= runHitMissTest("AsyncLoading Test 4: Hits don't suspend, misses do (sharded LRU)", sharded);
+    }
+    ok &= runCoalescingTest("AsyncLoading Test 5: Coalesced loads, absent keys, errors, inline loaders", 50);
+    ok &= runCrossThreadTest("AsyncLoading Test 6: Completions from other threads", 200);
+
+    runThroughputBench("AsyncLoading Bench 1: Zipf 0.9 over 50k keys, 5k cache, 1 ms backend", 50000, 5000, 16000, 256);
+
+    return ok ? 0 : 1;
+}
+
+#else
+
+int main() {
+    std::cout << "AsyncLoadingCache needs C++20 coroutines; skipped\n";
+    return 0;
+}
+
+#endif
@@ -0,0 +1,332 @@
+// BatchLoadingCache: misses from concurrent callers coalesced into bulk
+// loads; single flight, misses and loader errors; vs per-key cache-aside
+#include <iostream>
+#include <string>
+#include <random>
+#include <iomanip>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include "BatchLoadingCache.h"
+#include "BenchUtil.h"
+
+using namespace Cache;
+using Clock = std::chrono::steady_clock;
+
+// Key whose hash can park the calling thread on its Nth hash call, to
+// stop a lookup at an exact point between two of its steps
+struct GatedKey {
+    int k;
+    bool operator==(const GatedKey& o) const { return k == o.k; }
+};
+
+namespace HashGate {
+thread_local long countdown = 0;               // > 0: park on the call that takes it to 0
+std::atomic<bool> parked{false}, resume{false};
+}
+
+template<> struct std::hash<GatedKey> {
+    size_t operator()(const GatedKey& key) const {
+        if (HashGate::countdown > 0 && --HashGate::countdown == 0) {
+            HashGate::parked.store(true);
+            while (!HashGate::resume.load()) std::this_thread::yield();
+        }
+        return std::hash<int>{}(key.k);
+    }
+};
+
+// Simulated backend: one fixed round trip per call plus a small per-key
+// cost; `connections` > 0 caps concurrent calls like a connection pool
+struct Backend {
+    Backend(std::chrono::microseconds call, std::chrono::microseconds perKey, int connections = 0)
+        : callLatency(call), keyLatency(perKey), free(connections), limited(connections > 0) {}
+
+    std::unordered_map<int, std::string> fetch(const std::vector<int>& keys) {
+        calls.fetch_add(1);
+        keysFetched.fetch_add(keys.size());
+        acquire();
+        std::this_thread::sleep_for(callLatency + keyLatency * static_cast<int>(keys.size()));
+        release();
+        std::unordered_map<int, std::string> out;
+        for (int k : keys)
+            if (k >= 0) out.emplace(k, "v" + std::to_string(k));    // Negative keys don't exist
+        return out;
+    }
+
+    void acquire() {
+        if (!limited) return;
+        std::unique_lock<std::mutex> lock(m);
+        while (free == 0) cv.wait_for(lock, std::chrono::milliseconds(1));
+        --free;
+    }
+    void release() {
+        if (!limited) return;
+        std::lock_guard<std::mutex> lock(m);
+        ++free;
+        cv.notify_one();
+    }
+
+    std::chrono::microseconds callLatency, keyLatency;
+    std::atomic<size_t> calls{0}, keysFetched{0};
+    std::mutex m;
+    std::condition_variable cv;
+    int  free;
+    bool limited;
+};
+
+// Run fn(t) on `threads` threads released together
+template<typename Fn>
+void together(int threads, Fn fn) {
+    std::atomic<int> ready{0};
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; ++t) {
+        workers.emplace_back([&, t] {
+            ready.fetch_add(1);
+            while (ready.load() < threads) std::this_thread::yield();
+            fn(t);
+        });
+    }
+    for (auto& w : workers) w.join();
+}
+
+BatchLoadingCache<int, std::string>::BulkLoader loaderFor(Backend& backend) {
+    return [&backend](const std::vector<int>& keys) { return backend.fetch(keys); };
+}
+
+// Concurrent misses on distinct keys share loader calls; a batch that
+// reaches maxBatch goes out without waiting for the window
+bool runBatchingTest(const std::string& testName) {
+    std::cout << "=== " << testName << " ===\n";
+    bool ok = true;
+    {
+        Backend backend(std::chrono::microseconds(1000), std::chrono::microseconds(0));
+        BatchLoaderOptions opts;
+        opts.window = std::chrono::milliseconds(20);
+        BatchLoadingCache<int, std::string> cache(1000, loaderFor(backend), opts);
+        std::atomic<int> wrong{0};
+        together(16, [&](int t) {
+            std::string v;
+            if (!cache.get(t, v) || v != "v" + std::to_string(t)) wrong.fetch_add(1);
+        });
+        size_t callsAfterMiss = backend.calls.load();
+        together(16, [&](int t) {
+            std::string v;
+            if (!cache.get(t, v) || v != "v" + std::to_string(t)) wrong.fetch_add(1);
+        });
+        std::cout << "16 concurrent misses, 20 ms window: loader calls " << callsAfterMiss
+                  << ", after the hit round " << backend.calls.load() << ", wrong " << wrong.load() << "\n";
+        ok &= wrong.load() == 0 && callsAfterMiss <= 2 && backend.calls.load() == callsAfterMiss;
+    }
+    {
+        Backend backend(std::chrono::microseconds(1000), std::chrono::microseconds(0));
+        BatchLoaderOptions opts;
+        opts.window   = std::chrono::seconds(5);               // Only maxBatch can dispatch in time
+        opts.maxBatch = 8;
+        BatchLoadingCache<int, std::string> cache(1000, loaderFor(backend), opts);
+        auto start = Clock::now();
+        together(40, [&](int t) { std::string v; cache.get(t, v); });
+        double ms = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+        std::cout << std::fixed << std::setprecision(1) << "40 misses, maxBatch 8, 5 s window: loader calls "
+                  << backend.calls.load() << ", done in " << ms << " ms\n";
+        ok &= backend.calls.load() == 5 && ms < 2000.0;
+    }
+    std::cout << "Result: " << (ok ? "PASS" : "FAIL") << "\n\n";
+    return ok;
+}
+
+// Many callers missing the same key: one load of one key
+bool runSingleFlightTest(const std::string& testName) {
+    std::cout << "=== " << testName << " ===\n";
+    Backend backend(std::chrono::microseconds(2000), std::chrono::microseconds(0));
+    BatchLoadingCache<int, std::string> cache(1000, loaderFor(backend));
+    std::atomic<int> wrong{0};
+    together(16, [&](int) {
+        std::string v;
+        if (!cache.get(42, v) || v != "v42") wrong.fetch_add(1);
+    });
+    std::cout << "16 callers, one key: loader calls " << backend.calls.load() << ", keys fetched "
+              << backend.keysFetched.load() << ", shared misses " << cache.sharedMisses() << "\n";
+    bool ok = wrong.load() == 0 && backend.calls.load() == 1 && backend.keysFetched.load() == 1 &&
+              cache.sharedMisses() == 15;
+    std::cout << "Result: " << (ok ? "PASS" : "FAIL") << "\n\n";
+    return ok;
+}
+
+// Keys the loader omits are misses and are not cached; a loader error
+// reaches every caller of that batch, and the keys load again afterwards
+bool runErrorTest(const std::string& testName) {
+    std::cout << "=== " << testName << " ===\n";
+    Backend backend(std::chrono::microseconds(0), std::chrono::microseconds(0));
+    std::atomic<bool> failing{false};
+    BatchLoaderOptions opts;
+    opts.window = std::chrono::milliseconds(20);
+    BatchLoadingCache<int, std::string> cache(1000, [&](const std::vector<int>& keys) {
+        if (failing.load()) throw std::runtime_error("backend down");
+        return backend.fetch(keys);
+    }, opts);
+
+    std::string v;
+    bool absent = !cache.get(-5, v) && !cache.get(-5, v);
+    size_t absentCalls = backend.calls.load();
+
+    failing.store(true);
+    std::atomic<int> thrown{0};
+    together(8, [&](int t) {
+        std::string out;
+        try { cache.get(100 + t, out); } catch (const std::runtime_error&) { thrown.fetch_add(1); }
+    });
+    failing.store(false);
+    bool recovered = cache.get(100, v) && v == "v100";
+
+    std::cout << "Absent key loaded " << absentCalls << " times (not cached), callers that saw the error: "
+              << thrown.load() << "/8, recovered: " << (recovered ? "yes" : "no") << "\n";
+    bool ok = absent && absentCalls == 2 && thrown.load() == 8 && recovered;
+    std::cout << "Result: " << (ok ? "PASS" : "FAIL") << "\n\n";
+    return ok;
+}
+
+// A put() that lands while the key's batch is loading keeps its value:
+// the waiting get() sees the loaded value, the cache keeps the put()
+bool runPutRaceTest(const std::string& testName) {
+    std::cout << "=== " << testName << " ===\n";
+    std::atomic<bool> loading{false}, release{false};
+    BatchLoaderOptions opts;
+    opts.window = std::chrono::microseconds(0);
+    BatchLoadingCache<int, std::string> cache(1000, [&](const std::vector<int>& keys) {
+        loading.store(true);
+        while (!release.load()) std::this_thread::yield();
+        std::unordered_map<int, std::string> out;
+        for (int k : keys) out.emplace(k, "stale");
+        return out;
+    }, opts);
+
+    std::string loaded;
+    std::thread reader([&] { cache.get(7, loaded); });
+    while (!loading.load()) std::this_thread::yield();
+    cache.put(7, "fresh");
+    release.store(true);
+    reader.join();
+
+    std::string v;
+    bool cached = cache.get(7, v);
+    std::cout << "In-flight get returned \"" << loaded << "\", cache holds \"" << v << "\"\n";
+    bool ok = loaded == "stale" && cached && v == "fresh";
+    std::cout << "Result: " << (ok ? "PASS" : "FAIL") << "\n\n";
+    return ok;
+}
+
+// A put() that completes after a lookup's first miss, but before the
+// key is queued for loading, must not be overwritten by that load. The
+// reader is parked on the negative-cache check, which runs right after
+// the miss: its hash call comes after those of a HashLruCaches::get
+bool runPutAfterMissTest(const std::string& testName) {
+    std::cout << "=== " << testName << " ===\n";
+    std::atomic<int> loads{0};
+    BatchLoaderOptions opts;
+    opts.window      = std::chrono::microseconds(0);
+    opts.negativeTtl = std::chrono::seconds(10);
+    BatchLoadingCache<GatedKey, std::string> cache(1000, [&](const std::vector<GatedKey>& keys) {
+        loads.fetch_add(1);
+        std::unordered_map<GatedKey, std::string> out;
+        for (const auto& k : keys) out.emplace(k, "stale");
+        return out;
+    }, opts, 1);
+
+    std::string got;
+    std::thread reader([&] {
+        const long probe = 1L << 30;
+        HashLruCaches<GatedKey, std::string> twin(1000, 1);
+        std::string v;
+        HashGate::countdown = probe;
+        twin.get(GatedKey{7}, v);
+        long getHashes = probe - HashGate::countdown;
+        HashGate::countdown = getHashes + 1;   // cache_.get's hashes, then the negative-cache check
+        cache.get(GatedKey{7}, got);
+        HashGate::countdown = 0;
+    });
+    while (!HashGate::parked.load()) std::this_thread::yield();
+    cache.put(GatedKey{7}, "fresh");
+    HashGate::resume.store(true);
+    reader.join();
+
+    std::string v;
+    bool cached = cache.get(GatedKey{7}, v);
+    std::cout << "get() parked after its miss returned \"" << got << "\", loads " << loads.load()
+              << ", cache holds \"" << v << "\"\n";
+    bool ok = cached && v == "fresh" && got == "fresh" && loads.load() == 0;
+    std::cout << "Result: " << (ok ? "PASS" : "FAIL") << "\n\n";
+    return ok;
+}
+
+// Many threads reading a large Zipf key space through a small cache:
+// per-key cache-aside vs batched loading, against a 1 ms backend
+void runLoaderBench(const std::string& testName, int threads, int getsPerThread, int keySpace, int capacity,
+                    int connections) {
+    std::cout << "=== " << testName << " ===\n";
+    CacheBench::ZipfGenerator zipf(keySpace, 0.8);
+
+    auto run = [&](const char* name, Backend& backend, auto&& get) {
+        std::vector<CacheBench::Latency> lat(threads);
+        double ops = CacheBench::runThroughput(threads, [&](int t) {
+            std::mt19937 gen(t + 1);
+            std::string v;
+            for (int i = 0; i < getsPerThread; ++i) {
+                int key = zipf(gen);
+                lat[t].time([&] { get(key, v); });
+            }
+            return getsPerThread;
+        });
+        CacheBench::Latency all;
+        for (auto& l : lat) all.merge(l);
+        std::cout << std::left << std::setw(12) << name << std::right << " | " << std::setw(13) << backend.calls.load()
+                  << " | " << std::setw(12) << backend.keysFetched.load() << " | " << std::setw(8) << ops / 1e3
+                  << " | " << std::setw(8) << all.percentile(50) / 1e3 << " | " << std::setw(8)
+                  << all.percentile(99) / 1e3 << "\n";
+    };
+
+    std::cout << std::fixed << std::setprecision(1)
+              << "Mode         | backend calls | keys fetched | Kgets/s  |  p50 us  |  p99 us\n";
+    {
+        Backend backend(std::chrono::microseconds(1000), std::chrono::microseconds(2), connections);
+        HashLruCaches<int, std::string> cache(capacity, 4);
+        run("cache-aside", backend, [&](int key, std::string& v) {
+            if (cache.get(key, v)) return;
+            auto loaded = backend.fetch({key});
+            v = loaded[key];
+            cache.put(key, v);
+        });
+    }
+    {
+        Backend backend(std::chrono::microseconds(1000), std::chrono::microseconds(2), connections);
+        BatchLoaderOptions opts;
+        opts.window   = std::chrono::microseconds(200);
+        opts.maxBatch = 64;
+        BatchLoadingCache<int, std::string> cache(capacity, loaderFor(backend), opts, 4);
+        run("batched", backend, [&](int key, std::string& v) { cache.get(key, v); });
+        std::cout << "(shared misses: " << cache.sharedMisses() << ", avg keys per call: "
+                  << static_cast<double>(cache.keysLoaded()) / std::max<size_t>(1, cache.loaderCalls()) << ")\n";
+    }
+    std::cout << "\n";
+}
+
+int main() {
+    bool ok = true;
+    ok &= runBatchingTest("BatchLoading Test 1: Concurrent misses share loader calls");
+    ok &= runSingleFlightTest("BatchLoading Test 2: Single flight per key");
+    ok &= runErrorTest("BatchLoading Test 3: Absent keys and loader errors");
+    ok &= runPutRaceTest("BatchLoading Test 4: put() during an in-flight load wins");
+    ok &= runPutAfterMissTest("BatchLoading Test 5: put() between a miss and its batch wins");
+
+    runLoaderBench("BatchLoading Bench 1: Cache-aside vs batched, 1 ms backend, unlimited calls",
+                   32, 300, 100000, 5000, 0);
+    runLoaderBench("BatchLoading Bench 2: Cache-aside vs batched, 1 ms backend, 4 connections",
+                   32, 300, 100000, 5000, 4);
+
+    return ok ? 0 : 1;
+}
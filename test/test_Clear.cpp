@@ -0,0 +1,204 @@
+// O(1) clear / purge: a cleared generation is a miss at once and is
+// torn down in batches by later calls or the maintenance task; clear
+// latency against cache size, and get latency while a generation drains
+#include <iostream>
+#include <string>
+#include <random>
+#include <iomanip>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <thread>
+#include <vector>
+#include "ArcCache.h"
+#include "Arc_new.h"
+#include "LfuCache.h"
+#include "MaintenanceExecutor.h"
+#include "BenchUtil.h"
+
+using namespace Cache;
+using Clock = std::chrono::steady_clock;
+
+std::string val(int k) { return "value-" + std::to_string(k) + std::string(24, 'x'); }
+
+// Arc_new::clear() / LfuCache::purge() / ArcCache::clear() behind one name
+template<typename C> void wipe(C& c) { c.clear(); }
+template<typename K, typename V, typename L> void wipe(LfuCache<K, V, L>& c) { c.purge(); }
+
+template<typename CacheT>
+int countHits(CacheT& cache, int n) {
+    std::string v;
+    int hits = 0;
+    for (int k = 0; k < n; ++k) hits += cache.get(k, v);
+    return hits;
+}
+
+// Every key misses right after clear; the old entries are reported as
+// they are torn down, and the cache refills normally meanwhile
+template<typename CacheT>
+bool runGenerationTest(const std::string& testName, bool listener) {
+    std::cout << "=== " << testName << " ===\n";
+    CacheT cache(2000);
+    std::atomic<int> explicitRemovals{0};
+    if constexpr (!std::is_same_v<CacheT, ArcCache<int, std::string>>) {
+        if (listener) {
+            cache.setRemovalListener([&](RemovalBatch<int, std::string>& batch) {
+                for (auto& n : batch) explicitRemovals += n.cause == RemovalCause::Explicit;
+            });
+        }
+    }
+    for (int k = 0; k < 2000; ++k) cache.put(k, val(k));
+    for (int k = 0; k < 1000; ++k) cache.get(k, *std::make_unique<std::string>());   // Some in T2 / higher freq
+
+    wipe(cache);
+    bool pendingAfterClear = cache.reclaimPending() && cache.generation() == 1;
+    int hitsAfterClear = countHits(cache, 2000);     // Each of these gets also reclaims a batch
+
+    for (int k = 0; k < 2000; ++k) cache.put(k + 10000, val(k));
+    int steps = 0;
+    std::string v;
+    while (cache.reclaimPending() && steps < 100000) { cache.get(-1, v); ++steps; }
+    bool refilled = cache.get(11999, v) && v == val(1999);
+
+    std::cout << "hits right after clear: " << hitsAfterClear << ", generation " << cache.generation()
+              << ", reclaimed after " << steps << " more gets, Explicit notifications " << explicitRemovals.load()
+              << "\n";
+    bool ok = pendingAfterClear && hitsAfterClear == 0 && !cache.reclaimPending() && refilled &&
+              (!listener || explicitRemovals.load() == 2000);
+    std::cout << "Result: " << (ok ? "PASS" : "FAIL") << "\n\n";
+    return ok;
+}
+
+// With a maintenance executor the task tears the generation down; no
+// get / put has to help
+template<typename CacheT>
+bool runMaintenanceTest(const std::string& testName) {
+    std::cout << "=== " << testName << " ===\n";
+    auto executor = std::make_shared<MaintenanceExecutor>();
+    CacheT cache(5000);
+    cache.enableMaintenance(executor, 4500, 5500);
+    for (int k = 0; k < 5000; ++k) cache.put(k, val(k));
+    executor->drain();
+    wipe(cache);
+    executor->drain();
+    bool ok = !cache.reclaimPending() && cache.size() == 0;
+    std::cout << "reclaimed by the executor: " << (ok ? "yes" : "no") << "\n";
+    std::cout << "Result: " << (ok ? "PASS" : "FAIL") << "\n\n";
+    return ok;
+}
+
+// Readers and writers keep going while another thread clears in a loop
+template<typename CacheT>
+bool runConcurrentTest(const std::string& testName, int threads) {
+    std::cout << "=== " << testName << " ===\n";
+    CacheT cache(4096);
+    std::atomic<bool> stop{false};
+    std::atomic<int> clears{0};
+    std::atomic<int> wrong{0};
+    std::thread clearer([&] {
+        while (!stop.load()) {
+            wipe(cache);
+            clears.fetch_add(1);
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    });
+    CacheBench::runThroughput(threads, [&](int t) {
+        std::mt19937 gen(t + 1);
+        std::uniform_int_distribution<int> dist(0, 8191);
+        std::string v;
+        for (int i = 0; i < 30000; ++i) {
+            int k = dist(gen);
+            if (cache.get(k, v) && v != val(k)) wrong.fetch_add(1);
+            else cache.put(k, val(k));
+        }
+        return 30000;
+    });
+    stop = true;
+    clearer.join();
+    std::string v;
+    for (int i = 0; i < 100000 && cache.reclaimPending(); ++i) cache.get(-1, v);
+    std::cout << threads << " threads, " << clears.load() << " clears: " << wrong.load() << " wrong values, "
+              << (cache.reclaimPending() ? "still pending" : "all generations reclaimed") << "\n";
+    bool ok = wrong.load() == 0 && !cache.reclaimPending();
+    std::cout << "Result: " << (ok ? "PASS" : "FAIL") << "\n\n";
+    return ok;
+}
+
+// A removal listener runs while a generation drains; it may clear the
+// cache again (retire() never waits for the running drain)
+template<typename CacheT>
+bool runListenerClearTest(const std::string& testName) {
+    std::cout << "=== " << testName << " ===\n";
+    CacheT cache(2000);
+    std::atomic<int> nested{0};
+    std::atomic<int> explicitRemovals{0};
+    cache.setRemovalListener([&](RemovalBatch<int, std::string>& batch) {
+        for (auto& n : batch) explicitRemovals += n.cause == RemovalCause::Explicit;
+        if (nested.fetch_add(1) == 0) wipe(cache);
+    });
+    for (int k = 0; k < 2000; ++k) cache.put(k, val(k));
+    wipe(cache);
+    cache.reclaimNow();
+    std::cout << "generation " << cache.generation() << ", Explicit notifications " << explicitRemovals.load()
+              << "\n";
+    bool ok = !cache.reclaimPending() && cache.generation() == 2 && explicitRemovals.load() == 2000;
+    std::cout << "Result: " << (ok ? "PASS" : "FAIL") << "\n\n";
+    return ok;
+}
+
+// clear() latency for growing sizes; then how long the generation takes
+// to drain through ordinary gets, and what those gets cost meanwhile
+template<typename CacheT>
+void runClearBench(const std::string& label, int size) {
+    auto cache = std::make_unique<CacheT>(size);
+    for (int k = 0; k < size; ++k) cache->put(k, val(k));
+    std::string v;
+
+    CacheBench::Latency quiet;
+    for (int i = 0; i < 20000; ++i) quiet.time([&] { cache->get(i % size, v); });
+
+    auto t0 = Clock::now();
+    wipe(*cache);
+    double clearUs = std::chrono::duration<double, std::micro>(Clock::now() - t0).count();
+
+    CacheBench::Latency draining;
+    long gets = 0;
+    auto t1 = Clock::now();
+    while (cache->reclaimPending()) {
+        int k = static_cast<int>(gets++ % size);
+        draining.time([&] { cache->get(k, v); });
+    }
+    double drainMs = std::chrono::duration<double, std::milli>(Clock::now() - t1).count();
+
+    std::cout << std::left << std::setw(9) << label << std::right << " | " << std::setw(9) << size << " | "
+              << std::setw(8) << clearUs << " | " << std::setw(9) << drainMs << " | " << std::setw(8) << gets
+              << " | " << std::setw(8) << quiet.percentile(99) / 1e3 << " | " << std::setw(8)
+              << draining.percentile(50) / 1e3 << " | " << std::setw(8) << draining.percentile(99) / 1e3 << "\n";
+}
+
+int main() {
+    bool ok = true;
+    ok &= runGenerationTest<Arc_new<int, std::string>>("Clear Test 1: Arc_new::clear", true);
+    ok &= runGenerationTest<LfuCache<int, std::string>>("Clear Test 2: LfuCache::purge", true);
+    ok &= runGenerationTest<ArcCache<int, std::string>>("Clear Test 3: ArcCache::clear", false);
+    ok &= runMaintenanceTest<Arc_new<int, std::string>>("Clear Test 4: Arc_new, reclaimed by maintenance");
+    ok &= runMaintenanceTest<LfuCache<int, std::string>>("Clear Test 5: LfuCache, reclaimed by maintenance");
+    ok &= runConcurrentTest<Arc_new<int, std::string>>("Clear Test 6: Arc_new, clear under load", 4);
+    ok &= runConcurrentTest<LfuCache<int, std::string>>("Clear Test 7: LfuCache, purge under load", 4);
+    ok &= runConcurrentTest<ArcCache<int, std::string>>("Clear Test 8: ArcCache, clear under load", 4);
+    ok &= runListenerClearTest<Arc_new<int, std::string>>("Clear Test 9: Arc_new, listener clears during teardown");
+    ok &= runListenerClearTest<LfuCache<int, std::string>>("Clear Test 10: LfuCache, listener purges during teardown");
+
+    std::cout << "=== Clear Bench 1: clear() latency vs size, then teardown through ordinary gets ===\n";
+    std::cout << std::fixed << std::setprecision(1)
+              << "Policy    |   entries | clear us | drain ms  | gets     | p99 us   | drain p50| drain p99\n";
+    for (int size : {10000, 100000, 1000000}) {
+        runClearBench<Arc_new<int, std::string>>("Arc_new", size);
+        runClearBench<LfuCache<int, std::string>>("LfuCache", size);
+        runClearBench<ArcCache<int, std::string>>("ArcCache", size);
+    }
+    std::cout << "(p99 us: get before the clear; drain p50/p99: gets that also tear down up to 128 entries)\n\n";
+
+    return ok ? 0 : 1;
+}
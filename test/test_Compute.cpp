@@ -0,0 +1,206 @@
+// compute / computeIfAbsent / computeIfPresent / merge: semantics over
+// LRU, LFU and ARC, exact concurrent counters (get + put loses updates),
+// and a read-modify-write benchmark against get + put
+#include <iostream>
+#include <string>
+#include <random>
+#include <iomanip>
+#include <atomic>
+#include <functional>
+#include <thread>
+#include <vector>
+#include "LruCache.h"
+#include "LfuCache.h"
+#include "Arc_new.h"
+#include "BenchUtil.h"
+
+using namespace Cache;
+
+using List = std::vector<int>;
+
+// The same script against any cache with the compute family:
+// values are lists, so an in-place append is visible as such
+template<typename CacheT>
+bool runSemanticsTest(const std::string& testName, CacheT& cache) {
+    std::cout << "=== " << testName << " ===\n";
+    int removedExplicit = 0, removedSize = 0;
+    cache.setRemovalListener([&](RemovalBatch<int, List>& batch) {
+        for (auto& n : batch) {
+            if (n.cause == RemovalCause::Explicit) ++removedExplicit;
+            if (n.cause == RemovalCause::Size || n.cause == RemovalCause::DemotedT1 ||
+                n.cause == RemovalCause::DemotedT2) ++removedSize;
+        }
+    });
+
+    int calls = 0;
+    auto make = [&](const int& key) { ++calls; return List{key}; };
+    List first  = cache.computeIfAbsent(1, make);
+    List second = cache.computeIfAbsent(1, make);             // Cached: make is not called
+    bool absentOk = first == List{1} && second == List{1} && calls == 1;
+
+    bool ranOnMissing = false;
+    bool presentMissing = cache.computeIfPresent(2, [&](List&) { ranOnMissing = true; return true; });
+    bool presentHit = cache.computeIfPresent(1, [](List& l) { l.push_back(10); return true; });
+    List v;
+    bool presentOk = !presentMissing && !ranOnMissing && presentHit && cache.get(1, v) && v == List{1, 10};
+
+    auto append = [](List& stored, const List& more) { stored.insert(stored.end(), more.begin(), more.end()); };
+    cache.merge(3, List{7}, append);                           // Absent: inserted as is
+    cache.merge(3, List{8, 9}, append);
+    bool mergeOk = cache.get(3, v) && v == List{7, 8, 9};
+
+    bool inserted = cache.compute(4, [](List& l, bool present) { l.push_back(present ? -1 : 4); return false; });
+    bool declinedOk = !inserted && !cache.get(4, v);
+
+    bool kept = cache.computeIfPresent(3, [](List& l) { return l.size() < 3; });   // false: remove
+    bool removeOk = !kept && !cache.get(3, v) && removedExplicit == 1;
+
+    // Inserts through compute respect capacity like put
+    for (int k = 100; k < 120; ++k) cache.merge(k, List{k}, append);
+    bool evictOk = removedSize > 0;
+
+    std::cout << "computeIfAbsent " << (absentOk ? "ok" : "wrong") << ", computeIfPresent "
+              << (presentOk ? "ok" : "wrong") << ", merge " << (mergeOk ? "ok" : "wrong") << ", declined insert "
+              << (declinedOk ? "ok" : "wrong") << ", remove " << (removeOk ? "ok" : "wrong") << ", evictions "
+              << removedSize << "\n";
+    bool ok = absentOk && presentOk && mergeOk && declinedOk && removeOk && evictOk;
+    std::cout << "Result: " << (ok ? "PASS" : "FAIL") << "\n\n";
+    return ok;
+}
+
+// threads × increments on a few hot keys: merge must count every one;
+// get + put is reported for comparison (it may lose updates)
+template<typename CacheT>
+bool runCounterTest(const std::string& testName, CacheT& merged, CacheT& racy, int threads, int increments) {
+    std::cout << "=== " << testName << " ===\n";
+    const int keys = 4;
+    auto add = [](long& stored, const long& delta) { stored += delta; };
+    CacheBench::runThroughput(threads, [&](int t) {
+        for (int i = 0; i < increments; ++i) {
+            int key = (i + t) % keys;
+            merged.merge(key, 1L, add);
+            long cur = 0;
+            racy.get(key, cur);
+            racy.put(key, cur + 1);
+        }
+        return increments;
+    });
+
+    long viaMerge = 0, viaGetPut = 0, v;
+    for (int k = 0; k < keys; ++k) {
+        if (merged.get(k, v)) viaMerge += v;
+        if (racy.get(k, v)) viaGetPut += v;
+    }
+    const long expected = static_cast<long>(threads) * increments;
+    std::cout << "expected " << expected << ": merge " << viaMerge << ", get+put " << viaGetPut << " ("
+              << expected - viaGetPut << " lost)\n";
+    bool ok = viaMerge == expected;
+    std::cout << "Result: " << (ok ? "PASS" : "FAIL") << "\n\n";
+    return ok;
+}
+
+// Read-modify-write on Zipf keys: bump a counter, or append to a list
+// capped at 64 entries. get + put copies the list out and back in
+// under two lock holds; merge appends in place under one
+template<typename CacheT>
+void runRmwBench(const std::string& label, std::function<CacheT*()> make, int threads, int opsPerThread) {
+    CacheBench::ZipfGenerator zipf(10000, 0.9);
+    auto append = [](List& stored, const List& more) {
+        if (stored.size() >= 64) stored.erase(stored.begin());
+        stored.push_back(more.front());
+    };
+
+    auto run = [&](bool useMerge) {
+        std::unique_ptr<CacheT> cache(make());
+        return CacheBench::runThroughput(threads, [&](int t) {
+            std::mt19937 gen(t + 1);
+            List tmp;
+            const List one{t};
+            for (int i = 0; i < opsPerThread; ++i) {
+                int key = zipf(gen);
+                if (useMerge) {
+                    cache->merge(key, one, append);
+                } else {
+                    tmp.clear();
+                    cache->get(key, tmp);
+                    append(tmp, one);
+                    cache->put(key, tmp);
+                }
+            }
+            return opsPerThread;
+        });
+    };
+    double getPut = run(false), merge = run(true);
+    std::cout << std::left << std::setw(22) << label << std::right << " | " << std::setw(7) << threads << " | "
+              << std::setw(13) << getPut / 1e3 << " | " << std::setw(11) << merge / 1e3 << " | " << std::setw(6)
+              << merge / getPut << "x\n";
+}
+
+template<typename CacheT>
+void runCounterBench(const std::string& label, std::function<CacheT*()> make, int threads, int opsPerThread) {
+    CacheBench::ZipfGenerator zipf(10000, 0.9);
+    auto run = [&](bool useMerge) {
+        std::unique_ptr<CacheT> cache(make());
+        return CacheBench::runThroughput(threads, [&](int t) {
+            std::mt19937 gen(t + 1);
+            for (int i = 0; i < opsPerThread; ++i) {
+                int key = zipf(gen);
+                if (useMerge) {
+                    cache->merge(key, 1L, [](long& stored, const long& delta) { stored += delta; });
+                } else {
+                    long cur = 0;
+                    cache->get(key, cur);
+                    cache->put(key, cur + 1);
+                }
+            }
+            return opsPerThread;
+        });
+    };
+    double getPut = run(false), merge = run(true);
+    std::cout << std::left << std::setw(22) << label << std::right << " | " << std::setw(7) << threads << " | "
+              << std::setw(13) << getPut / 1e3 << " | " << std::setw(11) << merge / 1e3 << " | " << std::setw(6)
+              << merge / getPut << "x\n";
+}
+
+int main() {
+    bool ok = true;
+    {
+        LruCache<int, List> lru(8);
+        ok &= runSemanticsTest("Compute Test 1: LruCache", lru);
+        LfuCache<int, List> lfu(8);
+        ok &= runSemanticsTest("Compute Test 2: LfuCache", lfu);
+        Arc_new<int, List> arc(8);
+        ok &= runSemanticsTest("Compute Test 3: Arc_new", arc);
+        HashLruCaches<int, List> sharded(8, 2);
+        ok &= runSemanticsTest("Compute Test 4: HashLruCaches", sharded);
+    }
+    {
+        LruCache<int, long> a(64), b(64);
+        ok &= runCounterTest("Compute Test 5: LruCache concurrent counters", a, b, 8, 20000);
+        LfuCache<int, long> c(64), d(64);
+        ok &= runCounterTest("Compute Test 6: LfuCache concurrent counters", c, d, 8, 20000);
+        Arc_new<int, long> e(64), f(64);
+        ok &= runCounterTest("Compute Test 7: Arc_new concurrent counters", e, f, 8, 20000);
+    }
+
+    std::cout << "=== Compute Bench 1: read-modify-write, Zipf 0.9 over 10k keys, 5k entries ===\n";
+    std::cout << std::fixed << std::setprecision(1)
+              << "Workload               | threads | get+put Kop/s | merge Kop/s | speedup\n";
+    for (int threads : {1, 8}) {
+        runCounterBench<LruCache<int, long>>("counter, LruCache", [] { return new LruCache<int, long>(5000); },
+                                             threads, 200000);
+        runCounterBench<LfuCache<int, long>>("counter, LfuCache", [] { return new LfuCache<int, long>(5000); },
+                                             threads, 200000);
+        runCounterBench<Arc_new<int, long>>("counter, Arc_new", [] { return new Arc_new<int, long>(5000); },
+                                            threads, 200000);
+        runRmwBench<LruCache<int, List>>("list append, LruCache", [] { return new LruCache<int, List>(5000); },
+                                         threads, 100000);
+        runRmwBench<LfuCache<int, List>>("list append, LfuCache", [] { return new LfuCache<int, List>(5000); },
+                                         threads, 100000);
+        runRmwBench<Arc_new<int, List>>("list append, Arc_new", [] { return new Arc_new<int, List>(5000); },
+                                        threads, 100000);
+    }
+    std::cout << "\n";
+
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,167 @@
+// ConcurrentHashMap (lock-free reads + EBR) and SieveCache: stress tests + scaling benchmark
+#include <iostream>
+#include <string>
+#include <random>
+#include <iomanip>
+#include <thread>
+#include <atomic>
+#include <vector>
+#include "ConcurrentHashMap.h"
+#include "SieveCache.h"
+#include "LruCache.h"
+#include "BenchUtil.h"
+
+using namespace Cache;
+
+// Basic map semantics, growing through several rehashes
+bool runMapBasicTest(const std::string& testName, int keys) {
+    std::cout << "=== " << testName << " ===\n";
+    ConcurrentHashMap<int, std::string> map(4);
+    bool ok = true;
+    for (int k = 0; k < keys; ++k) ok &= map.insertOrAssign(k, "v" + std::to_string(k));
+    for (int k = 0; k < keys; k += 2) ok &= !map.insertOrAssign(k, "w" + std::to_string(k));
+    for (int k = 0; k < keys; k += 3) ok &= map.erase(k);
+    ok &= !map.erase(-1);
+
+    for (int k = 0; k < keys; ++k) {
+        std::string v;
+        bool found = map.find(k, v);
+        if (k % 3 == 0) ok &= !found;
+        else ok &= found && v == (k % 2 == 0 ? "w" : "v") + std::to_string(k);
+    }
+    int expectSize = keys - (keys + 2) / 3;
+    ok &= static_cast<int>(map.size()) == expectSize;
+    std::cout << "Keys: " << keys << ", Size: " << map.size() << ", Slots: " << map.slotCount() << "\n";
+    std::cout << "Result: " << (ok ? "PASS" : "FAIL") << "\n\n";
+    return ok;
+}
+
+// Linearizability stress: each writer owns the keys k with k % writers == w and
+// writes (key, version) pairs with increasing versions, erasing now and then.
+// Readers check that a value always belongs to the key it was found under and
+// that per-key versions never go backwards. Afterwards the map must hold
+// exactly each writer's last action.
+bool runMapStressTest(const std::string& testName, int writers, int readers, int keys, int opsPerWriter) {
+    std::cout << "=== " << testName << " ===\n";
+    ConcurrentHashMap<int, long long> map(16);   // Small start: forces rehashes under load
+    auto encode = [](int key, int version) { return static_cast<long long>(version) * 1000000 + key; };
+
+    std::atomic<int>  writersDone{0};
+    std::atomic<long> violations{0};
+    std::vector<std::vector<int>> finalVersion(writers, std::vector<int>(keys, -1)); // -1 = erased/absent
+
+    std::vector<std::thread> threads;
+    for (int w = 0; w < writers; ++w) {
+        threads.emplace_back([&, w] {
+            std::mt19937 gen(w);
+            auto& last = finalVersion[w];
+            for (int i = 1; i <= opsPerWriter; ++i) {
+                int key = static_cast<int>(gen() % (keys / writers)) * writers + w;
+                if (gen() % 8 == 0) { map.erase(key); last[key] = -1; }
+                else { map.insertOrAssign(key, encode(key, i)); last[key] = i; }
+            }
+            writersDone.fetch_add(1);
+        });
+    }
+    for (int r = 0; r < readers; ++r) {
+        threads.emplace_back([&, r] {
+            std::mt19937 gen(100 + r);
+            std::vector<int> seen(keys, 0);
+            while (writersDone.load() < writers) {
+                int key = static_cast<int>(gen() % keys);
+                long long v = 0;
+                if (!map.find(key, v)) continue;
+                int vKey = static_cast<int>(v % 1000000);
+                int version = static_cast<int>(v / 1000000);
+                if (vKey != key || version < seen[key]) violations.fetch_add(1);
+                seen[key] = version;
+            }
+        });
+    }
+    for (auto& t : threads) t.join();
+
+    bool ok = violations.load() == 0;
+    size_t expectSize = 0;
+    for (int key = 0; key < keys; ++key) {
+        int version = finalVersion[key % writers][key];
+        long long v = 0;
+        bool found = map.find(key, v);
+        if (version < 0) ok &= !found;
+        else { ok &= found && v == encode(key, version); ++expectSize; }
+    }
+    ok &= map.size() == expectSize;
+
+    EpochReclaimer::instance().tryReclaim();
+    EpochReclaimer::instance().tryReclaim();
+    std::cout << "Writers: " << writers << ", Readers: " << readers
+              << ", Violations: " << violations.load()
+              << ", Size: " << map.size() << ", Slots: " << map.slotCount()
+              << ", Pending retire: " << EpochReclaimer::instance().pendingCount() << "\n";
+    std::cout << "Result: " << (ok ? "PASS" : "FAIL") << "\n\n";
+    return ok;
+}
+
+// SIEVE keeps a repeatedly-read key alive while cold keys stream through
+bool runSieveBasicTest(const std::string& testName, size_t capacity) {
+    std::cout << "=== " << testName << " ===\n";
+    SieveCache<int, std::string> cache(capacity);
+    bool ok = true;
+    std::string v;
+    cache.put(0, "hot");
+    for (int k = 1; k < 1000; ++k) {
+        cache.get(0, v);
+        cache.put(k, "cold_" + std::to_string(k));
+        ok &= cache.size() <= capacity;
+    }
+    ok &= cache.get(0, v) && v == "hot";
+    ok &= cache.get(999, v) && v == "cold_999";
+    ok &= !cache.get(1, v);
+    std::cout << "Size: " << cache.size() << " / " << capacity << "\n";
+    std::cout << "Result: " << (ok ? "PASS" : "FAIL") << "\n\n";
+    return ok;
+}
+
+// Read-mostly Zipf workload: SieveCache (lock-free get) vs HashLruCaches
+void runSieveScalingBench(const std::string& testName, int capacity, int keyRange,
+                          int totalOps, int putRatio) {
+    std::cout << "=== " << testName << " ===\n";
+    CacheBench::ZipfGenerator zipf(keyRange, 0.99);
+
+    auto work = [&](auto& cache, int threads) {
+        int opsPerThread = totalOps / threads;
+        return CacheBench::runThroughput(threads, [&](int t) {
+            std::mt19937 gen(77 + t);
+            std::string result;
+            for (int i = 0; i < opsPerThread; ++i) {
+                int key = zipf(gen);
+                if (static_cast<int>(gen() % 100) < putRatio || !cache.get(key, result))
+                    cache.put(key, "val_" + std::to_string(key));
+            }
+            return opsPerThread;
+        });
+    };
+
+    std::cout << "Threads | HashLruCaches Mops/s | SieveCache Mops/s\n";
+    for (int threads : {1, 2, 4, 8, 16, 32, 64}) {
+        HashLruCaches<int, std::string> lru(capacity, 8);
+        SieveCache<int, std::string> sieve(capacity);
+        double lruOps = work(lru, threads);
+        double sieveOps = work(sieve, threads);
+        std::cout << std::setw(7) << threads << " | "
+                  << std::fixed << std::setprecision(2)
+                  << std::setw(20) << lruOps / 1e6 << " | "
+                  << std::setw(17) << sieveOps / 1e6 << "\n";
+    }
+    std::cout << "\n";
+}
+
+int main() {
+    bool ok = true;
+    ok &= runMapBasicTest("Map Test 1: insert/update/erase across rehashes", 10000);
+    ok &= runMapStressTest("Map Test 2: Linearizability stress (4 writers, 4 readers)", 4, 4, 4096, 100000);
+    ok &= runSieveBasicTest("Sieve Test 1: Hot key survives cold stream", 16);
+
+    runSieveScalingBench("Sieve Bench 1: Zipf 0.99, GET-mostly (PUT=5%)", 10000, 100000, 400000, 5);
+
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,211 @@
+// CuckooHashMap: semantics, occupancy, memory, concurrent stress, lookup scaling, use as an LRU index
+#include <iostream>
+#include <string>
+#include <random>
+#include <iomanip>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+#include "CuckooHashMap.h"
+#include "ConcurrentHashMap.h"
+#include "LruCache.h"
+#include "BenchUtil.h"
+
+using namespace Cache;
+
+template<typename Map, typename MakeValue>
+bool checkMapSemantics(Map& map, int keys, MakeValue makeValue) {
+    bool ok = true;
+    for (int k = 0; k < keys; ++k) ok &= map.insertOrAssign(k, makeValue(k));
+    for (int k = 0; k < keys; k += 2) ok &= !map.insertOrAssign(k, makeValue(k + 1));
+    for (int k = 0; k < keys; k += 3) ok &= map.erase(k);
+    for (int k = 0; k < keys; ++k) {
+        typename std::decay<decltype(makeValue(0))>::type v{};
+        bool found = map.find(k, v);
+        if (k % 3 == 0) ok &= !found;
+        else ok &= found && v == makeValue(k % 2 == 0 ? k + 1 : k);
+    }
+    ok &= static_cast<int>(map.size()) == keys - (keys + 2) / 3;
+    return ok;
+}
+
+bool runCuckooBasicTest(const std::string& testName, int keys) {
+    std::cout << "=== " << testName << " ===\n";
+    CuckooHashMap<int, int> optimistic(8);
+    CuckooHashMap<int, std::string> locked(8);
+    bool ok = checkMapSemantics(optimistic, keys, [](int k) { return k * 7; });
+    ok &= checkMapSemantics(locked, keys, [](int k) { return "v" + std::to_string(k); });
+    std::cout << "Keys: " << keys << ", Grows: " << optimistic.growCount()
+              << ", Load: " << std::fixed << std::setprecision(2) << optimistic.loadFactor() * 100 << "%\n";
+    std::cout << "Result: " << (ok ? "PASS" : "FAIL") << "\n\n";
+    return ok;
+}
+
+// Fill a fixed-size table until the first grow: that's the achievable load factor
+bool runCuckooOccupancyTest(const std::string& testName, size_t slots) {
+    std::cout << "=== " << testName << " ===\n";
+    CuckooHashMap<uint64_t, uint64_t> map(slots);
+    std::mt19937_64 gen(42);
+    size_t initialSlots = map.slotCount();
+    size_t maxLive = 0;
+    while (map.growCount() == 0) {
+        maxLive = map.size();
+        map.insertOrAssign(gen(), 1);
+    }
+    double load = static_cast<double>(maxLive) / initialSlots;
+
+    // Memory per entry at that occupancy vs. a node-based std::unordered_map
+    std::unordered_map<uint64_t, uint64_t> std_map;
+    std::mt19937_64 gen2(42);
+    for (size_t i = 0; i < maxLive; ++i) std_map.emplace(gen2(), 1);
+    size_t nodeBytes = ((sizeof(void*) + sizeof(std::pair<const uint64_t, uint64_t>) + 15) / 16) * 16 + 8;
+    double stdBytes = static_cast<double>(std_map.bucket_count() * sizeof(void*) + std_map.size() * nodeBytes);
+    double cuckooBytes = static_cast<double>(map.memoryBytes()) / 2;    // Table has doubled once
+
+    std::cout << "Slots: " << initialSlots << ", Max load before grow: "
+              << std::fixed << std::setprecision(2) << load * 100 << "%\n";
+    std::cout << "Bytes/entry  cuckoo: " << cuckooBytes / maxLive
+              << "  std::unordered_map (est.): " << stdBytes / maxLive << "\n";
+    bool ok = load > 0.90;
+    std::cout << "Result: " << (ok ? "PASS" : "FAIL") << "\n\n";
+    return ok;
+}
+
+// Writers own disjoint keys and publish increasing versions (with erases),
+// starting from a tiny table so displacement and growth happen under load.
+// Optimistic readers must never see a torn/misplaced value or a version go back.
+bool runCuckooStressTest(const std::string& testName, int writers, int readers, int keys, int opsPerWriter) {
+    std::cout << "=== " << testName << " ===\n";
+    CuckooHashMap<int, long long> map(8);
+    auto encode = [](int key, int version) { return static_cast<long long>(version) * 1000000 + key; };
+
+    std::atomic<int>  writersDone{0};
+    std::atomic<long> violations{0};
+    std::vector<std::vector<int>> finalVersion(writers, std::vector<int>(keys, -1));
+
+    std::vector<std::thread> threads;
+    for (int w = 0; w < writers; ++w) {
+        threads.emplace_back([&, w] {
+            std::mt19937 gen(w);
+            auto& last = finalVersion[w];
+            for (int i = 1; i <= opsPerWriter; ++i) {
+                int key = static_cast<int>(gen() % (keys / writers)) * writers + w;
+                if (gen() % 8 == 0) { map.erase(key); last[key] = -1; }
+                else { map.insertOrAssign(key, encode(key, i)); last[key] = i; }
+            }
+            writersDone.fetch_add(1);
+        });
+    }
+    for (int r = 0; r < readers; ++r) {
+        threads.emplace_back([&, r] {
+            std::mt19937 gen(100 + r);
+            std::vector<int> seen(keys, 0);
+            while (writersDone.load() < writers) {
+                int key = static_cast<int>(gen() % keys);
+                long long v = 0;
+                if (!map.find(key, v)) continue;
+                int version = static_cast<int>(v / 1000000);
+                if (static_cast<int>(v % 1000000) != key || version < seen[key]) violations.fetch_add(1);
+                seen[key] = version;
+            }
+        });
+    }
+    for (auto& t : threads) t.join();
+
+    bool ok = violations.load() == 0;
+    size_t expectSize = 0;
+    for (int key = 0; key < keys; ++key) {
+        int version = finalVersion[key % writers][key];
+        long long v = 0;
+        bool found = map.find(key, v);
+        if (version < 0) ok &= !found;
+        else { ok &= found && v == encode(key, version); ++expectSize; }
+    }
+    ok &= map.size() == expectSize;
+    std::cout << "Writers: " << writers << ", Readers: " << readers
+              << ", Violations: " << violations.load() << ", Grows: " << map.growCount()
+              << ", Load: " << std::fixed << std::setprecision(2) << map.loadFactor() * 100 << "%\n";
+    std::cout << "Result: " << (ok ? "PASS" : "FAIL") << "\n\n";
+    return ok;
+}
+
+// Hit rates of LruCache / HashLruCaches must not depend on the index
+void runCuckooIndexedLruTest(const std::string& testName, int capacity, int hotKeys, int coldKeys, int totalOps) {
+    std::cout << "=== " << testName << " ===\n";
+    LruCache<int, std::string> stdLru(capacity);
+    LruCache<int, std::string, CuckooIndex> cuckooLru(capacity);
+    LruCache<int, std::string, ConcurrentIndex> concurrentLru(capacity);
+    HashLruCaches<int, std::string, CuckooIndex> cuckooHash(capacity, 4);
+
+    std::mt19937 gen(7);
+    int getCount = 0, hitStd = 0, hitCuckoo = 0, hitConcurrent = 0, hitHash = 0;
+    for (int i = 0; i < totalOps; ++i) {
+        int key = (gen() % 100 < 70) ? gen() % hotKeys : hotKeys + gen() % coldKeys;
+        if (gen() % 100 < 30) {
+            std::string v = "val_" + std::to_string(key);
+            stdLru.put(key, v); cuckooLru.put(key, v); concurrentLru.put(key, v); cuckooHash.put(key, v);
+        } else {
+            std::string r;
+            ++getCount;
+            hitStd += stdLru.get(key, r);
+            hitCuckoo += cuckooLru.get(key, r);
+            hitConcurrent += concurrentLru.get(key, r);
+            hitHash += cuckooHash.get(key, r);
+        }
+    }
+    std::cout << std::fixed << std::setprecision(2)
+              << "LruCache<StdHashIndex> Hit Rate: " << 100.0 * hitStd / getCount << "%\n"
+              << "LruCache<CuckooIndex>  Hit Rate: " << 100.0 * hitCuckoo / getCount << "%\n"
+              << "LruCache<ConcurrentIndex> Hit Rate: " << 100.0 * hitConcurrent / getCount << "%\n"
+              << "HashLruCaches<CuckooIndex> (4 slices) Hit Rate: " << 100.0 * hitHash / getCount << "%\n\n";
+}
+
+// Read-only lookup scaling (Cuckoo table sized for ~90% load, rounded up to a power of two)
+void runLookupScalingBench(const std::string& testName, int keys, int totalOps) {
+    std::cout << "=== " << testName << " ===\n";
+    CuckooHashMap<int, int> cuckoo(static_cast<size_t>(keys / 0.9));
+    ConcurrentHashMap<int, int> concurrent(keys);
+    std::unordered_map<int, int> stdMap;
+    std::mutex stdMtx;
+    for (int k = 0; k < keys; ++k) {
+        cuckoo.insertOrAssign(k, k);
+        concurrent.insertOrAssign(k, k);
+        stdMap[k] = k;
+    }
+    std::cout << "Cuckoo load: " << std::fixed << std::setprecision(2) << cuckoo.loadFactor() * 100
+              << "%, " << cuckoo.memoryBytes() / 1024 << " KiB\n";
+
+    auto bench = [&](int threads, auto lookup) {
+        int opsPerThread = totalOps / threads;
+        return CacheBench::runThroughput(threads, [&](int t) {
+            std::mt19937 gen(t);
+            long long sink = 0;
+            for (int i = 0; i < opsPerThread; ++i) sink += lookup(static_cast<int>(gen() % keys));
+            return sink >= 0 ? opsPerThread : 0;
+        });
+    };
+
+    std::cout << "Threads | mutex+unordered_map | ConcurrentHashMap | CuckooHashMap  (Mops/s)\n";
+    for (int threads : {1, 2, 4, 8, 16, 32}) {
+        double a = bench(threads, [&](int k) { std::lock_guard<std::mutex> l(stdMtx); return stdMap.find(k)->second; });
+        double b = bench(threads, [&](int k) { int v = 0; concurrent.find(k, v); return v; });
+        double c = bench(threads, [&](int k) { int v = 0; cuckoo.find(k, v); return v; });
+        std::cout << std::setw(7) << threads << " | " << std::setw(19) << a / 1e6 << " | "
+                  << std::setw(17) << b / 1e6 << " | " << std::setw(13) << c / 1e6 << "\n";
+    }
+    std::cout << "\n";
+}
+
+int main() {
+    bool ok = true;
+    ok &= runCuckooBasicTest("Cuckoo Test 1: insert/update/erase (optimistic + locked reads)", 20000);
+    ok &= runCuckooOccupancyTest("Cuckoo Test 2: Occupancy before first grow", 1 << 16);
+    ok &= runCuckooStressTest("Cuckoo Test 3: Concurrent stress with displacement + growth", 4, 4, 4096, 100000);
+    runCuckooIndexedLruTest("Cuckoo Test 4: LruCache / HashLruCaches over alternative indices", 20, 20, 2000, 100000);
+
+    runLookupScalingBench("Cuckoo Bench 1: Lookup throughput", 100000, 2000000);
+
+    return ok ? 0 : 1;
+}
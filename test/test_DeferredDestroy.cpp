@@ -0,0 +1,183 @@
+// Deferred destruction (Graveyard.h): evicted / overwritten values must be
+// destroyed after the cache lock is released; lock hold time with 64 KB values
+#include <iostream>
+#include <string>
+#include <random>
+#include <iomanip>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "LruCache.h"
+#include "LfuCache.h"
+#include "Arc_new.h"
+#include "BenchUtil.h"
+
+using namespace Cache;
+
+// ---- ProbeLock: std::mutex that knows whether this thread holds it ----
+thread_local int tlsLocksHeld = 0;
+
+struct ProbeLock {
+    void lock()     { m.lock(); ++tlsLocksHeld; }
+    bool try_lock() { if (!m.try_lock()) return false; ++tlsLocksHeld; return true; }
+    void unlock()   { --tlsLocksHeld; m.unlock(); }
+    std::mutex m;
+};
+
+// A value that reports being destroyed under a cache lock. Moved-from and
+// default-constructed probes own nothing and may die anywhere.
+std::atomic<int> destroyedUnderLock{0};
+std::atomic<int> destroyedTotal{0};
+
+struct Probe {
+    Probe() = default;
+    explicit Probe(int v) : value(v), live(true) {}
+    Probe(const Probe& o) : value(o.value), live(o.live) {}
+    Probe(Probe&& o) noexcept : value(o.value), live(o.live) { o.live = false; }
+    Probe& operator=(const Probe& o) { release(); value = o.value; live = o.live; return *this; }
+    Probe& operator=(Probe&& o) noexcept { release(); value = o.value; live = o.live; o.live = false; return *this; }
+    ~Probe() { release(); }
+
+    void release() {
+        if (!live) return;
+        destroyedTotal.fetch_add(1);
+        if (tlsLocksHeld > 0) destroyedUnderLock.fetch_add(1);
+        live = false;
+    }
+
+    int  value{0};
+    bool live{false};
+};
+
+template<typename CacheT>
+void churn(CacheT& cache, int threads, int opsPerThread, int keySpace) {
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; ++t) {
+        workers.emplace_back([&, t] {
+            std::mt19937 gen(t + 1);
+            for (int i = 0; i < opsPerThread; ++i) {
+                int key = gen() % keySpace;
+                Probe out;                                       // Empty: get's assignment frees nothing
+                if (gen() % 3) cache.put(key, Probe(i));        // Inserts evict, repeats overwrite
+                else cache.get(key, out);                        // ARC ghost hits evict too
+            }
+        });
+    }
+    for (auto& w : workers) w.join();
+}
+
+bool runUnderLockTest(const std::string& testName, int threads, int opsPerThread) {
+    std::cout << "=== " << testName << " ===\n";
+    bool ok = true;
+    auto check = [&](const char* name, auto& cache) {
+        destroyedUnderLock.store(0);
+        destroyedTotal.store(0);
+        churn(cache, threads, opsPerThread, 400);
+        int total = destroyedTotal.load(), bad = destroyedUnderLock.load();
+        std::cout << std::left << std::setw(22) << name << std::right << " values destroyed: " << std::setw(7) << total
+                  << ", under the lock: " << bad << "\n";
+        ok &= total > 0 && bad == 0;
+    };
+
+    {
+        LruCache<int, Probe, StdHashIndex, ProbeLock> lru(100);
+        check("LruCache", lru);
+        LruCache<int, Probe, StdHashIndex, ProbeLock> lruFc(100, /*flatCombining*/true);
+        check("LruCache (combining)", lruFc);
+        LfuCache<int, Probe, ProbeLock> lfu(100);
+        check("LfuCache", lfu);
+        Arc_new<int, Probe, ProbeLock> arc(100);
+        check("Arc_new", arc);
+        Arc_new<int, Probe, ProbeLock> arcFc(100, /*flatCombining*/true);
+        check("Arc_new (combining)", arcFc);
+
+        destroyedUnderLock.store(0);
+        for (int k = 0; k < 400; ++k) lru.remove(k);
+        lfu.purge();
+        arc.clear();
+        lfu.reclaimNow();                                // The torn-down generations die off the lock too
+        arc.reclaimNow();
+        std::cout << "remove / purge / clear: under the lock: " << destroyedUnderLock.load() << "\n";
+        ok &= destroyedUnderLock.load() == 0;
+    }
+    std::cout << "Result: " << (ok ? "PASS" : "FAIL") << "\n\n";
+    return ok;
+}
+
+// ---- HoldTimer: std::mutex that records how long each hold lasted ----
+// Samples go to one global list: only one timed cache is in use at a time,
+// and each sample is appended while its lock is still held.
+std::vector<double> holdSamples;
+
+struct HoldTimer {
+    void lock() { m.lock(); since = std::chrono::steady_clock::now(); }
+    bool try_lock() {
+        if (!m.try_lock()) return false;
+        since = std::chrono::steady_clock::now();
+        return true;
+    }
+    void unlock() {
+        holdSamples.push_back(std::chrono::duration<double, std::nano>(
+                                  std::chrono::steady_clock::now() - since).count());
+        m.unlock();
+    }
+
+    std::mutex m;
+    std::chrono::steady_clock::time_point since;
+};
+
+double holdPercentile(double p) {
+    std::sort(holdSamples.begin(), holdSamples.end());
+    return holdSamples.empty() ? 0.0 : holdSamples[static_cast<size_t>(p / 100.0 * (holdSamples.size() - 1))];
+}
+
+// Put-only churn with 64 KB values over twice the capacity in keys (overwrites
+// and evicting inserts): lock hold percentiles and put throughput
+void runHoldTimeBench(const std::string& testName, int capacity, int totalOps) {
+    std::cout << "=== " << testName << " ===\n";
+    using Blob = std::vector<char>;
+    const Blob proto(64 * 1024, 'x');
+
+    auto bench = [&](const char* name, auto& cache, int threads) {
+        holdSamples.clear();
+        holdSamples.reserve(totalOps);
+        int opsPerThread = totalOps / threads;
+        double ops = CacheBench::runThroughput(threads, [&](int t) {
+            std::mt19937 gen(t + 1);
+            for (int i = 0; i < opsPerThread; ++i) cache.put(gen() % (capacity * 2), proto);
+            return opsPerThread;
+        });
+        std::cout << std::left << std::setw(9) << name << std::right << std::setw(7) << threads << " | "
+                  << std::setw(11) << holdPercentile(50) << " | " << std::setw(11) << holdPercentile(99) << " | "
+                  << std::setw(7) << ops / 1e3 << "\n";
+    };
+
+    std::cout << std::fixed << std::setprecision(0)
+              << "Cache    Threads | hold p50 ns | hold p99 ns | Kputs/s\n";
+    for (int threads : {1, 4}) {
+        {
+            LruCache<int, Blob, StdHashIndex, HoldTimer> lru(capacity);
+            bench("LruCache", lru, threads);
+        }
+        {
+            LfuCache<int, Blob, HoldTimer> lfu(capacity);
+            bench("LfuCache", lfu, threads);
+        }
+        {
+            Arc_new<int, Blob, HoldTimer> arc(capacity);
+            bench("Arc_new", arc, threads);
+        }
+    }
+    std::cout << "\n";
+}
+
+int main() {
+    bool ok = true;
+    ok &= runUnderLockTest("Deferred Test 1: No value destroyed under the lock", 4, 20000);
+
+    runHoldTimeBench("Deferred Bench 1: Lock hold time, 64 KB values", 1000, 40000);
+
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,177 @@
+// DelegatedCache (owner thread + MPSC ring): semantics, ordering, throughput/latency vs mutex-based caches
+#include <iostream>
+#include <string>
+#include <random>
+#include <iomanip>
+#include <thread>
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+#include "DelegatedCache.h"
+#include "LruCache.h"
+#include "Arc_new.h"
+#include "BenchUtil.h"
+
+using namespace Cache;
+
+// put / get / callbacks / futures on one client
+bool runDelegatedBasicTest(const std::string& testName) {
+    std::cout << "=== " << testName << " ===\n";
+    DelegatedCache<int, std::string> cache(std::make_unique<LruCache<int, std::string>>(2), 8, 4);
+
+    bool ok = true;
+    std::string v;
+    cache.put(1, "a");
+    ok &= cache.get(1, v) && v == "a";              // Same client: put is applied first
+    cache.put(2, "b");
+    cache.put(3, "c");                              // Evicts 1 (capacity 2)
+    ok &= !cache.get(1, v);
+    ok &= cache.get(3) == "c";
+
+    std::atomic<int> callbacks{0};
+    for (int i = 0; i < 100; ++i)                   // More than the ring holds → backpressure
+        cache.getAsync(2, [&](bool found, const std::string& s) { if (found && s == "b") callbacks++; });
+    auto fut = cache.getFuture(3);
+    ok &= fut.get() == std::optional<std::string>("c");
+    ok &= callbacks.load() == 100;                  // Earlier requests completed before the future
+
+    cache.putFuture(4, "d").get();
+    ok &= cache.getFuture(4).get().value_or("") == "d";
+    ok &= !cache.getFuture(1).get().has_value();
+
+    std::cout << "Batches: " << cache.batches() << ", Requests: " << cache.processed() << "\n";
+    std::cout << "Result: " << (ok ? "PASS" : "FAIL") << "\n\n";
+    return ok;
+}
+
+// Every client writes and immediately reads back its own keys:
+// per-client FIFO order means it must always see its latest write
+bool runDelegatedOrderingTest(const std::string& testName, int clients, int opsPerClient) {
+    std::cout << "=== " << testName << " ===\n";
+    DelegatedCache<int, int> cache(std::make_unique<Arc_new<int, int>>(clients * 16), 64, 16);
+
+    std::atomic<long> violations{0};
+    std::vector<std::thread> threads;
+    for (int c = 0; c < clients; ++c) {
+        threads.emplace_back([&, c] {
+            std::mt19937 gen(c);
+            for (int i = 1; i <= opsPerClient; ++i) {
+                int key = c * 16 + static_cast<int>(gen() % 16);
+                cache.put(key, i);
+                int v = 0;
+                if (!cache.get(key, v) || v != i) violations.fetch_add(1);
+            }
+        });
+    }
+    for (auto& t : threads) t.join();
+
+    bool ok = violations.load() == 0;
+    std::cout << "Clients: " << clients << ", Violations: " << violations.load()
+              << ", Avg batch: " << std::fixed << std::setprecision(2)
+              << static_cast<double>(cache.processed()) / cache.batches() << "\n";
+    std::cout << "Result: " << (ok ? "PASS" : "FAIL") << "\n\n";
+    return ok;
+}
+
+// Policy that fails on negative keys, to raise errors on the owner thread
+struct FailingPolicy : CachePolicy<int, std::string> {
+    LruCache<int, std::string> inner{16};
+    void put(const int& key, const std::string& value) override {
+        if (key < 0) throw std::runtime_error("put failed");
+        inner.put(key, value);
+    }
+    bool get(const int& key, std::string& value) override {
+        if (key < 0) throw std::runtime_error("get failed");
+        return inner.get(key, value);
+    }
+    std::string get(const int& key) override {
+        std::string v;
+        get(key, v);
+        return v;
+    }
+};
+
+// Errors thrown on the owner thread reach the client that asked; the
+// owner keeps serving afterwards
+bool runDelegatedErrorTest(const std::string& testName) {
+    std::cout << "=== " << testName << " ===\n";
+    DelegatedCache<int, std::string> cache(std::make_unique<FailingPolicy>(), 8, 4);
+
+    auto throwsRuntime = [](auto&& fn) {
+        try { fn(); } catch (const std::runtime_error&) { return true; }
+        return false;
+    };
+    std::string v;
+    bool syncGet   = throwsRuntime([&] { cache.get(-1, v); });
+    bool getFuture = throwsRuntime([&] { cache.getFuture(-1).get(); });
+    bool putFuture = throwsRuntime([&] { cache.putFuture(-1, "x").get(); });
+
+    cache.put(-2, "lost");                                             // Nobody to tell
+    cache.getAsync(1, [](bool, const std::string&) { throw std::runtime_error("callback failed"); });
+    cache.put(1, "a");
+    bool alive = cache.get(1, v) && v == "a";
+
+    std::cout << "get() " << (syncGet ? "rethrows" : "swallows") << ", futures "
+              << (getFuture && putFuture ? "hold the error" : "broken") << ", unreceived errors "
+              << cache.errors() << ", owner " << (alive ? "alive" : "dead") << "\n";
+    bool ok = syncGet && getFuture && putFuture && cache.errors() == 2 && alive;
+    std::cout << "Result: " << (ok ? "PASS" : "FAIL") << "\n\n";
+    return ok;
+}
+
+// 80% GET / 20% PUT over Zipf 0.99 keys; sync gets, fire-and-forget puts
+void runDelegatedBench(const std::string& testName, int capacity, int keySpace, int totalOps) {
+    std::cout << "=== " << testName << " ===\n";
+    CacheBench::ZipfGenerator zipf(keySpace, 0.99);
+
+    auto bench = [&](CachePolicy<int, int>& cache, int threads, CacheBench::Latency& latency) {
+        int opsPerThread = totalOps / threads;
+        std::vector<CacheBench::Latency> perThread(threads);
+        double opsPerSec = CacheBench::runThroughput(threads, [&](int t) {
+            std::mt19937 gen(t + 1);
+            int v = 0;
+            for (int i = 0; i < opsPerThread; ++i) {
+                int key = zipf(gen);
+                bool isPut = gen() % 5 == 0;
+                auto op = [&] { if (isPut) cache.put(key, i); else cache.get(key, v); };
+                if (i % 16 == 0) perThread[t].time(op);
+                else op();
+            }
+            return opsPerThread;
+        });
+        for (auto& l : perThread) latency.merge(l);
+        return opsPerSec;
+    };
+
+    std::cout << "Threads | Cache                     |  Mops/s | p50 ns | p99 ns\n";
+    for (int threads : {1, 4, 16}) {
+        auto row = [&](const char* name, CachePolicy<int, int>& cache) {
+            CacheBench::Latency latency;
+            double ops = bench(cache, threads, latency);
+            std::cout << std::setw(7) << threads << " | " << std::left << std::setw(25) << name << std::right
+                      << " | " << std::fixed << std::setprecision(2) << std::setw(7) << ops / 1e6
+                      << " | " << std::setw(6) << std::setprecision(0) << latency.percentile(50)
+                      << " | " << std::setw(6) << latency.percentile(99) << "\n";
+        };
+        LruCache<int, int> lru(capacity);
+        Arc_new<int, int>  arc(capacity);
+        DelegatedCache<int, int> delegatedLru(std::make_unique<LruCache<int, int>>(capacity));
+        DelegatedCache<int, int> delegatedArc(std::make_unique<Arc_new<int, int>>(capacity));
+        row("LruCache (mutex)", lru);
+        row("Delegated<LruCache>", delegatedLru);
+        row("Arc_new (mutex)", arc);
+        row("Delegated<Arc_new>", delegatedArc);
+    }
+    std::cout << "\n";
+}
+
+int main() {
+    bool ok = true;
+    ok &= runDelegatedBasicTest("Delegated Test 1: put/get, callbacks, futures, backpressure");
+    ok &= runDelegatedOrderingTest("Delegated Test 2: Per-client ordering under concurrency", 8, 20000);
+    ok &= runDelegatedErrorTest("Delegated Test 3: Owner-thread errors reach the caller");
+
+    runDelegatedBench("Delegated Bench 1: Throughput + latency vs mutex-based caches", 1000, 10000, 400000);
+
+    return ok ? 0 : 1;
+}
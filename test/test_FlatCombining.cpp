@@ -0,0 +1,187 @@
+// Flat-combining write path for LruCache / Arc_new: correctness + put throughput vs plain locking
+#include <iostream>
+#include <string>
+#include <random>
+#include <iomanip>
+#include <atomic>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include "LruCache.h"
+#include "Arc_new.h"
+#include "BenchUtil.h"
+
+using namespace Cache;
+
+// Writers own disjoint keys and overwrite them with increasing versions;
+// after the join every key must hold its writer's last version
+template<typename CacheT>
+bool checkConcurrentPuts(CacheT& cache, int writers, int keysPerWriter, int rounds) {
+    std::vector<std::thread> threads;
+    for (int w = 0; w < writers; ++w) {
+        threads.emplace_back([&, w] {
+            for (int r = 0; r < rounds; ++r)
+                for (int i = 0; i < keysPerWriter; ++i)
+                    cache.put(w * keysPerWriter + i, r);
+        });
+    }
+    for (auto& t : threads) t.join();
+
+    bool ok = true;
+    for (int key = 0; key < writers * keysPerWriter; ++key) {
+        int v = -1;
+        ok &= cache.get(key, v) && v == rounds - 1;
+    }
+    return ok;
+}
+
+bool runCombiningCorrectnessTest(const std::string& testName, int writers, int keysPerWriter, int rounds) {
+    std::cout << "=== " << testName << " ===\n";
+    int capacity = writers * keysPerWriter;
+    LruCache<int, int> lru(capacity, /*flatCombining*/true);
+    Arc_new<int, int>  arc(capacity, /*flatCombining*/true);
+    bool lruOk = checkConcurrentPuts(lru, writers, keysPerWriter, rounds);
+    bool arcOk = checkConcurrentPuts(arc, writers, keysPerWriter, rounds);
+    std::cout << "LruCache: " << (lruOk ? "ok" : "lost update") << ", batched passes: " << lru.combinedPasses() << "\n";
+    std::cout << "Arc_new:  " << (arcOk ? "ok" : "lost update") << ", batched passes: " << arc.combinedPasses() << "\n";
+    bool ok = lruOk && arcOk && arc.size() == static_cast<size_t>(capacity);
+    std::cout << "Result: " << (ok ? "PASS" : "FAIL") << "\n\n";
+    return ok;
+}
+
+// Value whose move throws when poisoned: the copy into the request
+// succeeds, the move into the cache (under the lock) does not
+struct Fragile {
+    int  v{0};
+    bool poison{false};
+    Fragile() = default;
+    Fragile(int value, bool p) : v(value), poison(p) {}
+    Fragile(const Fragile&) = default;
+    Fragile& operator=(const Fragile&) = default;
+    Fragile(Fragile&& o) : v(o.v), poison(o.poison) { if (poison) throw std::runtime_error("move failed"); }
+    Fragile& operator=(Fragile&& o) {
+        if (o.poison) throw std::runtime_error("move failed");
+        v = o.v;
+        return *this;
+    }
+};
+
+// A put that throws under the combiner reaches its own caller; the
+// mutex is released and every other writer still completes
+template<typename CacheT>
+bool checkThrowingPuts(CacheT& cache, int writers, int keysPerWriter) {
+    std::atomic<int> thrown{0};
+    std::vector<std::thread> threads;
+    for (int w = 0; w < writers; ++w) {
+        threads.emplace_back([&, w] {
+            for (int i = 0; i < keysPerWriter; ++i) {
+                try {
+                    cache.put(w * keysPerWriter + i, Fragile(i, i % 7 == 0));
+                } catch (const std::runtime_error&) {
+                    thrown.fetch_add(1);
+                }
+            }
+        });
+    }
+    for (auto& t : threads) t.join();
+
+    int expectedThrows = writers * ((keysPerWriter + 6) / 7);
+    bool ok = thrown.load() == expectedThrows;
+    for (int key = 0; key < writers * keysPerWriter; ++key) {
+        Fragile v;
+        int i = key % keysPerWriter;
+        ok &= cache.get(key, v) == (i % 7 != 0) && (i % 7 == 0 || v.v == i);
+    }
+    return ok;
+}
+
+bool runCombiningExceptionTest(const std::string& testName, int writers, int keysPerWriter) {
+    std::cout << "=== " << testName << " ===\n";
+    int capacity = writers * keysPerWriter;
+    LruCache<int, Fragile> lru(capacity, /*flatCombining*/true);
+    Arc_new<int, Fragile>  arc(capacity, /*flatCombining*/true);
+    bool lruOk = checkThrowingPuts(lru, writers, keysPerWriter);
+    bool arcOk = checkThrowingPuts(arc, writers, keysPerWriter);
+    std::cout << "LruCache: " << (lruOk ? "ok" : "wrong") << ", Arc_new: " << (arcOk ? "ok" : "wrong") << "\n";
+    bool ok = lruOk && arcOk;
+    std::cout << "Result: " << (ok ? "PASS" : "FAIL") << "\n\n";
+    return ok;
+}
+
+// Single thread: combining mode must not change the policy's decisions
+bool runCombiningHitRateTest(const std::string& testName, int capacity, int hotKeys, int coldKeys, int totalOps) {
+    std::cout << "=== " << testName << " ===\n";
+    LruCache<int, std::string> lruPlain(capacity), lruComb(capacity, true);
+    Arc_new<int, std::string>  arcPlain(capacity), arcComb(capacity, true);
+
+    std::mt19937 gen(42);
+    int getCount = 0, hits[4] = {0, 0, 0, 0};
+    for (int i = 0; i < totalOps; ++i) {
+        int key = (gen() % 100 < 70) ? gen() % hotKeys : hotKeys + gen() % coldKeys;
+        if (gen() % 100 < 30) {
+            std::string v = "val_" + std::to_string(key);
+            lruPlain.put(key, v); lruComb.put(key, v); arcPlain.put(key, v); arcComb.put(key, v);
+        } else {
+            std::string r;
+            ++getCount;
+            hits[0] += lruPlain.get(key, r);
+            hits[1] += lruComb.get(key, r);
+            hits[2] += arcPlain.get(key, r);
+            hits[3] += arcComb.get(key, r);
+        }
+    }
+    std::cout << std::fixed << std::setprecision(2)
+              << "LruCache plain / combining Hit Rate: " << 100.0 * hits[0] / getCount << "% / "
+              << 100.0 * hits[1] / getCount << "%\n"
+              << "Arc_new  plain / combining Hit Rate: " << 100.0 * hits[2] / getCount << "% / "
+              << 100.0 * hits[3] / getCount << "%\n";
+    bool ok = hits[0] == hits[1] && hits[2] == hits[3];
+    std::cout << "Result: " << (ok ? "PASS" : "FAIL") << "\n\n";
+    return ok;
+}
+
+// Write-heavy burst (90% PUT, Zipf 0.99 keys) at increasing thread counts
+void runPutThroughputBench(const std::string& testName, int capacity, int keySpace, int totalOps) {
+    std::cout << "=== " << testName << " ===\n";
+    CacheBench::ZipfGenerator zipf(keySpace, 0.99);
+
+    auto bench = [&](auto& cache, int threads) {
+        int opsPerThread = totalOps / threads;
+        return CacheBench::runThroughput(threads, [&](int t) {
+            std::mt19937 gen(t + 1);
+            int v = 0;
+            for (int i = 0; i < opsPerThread; ++i) {
+                int key = zipf(gen);
+                if (gen() % 10 != 0) cache.put(key, i);
+                else cache.get(key, v);
+            }
+            return opsPerThread;
+        });
+    };
+
+    std::cout << "Threads | LruCache plain | LruCache FC | Arc_new plain | Arc_new FC  (Mops/s)\n";
+    for (int threads : {1, 4, 16, 64}) {
+        LruCache<int, int> lruPlain(capacity), lruComb(capacity, true);
+        Arc_new<int, int>  arcPlain(capacity), arcComb(capacity, true);
+        double a = bench(lruPlain, threads);
+        double b = bench(lruComb, threads);
+        double c = bench(arcPlain, threads);
+        double d = bench(arcComb, threads);
+        std::cout << std::fixed << std::setprecision(2)
+                  << std::setw(7) << threads << " | " << std::setw(14) << a / 1e6 << " | "
+                  << std::setw(11) << b / 1e6 << " | " << std::setw(13) << c / 1e6 << " | "
+                  << std::setw(10) << d / 1e6 << "\n";
+    }
+    std::cout << "\n";
+}
+
+int main() {
+    bool ok = true;
+    ok &= runCombiningCorrectnessTest("FC Test 1: Concurrent puts, no lost updates", 8, 500, 20);
+    ok &= runCombiningHitRateTest("FC Test 2: Same decisions as plain locking", 20, 20, 2000, 100000);
+    ok &= runCombiningExceptionTest("FC Test 3: A throwing put reaches its caller, others complete", 8, 2000);
+
+    runPutThroughputBench("FC Bench 1: Write-heavy put throughput", 1000, 10000, 1000000);
+
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,182 @@
+// Compile-time lock policies: identical decisions, Spin/AdaptiveLock under contention,
+// single-thread ops/sec per policy × lock, sharded throughput per lock at 1–32 threads
+#include <iostream>
+#include <string>
+#include <random>
+#include <iomanip>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <shared_mutex>
+#include <vector>
+#include "LruCache.h"
+#include "LfuCache.h"
+#include "ArcCache.h"
+#include "Arc_new.h"
+#include "BenchUtil.h"
+
+using namespace Cache;
+
+template<typename Lock> using LruWith  = LruCache<int, int, StdHashIndex, Lock>;
+template<typename Lock> using HashWith = HashLruCaches<int, int, StdHashIndex, Lock>;
+template<typename Lock> using LfuWith  = LfuCache<int, int, Lock>;
+template<typename Lock> using ArcWith  = ArcCache<int, int, Lock>;
+template<typename Lock> using ArcNWith = Arc_new<int, int, Lock>;
+
+// Hot/cold mix; returns hits so different lock policies can be compared
+template<typename CacheT>
+int runMix(CacheT& cache, int hotKeys, int coldKeys, int totalOps) {
+    std::mt19937 gen(42);
+    int hits = 0, v = 0;
+    for (int i = 0; i < totalOps; ++i) {
+        int key = (gen() % 100 < 70) ? gen() % hotKeys : hotKeys + gen() % coldKeys;
+        if (gen() % 100 < 30) cache.put(key, i);
+        else hits += cache.get(key, v);
+    }
+    return hits;
+}
+
+template<template<typename> class CacheT>
+bool sameDecisions(const char* name, int capacity) {
+    CacheT<std::mutex>        a(capacity);
+    CacheT<NullLock>          b(capacity);
+    CacheT<SpinLock>          c(capacity);
+    CacheT<std::shared_mutex> d(capacity);
+    CacheT<AdaptiveLock>      e(capacity);
+    int ha = runMix(a, 20, 2000, 50000), hb = runMix(b, 20, 2000, 50000);
+    int hc = runMix(c, 20, 2000, 50000), hd = runMix(d, 20, 2000, 50000);
+    int he = runMix(e, 20, 2000, 50000);
+    bool ok = ha == hb && hb == hc && hc == hd && hd == he;
+    std::cout << std::left << std::setw(14) << name << std::right << " hits: " << ha << " / " << hb << " / "
+              << hc << " / " << hd << " / " << he << (ok ? "" : "  MISMATCH") << "\n";
+    return ok;
+}
+
+bool runLockDecisionTest(const std::string& testName) {
+    std::cout << "=== " << testName << " ===\n";
+    std::cout << "(mutex / NullLock / SpinLock / shared_mutex / AdaptiveLock)\n";
+    bool ok = true;
+    ok &= sameDecisions<LruWith>("LruCache", 20);
+    ok &= sameDecisions<LfuWith>("LfuCache", 20);
+    ok &= sameDecisions<ArcWith>("ArcCache", 20);
+    ok &= sameDecisions<ArcNWith>("Arc_new", 20);
+    std::cout << "Result: " << (ok ? "PASS" : "FAIL") << "\n\n";
+    return ok;
+}
+
+// Spinning locks must still serialize: concurrent writers on disjoint keys, no lost puts
+template<typename Lock>
+bool checkNoLostPuts(int threads, int keysPerThread) {
+    HashWith<Lock> cache(threads * keysPerThread, 2);
+    ArcNWith<Lock> arc(threads * keysPerThread);
+    std::vector<std::thread> ts;
+    for (int t = 0; t < threads; ++t) {
+        ts.emplace_back([&, t] {
+            for (int round = 0; round < 10; ++round)
+                for (int i = 0; i < keysPerThread; ++i) {
+                    cache.put(t * keysPerThread + i, round);
+                    arc.put(t * keysPerThread + i, round);
+                }
+        });
+    }
+    for (auto& th : ts) th.join();
+    bool ok = arc.size() == static_cast<size_t>(threads * keysPerThread);
+    for (int k = 0; k < threads * keysPerThread; ++k) {
+        int v = -1, w = -1;
+        ok &= cache.get(k, v) && v == 9 && arc.get(k, w) && w == 9;
+    }
+    return ok;
+}
+
+bool runSpinningLockContentionTest(const std::string& testName, int threads, int keysPerThread) {
+    std::cout << "=== " << testName << " ===\n";
+    bool spinOk     = checkNoLostPuts<SpinLock>(threads, keysPerThread);
+    bool adaptiveOk = checkNoLostPuts<AdaptiveLock>(threads, keysPerThread);
+    std::cout << "Threads: " << threads << ", Keys: " << threads * keysPerThread
+              << ", SpinLock: " << (spinOk ? "ok" : "lost put")
+              << ", AdaptiveLock: " << (adaptiveOk ? "ok" : "lost put") << "\n";
+    bool ok = spinOk && adaptiveOk;
+    std::cout << "Result: " << (ok ? "PASS" : "FAIL") << "\n\n";
+    return ok;
+}
+
+template<template<typename> class CacheT>
+void benchPolicy(const char* name, int capacity, int keySpace, int ops) {
+    CacheBench::ZipfGenerator zipf(keySpace, 0.99);
+    auto run = [&](auto& cache) {
+        return CacheBench::runThroughput(1, [&](int) {
+            std::mt19937 gen(7);
+            int v = 0;
+            for (int i = 0; i < ops; ++i) {
+                int key = zipf(gen);
+                if (gen() % 5 == 0) cache.put(key, i);
+                else cache.get(key, v);
+            }
+            return ops;
+        });
+    };
+    CacheT<NullLock>          a(capacity);
+    CacheT<std::mutex>        b(capacity);
+    CacheT<SpinLock>          c(capacity);
+    CacheT<std::shared_mutex> d(capacity);
+    double na = run(a), nb = run(b), nc = run(c), nd = run(d);
+    std::cout << std::left << std::setw(10) << name << std::right << std::fixed << std::setprecision(2)
+              << " | " << std::setw(8) << na / 1e6 << " | " << std::setw(10) << nb / 1e6
+              << " | " << std::setw(8) << nc / 1e6 << " | " << std::setw(12) << nd / 1e6
+              << " | x" << na / nb << "\n";
+}
+
+// Single thread, 80% GET / 20% PUT, Zipf 0.99: what does locking cost when nothing is shared?
+void runSingleThreadLockBench(const std::string& testName, int capacity, int keySpace, int ops) {
+    std::cout << "=== " << testName << " ===\n";
+    std::cout << "Policy     | NullLock | std::mutex | SpinLock | shared_mutex | NullLock vs mutex  (Mops/s)\n";
+    benchPolicy<LruWith>("LruCache", capacity, keySpace, ops);
+    benchPolicy<LfuWith>("LfuCache", capacity, keySpace, ops);
+    benchPolicy<ArcWith>("ArcCache", capacity, keySpace, ops);
+    benchPolicy<ArcNWith>("Arc_new", capacity, keySpace, ops);
+    std::cout << "\n";
+}
+
+// HashLruCaches (padded slices) under one lock type, 80% GET / 20% PUT, Zipf 0.99
+template<typename Lock>
+double shardedThroughput(int threads, int slices, int capacity, int keySpace, int totalOps) {
+    CacheBench::ZipfGenerator zipf(keySpace, 0.99);
+    HashWith<Lock> cache(capacity, slices);
+    int opsPerThread = totalOps / threads;
+    return CacheBench::runThroughput(threads, [&](int t) {
+        std::mt19937 gen(t + 1);
+        int v = 0;
+        for (int i = 0; i < opsPerThread; ++i) {
+            int key = zipf(gen);
+            if (gen() % 5 == 0) cache.put(key, i);
+            else cache.get(key, v);
+        }
+        return opsPerThread;
+    });
+}
+
+void runShardLockScalingBench(const std::string& testName, int slices, int capacity, int keySpace, int totalOps) {
+    std::cout << "=== " << testName << " ===\n";
+    std::cout << "Threads | std::mutex | SpinLock | AdaptiveLock  (Mops/s)\n";
+    for (int threads : {1, 2, 4, 8, 16, 32}) {
+        double a = shardedThroughput<std::mutex>(threads, slices, capacity, keySpace, totalOps);
+        double b = shardedThroughput<SpinLock>(threads, slices, capacity, keySpace, totalOps);
+        double c = shardedThroughput<AdaptiveLock>(threads, slices, capacity, keySpace, totalOps);
+        std::cout << std::fixed << std::setprecision(2) << std::setw(7) << threads << " | "
+                  << std::setw(10) << a / 1e6 << " | " << std::setw(8) << b / 1e6 << " | "
+                  << std::setw(12) << c / 1e6 << "\n";
+    }
+    std::cout << "\n";
+}
+
+int main() {
+    bool ok = true;
+    ok &= runLockDecisionTest("Lock Test 1: Same hits under every lock policy");
+    ok &= runSpinningLockContentionTest("Lock Test 2: SpinLock / AdaptiveLock under contention", 8, 500);
+
+    runSingleThreadLockBench("Lock Bench 1: Single-thread ops/sec with and without locking", 1000, 10000, 1000000);
+    runShardLockScalingBench("Lock Bench 2: HashLruCaches, 1 slice (one hot lock)", 1, 1000, 10000, 1000000);
+    runShardLockScalingBench("Lock Bench 3: HashLruCaches, 8 padded slices", 8, 1000, 10000, 1000000);
+
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,237 @@
+// Background maintenance (MaintenanceExecutor): executor semantics, watermarks,
+// hit rates vs inline eviction, and put tail latency inline vs background
+#include <iostream>
+#include <string>
+#include <random>
+#include <iomanip>
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+#include "LruCache.h"
+#include "LfuCache.h"
+#include "Arc_new.h"
+#include "MaintenanceExecutor.h"
+#include "BenchUtil.h"
+
+using namespace Cache;
+
+// schedule() coalesces while a run is pending; remove() waits out a running task
+bool runExecutorTest(const std::string& testName) {
+    std::cout << "=== " << testName << " ===\n";
+    MaintenanceExecutor executor;
+    std::atomic<bool> release{false};
+    std::atomic<int>  calls{0};
+    auto id = executor.add([&] {
+        calls.fetch_add(1);
+        while (!release.load()) std::this_thread::yield();
+    });
+
+    executor.schedule(id);
+    while (calls.load() == 0) std::this_thread::yield();   // First run is now blocked inside the task
+    for (int i = 0; i < 100; ++i) executor.schedule(id);   // Coalesce into one pending run
+    release.store(true);
+    executor.drain();
+    int coalesced = calls.load();
+
+    std::atomic<bool> removed{false};
+    auto slow = executor.add([&] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        if (removed.load()) calls.store(-1000);               // remove() returned while we ran
+    });
+    executor.schedule(slow);
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    executor.remove(slow);
+    removed.store(true);
+    executor.schedule(slow);                                 // Unknown id: ignored
+    executor.drain();
+
+    std::cout << "Runs for 1 + 100 schedules during a run: " << coalesced
+              << ", remove() waited for the running task: " << (calls.load() >= 0 ? "yes" : "no") << "\n";
+    bool ok = coalesced == 2 && calls.load() >= 0;
+    std::cout << "Result: " << (ok ? "PASS" : "FAIL") << "\n\n";
+    return ok;
+}
+
+// After the executor settles, every policy is between the low watermark
+// and capacity (puts after the last run don't schedule another until
+// capacity is crossed) and the most recent `low` keys are the survivors
+bool runWatermarkTest(const std::string& testName, int capacity, int low, int high, int keys) {
+    std::cout << "=== " << testName << " ===\n";
+    auto executor = std::make_shared<MaintenanceExecutor>();
+    LruCache<int, int> lru(capacity);
+    LfuCache<int, int> lfu(capacity);
+    Arc_new<int, int>  arc(capacity);
+    lru.enableMaintenance(executor, low, high);
+    lfu.enableMaintenance(executor, low, high);
+    arc.enableMaintenance(executor, low, high);
+
+    for (int k = 0; k < keys; ++k) {
+        lru.put(k, k);
+        lfu.put(k, k);
+        arc.put(k, k);
+    }
+    executor->drain();
+
+    int lruSize = 0, lruRecent = 0, v = 0;
+    for (int k = 0; k < keys; ++k) lruSize += lru.get(k, v);
+    for (int k = keys - low; k < keys; ++k) lruRecent += lru.get(k, v);
+
+    std::cout << "LruCache size: " << lruSize << " (recent " << lruRecent << "/" << low << ")"
+              << ", LfuCache size: " << lfu.size() << ", Arc_new size: " << arc.size()
+              << ", executor runs: " << executor->runs() << "\n";
+    auto settled = [&](size_t n) { return n >= static_cast<size_t>(low) && n <= static_cast<size_t>(capacity); };
+    bool ok = settled(lruSize) && lruRecent == low && settled(lfu.size()) && settled(arc.size());
+    std::cout << "Result: " << (ok ? "PASS" : "FAIL") << "\n\n";
+    return ok;
+}
+
+// Zipf workload: background eviction keeps the hit rate of inline eviction
+bool runHitRateTest(const std::string& testName, int capacity, int keySpace, int totalOps) {
+    std::cout << "=== " << testName << " ===\n";
+    auto executor = std::make_shared<MaintenanceExecutor>();
+    LruCache<int, int> lruInline(capacity), lruBg(capacity);
+    LfuCache<int, int> lfuInline(capacity, 20), lfuBg(capacity, 20);   // Low maxAvg: aging runs often
+    Arc_new<int, int>  arcInline(capacity), arcBg(capacity);
+    size_t low = capacity * 9 / 10, high = capacity * 11 / 10;
+    lruBg.enableMaintenance(executor, low, high);
+    lfuBg.enableMaintenance(executor, low, high);
+    arcBg.enableMaintenance(executor, low, high);
+
+    CacheBench::ZipfGenerator zipf(keySpace, 0.9);
+    std::mt19937 gen(7);
+    int hits[6] = {0, 0, 0, 0, 0, 0}, v = 0;
+    auto access = [&](auto& cache, int slot, int key) {
+        if (cache.get(key, v)) ++hits[slot];
+        else cache.put(key, key);
+    };
+    for (int i = 0; i < totalOps; ++i) {
+        int key = zipf(gen);
+        access(lruInline, 0, key); access(lruBg, 1, key);
+        access(lfuInline, 2, key); access(lfuBg, 3, key);
+        access(arcInline, 4, key); access(arcBg, 5, key);
+    }
+    executor->drain();
+
+    const char* names[] = {"LruCache", "LfuCache", "Arc_new "};
+    bool ok = true;
+    std::cout << std::fixed << std::setprecision(2);
+    for (int p = 0; p < 3; ++p) {
+        double a = 100.0 * hits[2 * p] / totalOps, b = 100.0 * hits[2 * p + 1] / totalOps;
+        std::cout << names[p] << " inline / background Hit Rate: " << a << "% / " << b << "%\n";
+        ok &= b > a - 3.0;                                   // Low watermark costs a little capacity
+    }
+    std::cout << "Result: " << (ok ? "PASS" : "FAIL") << "\n\n";
+    return ok;
+}
+
+// Concurrent readers/writers while the executor evicts; caches are destroyed
+// while it may still be scheduled (the destructor must unregister cleanly)
+bool runConcurrentTest(const std::string& testName, int threads, int opsPerThread) {
+    std::cout << "=== " << testName << " ===\n";
+    auto executor = std::make_shared<MaintenanceExecutor>();
+    bool ok = true;
+    for (int round = 0; round < 3; ++round) {
+        LruCache<int, std::string> lru(500);
+        LfuCache<int, std::string> lfu(500, 5);
+        Arc_new<int, std::string>  arc(500);
+        lru.enableMaintenance(executor, 400, 600);
+        lfu.enableMaintenance(executor, 400, 600);
+        arc.enableMaintenance(executor, 400, 600);
+
+        std::vector<std::thread> workers;
+        std::atomic<int> wrong{0};
+        for (int t = 0; t < threads; ++t) {
+            workers.emplace_back([&, t] {
+                std::mt19937 gen(t * 31 + round);
+                std::string v;
+                for (int i = 0; i < opsPerThread; ++i) {
+                    int key = gen() % 5000;
+                    std::string expect = "v" + std::to_string(key);
+                    if (gen() % 2) {
+                        lru.put(key, expect); lfu.put(key, expect); arc.put(key, expect);
+                    } else {
+                        if (lru.get(key, v) && v != expect) wrong.fetch_add(1);
+                        if (lfu.get(key, v) && v != expect) wrong.fetch_add(1);
+                        if (arc.get(key, v) && v != expect) wrong.fetch_add(1);
+                    }
+                }
+            });
+        }
+        for (auto& w : workers) w.join();
+        ok &= wrong.load() == 0 && lfu.size() <= 600 && arc.size() <= 600;
+    }
+    std::cout << "Executor runs: " << executor->runs() << "\n";
+    std::cout << "Result: " << (ok ? "PASS" : "FAIL") << "\n\n";
+    return ok;
+}
+
+// Put latency percentiles, inline vs background, for a cache whose
+// values are cheap to insert (shared_ptr) but expensive to destroy
+void runEvictionLatencyBench(const std::string& testName, int capacity, int totalPuts) {
+    std::cout << "=== " << testName << " ===\n";
+    using Blob = std::shared_ptr<std::vector<std::string>>;
+
+    auto bench = [&](bool background) {
+        auto executor = std::make_shared<MaintenanceExecutor>();
+        LruCache<int, Blob> cache(capacity);
+        if (background) cache.enableMaintenance(executor, capacity * 9 / 10, capacity * 2);
+        CacheBench::Latency lat;
+        for (int i = 0; i < totalPuts; ++i) {
+            Blob blob = std::make_shared<std::vector<std::string>>(64, std::string(48, 'x'));
+            lat.time([&] { cache.put(i, blob); });           // Cache now holds the only reference
+        }
+        executor->drain();
+        std::cout << std::setw(10) << (background ? "background" : "inline") << " | "
+                  << std::setw(8) << lat.percentile(50) << " | " << std::setw(8) << lat.percentile(99) << " | "
+                  << std::setw(8) << lat.percentile(99.9) << " | " << std::setw(10) << lat.percentile(100) << "\n";
+    };
+
+    std::cout << "  Eviction |  p50 ns  |  p99 ns  | p99.9 ns |    max ns\n" << std::fixed << std::setprecision(0);
+    bench(false);
+    bench(true);
+    std::cout << "\n";
+}
+
+// LFU with a low aging threshold: ageAll is O(n) under the lock on the
+// put that crosses it; in the background it runs in lock-sized pieces
+void runAgingLatencyBench(const std::string& testName, int capacity, int keySpace, int totalOps) {
+    std::cout << "=== " << testName << " ===\n";
+    CacheBench::ZipfGenerator zipf(keySpace, 0.99);
+
+    auto bench = [&](bool background) {
+        auto executor = std::make_shared<MaintenanceExecutor>();
+        LfuCache<int, int> cache(capacity, 3);
+        if (background) cache.enableMaintenance(executor, capacity * 9 / 10, capacity * 11 / 10);
+        std::mt19937 gen(11);
+        CacheBench::Latency lat;
+        int v = 0;
+        for (int i = 0; i < totalOps; ++i) {
+            int key = zipf(gen);
+            if (!cache.get(key, v)) lat.time([&] { cache.put(key, key); });
+        }
+        executor->drain();
+        std::cout << std::setw(10) << (background ? "background" : "inline") << " | "
+                  << std::setw(8) << lat.percentile(50) << " | " << std::setw(8) << lat.percentile(99) << " | "
+                  << std::setw(8) << lat.percentile(99.9) << " | " << std::setw(10) << lat.percentile(100)
+                  << "  (runs: " << executor->runs() << ")\n";
+    };
+
+    std::cout << "     Aging |  p50 ns  |  p99 ns  | p99.9 ns |    max ns\n" << std::fixed << std::setprecision(0);
+    bench(false);
+    bench(true);
+    std::cout << "\n";
+}
+
+int main() {
+    bool ok = true;
+    ok &= runExecutorTest("Maintenance Test 1: Executor coalescing and remove()");
+    ok &= runWatermarkTest("Maintenance Test 2: Settles at the low watermark", 1000, 900, 1200, 5000);
+    ok &= runHitRateTest("Maintenance Test 3: Hit rate inline vs background", 1000, 20000, 300000);
+    ok &= runConcurrentTest("Maintenance Test 4: Concurrent access + destruction", 4, 20000);
+
+    runEvictionLatencyBench("Maintenance Bench 1: LruCache put latency, costly values", 20000, 200000);
+    runAgingLatencyBench("Maintenance Bench 2: LfuCache put latency, frequent aging", 50000, 500000, 1000000);
+
+    return ok ? 0 : 1;
+}
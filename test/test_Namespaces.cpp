@@ -0,0 +1,230 @@
+// NamespacedCache: global LRU across namespaces, max / min quotas,
+// O(1) flush, per-namespace stats, concurrent tenants; and 1000 tenants
+// of Zipf-skewed activity against one fixed-size Arc_new per tenant
+#include <iostream>
+#include <string>
+#include <random>
+#include <iomanip>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include "NamespacedCache.h"
+#include "Arc_new.h"
+#include "BenchUtil.h"
+
+using namespace Cache;
+using Clock = std::chrono::steady_clock;
+
+std::string val(int k) { return "value-" + std::to_string(k); }
+
+// Capacity 10 shared by two namespaces: the victim is the oldest entry
+// of either, and a hit protects an entry whichever namespace it is in
+bool runGlobalLruTest() {
+    std::cout << "=== Namespaces Test 1: one LRU order across namespaces ===\n";
+    NamespacedCache<int, std::string> cache(10);
+    NamespaceId a = cache.open("a"), b = cache.open("b");
+    bool sameId = cache.open("a") == a && a != b;
+    for (int k = 0; k < 5; ++k) cache.put(a, k, val(k));
+    for (int k = 0; k < 5; ++k) cache.put(b, k, val(k));
+    std::string v;
+    cache.get(a, 0, v);
+    cache.put(b, 5, val(5));                             // Evicts a:1, not the touched a:0
+    cache.put(b, 6, val(6));                             // Then a:2
+    bool order = cache.get(a, 0, v) && !cache.get(a, 1, v) && !cache.get(a, 2, v) && cache.get(a, 3, v) &&
+                 cache.get(b, 0, v) && cache.size() == 10;
+    NamespaceStats sa = cache.stats(a), sb = cache.stats(b);
+    bool stats = sa.size == 3 && sa.evictions == 2 && sa.hits == 3 && sa.misses == 2 && sa.puts == 5 &&
+                 sb.size == 7 && sb.evictions == 0;
+    std::cout << "a: " << sa.size << " entries, " << sa.evictions << " evicted, hit rate " << sa.hitRate()
+              << "; b: " << sb.size << " entries\n";
+    bool ok = sameId && order && stats;
+    std::cout << "Result: " << (ok ? "PASS" : "FAIL") << "\n\n";
+    return ok;
+}
+
+// A namespace at its max pays for itself; one at its min is never a
+// victim of the others; quotas are validated and a lower max trims
+bool runQuotaTest() {
+    std::cout << "=== Namespaces Test 2: min / max quotas ===\n";
+    NamespacedCache<int, std::string> cache(100);
+    NamespaceId capped = cache.open("capped", 0, 5);
+    NamespaceId reserved = cache.open("reserved", 30);
+    NamespaceId flood = cache.open("flood");
+    std::string v;
+
+    for (int k = 0; k < 40; ++k) cache.put(capped, k, val(k));
+    bool maxOk = cache.stats(capped).size == 5 && cache.stats(capped).evictions == 35 &&
+                 cache.get(capped, 39, v) && !cache.get(capped, 34, v);
+
+    for (int k = 0; k < 30; ++k) cache.put(reserved, k, val(k));
+    for (int k = 0; k < 1000; ++k) cache.put(flood, k, val(k));   // Older capped entries go first
+    bool minOk = cache.stats(reserved).size == 30 && cache.stats(reserved).evictions == 0 &&
+                 cache.stats(flood).size == 70 && cache.stats(capped).size == 0 && cache.size() == 100;
+
+    bool rejected = false;
+    try { cache.open("greedy", 80); } catch (const std::invalid_argument&) { rejected = true; }
+    bool inverted = false;
+    try { cache.setQuota(flood, 10, 5); } catch (const std::invalid_argument&) { inverted = true; }
+    cache.setQuota(flood, 0, 20);
+    bool trimmed = cache.stats(flood).size == 20 && cache.get(flood, 999, v) && !cache.get(flood, 979, v);
+
+    // Mins that fill the capacity: an insert at the min replaces the
+    // namespace's own oldest entry instead of growing the cache
+    NamespacedCache<int, std::string> tight(10);
+    NamespaceId left = tight.open("left", 5), right = tight.open("right", 5);
+    for (int k = 0; k < 5; ++k) { tight.put(left, k, val(k)); tight.put(right, k, val(k)); }
+    for (int k = 5; k < 8; ++k) tight.put(left, k, val(k));
+    NamespaceId none = tight.open("none");
+    tight.put(none, 0, val(0));
+    bool bounded = tight.size() == 10 && tight.stats(right).size == 5 && tight.stats(left).size == 5 &&
+                   tight.get(left, 7, v) && !tight.get(left, 2, v) && tight.stats(none).size == 0;
+
+    bool unknown = false;
+    try { cache.put(NamespaceId{42}, 1, val(1)); } catch (const std::out_of_range&) { unknown = true; }
+
+    std::cout << "max " << (maxOk ? "held" : "broken") << ", min " << (minOk ? "held" : "broken")
+              << ", over-reserved min " << (rejected ? "rejected" : "accepted") << ", min > max "
+              << (inverted ? "rejected" : "accepted") << ", lower max " << (trimmed ? "trims" : "ignored") << ", mins at capacity "
+              << (bounded ? "bounded" : "overshoot") << ", unknown id " << (unknown ? "rejected" : "accepted") << "\n";
+    bool ok = maxOk && minOk && rejected && inverted && trimmed && bounded && unknown;
+    std::cout << "Result: " << (ok ? "PASS" : "FAIL") << "\n\n";
+    return ok;
+}
+
+// flush() is O(1): its entries miss at once and are torn down by later
+// calls; the other namespaces are untouched
+bool runFlushTest() {
+    std::cout << "=== Namespaces Test 3: O(1) flush ===\n";
+    NamespacedCache<int, std::string> cache(300000);
+    NamespaceId big = cache.open("big"), other = cache.open("other");
+    for (int k = 0; k < 200000; ++k) cache.put(big, k, val(k));
+    for (int k = 0; k < 1000; ++k) cache.put(other, k, val(k));
+
+    auto t0 = Clock::now();
+    size_t dropped = cache.flush(big);
+    double us = std::chrono::duration<double, std::micro>(Clock::now() - t0).count();
+    std::string v;
+    bool gone = dropped == 200000 && cache.size() == 1000 && cache.stats(big).size == 0 && !cache.get(big, 5, v) &&
+                cache.reclaimPending() && cache.stats(big).flushes == 1;
+    int calls = 0;
+    while (cache.reclaimPending()) { cache.get(other, calls % 1000, v); ++calls; }
+    cache.put(big, 5, "again");
+    bool reusable = cache.get(big, 5, v) && v == "again" && cache.stats(other).size == 1000;
+
+    std::cout << "flushed " << dropped << " entries in " << us << " us, torn down by " << calls
+              << " later gets\n";
+    bool ok = gone && reusable;
+    std::cout << "Result: " << (ok ? "PASS" : "FAIL") << "\n\n";
+    return ok;
+}
+
+// 4 threads over 64 quota'd namespaces with puts, gets, removes and
+// flushes; the accounting must add up afterwards
+bool runConcurrentTest() {
+    std::cout << "=== Namespaces Test 4: concurrent tenants ===\n";
+    NamespacedCache<int, std::string> cache(2000);
+    std::vector<NamespaceId> ids;
+    for (int i = 0; i < 64; ++i) ids.push_back(cache.open("t" + std::to_string(i), 10, 200));
+    CacheBench::runThroughput(4, [&](int t) {
+        std::mt19937 gen(t + 1);
+        std::uniform_int_distribution<int> ns(0, 63), key(0, 499), op(0, 99);
+        std::string v;
+        for (int i = 0; i < 40000; ++i) {
+            NamespaceId id = ids[ns(gen)];
+            int k = key(gen), o = op(gen);
+            if (o < 60) { if (!cache.get(id, k, v)) cache.put(id, k, val(k)); }
+            else if (o < 95) cache.put(id, k, val(k));
+            else if (o < 99) cache.remove(id, k);
+            else cache.flush(id);
+        }
+        return 40000;
+    });
+    size_t total = 0;
+    bool quotas = true;
+    for (NamespaceId id : ids) {
+        NamespaceStats s = cache.stats(id);
+        total += s.size;
+        quotas &= s.size <= 200;
+    }
+    cache.reclaimNow();
+    bool ok = total == cache.size() && cache.size() <= 2000 && quotas && !cache.reclaimPending();
+    std::cout << "64 namespaces, " << cache.size() << " entries (sum " << total << "), max quotas "
+              << (quotas ? "held" : "broken") << "\n";
+    std::cout << "Result: " << (ok ? "PASS" : "FAIL") << "\n\n";
+    return ok;
+}
+
+// 1000 tenants chosen by Zipf(1.0), each with a Zipf(0.8) key space of
+// 2000 keys; get, put on a miss. 100k entries in total either as one
+// Arc_new(100) per tenant or as one shared NamespacedCache
+struct TenantResult { double hitRate, headHitRate, tailHitRate, kops; size_t tailEntries; };
+
+template<typename Get, typename Put, typename Size>
+TenantResult runTenants(Get get, Put put, Size entriesOf, int tenants, int ops) {
+    CacheBench::ZipfGenerator pickTenant(tenants, 1.0), pickKey(2000, 0.8);
+    std::mt19937 gen(42);
+    std::vector<long> hits(tenants), total(tenants);
+    std::string v;
+    auto t0 = Clock::now();
+    for (int i = 0; i < ops; ++i) {
+        int t = pickTenant(gen), k = pickKey(gen);
+        ++total[t];
+        if (get(t, k, v)) ++hits[t];
+        else put(t, k, val(k));
+    }
+    double secs = std::chrono::duration<double>(Clock::now() - t0).count();
+    auto rate = [&](int from, int to) {
+        long h = 0, n = 0;
+        for (int t = from; t < to; ++t) { h += hits[t]; n += total[t]; }
+        return n ? 100.0 * h / n : 0.0;
+    };
+    size_t tailEntries = 0;
+    for (int t = tenants / 2; t < tenants; ++t) tailEntries += entriesOf(t);
+    return {rate(0, tenants), rate(0, 10), rate(tenants / 2, tenants), ops / secs / 1e3, tailEntries};
+}
+
+void printTenants(const std::string& label, const TenantResult& r) {
+    std::cout << std::left << std::setw(30) << label << std::right << " | " << std::setw(6) << r.hitRate << "% | "
+              << std::setw(8) << r.headHitRate << "% | " << std::setw(8) << r.tailHitRate << "% | " << std::setw(11)
+              << r.tailEntries << " | " << std::setw(7) << r.kops << "\n";
+}
+
+void runTenantBench() {
+    const int tenants = 1000, perTenant = 100, ops = 2000000;
+    std::cout << "=== Namespaces Bench 1: 1000 tenants, Zipf(1.0) activity, 100k entries in total ===\n";
+    std::cout << std::fixed << std::setprecision(1)
+              << "Layout                         |  hit % | top-10 % | tail-500% | tail entries| Kops/s\n";
+    {
+        std::vector<std::unique_ptr<Arc_new<int, std::string>>> caches;
+        for (int t = 0; t < tenants; ++t) caches.push_back(std::make_unique<Arc_new<int, std::string>>(perTenant));
+        printTenants("Arc_new(100) per tenant",
+                     runTenants([&](int t, int k, std::string& v) { return caches[t]->get(k, v); },
+                                [&](int t, int k, const std::string& v) { caches[t]->put(k, v); },
+                                [&](int t) { return caches[t]->size(); }, tenants, ops));
+    }
+    for (size_t minEach : {size_t(0), size_t(50)}) {
+        NamespacedCache<int, std::string> shared(tenants * perTenant);
+        std::vector<NamespaceId> ids;
+        for (int t = 0; t < tenants; ++t) ids.push_back(shared.open("tenant-" + std::to_string(t), minEach, 20000));
+        printTenants(minEach ? "shared, min 50 / max 20k each" : "shared, no quotas",
+                     runTenants([&](int t, int k, std::string& v) { return shared.get(ids[t], k, v); },
+                                [&](int t, int k, const std::string& v) { shared.put(ids[t], k, v); },
+                                [&](int t) { return shared.stats(ids[t]).size; }, tenants, ops));
+    }
+    std::cout << "(top-10: the 10 busiest tenants; tail-500: the 500 least active; tail entries: what they hold)\n\n";
+}
+
+int main() {
+    bool ok = true;
+    ok &= runGlobalLruTest();
+    ok &= runQuotaTest();
+    ok &= runFlushTest();
+    ok &= runConcurrentTest();
+
+    runTenantBench();
+    return ok ? 0 : 1;
+}
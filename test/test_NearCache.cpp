@@ -0,0 +1,123 @@
+// NearCache (thread-local L0 in front of HashLruCaches): coherence checks + Zipf throughput
+#include <iostream>
+#include <string>
+#include <random>
+#include <iomanip>
+#include <thread>
+#include <atomic>
+#include "NearCache.h"
+#include "BenchUtil.h"
+
+using namespace Cache;
+
+// Single thread: put/overwrite/remove must be visible through L0 immediately
+bool runNearCoherenceTest(const std::string& testName) {
+    std::cout << "=== " << testName << " ===\n";
+    NearCache<int, std::string> cache(64, 100, 4);
+
+    bool ok = true;
+    std::string v;
+    cache.put(1, "a");
+    ok &= cache.get(1, v) && v == "a";
+    ok &= cache.get(1, v) && v == "a";          // Served from L0
+    cache.put(1, "b");
+    ok &= cache.get(1, v) && v == "b";          // Stamp bumped → refetch
+    cache.remove(1);
+    ok &= !cache.get(1, v);
+    cache.put(2, "x");
+    ok &= cache.get(2, v) && v == "x";
+    cache.backend().put(2, "y");                // Bypasses the stamps...
+    cache.invalidateAll();                      // ...so drop every L0 table
+    ok &= cache.get(2, v) && v == "y";
+
+    std::cout << "Result: " << (ok ? "PASS" : "FAIL") << "\n\n";
+    return ok;
+}
+
+// Writers publish increasing versions of a few keys; every reader must see
+// each key's version go forward only (a stale L0 hit would move it back)
+bool runNearConcurrentTest(const std::string& testName, int readers, int writes) {
+    std::cout << "=== " << testName << " ===\n";
+    constexpr int kKeys = 8;
+    NearCache<int, int> cache(16, 64, 4);
+    for (int k = 0; k < kKeys; ++k) cache.put(k, 0);
+
+    std::atomic<bool> done{false};
+    std::atomic<int>  violations{0};
+
+    std::thread writer([&] {
+        for (int i = 1; i <= writes; ++i) cache.put(i % kKeys, i);
+        done.store(true);
+    });
+    std::vector<std::thread> rs;
+    for (int r = 0; r < readers; ++r) {
+        rs.emplace_back([&] {
+            int last[kKeys] = {};
+            while (!done.load()) {
+                for (int k = 0; k < kKeys; ++k) {
+                    int v = 0;
+                    if (!cache.get(k, v)) continue;
+                    if (v < last[k]) violations.fetch_add(1);
+                    last[k] = v;
+                }
+            }
+        });
+    }
+    writer.join();
+    for (auto& t : rs) t.join();
+
+    // After the writer is done, every key must read its final value
+    bool ok = violations.load() == 0;
+    for (int k = 0; k < kKeys; ++k) {
+        int v = -1;
+        int expect = writes - (writes - k) % kKeys;
+        ok &= cache.get(k, v) && v == expect;
+    }
+    std::cout << "Readers: " << readers << ", Writes: " << writes
+              << ", Violations: " << violations.load() << "\n";
+    std::cout << "Result: " << (ok ? "PASS" : "FAIL") << "\n\n";
+    return ok;
+}
+
+// Zipf 0.99 read-mostly workload, HashLruCaches alone vs NearCache in front
+void runNearZipfBench(const std::string& testName, int threads, int capacity, int keyRange,
+                      int opsPerThread, int putRatio, size_t l0Slots) {
+    std::cout << "=== " << testName << " ===\n";
+    CacheBench::ZipfGenerator zipf(keyRange, 0.99);
+
+    auto work = [&](auto& cache) {
+        for (int k = 0; k < keyRange; ++k) cache.put(k, "val_" + std::to_string(k));
+        return CacheBench::runThroughput(threads, [&](int t) {
+            std::mt19937 gen(1234 + t);
+            std::string result;
+            for (int i = 0; i < opsPerThread; ++i) {
+                int key = zipf(gen);
+                if (static_cast<int>(gen() % 100) < putRatio) cache.put(key, "val_" + std::to_string(key));
+                else cache.get(key, result);
+            }
+            return opsPerThread;
+        });
+    };
+
+    HashLruCaches<int, std::string> plain(capacity, 8);
+    NearCache<int, std::string> near(l0Slots, capacity, 8);
+    double plainOps = work(plain);
+    double nearOps  = work(near);
+
+    std::cout << "Threads: " << threads << ", Zipf: 0.99, PUT: " << putRatio << "%\n";
+    std::cout << std::fixed << std::setprecision(2)
+              << "HashLruCaches:           " << plainOps / 1e6 << " Mops/s\n"
+              << "NearCache+HashLruCaches: " << nearOps / 1e6 << " Mops/s"
+              << " (x" << nearOps / plainOps << ")\n\n";
+}
+
+int main() {
+    bool ok = true;
+    ok &= runNearCoherenceTest("Near Test 1: put/remove/invalidateAll coherence");
+    ok &= runNearConcurrentTest("Near Test 2: Monotonic reads under concurrent puts", 4, 200000);
+
+    runNearZipfBench("Near Bench 1: Zipf 0.99, 32 threads, PUT=5%", 32, 10000, 100000, 20000, 5, 256);
+    runNearZipfBench("Near Bench 2: Zipf 0.99, 32 threads, read-only", 32, 10000, 100000, 20000, 0, 256);
+
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,205 @@
+// NegativeCache: expiry, erase and a fixed budget; "known absent" answers
+// from RefreshAheadCache and BatchLoadingCache; backend calls saved on a
+// workload with ~30% nonexistent keys
+#include <iostream>
+#include <string>
+#include <random>
+#include <iomanip>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <thread>
+#include <vector>
+#include "NegativeCache.h"
+#include "RefreshAheadCache.h"
+#include "BatchLoadingCache.h"
+#include "LruCache.h"
+#include "BenchUtil.h"
+
+using namespace Cache;
+using Clock = std::chrono::steady_clock;
+
+const char* name(LookupResult r) {
+    switch (r) {
+    case LookupResult::Hit:         return "Hit";
+    case LookupResult::Miss:        return "Miss";
+    case LookupResult::KnownAbsent: return "KnownAbsent";
+    }
+    return "?";
+}
+
+// Keys are absent until ttl, erase() forgets one, and the table never
+// holds more than its capacity however many keys go in
+bool runTableTest(const std::string& testName) {
+    std::cout << "=== " << testName << " ===\n";
+    NegativeCache<int> neg(1000, std::chrono::milliseconds(100));
+    auto t0 = Clock::now();
+
+    neg.insert(1, t0);
+    neg.insert(2, t0);
+    bool present = neg.contains(1, t0 + std::chrono::milliseconds(99)) && neg.contains(2, t0);
+    bool unknown = !neg.contains(3, t0);
+    bool expired = !neg.contains(1, t0 + std::chrono::milliseconds(100));
+    neg.erase(2);
+    bool erased  = !neg.contains(2, t0);
+
+    for (int k = 0; k < 20000; ++k) neg.insert(k, t0 + std::chrono::microseconds(k));
+    int kept = 0, recentKept = 0;
+    for (int k = 0; k < 20000; ++k) kept += neg.contains(k, t0);
+    for (int k = 19000; k < 20000; ++k) recentKept += neg.contains(k, t0);
+
+    std::cout << "present " << (present ? "yes" : "no") << ", expired " << (expired ? "yes" : "no") << ", erased "
+              << (erased ? "yes" : "no") << "; 20000 keys into " << neg.capacity() << " slots ("
+              << neg.memoryBytes() << " bytes): " << kept << " kept, last 1000: " << recentKept << "\n";
+    bool ok = present && unknown && expired && erased && kept <= static_cast<int>(neg.capacity()) &&
+              neg.capacity() >= 1000 && neg.memoryBytes() == neg.capacity() * 16 && recentKept >= 500;
+    std::cout << "Result: " << (ok ? "PASS" : "FAIL") << "\n\n";
+    return ok;
+}
+
+// First lookup of a missing key asks the loader (Miss); the next ones are
+// KnownAbsent until negativeTtl passes or the key is put
+bool runRefreshAheadTest(const std::string& testName) {
+    std::cout << "=== " << testName << " ===\n";
+    std::atomic<long> ms{0};
+    auto base = Clock::now();
+    std::atomic<int> calls{0};
+    auto loader = [&](const int& key, std::string& value) {
+        calls.fetch_add(1);
+        value = "v" + std::to_string(key);
+        return key >= 0;
+    };
+    RefreshOptions opts;
+    opts.negativeTtl = std::chrono::milliseconds(50);
+    opts.clock       = [&] { return base + std::chrono::milliseconds(ms.load()); };
+    RefreshAheadCache<int, std::string> cache(std::make_unique<LruCache<int, TimedValue<std::string>>>(100),
+                                              loader, opts);
+    std::string v;
+    LookupResult first = cache.lookup(-1, v), second = cache.lookup(-1, v);
+    int callsCached = calls.load();
+    ms.store(60);
+    LookupResult afterTtl = cache.lookup(-1, v);
+    cache.put(-1, "now exists");
+    bool putWins = cache.lookup(-1, v) == LookupResult::Hit && v == "now exists";
+
+    RefreshAheadCache<int, std::string> plain(std::make_unique<LruCache<int, TimedValue<std::string>>>(100), loader);
+    calls.store(0);
+    LookupResult p1 = plain.lookup(-1, v), p2 = plain.lookup(-1, v);
+
+    std::cout << "negativeTtl 50 ms: " << name(first) << ", " << name(second) << " (loader calls " << callsCached
+              << "), after 60 ms: " << name(afterTtl) << ", after put: " << (putWins ? "Hit" : "?")
+              << "; without: " << name(p1) << ", " << name(p2) << " (loader calls " << calls.load() << ")\n";
+    bool ok = first == LookupResult::Miss && second == LookupResult::KnownAbsent && callsCached == 1 &&
+              afterTtl == LookupResult::Miss && putWins && cache.negativeHits() == 1 &&
+              p1 == LookupResult::Miss && p2 == LookupResult::Miss && calls.load() == 2;
+    std::cout << "Result: " << (ok ? "PASS" : "FAIL") << "\n\n";
+    return ok;
+}
+
+// Concurrent misses of one absent key share a batch; afterwards the key is
+// known absent until remove() or put()
+bool runBatchLoadingTest(const std::string& testName, int threads) {
+    std::cout << "=== " << testName << " ===\n";
+    std::atomic<int> calls{0};
+    BatchLoaderOptions opts;
+    opts.window      = std::chrono::milliseconds(5);
+    opts.negativeTtl = std::chrono::seconds(60);
+    BatchLoadingCache<int, std::string> cache(100, [&](const std::vector<int>& keys) {
+        calls.fetch_add(1);
+        std::unordered_map<int, std::string> out;
+        for (int k : keys)
+            if (k >= 0) out.emplace(k, "v" + std::to_string(k));
+        return out;
+    }, opts);
+
+    std::atomic<int> misses{0}, knownFirst{0};
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; ++t) {
+        workers.emplace_back([&] {
+            std::string v;
+            LookupResult r = cache.lookup(-7, v);
+            misses += r == LookupResult::Miss;                // Joined the batch
+            knownFirst += r == LookupResult::KnownAbsent;     // Arrived after it finished
+        });
+    }
+    for (auto& w : workers) w.join();
+    std::string v;
+    LookupResult known = cache.lookup(-7, v);
+    int callsBefore = calls.load();
+    cache.remove(-7);
+    LookupResult afterRemove = cache.lookup(-7, v);
+    cache.put(-7, "x");
+    bool putWins = cache.lookup(-7, v) == LookupResult::Hit && v == "x";
+
+    std::cout << threads << " concurrent lookups of an absent key: Miss " << misses.load() << ", KnownAbsent "
+              << knownFirst.load() << ", loader calls " << callsBefore << ", then " << name(known)
+              << "; after remove(): " << name(afterRemove) << ", after put(): " << (putWins ? "Hit" : "?") << "\n";
+    bool ok = misses.load() >= 1 && misses.load() + knownFirst.load() == threads && callsBefore == 1 &&
+              known == LookupResult::KnownAbsent && afterRemove == LookupResult::Miss && calls.load() == 2 && putWins;
+    std::cout << "Result: " << (ok ? "PASS" : "FAIL") << "\n\n";
+    return ok;
+}
+
+// Zipf lookups where ~30% of the traffic is for keys the backend does not
+// have; a 100 us backend, with and without a negative cache
+void runAbsentKeyBench(const std::string& testName, int threads, int getsPerThread, int keySpace, int capacity) {
+    std::cout << "=== " << testName << " ===\n";
+    CacheBench::ZipfGenerator zipf(keySpace, 0.9);
+    auto exists = [](int key) { return std::hash<uint64_t>{}(key * 0x9E3779B97F4A7C15ULL) % 10 >= 3; };
+
+    auto run = [&](const char* label, std::chrono::milliseconds negativeTtl) {
+        std::atomic<size_t> calls{0}, absentCalls{0}, absentLookups{0};
+        RefreshOptions opts;
+        opts.ttl              = std::chrono::seconds(60);
+        opts.refreshAfter     = opts.ttl;
+        opts.negativeTtl      = negativeTtl;
+        opts.negativeCapacity = capacity;
+        RefreshAheadCache<int, std::string> cache(
+            std::make_unique<LruCache<int, TimedValue<std::string>>>(capacity),
+            [&](const int& key, std::string& value) {
+                calls.fetch_add(1);
+                std::this_thread::sleep_for(std::chrono::microseconds(100));
+                if (!exists(key)) { absentCalls.fetch_add(1); return false; }
+                value = "v" + std::to_string(key);
+                return true;
+            }, opts);
+        std::vector<CacheBench::Latency> lat(threads);
+        double ops = CacheBench::runThroughput(threads, [&](int t) {
+            std::mt19937 gen(t + 1);
+            std::string v;
+            for (int i = 0; i < getsPerThread; ++i) {
+                int key = zipf(gen);
+                if (!exists(key)) absentLookups.fetch_add(1, std::memory_order_relaxed);
+                lat[t].time([&] { cache.get(key, v); });
+            }
+            return getsPerThread;
+        });
+        CacheBench::Latency all;
+        for (auto& l : lat) all.merge(l);
+        std::cout << std::left << std::setw(14) << label << std::right << " | " << std::setw(5) << std::setprecision(1)
+                  << 100.0 * absentLookups.load() / (threads * getsPerThread) << "% | " << std::setw(13)
+                  << calls.load() << " | " << std::setw(13) << absentCalls.load() << " | " << std::setw(8)
+                  << ops / 1e3 << " | " << std::setw(7) << all.percentile(50) / 1e3 << " | " << std::setw(7)
+                  << all.percentile(99) / 1e3 << "\n";
+    };
+
+    std::cout << std::fixed << "Mode           | absent | backend calls | for absent    | Kgets/s  |  p50 us |  p99 us\n";
+    run("no negatives", std::chrono::milliseconds(0));
+    run("negative 1 s", std::chrono::milliseconds(1000));
+    NegativeCache<int> sized(capacity, std::chrono::milliseconds(1000));
+    std::cout << "(negative cache: " << sized.capacity() << " slots, " << sized.memoryBytes() / 1024
+              << " KiB, allocated once)\n\n";
+}
+
+int main() {
+    bool ok = true;
+    ok &= runTableTest("NegativeCache Test 1: Expiry, erase and a fixed budget");
+    ok &= runRefreshAheadTest("NegativeCache Test 2: RefreshAheadCache known-absent lookups");
+    ok &= runBatchLoadingTest("NegativeCache Test 3: BatchLoadingCache known-absent lookups", 8);
+
+    runAbsentKeyBench("NegativeCache Bench 1: ~30% absent keys, Zipf 0.9 over 20k keys, 100 us backend",
+                      4, 20000, 20000, 4096);
+
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,291 @@
+// OffHeapArena / OffHeapCache: size classes and chunk reuse, large
+// mappings, handle reference counting, eviction freeing chunks, a
+// file-backed arena, concurrent readers and writers; and RSS,
+// fragmentation and throughput against on-heap std::string values
+#include <iostream>
+#include <string>
+#include <random>
+#include <iomanip>
+#include <chrono>
+#include <cstdio>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+#include <malloc.h>
+#include <sys/stat.h>
+#include "OffHeapCache.h"
+#include "LruCache.h"
+#include "Arc_new.h"
+#include "BenchUtil.h"
+
+using namespace Cache;
+using Clock = std::chrono::steady_clock;
+using Handle = OffHeap<std::string>;
+
+// "key:version|" then a fill character derived from both; any torn or
+// reused chunk fails check()
+std::string makeValue(int key, int version, size_t len) {
+    std::string v = std::to_string(key) + ":" + std::to_string(version) + "|";
+    v.resize(std::max(len, v.size()), static_cast<char>('a' + (key + version) % 26));
+    return v;
+}
+
+bool check(int key, const std::string& v) {
+    size_t colon = v.find(':'), bar = v.find('|');
+    if (colon == std::string::npos || bar == std::string::npos || std::stoi(v.substr(0, colon)) != key) return false;
+    int version = std::stoi(v.substr(colon + 1, bar - colon - 1));
+    char fill = static_cast<char>('a' + (key + version) % 26);
+    return v.find_first_not_of(fill, bar + 1) == std::string::npos;
+}
+
+// Geometric classes, LIFO chunk reuse, 16-byte alignment, large
+// requests mapped and unmapped on their own, option checks
+bool runArenaTest() {
+    std::cout << "=== OffHeap Test 1: size classes, reuse, large mappings ===\n";
+    OffHeapArena arena;
+    bool geometric = arena.classSize(0) == 32 && arena.maxChunk() == (1u << 20) / 4;
+    for (size_t c = 1; c < arena.classCount(); ++c)
+        geometric &= arena.classSize(c) > arena.classSize(c - 1) && arena.classSize(c) <= arena.classSize(c - 1) * 5 / 4 + 16;
+
+    void* a = arena.allocate(100);
+    void* b = arena.allocate(100);
+    arena.deallocate(a, 100);
+    bool reused = arena.allocate(90) == a && reinterpret_cast<uintptr_t>(b) % 16 == 0;   // Same class
+    ArenaStats s = arena.stats();
+    bool counted = s.allocations == 2 && s.requestedBytes == 190 && s.slabs == 1 &&
+                   s.mappedBytes == arena.options().regionBytes;
+
+    void* big = arena.allocate(1u << 20);
+    bool mapped = arena.stats().largeBytes == (1u << 20) && arena.stats().mappedBytes == s.mappedBytes + (1u << 20);
+    static_cast<char*>(big)[(1u << 20) - 1] = 1;
+    arena.deallocate(big, 1u << 20);
+    bool unmapped = arena.stats().largeBytes == 0 && arena.stats().mappedBytes == s.mappedBytes;
+
+    bool rejected = false;
+    try { ArenaOptions bad; bad.regionBytes = bad.slabBytes + 1; OffHeapArena x(bad); }
+    catch (const std::invalid_argument&) { rejected = true; }
+
+    std::cout << arena.classCount() << " classes, " << arena.classSize(0) << " B .. " << arena.maxChunk()
+              << " B; reuse " << (reused ? "LIFO" : "broken") << ", large mapping "
+              << (mapped && unmapped ? "mapped and unmapped" : "leaked") << "\n";
+    bool ok = geometric && reused && counted && mapped && unmapped && rejected;
+    std::cout << "Result: " << (ok ? "PASS" : "FAIL") << "\n\n";
+    return ok;
+}
+
+// Copies share a chunk; the last handle frees it. Traits for strings,
+// flat structs and vectors of flat types
+bool runHandleTest() {
+    std::cout << "=== OffHeap Test 2: handle reference counting and ValueTraits ===\n";
+    OffHeapArena arena;
+    bool shared;
+    {
+        Handle h(arena, "hello off-heap");
+        Handle copy = h, moved = std::move(copy);
+        Handle assigned;
+        assigned = moved;
+        assigned = assigned;
+        shared = arena.stats().allocations == 1 && !copy && assigned.get() == "hello off-heap" && h.bytes() == 14;
+        h = Handle(arena, "other");
+        shared &= arena.stats().allocations == 2 && moved.get() == "hello off-heap" && h.get() == "other";
+    }
+    bool freed = arena.stats().allocations == 0 && arena.stats().requestedBytes == 0;
+
+    struct Point { int x; double y; };
+    OffHeap<Point> p(arena, Point{3, 4.5});
+    OffHeap<std::vector<double>> vec(arena, std::vector<double>{1.0, 2.0, 3.0});
+    OffHeap<std::string> empty(arena, std::string());
+    bool traits = p.get().x == 3 && p.get().y == 4.5 && vec.get().size() == 3 && vec.get()[2] == 3.0 &&
+                  empty && empty.get().empty() && !Handle().get().size();
+
+    std::cout << "copies share " << (shared ? "one chunk" : "wrong") << ", last handle "
+              << (freed ? "frees it" : "leaks") << ", traits " << (traits ? "ok" : "wrong") << "\n";
+    bool ok = shared && freed && traits;
+    std::cout << "Result: " << (ok ? "PASS" : "FAIL") << "\n\n";
+    return ok;
+}
+
+// The arena holds exactly the resident values: eviction and overwrite
+// free their chunks, and destroying the cache frees the rest
+template<typename PolicyT>
+bool runCacheTest(const std::string& testName) {
+    std::cout << "=== " << testName << " ===\n";
+    auto arena = std::make_shared<OffHeapArena>();
+    bool resident, overwrite;
+    {
+        OffHeapCache<int, std::string> cache(std::make_unique<PolicyT>(1000), arena);
+        for (int k = 0; k < 5000; ++k) cache.put(k, makeValue(k, 0, 50 + k % 700));
+        std::string v;
+        resident = arena->stats().allocations == 1000 && cache.get(4999, v) && check(4999, v) &&
+                   !cache.get(0, v) && cache.get(0).empty();
+        cache.put(4999, makeValue(4999, 1, 3000));
+        overwrite = cache.get(4999, v) && check(4999, v) && v.size() == 3000 && arena->stats().allocations == 1000;
+    }
+    bool released = arena->stats().allocations == 0;
+    bool rejected = false;
+    try { OffHeapCache<int, std::string> bad(nullptr, arena); } catch (const std::invalid_argument&) { rejected = true; }
+    std::cout << "resident chunks " << (resident ? "= capacity" : "wrong") << ", overwrite "
+              << (overwrite ? "frees the old chunk" : "wrong") << ", destruction "
+              << (released ? "frees the rest" : "leaks") << ", null policy "
+              << (rejected ? "rejected" : "accepted") << "\n";
+    bool ok = resident && overwrite && released && rejected;
+    std::cout << "Result: " << (ok ? "PASS" : "FAIL") << "\n\n";
+    return ok;
+}
+
+// Regions are views of a scratch file; large values are punched out of
+// it when freed
+bool runFileBackedTest() {
+    std::cout << "=== OffHeap Test 5: file-backed arena ===\n";
+    const std::string path = "offheap_test_arena.bin";
+    ArenaOptions opts;
+    opts.backingFile = path;
+    opts.regionBytes = 4u << 20;
+    bool roundTrip = true;
+    off_t fileSize = 0;
+    {
+        auto arena = std::make_shared<OffHeapArena>(opts);
+        OffHeapCache<int, std::string> cache(std::make_unique<LruCache<int, Handle>>(2000), arena);
+        std::string v;
+        for (int k = 0; k < 3000; ++k) cache.put(k, makeValue(k, 0, k % 10 == 0 ? 400000 : 200 + k % 900));
+        for (int k = 1000; k < 3000; ++k) roundTrip &= cache.get(k, v) && check(k, v);
+        struct stat st{};
+        if (::stat(path.c_str(), &st) == 0) fileSize = st.st_size;
+    }
+    std::remove(path.c_str());
+    bool ok = roundTrip && fileSize >= static_cast<off_t>(opts.regionBytes);
+    std::cout << "2000 values read back " << (roundTrip ? "intact" : "corrupt") << ", file grew to "
+              << fileSize / (1 << 20) << " MiB\n";
+    std::cout << "Result: " << (ok ? "PASS" : "FAIL") << "\n\n";
+    return ok;
+}
+
+// Readers decode after the policy's lock while writers overwrite and
+// evict the same keys; every value read must be intact
+bool runConcurrentTest() {
+    std::cout << "=== OffHeap Test 6: concurrent get / put with eviction ===\n";
+    auto arena = std::make_shared<OffHeapArena>();
+    OffHeapCache<int, std::string> cache(std::make_unique<LruCache<int, Handle>>(500), arena);
+    std::atomic<long> torn{0}, hits{0};
+    CacheBench::runThroughput(4, [&](int t) {
+        std::mt19937 gen(t + 1);
+        std::uniform_int_distribution<int> key(0, 1999), len(16, 5000);
+        std::string v;
+        for (int i = 0; i < 30000; ++i) {
+            int k = key(gen);
+            if (cache.get(k, v)) {
+                hits.fetch_add(1, std::memory_order_relaxed);
+                if (!check(k, v)) torn.fetch_add(1, std::memory_order_relaxed);
+            }
+            if (i % 3 == 0) cache.put(k, makeValue(k, i, len(gen)));
+        }
+        return 30000;
+    });
+    bool ok = torn == 0 && arena->stats().allocations == 500;
+    std::cout << hits << " hits, " << torn << " torn values, " << arena->stats().allocations << " live chunks\n";
+    std::cout << "Result: " << (ok ? "PASS" : "FAIL") << "\n\n";
+    return ok;
+}
+
+// 200k entries; fill with sizes from one distribution, then 1M overwrites
+// drawing from a shifted one, then a Zipf get / put mix. RSS and heap are
+// growth over the run's start (malloc_trim'd); the heap variant runs last
+// so the arena's unmapped regions don't count for it
+struct ValueResult { double payloadMiB, fillMiB, churnMiB, heapMiB, frag, putP999, getKops, mixKops; };
+
+size_t heapBytes() {
+    struct mallinfo2 mi = mallinfo2();
+    return mi.arena + mi.hblkhd;
+}
+
+template<typename CacheT>
+ValueResult runValueBench(CacheT& cache, std::function<double()> frag, size_t baseRss, size_t baseHeap) {
+    const int keys = 200000;
+    std::mt19937 gen(11);
+    std::lognormal_distribution<double> small(5.5, 0.8), shifted(7.0, 0.6);   // ~330 B, then ~1.3 KB
+    auto clampLen = [](double x) { return static_cast<size_t>(std::min(std::max(x, 16.0), 16000.0)); };
+    std::vector<size_t> lens(keys);
+    for (int k = 0; k < keys; ++k) { lens[k] = clampLen(small(gen)); cache.put(k, makeValue(k, 0, lens[k])); }
+    ValueResult r{};
+    r.fillMiB = (CacheBench::residentBytes() - baseRss) / 1048576.0;
+
+    std::uniform_int_distribution<int> anyKey(0, keys - 1);
+    CacheBench::Latency putLatency;
+    for (int i = 1; i <= 1000000; ++i) {
+        int k = anyKey(gen);
+        lens[k] = clampLen(i % 2 ? shifted(gen) : small(gen));
+        std::string value = makeValue(k, i, lens[k]);
+        putLatency.time([&] { cache.put(k, value); });
+    }
+    r.churnMiB = (CacheBench::residentBytes() - baseRss) / 1048576.0;
+    r.heapMiB = (static_cast<double>(heapBytes()) - baseHeap) / 1048576.0;
+    r.putP999 = putLatency.percentile(99.9) / 1e3;
+    double payload = 0;
+    for (size_t n : lens) payload += n;
+    r.payloadMiB = payload / 1048576.0;
+    r.frag = frag();
+
+    CacheBench::ZipfGenerator zipf(keys, 0.9);
+    std::string v;
+    auto t0 = Clock::now();
+    for (int i = 0; i < 1000000; ++i) cache.get(zipf(gen), v);
+    r.getKops = 1000000 / std::chrono::duration<double>(Clock::now() - t0).count() / 1e3;
+    t0 = Clock::now();
+    for (int i = 0; i < 500000; ++i) {
+        int k = zipf(gen);
+        if (i % 5 == 0) cache.put(k, makeValue(k, i, lens[k]));
+        else cache.get(k, v);
+    }
+    r.mixKops = 500000 / std::chrono::duration<double>(Clock::now() - t0).count() / 1e3;
+    return r;
+}
+
+void printValueResult(const std::string& label, const ValueResult& r) {
+    std::cout << std::left << std::setw(24) << label << std::right << " | " << std::setw(6) << r.payloadMiB << " | "
+              << std::setw(8) << r.fillMiB << " | " << std::setw(9) << r.churnMiB << " | " << std::setw(8)
+              << r.heapMiB << " | " << std::setw(5) << r.frag * 100 << "% | " << std::setw(8) << r.putP999 << " | "
+              << std::setw(7) << r.getKops << " | " << std::setw(7) << r.mixKops << "\n";
+}
+
+void runValueBenches() {
+    std::cout << "=== OffHeap Bench 1: 200k std::string values, sizes shift from ~330 B to a ~330 B / 1.3 KB mix ===\n";
+    std::cout << std::fixed << std::setprecision(1)
+              << "Storage                 | live   | fill RSS | churn RSS | heap MiB | frag   | put p999 | get K/s | mix K/s\n";
+    const std::string path = "offheap_bench_arena.bin";
+    for (bool file : {false, true}) {
+        malloc_trim(0);
+        size_t baseRss = CacheBench::residentBytes(), baseHeap = heapBytes();
+        ArenaOptions opts;
+        if (file) opts.backingFile = path;
+        auto arena = std::make_shared<OffHeapArena>(opts);
+        OffHeapCache<int, std::string> cache(std::make_unique<LruCache<int, Handle>>(200000), arena);
+        printValueResult(file ? "OffHeapArena, file" : "OffHeapArena, anonymous",
+                         runValueBench(cache, [&] { return arena->stats().fragmentation(); }, baseRss, baseHeap));
+    }
+    std::remove(path.c_str());
+    {
+        malloc_trim(0);
+        size_t baseRss = CacheBench::residentBytes(), baseHeap = heapBytes();
+        LruCache<int, std::string> cache(200000);
+        printValueResult("std::string on the heap", runValueBench(cache, [&] {
+            struct mallinfo2 mi = mallinfo2();
+            return 1.0 - static_cast<double>(mi.uordblks) / (mi.arena + mi.hblkhd);   // Free share of the heap
+        }, baseRss, baseHeap));
+    }
+    std::cout << "(all over LruCache; live: value bytes resident; RSS / heap: growth in MiB, nodes and keys included; "
+                 "frag: arena = 1 - requested / slab bytes, heap = free share of malloc's arena; put p999 in us)\n\n";
+}
+
+int main() {
+    bool ok = true;
+    ok &= runArenaTest();
+    ok &= runHandleTest();
+    ok &= runCacheTest<LruCache<int, Handle>>("OffHeap Test 3: OffHeapCache over LruCache");
+    ok &= runCacheTest<Arc_new<int, Handle>>("OffHeap Test 4: OffHeapCache over Arc_new");
+    ok &= runFileBackedTest();
+    ok &= runConcurrentTest();
+
+    runValueBenches();
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,193 @@
+// pin / Lease: pinned entries survive eviction in LRU, LFU and ARC,
+// the pinned-bytes budget, stale leases after removal, concurrent
+// pin + churn, and eviction cost with 10% of the entries pinned
+#include <iostream>
+#include <string>
+#include <random>
+#include <iomanip>
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <thread>
+#include <vector>
+#include "LruCache.h"
+#include "LfuCache.h"
+#include "Arc_new.h"
+#include "BenchUtil.h"
+
+using namespace Cache;
+
+std::string val(int k) { return "v" + std::to_string(k); }
+
+template<typename CacheT>
+void churn(CacheT& cache, int from, int count, int getsEach = 0) {
+    std::string v;
+    for (int k = from; k < from + count; ++k) {
+        cache.put(k, val(k));
+        for (int i = 0; i < getsEach; ++i) cache.get(k, v);
+    }
+}
+
+// Same script against every policy; each step starts from a fresh
+// cache of capacity 8 holding keys 1..8
+template<typename CacheT>
+bool runLeaseTest(const std::string& testName) {
+    std::cout << "=== " << testName << " ===\n";
+    const size_t weight = sizeof(int) + sizeof(std::string);
+    std::string v;
+    std::unique_ptr<CacheT> owner;
+    auto fresh = [&]() -> CacheT& {
+        owner = std::make_unique<CacheT>(8);
+        for (int k = 1; k <= 8; ++k) owner->put(k, val(k));
+        return *owner;
+    };
+    CacheT* cache = &fresh();
+
+    // 1. Two pinned entries outlive 40 inserts; the lease carries the value
+    auto a = cache->pin(1);
+    auto b = cache->pin(2);
+    churn(*cache, 100, 40);
+    bool survived = a && b && a.value() == "v1" && cache->get(1, v) && cache->get(2, v) && !cache->get(3, v) &&
+                    cache->pinnedBytes() == 2 * weight;
+
+    // 2. A second lease on the same entry: released only with the last one
+    auto a2 = cache->pin(1);
+    a.release();
+    churn(*cache, 200, 40);
+    bool stillHeld = cache->get(1, v);
+    a2.release();
+    churn(*cache, 300, 40, 8);        // Hot enough to displace key 1 under LFU / ARC too
+    bool evictedAfter = !cache->get(1, v) && cache->get(2, v);
+    b.release();
+    bool released = cache->pinnedBytes() == 0;
+
+    // 3. Budget of two entries: a third pin is refused, re-pinning is free
+    cache = &fresh();
+    cache->setPinLimit(2 * weight);
+    auto p1 = cache->pin(1), p2 = cache->pin(2), p3 = cache->pin(3), p1again = cache->pin(1);
+    bool budget = p1 && p2 && !p3 && p1again && cache->pinnedBytes() == 2 * weight;
+    p1 = {}; p2 = {}; p1again = {};
+
+    // 4. Removing a pinned entry drops its pins; the stale lease must not
+    //    release a later pin of the same key
+    cache = &fresh();
+    auto stale = cache->pin(5);
+    cache->computeIfPresent(5, [](std::string&) { return false; });
+    bool dropped = !cache->get(5, v) && cache->pinnedBytes() == 0;
+    cache->put(5, "again");
+    auto repinned = cache->pin(5);
+    stale.release();
+    churn(*cache, 400, 40);
+    bool staleIgnored = repinned && cache->get(5, v) && v == "again";
+    repinned.release();
+
+    // 5. Everything pinned: inserts overshoot instead of evicting
+    cache = &fresh();
+    std::vector<typename CacheT::PinLease> all;
+    for (int k = 1; k <= 8; ++k) all.push_back(cache->pin(k));
+    cache->put(50, val(50));
+    bool overshoot = true;
+    for (int k = 1; k <= 8; ++k) overshoot &= cache->get(k, v);
+    all.clear();
+
+    std::cout << "survived churn " << (survived ? "yes" : "no") << ", shared lease " << (stillHeld ? "yes" : "no")
+              << ", evicted after release " << (evictedAfter ? "yes" : "no") << ", budget "
+              << (budget ? "ok" : "wrong") << ", removal drops pins " << (dropped ? "yes" : "no")
+              << ", stale lease ignored " << (staleIgnored ? "yes" : "no") << ", all pinned overshoot "
+              << (overshoot ? "yes" : "no") << "\n";
+    bool ok = survived && stillHeld && evictedAfter && released && budget && dropped && staleIgnored && overshoot;
+    std::cout << "Result: " << (ok ? "PASS" : "FAIL") << "\n\n";
+    return ok;
+}
+
+// Each thread keeps re-pinning its own key while all threads insert
+// fresh keys; a pinned key must always be found
+template<typename CacheT>
+bool runConcurrentTest(const std::string& testName, CacheT& cache, int threads, int rounds) {
+    std::cout << "=== " << testName << " ===\n";
+    std::atomic<int> lost{0}, refused{0};
+    CacheBench::runThroughput(threads, [&](int t) {
+        std::mt19937 gen(t + 1);
+        std::uniform_int_distribution<int> dist(1000, 100000);
+        std::string v;
+        const int mine = t;
+        for (int r = 0; r < rounds; ++r) {
+            cache.put(mine, val(mine));
+            auto lease = cache.pin(mine);
+            if (!lease) { refused.fetch_add(1); continue; }     // Evicted between put and pin
+            for (int i = 0; i < 20; ++i) { int k = dist(gen); cache.put(k, val(k)); cache.get(k, v); }
+            if (!cache.get(mine, v)) lost.fetch_add(1);
+        }
+        return rounds;
+    });
+    std::cout << threads << " threads × " << rounds << " leases: " << lost.load() << " pinned keys lost, "
+              << refused.load() << " pins of a just-evicted key, " << cache.pinnedBytes() << " bytes left pinned\n";
+    bool ok = lost.load() == 0 && cache.pinnedBytes() == 0;
+    std::cout << "Result: " << (ok ? "PASS" : "FAIL") << "\n\n";
+    return ok;
+}
+
+// Inserts into a full cache (each one evicts) with 0% and 10% of the
+// entries pinned at random
+template<typename CacheT>
+void runEvictionBench(const std::string& label, std::function<CacheT*()> make, int capacity, int inserts) {
+    for (int pct : {0, 10}) {
+        std::unique_ptr<CacheT> cache(make());
+        for (int k = 0; k < capacity; ++k) cache->put(k, val(k));
+        std::vector<typename CacheT::PinLease> leases;
+        std::mt19937 gen(7);
+        std::uniform_int_distribution<int> dist(0, capacity - 1);
+        while (static_cast<int>(leases.size()) < capacity * pct / 100) {
+            auto lease = cache->pin(dist(gen));
+            if (lease) leases.push_back(std::move(lease));   // Duplicates add a second lease only
+        }
+
+        CacheBench::Latency lat;
+        std::string v;
+        double ops = CacheBench::runThroughput(1, [&](int) {
+            for (int i = 0; i < inserts; ++i) {
+                int k = capacity + i;
+                lat.time([&] { cache->put(k, val(k)); });
+            }
+            return inserts;
+        });
+        int pinnedAlive = 0;
+        for (auto& l : leases) pinnedAlive += cache->get(l.key(), v);
+        std::cout << std::left << std::setw(10) << label << std::right << " | " << std::setw(6) << pct << "% | "
+                  << std::setw(13) << ops / 1e3 << " | " << std::setw(8) << lat.percentile(50) << " | "
+                  << std::setw(8) << lat.percentile(99) << " | " << std::setw(9) << lat.percentile(99.9) << " | "
+                  << pinnedAlive << "/" << leases.size() << "\n";
+    }
+}
+
+int main() {
+    bool ok = true;
+    {
+        ok &= runLeaseTest<LruCache<int, std::string>>("Pinning Test 1: LruCache");
+        ok &= runLeaseTest<LfuCache<int, std::string>>("Pinning Test 2: LfuCache");
+        ok &= runLeaseTest<Arc_new<int, std::string>>("Pinning Test 3: Arc_new");
+    }
+    {
+        LruCache<int, std::string> lru(256);
+        ok &= runConcurrentTest("Pinning Test 4: LruCache, concurrent pin + churn", lru, 8, 2000);
+        LfuCache<int, std::string> lfu(256);
+        ok &= runConcurrentTest("Pinning Test 5: LfuCache, concurrent pin + churn", lfu, 8, 2000);
+        Arc_new<int, std::string> arc(256);
+        ok &= runConcurrentTest("Pinning Test 6: Arc_new, concurrent pin + churn", arc, 8, 2000);
+        HashLruCaches<int, std::string> sharded(512, 4);
+        ok &= runConcurrentTest("Pinning Test 7: HashLruCaches, concurrent pin + churn", sharded, 8, 2000);
+    }
+
+    std::cout << "=== Pinning Bench 1: inserts into a full 10k-entry cache (each evicts), 200k inserts ===\n";
+    std::cout << std::fixed << std::setprecision(1)
+              << "Policy     | pinned | Kinserts/s    |  p50 ns  |  p99 ns  | p99.9 ns  | pinned kept\n";
+    runEvictionBench<LruCache<int, std::string>>("LruCache", [] { return new LruCache<int, std::string>(10000); },
+                                                 10000, 200000);
+    runEvictionBench<LfuCache<int, std::string>>("LfuCache", [] { return new LfuCache<int, std::string>(10000); },
+                                                 10000, 200000);
+    runEvictionBench<Arc_new<int, std::string>>("Arc_new", [] { return new Arc_new<int, std::string>(10000); },
+                                                10000, 200000);
+    std::cout << "\n";
+
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,155 @@
+// Priority classes: lower tiers are drained first in LRU, ARC and the
+// sharded LRU, retiering and pins, per-tier stats under concurrent
+// puts; and a workload where misses cost 1 / 10 / 100 by tier
+#include <iostream>
+#include <string>
+#include <random>
+#include <iomanip>
+#include <functional>
+#include <memory>
+#include <vector>
+#include "LruCache.h"
+#include "Arc_new.h"
+#include "BenchUtil.h"
+
+using namespace Cache;
+
+std::string val(int k) { return "v" + std::to_string(k); }
+
+// Same script against every cache; capacity 10
+template<typename CacheT>
+bool runTierTest(const std::string& testName, CacheT& cache) {
+    std::cout << "=== " << testName << " ===\n";
+    std::string v;
+
+    // 1. Five High and five Low entries, then 20 Normal inserts: the Low
+    //    tier goes first, then Normal churns among itself
+    for (int k = 0; k < 5; ++k) cache.put(k, val(k), Priority::High);
+    for (int k = 5; k < 10; ++k) cache.put(k, val(k), Priority::Low);
+    for (int k = 100; k < 120; ++k) cache.put(k, val(k));
+    int high = 0, low = 0;
+    for (int k = 0; k < 5; ++k) high += cache.get(k, v);
+    for (int k = 5; k < 10; ++k) low += cache.get(k, v);
+    PriorityStats s = cache.priorityStats();
+    bool drained = high == 5 && low == 0 && s.evictions[0] == 5 && s.evictions[1] == 15 && s.evictions[2] == 0 &&
+                   s.entries[0] == 0 && s.entries[1] == 5 && s.entries[2] == 5 && s.hits[2] == 5;
+    cache.compute(0, [](std::string&, bool present) { return present; });   // A hit like get()
+    bool computeHit = cache.priorityStats().hits[2] == 6;
+
+    // 2. A plain put keeps the tier; a put with a priority moves the entry
+    cache.put(0, "again");
+    cache.put(1, val(1), Priority::Low);
+    cache.put(200, val(200), Priority::Normal);          // Evicts the Low one: key 1
+    bool retiered = !cache.get(1, v) && cache.get(0, v) && v == "again" && cache.priorityStats().entries[2] == 4;
+
+    // 3. A pinned Low entry is off its list: the next insert takes the
+    //    other Low entry, not the pinned one
+    cache.put(300, val(300), Priority::Low);
+    auto lease = cache.pin(300);
+    cache.put(301, val(301), Priority::Low);             // Low list empty: a Normal goes
+    cache.put(302, val(302), Priority::High);            // Takes 301
+    bool pinned = cache.get(300, v) && !cache.get(301, v) && cache.get(302, v);
+    lease.release();
+
+    std::cout << "High kept " << high << "/5, Low kept " << low << "/5, evictions by tier " << s.evictions[0] << " / "
+              << s.evictions[1] << " / " << s.evictions[2] << ", retier " << (retiered ? "ok" : "wrong")
+              << ", pinned Low " << (pinned ? "kept" : "lost") << ", compute hit "
+              << (computeHit ? "counted" : "missed") << "\n";
+    bool ok = drained && computeHit && retiered && pinned;
+    std::cout << "Result: " << (ok ? "PASS" : "FAIL") << "\n\n";
+    return ok;
+}
+
+// Threads put keys whose tier is fixed by the key (the LRU through its
+// combiner); the key space is 4x the capacity, so the per-tier entry
+// counts must add up to a full cache, and the High tier, drained last,
+// must lose the fewest entries
+template<typename CacheT>
+bool runConcurrentTest(const std::string& testName, CacheT& cache, int threads, size_t capacity) {
+    std::cout << "=== " << testName << " ===\n";
+    CacheBench::runThroughput(threads, [&](int t) {
+        std::mt19937 gen(t + 1);
+        std::uniform_int_distribution<int> dist(0, 4 * static_cast<int>(capacity));
+        std::string v;
+        for (int i = 0; i < 20000; ++i) {
+            int k = dist(gen);
+            if (!cache.get(k, v)) cache.put(k, val(k), static_cast<Priority>(k % 3));
+        }
+        return 20000;
+    });
+    PriorityStats s = cache.priorityStats();
+    size_t entries = s.entries[0] + s.entries[1] + s.entries[2];
+    std::cout << threads << " threads: entries Low / Normal / High " << s.entries[0] << " / " << s.entries[1]
+              << " / " << s.entries[2] << ", evictions " << s.evictions[0] << " / " << s.evictions[1] << " / "
+              << s.evictions[2] << "\n";
+    bool ok = entries == capacity && s.entries[2] >= s.entries[0] && s.evictions[2] < s.evictions[0] &&
+              s.evictions[2] < s.evictions[1];
+    std::cout << "Result: " << (ok ? "PASS" : "FAIL") << "\n\n";
+    return ok;
+}
+
+// Zipf(0.8) over 20k keys, 2k entries. Each key has a fixed tier:
+// 30% Low (a miss costs 1), 60% Normal (10), 10% High (100). Get, put on
+// a miss, with and without passing the tier
+template<typename CacheT>
+void runCostBench(const std::string& label, std::function<CacheT*()> make) {
+    const int keys = 20000, ops = 1000000;
+    auto tierOfKey = [](int k) {
+        unsigned h = static_cast<unsigned>(k) * 2654435761u >> 24;
+        return h % 10 == 0 ? Priority::High : h % 10 < 4 ? Priority::Low : Priority::Normal;
+    };
+    const double cost[kPriorities] = {1, 10, 100};
+    CacheBench::ZipfGenerator zipf(keys, 0.8);
+
+    for (bool aware : {false, true}) {
+        std::unique_ptr<CacheT> cache(make());
+        std::mt19937 gen(7);
+        std::string v;
+        long hits[kPriorities] = {}, total[kPriorities] = {};
+        double spent = 0;
+        for (int i = 0; i < ops; ++i) {
+            int k = zipf(gen);
+            Priority p = tierOfKey(k);
+            ++total[tierOf(p)];
+            if (cache->get(k, v)) { ++hits[tierOf(p)]; continue; }
+            spent += cost[tierOf(p)];
+            if (aware) cache->put(k, val(k), p);
+            else cache->put(k, val(k));
+        }
+        auto rate = [&](size_t t) { return 100.0 * hits[t] / total[t]; };
+        long allHits = hits[0] + hits[1] + hits[2];
+        std::cout << std::left << std::setw(9) << label << std::setw(11) << (aware ? " tiered" : " flat")
+                  << std::right << " | " << std::setw(6) << 100.0 * allHits / ops << "% | " << std::setw(6)
+                  << rate(0) << "% | " << std::setw(6) << rate(1) << "% | " << std::setw(6) << rate(2) << "% | "
+                  << std::setw(10) << spent / 1e3 << "\n";
+    }
+}
+
+int main() {
+    bool ok = true;
+    {
+        LruCache<int, std::string> lru(10);
+        ok &= runTierTest("Priority Test 1: LruCache", lru);
+        Arc_new<int, std::string> arc(10);
+        ok &= runTierTest("Priority Test 2: Arc_new", arc);
+        HashLruCaches<int, std::string> sharded(10, 1);
+        ok &= runTierTest("Priority Test 3: HashLruCaches", sharded);
+    }
+    {
+        LruCache<int, std::string> lru(512, /*flatCombining*/ true);
+        ok &= runConcurrentTest("Priority Test 4: LruCache (combining), concurrent tiered puts", lru, 4, 512);
+        Arc_new<int, std::string> arc(512);
+        ok &= runConcurrentTest("Priority Test 5: Arc_new, concurrent tiered puts", arc, 4, 512);
+        HashLruCaches<int, std::string> sharded(512, 4);
+        ok &= runConcurrentTest("Priority Test 6: HashLruCaches, concurrent tiered puts", sharded, 4, 512);
+    }
+
+    std::cout << "=== Priority Bench 1: miss cost 1 / 10 / 100 by tier, Zipf 0.8 over 20k keys, 2k entries ===\n";
+    std::cout << std::fixed << std::setprecision(1)
+              << "Policy                | hit %  | Low %  | Norm % | High % | cost (k)\n";
+    runCostBench<LruCache<int, std::string>>("LruCache", [] { return new LruCache<int, std::string>(2000); });
+    runCostBench<Arc_new<int, std::string>>("Arc_new", [] { return new Arc_new<int, std::string>(2000); });
+    std::cout << "(flat: every put at Normal; tiered: put with the key's tier; cost: sum of miss costs)\n\n";
+
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,384 @@
+// RefreshAheadCache: fresh / refresh-ahead / stale / expired thresholds over
+// LRU, LFU and ARC, deduplicated reloads, put vs reload, reload errors,
+// single-flight misses, XFetch early recomputation, concurrency, tail
+// latency with and without refresh-ahead, and an expiry stampede
+#include <iostream>
+#include <string>
+#include <random>
+#include <iomanip>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include "RefreshAheadCache.h"
+#include "LruCache.h"
+#include "LfuCache.h"
+#include "Arc_new.h"
+#include "BenchUtil.h"
+
+using namespace Cache;
+using Clock = std::chrono::steady_clock;
+using Refreshing = RefreshAheadCache<int, std::string>;
+
+// Test clock moved by hand, in milliseconds
+struct ManualClock {
+    std::atomic<long> ms{0};
+    Clock::time_point base = Clock::now();
+    void advanceTo(long t) { ms.store(t); }
+    std::function<Clock::time_point()> fn() {
+        return [this] { return base + std::chrono::milliseconds(ms.load()); };
+    }
+};
+
+// Loader returning "v<key>.<n>" for its n-th call; reloads (not the caller's
+// own loads) block while the gate is closed, and throw while `failing`
+struct Source {
+    std::atomic<int>  calls{0};
+    std::atomic<bool> gateOpen{true};
+    std::atomic<bool> failing{false};
+    std::thread::id   caller = std::this_thread::get_id();
+
+    Refreshing::Loader loader() {
+        return [this](const int& key, std::string& value) {
+            if (std::this_thread::get_id() != caller) {
+                while (!gateOpen.load()) std::this_thread::sleep_for(std::chrono::microseconds(100));
+                if (failing.load()) throw std::runtime_error("source down");
+            }
+            value = "v" + std::to_string(key) + "." + std::to_string(calls.fetch_add(1) + 1);
+            return key >= 0;
+        };
+    }
+};
+
+RefreshOptions manualOptions(ManualClock& clock, long staleMs) {
+    RefreshOptions opts;
+    opts.ttl          = std::chrono::milliseconds(100);
+    opts.refreshAfter = std::chrono::milliseconds(80);
+    opts.staleWindow  = std::chrono::milliseconds(staleMs);
+    opts.clock        = clock.fn();
+    return opts;
+}
+
+// Every threshold, through one policy
+template<typename Policy>
+bool runThresholdTest(const std::string& testName) {
+    std::cout << "=== " << testName << " ===\n";
+    bool ok = true;
+    {
+        ManualClock clock;
+        Source src;
+        Refreshing cache(std::make_unique<Policy>(100), src.loader(), manualOptions(clock, 0));
+        std::string v;
+
+        ok &= cache.get(1, v) && v == "v1.1" && cache.loads() == 1;         // Miss: caller loads
+        clock.advanceTo(50);
+        ok &= cache.get(1, v) && v == "v1.1" && src.calls.load() == 1;      // Fresh
+
+        src.gateOpen.store(false);
+        clock.advanceTo(85);
+        int old = 0;
+        for (int i = 0; i < 10; ++i) old += cache.get(1, v) && v == "v1.1";
+        src.gateOpen.store(true);
+        cache.awaitRefreshes();
+        bool refreshed = cache.get(1, v) && v == "v1.2";
+        std::cout << "Past refreshAfter: " << old << "/10 reads got the old value at once, reloads "
+                  << cache.refreshes() << ", new value after the reload: " << (refreshed ? "yes" : "no") << "\n";
+        ok &= old == 10 && cache.refreshes() == 1 && refreshed && cache.loads() == 1;
+
+        clock.advanceTo(85 + 101);                                           // Reloaded at 85
+        bool expired = cache.get(1, v) && v == "v1.3";
+        std::cout << "Past ttl, no stale window: loaded on the caller: " << (expired ? "yes" : "no")
+                  << ", expired misses " << cache.expiredMisses() << "\n";
+        ok &= expired && cache.loads() == 2 && cache.expiredMisses() == 1;
+
+        ok &= !cache.get(-1, v) && !cache.get(-1, v) && cache.loads() == 4; // Absent: not cached
+    }
+    {
+        ManualClock clock;
+        Source src;
+        Refreshing cache(std::make_unique<Policy>(100), src.loader(), manualOptions(clock, 50));
+        std::string v;
+        cache.get(2, v);
+        clock.advanceTo(120);                                                // ttl < age < ttl + stale
+        bool stale = cache.get(2, v) && v == "v2.1";
+        cache.awaitRefreshes();
+        bool revalidated = cache.get(2, v) && v == "v2.2";
+        clock.advanceTo(120 + 151);                                          // Past the stale window too
+        bool missed = cache.get(2, v) && v == "v2.3";
+        std::cout << "Stale window: served stale " << (stale ? "yes" : "no") << ", revalidated "
+                  << (revalidated ? "yes" : "no") << ", miss past the window " << (missed ? "yes" : "no") << "\n";
+        ok &= stale && revalidated && missed && cache.staleServed() == 1 && cache.loads() == 2;
+    }
+    std::cout << "Result: " << (ok ? "PASS" : "FAIL") << "\n\n";
+    return ok;
+}
+
+// A put while a reload is in flight wins; a reload that throws keeps the
+// old entry until it expires
+bool runPutAndErrorTest(const std::string& testName) {
+    std::cout << "=== " << testName << " ===\n";
+    ManualClock clock;
+    Source src;
+    Refreshing cache(std::make_unique<LruCache<int, TimedValue<std::string>>>(100), src.loader(),
+                     manualOptions(clock, 0));
+    std::string v;
+
+    cache.get(1, v);
+    src.gateOpen.store(false);
+    clock.advanceTo(90);
+    cache.get(1, v);                                         // Reload of key 1 blocked in the loader
+    cache.put(1, "mine");
+    src.gateOpen.store(true);
+    cache.awaitRefreshes();
+    bool putWins = cache.get(1, v) && v == "mine";
+
+    cache.get(2, v);                                         // Loaded at 90
+    src.failing.store(true);
+    clock.advanceTo(175);
+    cache.get(2, v);
+    cache.awaitRefreshes();
+    bool kept = cache.get(2, v) && v == "v2.3";
+    src.failing.store(false);
+    cache.awaitRefreshes();                                  // The read above queued a retry
+    clock.advanceTo(300);
+    bool reloaded = cache.get(2, v) && v != "v2.3";
+
+    std::cout << "put during reload wins: " << (putWins ? "yes" : "no") << ", old value kept after a failed reload: "
+              << (kept ? "yes" : "no") << ", reload errors " << cache.refreshErrors() << "\n";
+    bool ok = putWins && kept && reloaded && cache.refreshErrors() >= 1;
+    std::cout << "Result: " << (ok ? "PASS" : "FAIL") << "\n\n";
+    return ok;
+}
+
+// Real clock, short ttl: reads always get their own key's value while
+// reloads and expirations race with them
+bool runConcurrentTest(const std::string& testName, int threads, int opsPerThread) {
+    std::cout << "=== " << testName << " ===\n";
+    RefreshOptions opts;
+    opts.ttl          = std::chrono::milliseconds(4);
+    opts.refreshAfter = std::chrono::milliseconds(2);
+    opts.staleWindow  = std::chrono::milliseconds(2);
+    Refreshing cache(std::make_unique<LruCache<int, TimedValue<std::string>>>(256),
+                     [](const int& key, std::string& value) {
+                         value = "v" + std::to_string(key);
+                         return true;
+                     }, opts);
+    std::atomic<int> wrong{0};
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; ++t) {
+        workers.emplace_back([&, t] {
+            std::mt19937 gen(t + 1);
+            std::string v;
+            for (int i = 0; i < opsPerThread; ++i) {
+                int key = gen() % 100;
+                if (gen() % 8 == 0) cache.put(key, "v" + std::to_string(key));
+                else if (!cache.get(key, v) || v != "v" + std::to_string(key)) wrong.fetch_add(1);
+                if (i % 64 == 0) std::this_thread::sleep_for(std::chrono::microseconds(200));
+            }
+        });
+    }
+    for (auto& w : workers) w.join();
+    std::cout << "Wrong reads: " << wrong.load() << ", loads " << cache.loads() << ", reloads "
+              << cache.refreshes() << ", stale served " << cache.staleServed() << "\n";
+    bool ok = wrong.load() == 0 && cache.refreshes() > 0;
+    std::cout << "Result: " << (ok ? "PASS" : "FAIL") << "\n\n";
+    return ok;
+}
+
+// Concurrent misses on one key: one load, everyone gets its value.
+// A caller that arrives after the load finished hits instead of waiting
+// (a slow runner can delay threads past the 20 ms load), so every caller
+// but the loader either waited on it or hit
+bool runSingleFlightTest(const std::string& testName, int threads) {
+    std::cout << "=== " << testName << " ===\n";
+    std::atomic<int> calls{0};
+    Refreshing cache(std::make_unique<LruCache<int, TimedValue<std::string>>>(100),
+                     [&](const int& key, std::string& value) {
+                         calls.fetch_add(1);
+                         std::this_thread::sleep_for(std::chrono::milliseconds(20));
+                         value = "v" + std::to_string(key);
+                         return true;
+                     });
+    std::atomic<int> ready{0}, wrong{0};
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; ++t) {
+        workers.emplace_back([&] {
+            ready.fetch_add(1);
+            while (ready.load() < threads) std::this_thread::yield();
+            std::string v;
+            if (!cache.get(7, v) || v != "v7") wrong.fetch_add(1);
+        });
+    }
+    for (auto& w : workers) w.join();
+    size_t waited = cache.sharedLoads();
+    size_t hits = waited < static_cast<size_t>(threads) ? threads - 1 - waited : 0;
+    std::cout << threads << " callers missing one key: loader calls " << calls.load() << ", waited on it "
+              << waited << ", hit after it " << hits << ", wrong " << wrong.load() << "\n";
+    bool ok = wrong.load() == 0 && calls.load() == 1 && cache.loads() == 1 &&
+              waited <= static_cast<size_t>(threads - 1);
+    std::cout << "Result: " << (ok ? "PASS" : "FAIL") << "\n\n";
+    return ok;
+}
+
+// XFetch: early recomputation is rare long before expiry and likely just
+// before it; values from put() (no load time) never draw early
+bool runXFetchTest(const std::string& testName, int keys) {
+    std::cout << "=== " << testName << " ===\n";
+    ManualClock clock;
+    std::atomic<int> calls{0};
+    RefreshOptions opts = manualOptions(clock, 0);
+    opts.refreshAfter = opts.ttl;                            // XFetch only
+    opts.xfetchBeta   = 10.0;                                // Load ~1 ms → gaps of ~10 ms
+    Refreshing cache(std::make_unique<LruCache<int, TimedValue<std::string>>>(keys * 4),
+                     [&](const int& key, std::string& value) {
+                         std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                         value = "v" + std::to_string(key) + "." + std::to_string(calls.fetch_add(1) + 1);
+                         return true;
+                     }, opts);
+    std::string v;
+    for (int k = 0; k < 2 * keys; ++k) cache.get(k, v);     // All loaded at t = 0
+    for (int k = 0; k < keys; ++k) cache.put(10000 + k, "p");
+
+    auto earlyAt = [&](long t, int first) {
+        clock.advanceTo(t);
+        size_t before = cache.earlyLoads();
+        int fresh = 0;
+        for (int k = first; k < first + keys; ++k) {
+            int callsBefore = calls.load();
+            cache.get(k, v);
+            fresh += calls.load() != callsBefore && v == "v" + std::to_string(k) + "." + std::to_string(calls.load());
+        }
+        return std::make_pair(cache.earlyLoads() - before, fresh);
+    };
+    auto atStart = earlyAt(5, 0);
+    auto nearEnd = earlyAt(95, keys);
+    auto fromPut = earlyAt(95, 10000);
+
+    std::cout << "Early recomputations at age 5/100 ms: " << atStart.first << "/" << keys << ", at age 95: "
+              << nearEnd.first << "/" << keys << " (returned the new value: " << nearEnd.second
+              << "), of put() values: " << fromPut.first << ", expired misses " << cache.expiredMisses() << "\n";
+    bool ok = atStart.first <= static_cast<size_t>(keys / 20) && nearEnd.first >= static_cast<size_t>(keys / 2) &&
+              nearEnd.second == static_cast<int>(nearEnd.first) && fromPut.first == 0 && cache.expiredMisses() == 0;
+    std::cout << "Result: " << (ok ? "PASS" : "FAIL") << "\n\n";
+    return ok;
+}
+
+// Zipf reads of keys with a short ttl against a slow source: plain
+// expiry (readers of an expired key wait for one load), refresh-ahead,
+// and refresh-ahead plus a stale window
+void runTailBench(const std::string& testName, int threads, int getsPerThread, int keySpace, int ttlMs,
+                  int loadUs) {
+    std::cout << "=== " << testName << " ===\n";
+    CacheBench::ZipfGenerator zipf(keySpace, 0.9);
+
+    auto run = [&](const char* name, int refreshAfterMs, int staleMs) {
+        RefreshOptions opts;
+        opts.ttl          = std::chrono::milliseconds(ttlMs);
+        opts.refreshAfter = std::chrono::milliseconds(refreshAfterMs);
+        opts.staleWindow  = std::chrono::milliseconds(staleMs);
+        Refreshing cache(std::make_unique<LruCache<int, TimedValue<std::string>>>(keySpace * 2),
+                         [loadUs](const int& key, std::string& value) {
+                             std::this_thread::sleep_for(std::chrono::microseconds(loadUs));
+                             value = "v" + std::to_string(key);
+                             return true;
+                         }, opts);
+        std::vector<CacheBench::Latency> lat(threads);
+        double ops = CacheBench::runThroughput(threads, [&](int t) {
+            std::mt19937 gen(t + 1);
+            std::string v;
+            for (int i = 0; i < getsPerThread; ++i) {
+                int key = zipf(gen);
+                lat[t].time([&] { cache.get(key, v); });
+                if (i % 8 == 0) std::this_thread::sleep_for(std::chrono::microseconds(100));   // Paced readers
+            }
+            return getsPerThread;
+        });
+        CacheBench::Latency all;
+        for (auto& l : lat) all.merge(l);
+        std::cout << std::left << std::setw(16) << name << std::right << " | " << std::setw(10) << cache.loads()
+                  << " | " << std::setw(7) << cache.refreshes() << " | " << std::setw(8) << ops / 1e3 << " | "
+                  << std::setw(7) << all.percentile(50) / 1e3 << " | " << std::setw(7) << all.percentile(99) / 1e3
+                  << " | " << std::setw(8) << all.percentile(99.9) / 1e3 << "\n";
+    };
+
+    std::cout << std::fixed << std::setprecision(1)
+              << "Mode             | sync loads | reloads | Kgets/s  |  p50 us |  p99 us | p99.9 us\n";
+    run("expiry only", ttlMs, 0);
+    run("refresh-ahead", ttlMs * 3 / 4, 0);
+    run("refresh + stale", ttlMs * 3 / 4, ttlMs);
+    std::cout << "\n";
+}
+
+// Hot keys all loaded at the same moment, read by many threads, slow
+// source: with expiry alone they expire together and every reader of an
+// expired key waits; XFetch lets single readers recompute them early
+void runStampedeBench(const std::string& testName, int threads, int getsPerThread, int keys, int ttlMs,
+                      int loadUs) {
+    std::cout << "=== " << testName << " ===\n";
+    auto run = [&](const char* name, double beta) {
+        RefreshOptions opts;
+        opts.ttl          = std::chrono::milliseconds(ttlMs);
+        opts.refreshAfter = opts.ttl;                        // No background refresh
+        opts.xfetchBeta   = beta;
+        std::atomic<int> loading{0}, peak{0};
+        Refreshing cache(std::make_unique<LruCache<int, TimedValue<std::string>>>(keys * 2),
+                         [&](const int& key, std::string& value) {
+                             int now = loading.fetch_add(1) + 1;
+                             int seen = peak.load();
+                             while (now > seen && !peak.compare_exchange_weak(seen, now)) {}
+                             std::this_thread::sleep_for(std::chrono::microseconds(loadUs));
+                             loading.fetch_sub(1);
+                             value = "v" + std::to_string(key);
+                             return true;
+                         }, opts);
+        std::string v;
+        for (int k = 0; k < keys; ++k) cache.get(k, v);
+        peak.store(0);
+        size_t warmLoads = cache.loads();
+
+        std::vector<CacheBench::Latency> lat(threads);
+        CacheBench::runThroughput(threads, [&](int t) {
+            std::mt19937 gen(t + 1);
+            std::string out;
+            for (int i = 0; i < getsPerThread; ++i) {
+                int key = gen() % keys;
+                lat[t].time([&] { cache.get(key, out); });
+                if (i % 8 == 0) std::this_thread::sleep_for(std::chrono::microseconds(100));
+            }
+            return getsPerThread;
+        });
+        CacheBench::Latency all;
+        for (auto& l : lat) all.merge(l);
+        std::cout << std::left << std::setw(15) << name << std::right << " | " << std::setw(7)
+                  << cache.expiredMisses() << " | " << std::setw(7) << cache.sharedLoads() << " | " << std::setw(6)
+                  << cache.loads() - warmLoads << " | " << std::setw(5) << cache.earlyLoads() << " | "
+                  << std::setw(11) << peak.load() << " | " << std::setw(7) << all.percentile(99) / 1e3 << " | "
+                  << std::setw(8) << all.percentile(99.9) / 1e3 << "\n";
+    };
+
+    std::cout << std::fixed << std::setprecision(1)
+              << "Mode            | expired | blocked |  loads | early | peak source |  p99 us | p99.9 us\n";
+    run("expiry only", 0.0);
+    run("XFetch beta 1", 1.0);
+    run("XFetch beta 4", 4.0);
+    std::cout << "\n";
+}
+
+int main() {
+    bool ok = true;
+    ok &= runThresholdTest<LruCache<int, TimedValue<std::string>>>("RefreshAhead Test 1: Thresholds over LRU");
+    ok &= runThresholdTest<LfuCache<int, TimedValue<std::string>>>("RefreshAhead Test 2: Thresholds over LFU");
+    ok &= runThresholdTest<Arc_new<int, TimedValue<std::string>>>("RefreshAhead Test 3: Thresholds over ARC");
+    ok &= runPutAndErrorTest("RefreshAhead Test 4: put vs reload, failed reloads");
+    ok &= runSingleFlightTest("RefreshAhead Test 5: Single-flight misses", 8);
+    ok &= runXFetchTest("RefreshAhead Test 6: XFetch early recomputation", 100);
+    ok &= runConcurrentTest("RefreshAhead Test 7: Concurrent reads, reloads and puts", 4, 20000);
+
+    runTailBench("RefreshAhead Bench 1: 100 ms ttl, 1 ms source, 32 hot keys", 4, 100000, 32, 100, 1000);
+    runStampedeBench("RefreshAhead Bench 2: Expiry stampede, 8 threads, 16 keys, 50 ms ttl, 2 ms source",
+                     8, 20000, 16, 50, 2000);
+
+    return ok ? 0 : 1;
+}
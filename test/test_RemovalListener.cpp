@@ -0,0 +1,215 @@
+// Removal listeners (RemovalListener.h): causes per policy, delivery after the
+// unlock, nothing lost or duplicated under concurrency, and put throughput
+#include <algorithm>
+#include <iostream>
+#include <string>
+#include <random>
+#include <iomanip>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "LruCache.h"
+#include "LfuCache.h"
+#include "Arc_new.h"
+#include "BenchUtil.h"
+
+using namespace Cache;
+
+using Note = RemovalNotification<int, std::string>;
+
+std::string describe(const std::vector<Note>& notes) {
+    std::string s;
+    for (const auto& n : notes)
+        s += std::to_string(n.key) + "=" + n.value + ":" + toString(n.cause) + " ";
+    return s;
+}
+
+// Collects notifications; each batch first re-enters the cache with a get
+// (a deadlock here would mean delivery under the lock)
+template<typename CacheT>
+void record(CacheT& cache, std::vector<Note>& out) {
+    cache.setRemovalListener([&cache, &out](RemovalBatch<int, std::string>& batch) {
+        std::string v;
+        cache.get(-1, v);
+        for (auto& n : batch) out.push_back(std::move(n));
+    });
+}
+
+bool expect(const char* name, const std::vector<Note>& got, const std::string& want) {
+    std::string have = describe(got);
+    bool ok = have == want;
+    std::cout << std::left << std::setw(9) << name << std::right << have << (ok ? "" : "  expected: " + want) << "\n";
+    return ok;
+}
+
+bool runCauseTest(const std::string& testName) {
+    std::cout << "=== " << testName << " ===\n";
+    bool ok = true;
+    {
+        std::vector<Note> notes;
+        LruCache<int, std::string> lru(2);
+        record(lru, notes);
+        lru.put(1, "a"); lru.put(2, "b");
+        lru.put(1, "a2");                                    // Replaced: old value "a"
+        lru.put(3, "c");                                     // Evicts 2
+        lru.remove(1);
+        lru.remove(42);                                      // Absent: nothing
+        ok &= expect("LruCache", notes, "1=a:Replaced 2=b:Size 1=a2:Explicit ");
+    }
+    {
+        std::vector<Note> notes;
+        LfuCache<int, std::string> lfu(2);
+        record(lfu, notes);
+        lfu.put(1, "a"); lfu.put(2, "b");
+        std::string v;
+        lfu.get(1, v);
+        lfu.put(3, "c");                                     // Evicts 2 (freq 1, oldest)
+        lfu.put(1, "a2");
+        lfu.purge();
+        lfu.reclaimNow();                                    // Purged entries are reported as they are torn down
+        std::sort(notes.begin() + 2, notes.end(), [](const Note& x, const Note& y) { return x.key < y.key; });
+        ok &= expect("LfuCache", notes, "2=b:Size 1=a:Replaced 1=a2:Explicit 3=c:Explicit ");
+    }
+    {
+        std::vector<Note> notes;
+        Arc_new<int, std::string> arc(2);
+        record(arc, notes);
+        std::string v;
+        arc.put(1, "a"); arc.put(2, "b");
+        arc.get(1, v);                                       // 1 → T2
+        arc.put(3, "c");                                     // T1 over p: 2 → B1
+        arc.get(3, v);                                       // 3 → T2, T1 now empty
+        arc.put(4, "d");                                     // T1 empty: T2's LRU (1) → B2
+        arc.put(4, "d2");
+        arc.clear();
+        arc.reclaimNow();
+        std::sort(notes.begin() + 3, notes.end(), [](const Note& x, const Note& y) { return x.key < y.key; });
+        ok &= expect("Arc_new", notes, "2=b:DemotedT1 1=a:DemotedT2 4=d:Replaced 3=c:Explicit 4=d2:Explicit ");
+    }
+    std::cout << "Result: " << (ok ? "PASS" : "FAIL") << "\n\n";
+    return ok;
+}
+
+// Every value that enters the cache leaves it exactly once: after a final
+// remove / purge / clear, the notifications cover all puts, with no
+// duplicates, whether delivered inline or on an executor
+bool runConservationTest(const std::string& testName, int threads, int opsPerThread) {
+    std::cout << "=== " << testName << " ===\n";
+    const int total = threads * opsPerThread, keySpace = 600;
+    bool ok = true;
+
+    auto check = [&](const char* name, auto& cache, auto&& drop, std::shared_ptr<MaintenanceExecutor> executor) {
+        std::mutex m;
+        std::vector<int> seen(total, 0);
+        cache.setRemovalListener([&](RemovalBatch<int, std::string>& batch) {
+            std::lock_guard<std::mutex> lock(m);
+            for (auto& n : batch) ++seen[std::stoi(n.value)];
+        }, executor);
+
+        std::vector<std::thread> workers;
+        for (int t = 0; t < threads; ++t) {
+            workers.emplace_back([&, t] {
+                std::mt19937 gen(t + 1);
+                std::string v;
+                for (int i = 0; i < opsPerThread; ++i) {
+                    int key = gen() % keySpace;
+                    cache.put(key, std::to_string(t * opsPerThread + i));   // Unique value per put
+                    if (gen() % 4 == 0) cache.get(gen() % keySpace, v);
+                }
+            });
+        }
+        for (auto& w : workers) w.join();
+        drop(cache);
+        if (executor) executor->drain();
+
+        int missing = 0, duplicated = 0;
+        std::lock_guard<std::mutex> lock(m);
+        for (int c : seen) {
+            missing += c == 0;
+            duplicated += c > 1;
+        }
+        std::cout << std::left << std::setw(30) << name << std::right << " missing: " << missing
+                  << ", duplicated: " << duplicated << "\n";
+        ok &= missing == 0 && duplicated == 0;
+    };
+
+    auto removeAll = [&](auto& cache) { for (int k = 0; k < keySpace; ++k) cache.remove(k); };
+    auto purge     = [](auto& cache) { cache.purge(); cache.reclaimNow(); };
+    auto clear     = [](auto& cache) { cache.clear(); cache.reclaimNow(); };
+    auto executor  = std::make_shared<MaintenanceExecutor>();
+
+    { LruCache<int, std::string> c(200);                 check("LruCache", c, removeAll, nullptr); }
+    { LruCache<int, std::string> c(200, true);           check("LruCache (combining)", c, removeAll, nullptr); }
+    { LruCache<int, std::string> c(200);                 check("LruCache (executor)", c, removeAll, executor); }
+    {
+        LruCache<int, std::string> c(200);
+        c.enableMaintenance(executor, 150, 300);
+        check("LruCache (maintenance)", c, removeAll, executor);
+    }
+    { LfuCache<int, std::string> c(200, 5);              check("LfuCache", c, purge, nullptr); }
+    { LfuCache<int, std::string> c(200, 5);              check("LfuCache (executor)", c, purge, executor); }
+    { Arc_new<int, std::string> c(200);                  check("Arc_new", c, clear, nullptr); }
+    { Arc_new<int, std::string> c(200, true);            check("Arc_new (combining)", c, clear, executor); }
+    {
+        Arc_new<int, std::string> c(200);
+        c.enableMaintenance(executor, 150, 300);
+        check("Arc_new (maintenance)", c, clear, executor);
+    }
+    {
+        HashLruCaches<int, std::string> c(200, 4);
+        check("HashLruCaches", c, removeAll, nullptr);
+    }
+    std::cout << "Result: " << (ok ? "PASS" : "FAIL") << "\n\n";
+    return ok;
+}
+
+// Put throughput on a churning key space (most puts evict or overwrite):
+// no listener, an inline listener, and one delivered on an executor
+void runThroughputBench(const std::string& testName, int capacity, int totalOps) {
+    std::cout << "=== " << testName << " ===\n";
+
+    auto bench = [&](const char* name, auto make) {
+        std::cout << std::left << std::setw(9) << name << std::right;
+        for (int mode = 0; mode < 3; ++mode) {
+            for (int threads : {1, 4}) {
+                auto executor = std::make_shared<MaintenanceExecutor>();
+                auto cache = make();
+                std::atomic<long> notified{0};
+                auto listener = [&](RemovalBatch<int, std::string>& batch) {
+                    notified.fetch_add(static_cast<long>(batch.size()), std::memory_order_relaxed);
+                };
+                if (mode == 1) cache->setRemovalListener(listener);
+                if (mode == 2) cache->setRemovalListener(listener, executor);
+                int opsPerThread = totalOps / threads;
+                double ops = CacheBench::runThroughput(threads, [&](int t) {
+                    std::mt19937 gen(t + 1);
+                    const std::string value(32, 'v');
+                    for (int i = 0; i < opsPerThread; ++i) cache->put(gen() % (capacity * 4), value);
+                    return opsPerThread;
+                });
+                executor->drain();
+                std::cout << " | " << std::setw(9) << ops / 1e3;
+            }
+        }
+        std::cout << "\n";
+    };
+
+    std::cout << std::fixed << std::setprecision(0)
+              << "Cache     |   none 1T |   none 4T | inline 1T | inline 4T |  exec. 1T |  exec. 4T   (Kputs/s)\n";
+    bench("LruCache", [&] { return std::make_unique<LruCache<int, std::string>>(capacity); });
+    bench("LfuCache", [&] { return std::make_unique<LfuCache<int, std::string>>(capacity); });
+    bench("Arc_new",  [&] { return std::make_unique<Arc_new<int, std::string>>(capacity); });
+    std::cout << "\n";
+}
+
+int main() {
+    bool ok = true;
+    ok &= runCauseTest("Removal Test 1: Causes per policy, listener may re-enter");
+    ok &= runConservationTest("Removal Test 2: Every value reported exactly once", 4, 20000);
+
+    runThroughputBench("Removal Bench 1: Put throughput with a listener", 1000, 400000);
+
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,162 @@
+// SeqlockLruCache (optimistic get for trivially copyable values): semantics, torn-read stress, read scaling
+#include <iostream>
+#include <string>
+#include <random>
+#include <iomanip>
+#include <thread>
+#include <atomic>
+#include <vector>
+#include "SeqlockLruCache.h"
+#include "LruCache.h"
+#include "BenchUtil.h"
+
+using namespace Cache;
+
+// Multi-word value: a torn copy breaks the checksum
+struct Record {
+    int       key;
+    int       version;
+    long long payload[4];
+    long long checksum;
+
+    static Record make(int key, int version) {
+        Record r{key, version, {}, 0};
+        for (int i = 0; i < 4; ++i) r.payload[i] = static_cast<long long>(version) * 31 + key + i;
+        r.checksum = key ^ version;
+        for (long long p : r.payload) r.checksum ^= p;
+        return r;
+    }
+    bool intact() const {
+        long long c = key ^ version;
+        for (long long p : payload) c ^= p;
+        return c == checksum;
+    }
+};
+
+bool runSeqlockBasicTest(const std::string& testName) {
+    std::cout << "=== " << testName << " ===\n";
+    SeqlockLruCache<int, int> cache(3);
+    bool ok = true;
+    int v = 0;
+    cache.put(1, 10);
+    cache.put(2, 20);
+    cache.put(3, 30);
+    ok &= cache.get(1, v) && v == 10;           // 1 referenced → second chance
+    cache.put(4, 40);                           // Evicts 2 (LRU end after 1 is promoted)
+    ok &= !cache.get(2, v);
+    ok &= cache.get(1, v) && cache.get(3, v) && cache.get(4, v);
+    cache.put(3, 33);
+    ok &= cache.get(3) == 33;
+    cache.remove(3);
+    ok &= !cache.get(3, v) && cache.size() == 2;
+    cache.put(5, 50);                           // Reuses the removed slot, no eviction
+    ok &= cache.get(1, v) && cache.get(4, v) && cache.get(5, v) && cache.size() == 3;
+    std::cout << "Result: " << (ok ? "PASS" : "FAIL") << "\n\n";
+    return ok;
+}
+
+// Hit rate of the deferred (second-chance) recency vs exact LRU on the hot/cold workload
+void runSeqlockHitRateTest(const std::string& testName, int capacity, int hotKeys, int coldKeys, int totalOps) {
+    std::cout << "=== " << testName << " ===\n";
+    LruCache<int, int> lru(capacity);
+    SeqlockLruCache<int, int> seq(capacity);
+    std::mt19937 gen(42);
+    int getCount = 0, hitLru = 0, hitSeq = 0;
+    for (int i = 0; i < totalOps; ++i) {
+        int key = (gen() % 100 < 70) ? gen() % hotKeys : hotKeys + gen() % coldKeys;
+        if (gen() % 100 < 30) { lru.put(key, key); seq.put(key, key); }
+        else {
+            int v;
+            ++getCount;
+            hitLru += lru.get(key, v);
+            hitSeq += seq.get(key, v);
+        }
+    }
+    std::cout << std::fixed << std::setprecision(2)
+              << "LruCache Hit Rate:        " << 100.0 * hitLru / getCount << "%\n"
+              << "SeqlockLruCache Hit Rate: " << 100.0 * hitSeq / getCount << "%\n\n";
+}
+
+// Writers rewrite records (and evict: more keys than capacity) while readers
+// check every copy is intact and belongs to the key asked for
+bool runSeqlockStressTest(const std::string& testName, int writers, int readers, int capacity, int keys, int writes) {
+    std::cout << "=== " << testName << " ===\n";
+    HashSeqlockLruCaches<int, Record> cache(capacity, 4);
+    std::atomic<int>  writersDone{0};
+    std::atomic<long> violations{0}, hits{0};
+
+    std::vector<std::thread> threads;
+    for (int w = 0; w < writers; ++w) {
+        threads.emplace_back([&, w] {
+            std::mt19937 gen(w);
+            for (int i = 1; i <= writes; ++i) {
+                int key = gen() % keys;
+                if (gen() % 16 == 0) cache.remove(key);
+                else cache.put(key, Record::make(key, i));
+            }
+            writersDone.fetch_add(1);
+        });
+    }
+    for (int r = 0; r < readers; ++r) {
+        threads.emplace_back([&, r] {
+            std::mt19937 gen(100 + r);
+            while (writersDone.load() < writers) {
+                int key = gen() % keys;
+                Record rec;
+                if (!cache.get(key, rec)) continue;
+                hits.fetch_add(1, std::memory_order_relaxed);
+                if (!rec.intact() || rec.key != key) violations.fetch_add(1);
+            }
+        });
+    }
+    for (auto& t : threads) t.join();
+
+    bool ok = violations.load() == 0;
+    std::cout << "Writers: " << writers << ", Readers: " << readers << ", Hits: " << hits.load()
+              << ", Violations: " << violations.load() << "\n";
+    std::cout << "Result: " << (ok ? "PASS" : "FAIL") << "\n\n";
+    return ok;
+}
+
+// Read-mostly Zipf 0.99 (PUT=2%), HashLruCaches vs HashSeqlockLruCaches
+void runSeqlockScalingBench(const std::string& testName, int capacity, int keyRange, int totalOps) {
+    std::cout << "=== " << testName << " ===\n";
+    CacheBench::ZipfGenerator zipf(keyRange, 0.99);
+
+    auto bench = [&](auto& cache, int threads) {
+        for (int k = 0; k < keyRange; ++k) cache.put(k, k);
+        int opsPerThread = totalOps / threads;
+        return CacheBench::runThroughput(threads, [&](int t) {
+            std::mt19937 gen(t + 1);
+            int v = 0;
+            for (int i = 0; i < opsPerThread; ++i) {
+                int key = zipf(gen);
+                if (gen() % 50 == 0) cache.put(key, i);
+                else cache.get(key, v);
+            }
+            return opsPerThread;
+        });
+    };
+
+    std::cout << "Threads | HashLruCaches | HashSeqlockLruCaches  (Mops/s)\n";
+    for (int threads : {1, 2, 4, 8, 16, 32}) {
+        HashLruCaches<int, int> plain(capacity, 8);
+        HashSeqlockLruCaches<int, int> seq(capacity, 8);
+        double a = bench(plain, threads);
+        double b = bench(seq, threads);
+        std::cout << std::fixed << std::setprecision(2) << std::setw(7) << threads << " | "
+                  << std::setw(13) << a / 1e6 << " | " << std::setw(20) << b / 1e6 << "\n";
+    }
+    std::cout << "\n";
+}
+
+int main() {
+    bool ok = true;
+    ok &= runSeqlockBasicTest("Seqlock Test 1: put/get/remove, second-chance eviction");
+    runSeqlockHitRateTest("Seqlock Test 2: Hit rate vs exact LRU (hot/cold)", 20, 20, 2000, 100000);
+    ok &= runSeqlockStressTest("Seqlock Test 3: No torn reads under writes + evictions", 2, 4, 256, 1024, 200000);
+
+    runSeqlockScalingBench("Seqlock Bench 1: Read scaling, Zipf 0.99, PUT=2%", 10000, 100000, 2000000);
+
+    return ok ? 0 : 1;
+}
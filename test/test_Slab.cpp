@@ -0,0 +1,283 @@
+// SlabAllocator / SlabCache: size classes and page moves, per-class LRU
+// eviction, a manual page move, automove after a size shift, concurrent
+// puts with moves in flight; and hit rate, fragmentation and throughput
+// on a workload whose value sizes shift twice
+#include <iostream>
+#include <string>
+#include <random>
+#include <iomanip>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+#include "SlabCache.h"
+#include "BenchUtil.h"
+
+using namespace Cache;
+using Clock = std::chrono::steady_clock;
+
+// "key:version|" then a fill character derived from both
+std::string makeValue(int key, int version, size_t len) {
+    std::string v = std::to_string(key) + ":" + std::to_string(version) + "|";
+    v.resize(std::max(len, v.size()), static_cast<char>('a' + (key + version) % 26));
+    return v;
+}
+
+bool check(int key, const std::string& v) {
+    size_t colon = v.find(':'), bar = v.find('|');
+    if (colon == std::string::npos || bar == std::string::npos || std::stoi(v.substr(0, colon)) != key) return false;
+    int version = std::stoi(v.substr(colon + 1, bar - colon - 1));
+    char fill = static_cast<char>('a' + (key + version) % 26);
+    return v.find_first_not_of(fill, bar + 1) == std::string::npos;
+}
+
+SlabOptions pages(size_t n) {
+    SlabOptions opts;
+    opts.memoryLimit = n << 20;
+    return opts;
+}
+
+// Geometric classes up to a page; chunks come back LIFO; a detached
+// page keeps its freed chunks off the free list and is re-carved whole
+bool runAllocatorTest() {
+    std::cout << "=== Slab Test 1: size classes and page moves ===\n";
+    SlabAllocator slabs(pages(2));
+    bool classes = slabs.chunkSize(0) == 64 && slabs.chunkSize(slabs.classCount() - 1) == (1u << 20) &&
+                   slabs.classFor(65) == 1 && slabs.classFor((1u << 20) + 1) == SlabAllocator::kNoClass;
+
+    const uint32_t small = slabs.classFor(100);
+    std::vector<void*> chunks;
+    for (size_t i = 0; i < (1u << 20) / slabs.chunkSize(small); ++i) {
+        chunks.push_back(slabs.allocate(small));
+        *static_cast<uint32_t*>(chunks.back()) = 1;            // In use
+    }
+    void* extra = slabs.allocate(small);                       // Second page
+    *static_cast<uint32_t*>(extra) = 1;
+    const uint32_t big = slabs.classFor(300000);
+    bool full = slabs.freePages() == 0 && slabs.pages(small) == 2 && slabs.allocate(big) == nullptr;
+    slabs.free(chunks[5]);
+    bool lifo = slabs.allocate(small) == chunks[5];
+    *static_cast<uint32_t*>(chunks[5]) = 1;
+
+    const size_t page = slabs.pageOf(chunks[0]);
+    slabs.detachPage(page);
+    for (void* c : chunks) slabs.free(c);
+    bool detached = slabs.usedChunks(small) == 1 && slabs.allocate(small) != chunks[0];   // Second page's chunk
+    slabs.assignPage(page, big);
+    void* b = slabs.allocate(big);
+    bool moved = slabs.pages(small) == 1 && slabs.pages(big) == 1 && b != nullptr && slabs.pageOf(b) == page &&
+                 slabs.classOf(b) == big;
+
+    std::cout << slabs.classCount() << " classes, " << slabs.chunkSize(0) << " B .. " << slabs.pageBytes()
+              << " B; page move " << (moved ? "re-carves" : "broken") << "\n";
+    bool ok = classes && full && lifo && detached && moved;
+    std::cout << "Result: " << (ok ? "PASS" : "FAIL") << "\n\n";
+    return ok;
+}
+
+// put / get / overwrite within and across classes, remove, oversized
+// items; requested bytes track exactly what is stored
+bool runBasicTest() {
+    std::cout << "=== Slab Test 2: put / get / overwrite / remove ===\n";
+    SlabCache<int, std::string> cache(pages(4));
+    std::string v;
+    cache.put(1, makeValue(1, 0, 100));
+    cache.put(2, makeValue(2, 0, 100));
+    cache.put(1, makeValue(1, 1, 110));                        // Same class: in place
+    cache.put(2, makeValue(2, 1, 5000));                       // Other class
+    bool values = cache.get(1, v) && check(1, v) && v.size() == 110 && cache.get(2, v) && check(2, v) &&
+                  v.size() == 5000 && !cache.get(3, v) && cache.get(3).empty();
+
+    SlabStats s = cache.stats();
+    bool accounted = s.items == 2 && s.requestedBytes == 2 * 48 + 2 * sizeof(int) + 110 + 5000 && s.hits == 2 &&
+                     s.misses == 2;
+
+    cache.put(2, std::string(2u << 20, 'x'));                  // Over a page: dropped with the old item
+    bool removed = !cache.get(2, v) && cache.stats().tooLarge == 1 && cache.remove(1) && !cache.remove(1) &&
+                   cache.size() == 0 && cache.stats().requestedBytes == 0;
+
+    SlabCache<std::string, std::vector<double>> typed(pages(1));
+    typed.put("weights", {0.5, 1.5});
+    std::vector<double> w;
+    bool traits = typed.get("weights", w) && w.size() == 2 && w[1] == 1.5;
+
+    std::cout << "values " << (values ? "ok" : "wrong") << ", accounting " << (accounted ? "exact" : "off")
+              << ", oversized / remove " << (removed ? "ok" : "wrong") << ", string keys " << (traits ? "ok" : "wrong")
+              << "\n";
+    bool ok = values && accounted && removed && traits;
+    std::cout << "Result: " << (ok ? "PASS" : "FAIL") << "\n\n";
+    return ok;
+}
+
+// 4 pages. One page of ~100 B items, three of ~1 KB items: the 1 KB class
+// evicts only its own LRU. 10 KB items find no page and are dropped
+// until rebalance() moves one from the 1 KB class
+bool runClassLruTest() {
+    std::cout << "=== Slab Test 3: per-class LRU and a manual page move ===\n";
+    SlabCache<int, std::string> cache(pages(4));
+    std::string v;
+    for (int k = 0; k < 1000; ++k) cache.put(k, makeValue(k, 0, 100));
+    for (int k = 1000; k < 6000; ++k) cache.put(k, makeValue(k, 0, 1000));
+    int small = 0;
+    for (int k = 0; k < 1000; ++k) small += cache.get(k, v);
+    SlabStats s = cache.stats();
+    bool ownClass = small == 1000 && s.pagesFree == 0 && s.evictions > 0 && cache.get(5999, v) &&
+                    !cache.get(1000, v);
+
+    for (int k = 10000; k < 10010; ++k) cache.put(k, makeValue(k, 0, 10000));
+    bool starved = !cache.get(10009, v) && cache.stats().evictions == s.evictions;
+
+    bool moved = cache.rebalance();
+    for (int k = 10000; k < 10010; ++k) cache.put(k, makeValue(k, 0, 10000));
+    s = cache.stats();
+    small = 0;
+    for (int k = 0; k < 1000; ++k) small += cache.get(k, v);
+    bool fed = moved && s.pagesMoved == 1 && s.moveEvictions > 0 && cache.get(10009, v) && check(10009, v) &&
+               small == 1000 && !cache.rebalance();
+
+    std::cout << "small class kept " << small << "/1000, 10 KB items " << (starved ? "dropped" : "stored")
+              << " before the move, " << s.moveEvictions << " items displaced by it\n";
+    bool ok = ownClass && starved && fed;
+    std::cout << "Result: " << (ok ? "PASS" : "FAIL") << "\n\n";
+    return ok;
+}
+
+// Automove on an executor: ~200 B items fill all 16 pages, then the
+// workload switches to ~4 KB items, a class that has no page. Pages
+// follow, and the hit rate on the new sizes recovers
+bool runAutomoveTest() {
+    std::cout << "=== Slab Test 4: automove after a size shift ===\n";
+    auto executor = std::make_shared<MaintenanceExecutor>();
+    size_t bigPages[2];
+    double hitRate[2];
+    for (bool automove : {false, true}) {
+        SlabOptions opts = pages(16);
+        opts.rebalanceWindow = 200;
+        SlabCache<int, std::string> cache(opts);
+        if (automove) cache.enableRebalancing(executor);
+        std::mt19937 gen(3);
+        std::uniform_int_distribution<int> smallKey(0, 59999), bigKey(100000, 102999);
+        std::string v;
+        for (int i = 0; i < 200000; ++i) {
+            int k = smallKey(gen);
+            if (!cache.get(k, v)) cache.put(k, makeValue(k, 0, 200));
+        }
+        long hits = 0;
+        for (int i = 0; i < 100000; ++i) {
+            int k = bigKey(gen);
+            if (cache.get(k, v)) ++hits;
+            else cache.put(k, makeValue(k, 0, 4000));
+            if (automove && i % 1000 == 0) executor->drain();   // Let the moves keep pace on one core
+        }
+        executor->drain();
+        bigPages[automove] = 0;
+        for (const auto& c : cache.stats().classes)
+            if (c.chunkBytes >= 48 + sizeof(int) + 4000) bigPages[automove] += c.pages;
+        hitRate[automove] = 100.0 * hits / 100000;
+    }
+    std::cout << "4 KB class pages: " << bigPages[0] << " without automove, " << bigPages[1] << " with; hit rate "
+              << hitRate[0] << "% / " << hitRate[1] << "%\n";
+    bool ok = bigPages[0] == 0 && bigPages[1] >= 8 && hitRate[1] > hitRate[0] + 50;
+    std::cout << "Result: " << (ok ? "PASS" : "FAIL") << "\n\n";
+    return ok;
+}
+
+// 4 threads get-or-put with sizes drifting per thread, automove running
+// and one thread forcing extra moves; every value read must be intact
+bool runConcurrentTest() {
+    std::cout << "=== Slab Test 5: concurrent puts with page moves in flight ===\n";
+    auto executor = std::make_shared<MaintenanceExecutor>();
+    SlabOptions opts = pages(8);
+    opts.rebalanceWindow = 100;
+    SlabCache<int, std::string> cache(opts);
+    cache.enableRebalancing(executor);
+    std::atomic<long> torn{0};
+    CacheBench::runThroughput(4, [&](int t) {
+        std::mt19937 gen(t + 1);
+        std::uniform_int_distribution<int> key(0, 9999);
+        std::string v;
+        for (int i = 0; i < 30000; ++i) {
+            int k = key(gen);
+            bool hit = cache.get(k, v);
+            if (hit && !check(k, v)) torn.fetch_add(1, std::memory_order_relaxed);
+            if (!hit || i % 4 == 0) {
+                size_t len = (i / 10000) % 2 ? 3000 : 150;      // Small, large, small again
+                cache.put(k, makeValue(k, i, len + k % 16));
+            }
+            if (t == 0 && i % 2000 == 0) cache.rebalance();
+        }
+        return 30000;
+    });
+    executor->drain();
+    SlabStats s = cache.stats();
+    size_t classItems = 0, classBytes = 0, classPages = 0;
+    for (const auto& c : s.classes) { classItems += c.items; classBytes += c.requestedBytes; classPages += c.pages; }
+    bool ok = torn == 0 && classItems == s.items && classBytes == s.requestedBytes &&
+              classPages == s.pagesAssigned && s.pagesMoved > 0;
+    std::cout << s.items << " items, " << s.pagesMoved << " pages moved, " << torn << " torn values\n";
+    std::cout << "Result: " << (ok ? "PASS" : "FAIL") << "\n\n";
+    return ok;
+}
+
+// 64 MiB, get-or-put, Zipf(0.9) over 100k keys; three phases of 1M ops,
+// each on fresh keys, whose value sizes are lognormal around ~150 B,
+// ~1.5 KB, then ~400 B. The old phase's items stay until evicted
+struct ShiftResult { double hit[3], frag[3], kops; uint64_t moved; };
+
+ShiftResult runShift(SlabOptions opts, bool automove) {
+    auto executor = std::make_shared<MaintenanceExecutor>();
+    SlabCache<int, std::string> cache(opts);
+    if (automove) cache.enableRebalancing(executor);
+    CacheBench::ZipfGenerator zipf(100000, 0.9);
+    std::mt19937 gen(5);
+    const double mu[3] = {5.0, 7.3, 6.0};
+    std::string v;
+    ShiftResult r{};
+    auto t0 = Clock::now();
+    for (int phase = 0; phase < 3; ++phase) {
+        std::lognormal_distribution<double> size(mu[phase], 0.5);
+        long hits = 0;
+        for (int i = 0; i < 1000000; ++i) {
+            int k = phase * 1000000 + zipf(gen);
+            if (cache.get(k, v)) { ++hits; continue; }
+            cache.put(k, makeValue(k, phase, static_cast<size_t>(std::min(size(gen), 60000.0))));
+        }
+        executor->drain();
+        r.hit[phase] = 100.0 * hits / 1000000;
+        r.frag[phase] = cache.stats().fragmentation() * 100;
+    }
+    r.kops = 3000000 / std::chrono::duration<double>(Clock::now() - t0).count() / 1e3;
+    r.moved = cache.stats().pagesMoved;
+    return r;
+}
+
+void runShiftBench() {
+    std::cout << "=== Slab Bench 1: 64 MiB, Zipf 0.9 over 100k fresh keys per phase, sizes ~150 B → ~1.5 KB → ~400 B ===\n";
+    std::cout << std::fixed << std::setprecision(1)
+              << "Configuration            | hit % per phase     | frag % per phase    | moved | Kops/s\n";
+    struct Row { const char* label; double growth; bool automove; };
+    for (Row row : {Row{"x1.25, no rebalancing", 1.25, false}, Row{"x1.25, automove", 1.25, true},
+                    Row{"x2.0,  automove", 2.0, true}}) {
+        SlabOptions opts = pages(64);
+        opts.growthFactor = row.growth;
+        ShiftResult r = runShift(opts, row.automove);
+        std::cout << std::left << std::setw(24) << row.label << std::right << " | " << std::setw(5) << r.hit[0]
+                  << " " << std::setw(5) << r.hit[1] << " " << std::setw(5) << r.hit[2] << "   | " << std::setw(5)
+                  << r.frag[0] << " " << std::setw(5) << r.frag[1] << " " << std::setw(5) << r.frag[2] << "   | "
+                  << std::setw(5) << r.moved << " | " << std::setw(6) << r.kops << "\n";
+    }
+    std::cout << "(frag: 1 - item bytes / assigned page bytes, at the end of each phase)\n\n";
+}
+
+int main() {
+    bool ok = true;
+    ok &= runAllocatorTest();
+    ok &= runBasicTest();
+    ok &= runClassLruTest();
+    ok &= runAutomoveTest();
+    ok &= runConcurrentTest();
+
+    runShiftBench();
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,203 @@
+// Tags / invalidateTag: index upkeep through retagging, eviction and
+// removal over LRU, LFU, ARC and the sharded LRU; tagged puts racing
+// invalidations; and invalidating a 100k-member tag against removing
+// the same keys one at a time
+#include <iostream>
+#include <string>
+#include <random>
+#include <iomanip>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <thread>
+#include <vector>
+#include "LruCache.h"
+#include "LfuCache.h"
+#include "Arc_new.h"
+#include "BenchUtil.h"
+
+using namespace Cache;
+using Clock = std::chrono::steady_clock;
+using Tags = std::vector<std::string>;
+
+std::string val(int k) { return "v" + std::to_string(k); }
+
+// The same script against every cache; capacity 100
+template<typename CacheT>
+bool runTagTest(const std::string& testName, CacheT& cache) {
+    std::cout << "=== " << testName << " ===\n";
+    std::atomic<int> explicitRemovals{0};
+    cache.setRemovalListener([&](RemovalBatch<int, std::string>& batch) {
+        for (auto& n : batch) explicitRemovals += n.cause == RemovalCause::Explicit;
+    });
+    std::string v;
+
+    // 1. Two tags per entry, some entries untagged
+    for (int k = 0; k < 50; ++k) cache.put(k, val(k), Tags{k % 2 ? "odd" : "even", "all", "all"});
+    for (int k = 50; k < 60; ++k) cache.put(k, val(k));
+    bool counted = cache.tagSize("even") == 25 && cache.tagSize("odd") == 25 && cache.tagSize("all") == 50 &&
+                   cache.tagSize("none") == 0;
+
+    // 2. A tagged put replaces the tags, a plain put keeps them
+    cache.put(0, val(0), Tags{"odd"});
+    cache.put(1, "fresh");
+    bool retagged = cache.tagSize("even") == 24 && cache.tagSize("odd") == 26 && cache.tagSize("all") == 49;
+
+    // 3. Invalidation removes exactly the members, pinned ones too
+    auto lease = cache.pin(3);
+    size_t gone = cache.invalidateTag("odd");
+    int oddLeft = 0, evenLeft = 0;
+    for (int k = 0; k < 50; ++k) (k % 2 && k != 0 ? oddLeft : evenLeft) += cache.get(k, v);
+    bool invalidated = gone == 26 && explicitRemovals.load() == 26 && oddLeft == 0 && evenLeft == 24 &&
+                       !cache.get(0, v) && cache.tagSize("odd") == 0 && cache.tagSize("all") == 24 &&
+                       cache.pinnedBytes() == 0 && cache.get(55, v);
+    lease.release();                                   // Stale: releases nothing
+
+    // 4. Evicted members leave the index as they go
+    for (int k = 1000; k < 1200; ++k) cache.put(k, val(k));
+    int resident = 0;
+    for (int k = 0; k < 50; k += 2) resident += cache.get(k, v);
+    bool evicted = cache.tagSize("all") == static_cast<size_t>(resident) &&
+                   cache.invalidateTag("all") == static_cast<size_t>(resident) && cache.tagSize("even") == 0;
+
+    // 5. An emptied tag can be used again
+    cache.put(7, val(7), Tags{"odd"});
+    bool reused = cache.tagSize("odd") == 1 && cache.invalidateTag("odd") == 1 && !cache.get(7, v);
+
+    std::cout << "counted " << (counted ? "yes" : "no") << ", retagged " << (retagged ? "yes" : "no")
+              << ", invalidated " << gone << " (" << explicitRemovals.load() << " reported), evicted members "
+              << (evicted ? "dropped" : "kept") << " (" << resident << " left), tag reused "
+              << (reused ? "yes" : "no") << "\n";
+    bool ok = counted && retagged && invalidated && evicted && reused;
+    std::cout << "Result: " << (ok ? "PASS" : "FAIL") << "\n\n";
+    return ok;
+}
+
+// Writers put tagged keys (group = key % 16) while one thread keeps
+// invalidating random groups; afterwards invalidating every group must
+// leave no key behind, whatever interleaving happened
+template<typename CacheT>
+bool runConcurrentTest(const std::string& testName, CacheT& cache, int threads) {
+    std::cout << "=== " << testName << " ===\n";
+    std::atomic<bool> stop{false};
+    std::atomic<size_t> invalidated{0};
+    std::thread invalidator([&] {
+        std::mt19937 gen(99);
+        while (!stop.load()) {
+            invalidated += cache.invalidateTag("g" + std::to_string(gen() % 16));
+            std::this_thread::yield();
+        }
+    });
+    CacheBench::runThroughput(threads, [&](int t) {
+        std::mt19937 gen(t + 1);
+        std::uniform_int_distribution<int> dist(0, 4095);
+        std::string v;
+        for (int i = 0; i < 20000; ++i) {
+            int k = dist(gen);
+            cache.put(k, val(k), Tags{"g" + std::to_string(k % 16), "all"});
+            cache.get(dist(gen), v);
+        }
+        return 20000;
+    });
+    stop = true;
+    invalidator.join();
+
+    size_t tagged = cache.tagSize("all"), members = 0;
+    for (int g = 0; g < 16; ++g) members += cache.invalidateTag("g" + std::to_string(g));
+    std::string v;
+    int left = 0;
+    for (int k = 0; k < 4096; ++k) left += cache.get(k, v);
+    std::cout << threads << " writers, " << invalidated.load() << " entries invalidated meanwhile, " << members
+              << " at the end (index said " << tagged << "), " << left << " keys left\n";
+    bool ok = left == 0 && members == tagged && cache.tagSize("all") == 0;
+    std::cout << "Result: " << (ok ? "PASS" : "FAIL") << "\n\n";
+    return ok;
+}
+
+// 300k entries: one 100k-member tag, 100k entries spread over 1000 small
+// tags, 100k untagged. Times invalidateTag against removing the same
+// keys one by one (remove(), or computeIfPresent returning false where
+// there is no remove), and the cost a tagged put adds over a plain one
+template<typename CacheT>
+void runInvalidateBench(const std::string& label, std::function<CacheT*()> make,
+                        std::function<void(CacheT&, int)> removeOne) {
+    const int members = 100000;
+    auto fill = [&](CacheT& cache, CacheBench::Latency* plain, CacheBench::Latency* tagged) {
+        for (int k = 0; k < 3 * members; ++k) {
+            std::string value = val(k);
+            if (k < members) {
+                Tags tags{"hot"};
+                auto put = [&] { cache.put(k, value, tags); };
+                tagged ? tagged->time(put) : put();
+            } else if (k < 2 * members) {
+                cache.put(k, value, Tags{"t" + std::to_string(k % 1000)});
+            } else {
+                auto put = [&] { cache.put(k, value); };
+                plain ? plain->time(put) : put();
+            }
+        }
+    };
+
+    CacheBench::Latency plainPut, taggedPut;
+    std::unique_ptr<CacheT> cache(make());
+    fill(*cache, &plainPut, &taggedPut);
+    auto t0 = Clock::now();
+    size_t removed = cache->invalidateTag("hot");
+    double tagMs = std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+    std::string v;
+    bool othersKept = cache->get(members + 5, v) && cache->get(2 * members + 5, v) && cache->tagSize("t5") == 100;
+
+    cache.reset(make());
+    fill(*cache, nullptr, nullptr);
+    auto t1 = Clock::now();
+    for (int k = 0; k < members; ++k) removeOne(*cache, k);
+    double oneMs = std::chrono::duration<double, std::milli>(Clock::now() - t1).count();
+
+    std::cout << std::left << std::setw(14) << label << std::right << " | " << std::setw(7) << removed << " | "
+              << std::setw(9) << tagMs << " | " << std::setw(7) << tagMs * 1e6 / members << " | " << std::setw(10)
+              << oneMs << " | " << std::setw(8) << plainPut.percentile(50) << " | " << std::setw(9)
+              << taggedPut.percentile(50) << " | " << (othersKept ? "yes" : "NO") << "\n";
+}
+
+int main() {
+    bool ok = true;
+    {
+        LruCache<int, std::string> lru(100);
+        ok &= runTagTest("Tags Test 1: LruCache", lru);
+        LfuCache<int, std::string> lfu(100);
+        ok &= runTagTest("Tags Test 2: LfuCache", lfu);
+        Arc_new<int, std::string> arc(100);
+        ok &= runTagTest("Tags Test 3: Arc_new", arc);
+        HashLruCaches<int, std::string> sharded(100, 1);
+        ok &= runTagTest("Tags Test 4: HashLruCaches", sharded);
+    }
+    {
+        LruCache<int, std::string> lru(2048);
+        ok &= runConcurrentTest("Tags Test 5: LruCache, tagged puts vs invalidation", lru, 4);
+        LfuCache<int, std::string> lfu(2048);
+        ok &= runConcurrentTest("Tags Test 6: LfuCache, tagged puts vs invalidation", lfu, 4);
+        Arc_new<int, std::string> arc(2048);
+        ok &= runConcurrentTest("Tags Test 7: Arc_new, tagged puts vs invalidation", arc, 4);
+        HashLruCaches<int, std::string> sharded(2048, 8);
+        ok &= runConcurrentTest("Tags Test 8: HashLruCaches, tagged puts vs invalidation", sharded, 4);
+    }
+
+    using Lru = LruCache<int, std::string>;
+    using Lfu = LfuCache<int, std::string>;
+    using Arc = Arc_new<int, std::string>;
+    using Sharded = HashLruCaches<int, std::string>;
+    auto dropIfPresent = [](auto& c, int k) { c.computeIfPresent(k, [](std::string&) { return false; }); };
+
+    std::cout << "=== Tags Bench 1: invalidate a 100k-member tag in a 300k-entry cache ===\n";
+    std::cout << std::fixed << std::setprecision(1)
+              << "Policy         | removed | tag ms    | ns/key  | 1-by-1 ms  | put p50  | tagged p50| rest kept\n";
+    runInvalidateBench<Lru>("LruCache", [] { return new Lru(300000); }, [](Lru& c, int k) { c.remove(k); });
+    runInvalidateBench<Lfu>("LfuCache", [] { return new Lfu(300000); }, dropIfPresent);
+    runInvalidateBench<Arc>("Arc_new", [] { return new Arc(300000); }, dropIfPresent);
+    runInvalidateBench<Sharded>("HashLru x8", [] { return new Sharded(300000 + 8 * 4096, 8); },
+                                [](Sharded& c, int k) { c.remove(k); });
+    std::cout << "(1-by-1: remove() / computeIfPresent(..., false) per key; put p50 in ns)\n\n";
+
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,278 @@
+// WriteBackCache: dirty tracking, coalescing, max dirty age, eviction with
+// read-through, store failures, concurrency, and write-through vs write-back
+#include <iostream>
+#include <string>
+#include <random>
+#include <iomanip>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include "WriteBackCache.h"
+#include "BenchUtil.h"
+
+using namespace Cache;
+using Store = MemoryBackingStore<int, std::string>;
+
+// Puts stay in memory until flushed; repeated puts to a key are written once
+bool runCoalescingTest(const std::string& testName) {
+    std::cout << "=== " << testName << " ===\n";
+    auto store = std::make_shared<Store>();
+    WriteBackOptions opts;
+    opts.maxDirtyAge = std::chrono::milliseconds(60000);     // Only explicit flushes here
+    opts.flushBatch  = 1000;
+    WriteBackCache<int, std::string> cache(100, store, opts);
+
+    for (int round = 0; round < 10; ++round)
+        for (int k = 0; k < 10; ++k) cache.put(k, "v" + std::to_string(round));
+    size_t before = store->entriesWritten();
+    std::string v;
+    bool visible = cache.get(3, v) && v == "v9";
+    size_t dirty = cache.dirtyCount();
+    cache.flush();
+
+    bool stored = store->read(3, v) && v == "v9";
+    std::cout << "Puts: " << cache.puts() << ", dirty: " << dirty << ", written before flush: " << before
+              << ", after: " << store->entriesWritten() << " in " << store->writeCalls() << " call(s)\n";
+    bool ok = visible && stored && before == 0 && dirty == 10 && store->entriesWritten() == 10 &&
+              store->writeCalls() == 1 && cache.dirtyCount() == 0;
+    std::cout << "Result: " << (ok ? "PASS" : "FAIL") << "\n\n";
+    return ok;
+}
+
+// With no further puts, the flusher writes a lone dirty entry after about maxDirtyAge
+bool runDirtyAgeTest(const std::string& testName) {
+    std::cout << "=== " << testName << " ===\n";
+    auto store = std::make_shared<Store>();
+    WriteBackOptions opts;
+    opts.maxDirtyAge = std::chrono::milliseconds(20);
+    WriteBackCache<int, std::string> cache(100, store, opts);
+
+    auto start = std::chrono::steady_clock::now();
+    cache.put(1, "one");
+    while (store->entriesWritten() == 0 &&
+           std::chrono::steady_clock::now() - start < std::chrono::seconds(2))
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << std::fixed << std::setprecision(1) << "maxDirtyAge 20 ms, written after " << ms << " ms\n";
+    bool ok = store->entriesWritten() == 1 && ms >= 15.0;
+    std::cout << "Result: " << (ok ? "PASS" : "FAIL") << "\n\n";
+    return ok;
+}
+
+// Dirty keys evicted from the LRU are still served, then written; a fresh
+// cache over the same store reads everything back through the store
+bool runEvictionTest(const std::string& testName, int capacity, int keys) {
+    std::cout << "=== " << testName << " ===\n";
+    auto store = std::make_shared<Store>();
+    WriteBackOptions opts;
+    opts.maxDirtyAge     = std::chrono::milliseconds(60000);
+    opts.flushBatch      = keys * 2;
+    opts.maxDirtyEntries = keys * 2;
+    bool ok = true;
+    {
+        WriteBackCache<int, std::string> cache(capacity, store, opts);
+        for (int k = 0; k < keys; ++k) cache.put(k, "v" + std::to_string(k));
+        std::string v;
+        int served = 0;
+        for (int k = 0; k < keys; ++k) served += cache.get(k, v) && v == "v" + std::to_string(k);
+        std::cout << "Evicted while dirty: " << cache.evictedDirty() << ", served before any flush: "
+                  << served << "/" << keys << ", store reads: " << store->reads() << "\n";
+        ok &= cache.evictedDirty() > 0 && served == keys && store->reads() == 0;
+    }                                                       // Destructor flushes
+
+    WriteBackCache<int, std::string> reader(capacity, store, opts);
+    std::string v;
+    int readBack = 0;
+    for (int k = 0; k < keys; ++k) readBack += reader.get(k, v) && v == "v" + std::to_string(k);
+    bool missing = !reader.get(keys + 1, v);
+    std::cout << "Read back through the store: " << readBack << "/" << keys << "\n";
+    ok &= readBack == keys && missing;
+    std::cout << "Result: " << (ok ? "PASS" : "FAIL") << "\n\n";
+    return ok;
+}
+
+// A store whose first few writeBatch calls fail
+class FlakyStore : public MemoryBackingStore<int, std::string> {
+public:
+    explicit FlakyStore(int failures) : failures_(failures) {}
+    void writeBatch(const Entries& entries) override {
+        if (failures_.fetch_sub(1) > 0) throw std::runtime_error("store unavailable");
+        MemoryBackingStore<int, std::string>::writeBatch(entries);
+    }
+private:
+    std::atomic<int> failures_;
+};
+
+bool runFailureTest(const std::string& testName) {
+    std::cout << "=== " << testName << " ===\n";
+    auto store = std::make_shared<FlakyStore>(2);
+    WriteBackOptions opts;
+    opts.maxDirtyAge = std::chrono::milliseconds(60000);
+    WriteBackCache<int, std::string> cache(100, store, opts);
+
+    for (int k = 0; k < 20; ++k) cache.put(k, "old");
+    int thrown = 0;
+    try { cache.flush(); } catch (const std::runtime_error&) { ++thrown; }
+    size_t keptAfterFailure = cache.dirtyCount();
+    cache.put(7, "new");                                    // Newer than the retained copy
+    try { cache.flush(); } catch (const std::runtime_error&) { ++thrown; }
+    cache.flush();
+
+    std::string v7, v8;
+    bool stored = store->read(7, v7) && v7 == "new" && store->read(8, v8) && v8 == "old";
+    std::cout << "Failed flushes: " << thrown << ", entries kept: " << keptAfterFailure
+              << ", key 7 in store: " << v7 << ", dirty now: " << cache.dirtyCount() << "\n";
+    bool ok = thrown == 2 && keptAfterFailure == 20 && stored && cache.dirtyCount() == 0;
+    std::cout << "Result: " << (ok ? "PASS" : "FAIL") << "\n\n";
+    return ok;
+}
+
+// A put that triggers an inline flush against a failing store still
+// succeeds: the error is counted and the entries stay dirty for a retry
+bool runInlineFailureTest(const std::string& testName) {
+    std::cout << "=== " << testName << " ===\n";
+    auto store = std::make_shared<FlakyStore>(3);
+    WriteBackOptions opts;
+    opts.maxDirtyAge     = std::chrono::milliseconds(60000);
+    opts.flushBatch      = 4;
+    opts.maxDirtyEntries = 4;
+    WriteBackCache<int, std::string> cache(100, store, opts);
+
+    int thrown = 0;
+    for (int k = 0; k < 6; ++k) {
+        try { cache.put(k, "v" + std::to_string(k)); } catch (const std::runtime_error&) { ++thrown; }
+    }
+    size_t errors = cache.flushErrors();
+    while (cache.dirtyCount() > 0) {
+        try { cache.flush(); } catch (const std::runtime_error&) {}
+    }
+    std::string v5;
+    bool stored = store->read(5, v5) && v5 == "v5";
+    std::cout << "puts that threw: " << thrown << ", puts counted: " << cache.puts() << ", flush errors: "
+              << errors << ", key 5 in store: " << v5 << "\n";
+    bool ok = thrown == 0 && cache.puts() == 6 && errors >= 1 && stored;
+    std::cout << "Result: " << (ok ? "PASS" : "FAIL") << "\n\n";
+    return ok;
+}
+
+// Threads own disjoint key ranges and always read their own last write,
+// through evictions, background flushes and read-through fills
+bool runConcurrentTest(const std::string& testName, int threads, int opsPerThread) {
+    std::cout << "=== " << testName << " ===\n";
+    auto store = std::make_shared<Store>();
+    WriteBackOptions opts;
+    opts.maxDirtyAge = std::chrono::milliseconds(2);
+    opts.flushBatch  = 32;
+    const int keysPerThread = 300;
+    std::vector<std::vector<int>> last(threads, std::vector<int>(keysPerThread, -1));
+    std::atomic<int> wrong{0};
+    size_t flushRuns = 0;
+    {
+        WriteBackCache<int, std::string> cache(200, store, opts);
+        std::vector<std::thread> workers;
+        for (int t = 0; t < threads; ++t) {
+            workers.emplace_back([&, t] {
+                std::mt19937 gen(t + 1);
+                std::string v;
+                for (int i = 0; i < opsPerThread; ++i) {
+                    int slot = gen() % keysPerThread, key = t * keysPerThread + slot;
+                    if (gen() % 2) {
+                        cache.put(key, std::to_string(i));
+                        last[t][slot] = i;
+                    } else {
+                        bool found = cache.get(key, v);
+                        if (found != (last[t][slot] >= 0) || (found && v != std::to_string(last[t][slot])))
+                            wrong.fetch_add(1);
+                    }
+                }
+            });
+        }
+        for (auto& w : workers) w.join();
+        flushRuns = cache.flushRuns();
+    }
+
+    int stale = 0;
+    for (int t = 0; t < threads; ++t) {
+        for (int slot = 0; slot < keysPerThread; ++slot) {
+            if (last[t][slot] < 0) continue;
+            std::string v;
+            stale += !store->read(t * keysPerThread + slot, v) || v != std::to_string(last[t][slot]);
+        }
+    }
+    std::cout << "Wrong reads: " << wrong.load() << ", stale store entries after destruction: " << stale
+              << ", background flush runs: " << flushRuns << "\n";
+    bool ok = wrong.load() == 0 && stale == 0 && flushRuns > 0;
+    std::cout << "Result: " << (ok ? "PASS" : "FAIL") << "\n\n";
+    return ok;
+}
+
+// Zipf puts against a store with a per-call round trip: write-through
+// (one writeBatch per put, the old setup) vs write-back
+void runWriteBench(const std::string& testName, int keySpace, int puts, int latencyUs) {
+    std::cout << "=== " << testName << " ===\n";
+    CacheBench::ZipfGenerator zipf(keySpace, 0.99);
+
+    auto report = [&](const char* name, Store& store, CacheBench::Latency& lat, double seconds) {
+        std::cout << std::left << std::setw(13) << name << std::right << " | " << std::setw(11) << store.writeCalls()
+                  << " | " << std::setw(9) << store.entriesWritten() << " | " << std::setw(11) << std::setprecision(3)
+                  << static_cast<double>(store.entriesWritten()) / puts << " | " << std::setprecision(0) << std::setw(8)
+                  << lat.percentile(50) << " | " << std::setw(8) << lat.percentile(99) << " | " << std::setw(8)
+                  << puts / seconds / 1e3 << "\n";
+    };
+
+    std::cout << std::fixed << "Mode          | store calls |   entries | write ampl. |  p50 ns  |  p99 ns  | Kputs/s\n";
+    {
+        auto store = std::make_shared<Store>(std::chrono::microseconds(latencyUs));
+        LruCache<int, std::string> cache(keySpace / 10);
+        std::mt19937 gen(5);
+        CacheBench::Latency lat;
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < puts; ++i) {
+            int key = zipf(gen);
+            std::string value = "v" + std::to_string(i);
+            lat.time([&] {
+                store->writeBatch({{key, value}});
+                cache.put(key, value);
+            });
+        }
+        report("write-through", *store, lat,
+               std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+    }
+    {
+        auto store = std::make_shared<Store>(std::chrono::microseconds(latencyUs));
+        CacheBench::Latency lat;
+        double seconds;
+        {
+            WriteBackCache<int, std::string> cache(keySpace / 10, store);
+            std::mt19937 gen(5);
+            auto start = std::chrono::steady_clock::now();
+            for (int i = 0; i < puts; ++i) {
+                int key = zipf(gen);
+                std::string value = "v" + std::to_string(i);
+                lat.time([&] { cache.put(key, value); });
+            }
+            cache.flush();
+            seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        }
+        report("write-back", *store, lat, seconds);
+    }
+    std::cout << "\n";
+}
+
+int main() {
+    bool ok = true;
+    ok &= runCoalescingTest("WriteBack Test 1: Dirty until flushed, coalesced writes");
+    ok &= runDirtyAgeTest("WriteBack Test 2: Max dirty age");
+    ok &= runEvictionTest("WriteBack Test 3: Dirty eviction + read-through", 100, 2000);
+    ok &= runFailureTest("WriteBack Test 4: Failed writes are retried, newer puts win");
+    ok &= runConcurrentTest("WriteBack Test 5: Read-your-writes under concurrency", 4, 20000);
+    ok &= runInlineFailureTest("WriteBack Test 6: A failed inline flush doesn't fail the put");
+
+    runWriteBench("WriteBack Bench 1: Write-through vs write-back, 50 us store", 10000, 10000, 50);
+
+    return ok ? 0 : 1;
+}